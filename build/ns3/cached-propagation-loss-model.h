@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include <unordered_map>
+#include <utility>
+
+#include "ns3/vector.h"
+#include "propagation-loss-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the reception powers computed by a deterministic chain of
+ * propagation loss models.
+ *
+ * The wrapped chain, set with the Model attribute, is evaluated once per
+ * (source, destination) pair of mobility models: the reception power is
+ * kept with the positions of the pair and the transmission power, and is
+ * returned again as long as they do not change.  This saves the loss
+ * computations between static nodes, whose loss would otherwise be computed
+ * again for every packet.  The direction of the pair matters, since some
+ * models, such as OkumuraHataPropagationLossModel, are not symmetric.
+ *
+ * Only a chain whose models all tell that they are deterministic (see
+ * PropagationLossModel::IsDeterministic ()) is cached; any other chain is
+ * evaluated every time.  The random models, such as fading, should be
+ * chained after the cache, with SetNext (), so that they still draw a value
+ * for every packet:
+ *
+ * \code
+ *   Ptr<CachedPropagationLossModel> cache = CreateObject<CachedPropagationLossModel> ();
+ *   cache->SetModel (CreateObject<LogDistancePropagationLossModel> ());
+ *   cache->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+ * \endcode
+ *
+ * The attributes of the wrapped models are not watched: Clear () must be
+ * called after changing them.  The cache is cleared when it holds MaxSize
+ * pairs.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the chain of loss models to cache
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+
+  /**
+   * \returns the chain of loss models cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+
+  /**
+   * \brief Forget the cached reception powers.
+   */
+  void Clear (void);
+
+  /**
+   * \returns the number of (source, destination) pairs cached
+   */
+  std::size_t GetN (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel & operator = (const CachedPropagationLossModel &);
+
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               std::vector<double> &powerDbm) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
+
+  /**
+   * Returns the reception power of a pair, from the cache if possible.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param aPosition the position of the source
+   * \param b the mobility model of the destination
+   * \returns the reception power after the loss of the wrapped chain (in dBm)
+   */
+  double Lookup (double txPowerDbm, Ptr<MobilityModel> a, const Vector &aPosition,
+                 Ptr<MobilityModel> b) const;
+
+  /// A cached reception power
+  struct Entry
+  {
+    Vector aPosition;    //!< Position of the source
+    Vector bPosition;    //!< Position of the destination
+    double txPowerDbm;   //!< Transmission power
+    double rxPowerDbm;   //!< Reception power
+  };
+
+  /// A (source, destination) pair
+  typedef std::pair<const MobilityModel *, const MobilityModel *> Key;
+
+  /// Hash of a (source, destination) pair
+  struct KeyHash
+  {
+    /**
+     * \param key the pair
+     * \returns the hash of the pair
+     */
+    std::size_t operator () (const Key &key) const
+    {
+      std::hash<const MobilityModel *> hasher;
+      return hasher (key.first) * 31 + hasher (key.second);
+    }
+  };
+
+  /// Cached reception powers of the pairs
+  typedef std::unordered_map<Key, Entry, KeyHash> Cache;
+
+  Ptr<PropagationLossModel> m_model;  //!< The chain of loss models cached
+  uint32_t m_maxSize;                 //!< Number of pairs beyond which the cache is cleared
+  mutable Cache m_cache;              //!< The cached reception powers
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
@@ -0,0 +1,531 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef INTERFERENCE_HELPER_H
+#define INTERFERENCE_HELPER_H
+
+#include "ns3/nstime.h"
+#include "wifi-tx-vector.h"
+#include <vector>
+
+namespace ns3 {
+
+class WifiPpdu;
+class WifiPsdu;
+class ErrorRateModel;
+
+/**
+ * \ingroup wifi
+ * \brief handles interference calculations
+ * \brief signal event for a PPDU.
+ */
+class Event : public SimpleRefCount<Event>
+{
+public:
+  /**
+   * Create an Event with the given parameters.
+   *
+   * \param ppdu the PPDU
+   * \param txVector the TXVECTOR
+   * \param duration duration of the PPDU
+   * \param rxPower the received power (w)
+   */
+  Event (Ptr<const WifiPpdu> ppdu, WifiTxVector txVector, Time duration, double rxPower);
+  ~Event ();
+
+  /**
+   * Return the PSDU in the PPDU.
+   *
+   * \return the PSDU in the PPDU
+   */
+  Ptr<const WifiPsdu> GetPsdu (void) const;
+  /**
+   * Return the PPDU.
+   *
+   * \return the PPDU
+   */
+  Ptr<const WifiPpdu> GetPpdu (void) const;
+  /**
+   * Return the start time of the signal.
+   *
+   * \return the start time of the signal
+   */
+  Time GetStartTime (void) const;
+  /**
+   * Return the end time of the signal.
+   *
+   * \return the end time of the signal
+   */
+  Time GetEndTime (void) const;
+  /**
+   * Return the duration of the signal.
+   *
+   * \return the duration of the signal
+   */
+  Time GetDuration (void) const;
+  /**
+   * Return the received power (w).
+   *
+   * \return the received power (w)
+   */
+  double GetRxPowerW (void) const;
+  /**
+   * Return the TXVECTOR of the PPDU.
+   *
+   * \return the TXVECTOR of the PPDU
+   */
+  WifiTxVector GetTxVector (void) const;
+
+
+private:
+  Ptr<const WifiPpdu> m_ppdu; ///< PPDU
+  WifiTxVector m_txVector; ///< TXVECTOR
+  Time m_startTime; ///< start time
+  Time m_endTime; ///< end time
+  double m_rxPowerW; ///< received power in watts
+};
+
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param os the stream
+ * \param event the event
+ * \returns a reference to the stream
+ */
+std::ostream& operator<< (std::ostream& os, const Event &event);
+
+
+/**
+ * \ingroup wifi
+ * \brief handles interference calculations
+ */
+class InterferenceHelper
+{
+public:
+  /**
+   * Signal event for a PPDU.
+   */
+
+  /**
+   * A struct for both SNR and PER
+   */
+  struct SnrPer
+  {
+    double snr; ///< SNR in linear scale
+    double per; ///< PER
+  };
+
+  InterferenceHelper ();
+  ~InterferenceHelper ();
+
+  /**
+   * Set the noise figure.
+   *
+   * \param value noise figure in linear scale
+   */
+  void SetNoiseFigure (double value);
+  /**
+   * Set the error rate model for this interference helper.
+   *
+   * \param rate Error rate model
+   */
+  void SetErrorRateModel (const Ptr<ErrorRateModel> rate);
+
+  /**
+   * Return the error rate model.
+   *
+   * \return Error rate model
+   */
+  Ptr<ErrorRateModel> GetErrorRateModel (void) const;
+  /**
+   * Set the number of RX antennas in the receiver corresponding to this
+   * interference helper.
+   *
+   * \param rx the number of RX antennas
+   */
+  void SetNumberOfReceiveAntennas (uint8_t rx);
+
+  /**
+   * \param energyW the minimum energy (W) requested
+   *
+   * \returns the expected amount of time the observed
+   *          energy on the medium will be higher than
+   *          the requested threshold.
+   */
+  Time GetEnergyDuration (double energyW) const;
+
+  /**
+   * Add the PPDU-related signal to interference helper.
+   *
+   * \param ppdu the PPDU
+   * \param txVector the TXVECTOR
+   * \param rxPower received power (W)
+   *
+   * \return Event
+   */
+  Ptr<Event> Add (Ptr<const WifiPpdu> ppdu, WifiTxVector txVector, Time duration, double rxPower);
+
+  /**
+   * Add a non-Wifi signal to interference helper.
+   * \param duration the duration of the signal
+   * \param rxPower received power (W)
+   */
+  void AddForeignSignal (Time duration, double rxPower);
+  /**
+   * Set the number of 20 MHz sub-bands whose energy is tracked, in
+   * addition to the energy over the whole channel.  The sub-bands are
+   * forgotten.
+   *
+   * \param nSubBands the number of 20 MHz sub-bands (0 to disable the tracking)
+   */
+  void SetNumberOfSubBands (uint8_t nSubBands);
+  /**
+   * \return the number of 20 MHz sub-bands whose energy is tracked
+   */
+  uint8_t GetNumberOfSubBands (void) const;
+  /**
+   * Add the powers received on each 20 MHz sub-band by a signal.
+   *
+   * \param duration the duration of the signal
+   * \param rxPowersW the power (W) received on each sub-band, from the lowest frequency
+   */
+  void AddSubBandPowers (Time duration, const std::vector<double> &rxPowersW);
+  /**
+   * \param energyW the minimum energy (W) requested
+   * \param subBand the index of the 20 MHz sub-band
+   *
+   * \returns the expected amount of time the observed
+   *          energy on the sub-band will be higher than
+   *          the requested threshold.
+   */
+  Time GetEnergyDuration (double energyW, uint8_t subBand) const;
+  /**
+   * Calculate the SNIR at the start of the payload and accumulate
+   * all SNIR changes in the SNIR vector for each MPDU of an A-MPDU.
+   * This workaround is required in order to provide one PER per MPDU, for
+   * reception success/failure evaluation, while hiding aggregation details from
+   * this class.
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   * \param relativeMpduStartStop the time window (pair of start and end times) of PHY payload to focus on
+   *
+   * \return struct of SNR and PER (with PER being evaluated over the provided time window)
+   */
+  struct InterferenceHelper::SnrPer CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Time> relativeMpduStartStop) const;
+  /**
+   * Calculate the SNIR for the event (starting from now until the event end).
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   *
+   * \return the SNR for the PPDU in linear scale
+   */
+  double CalculateSnr (Ptr<Event> event) const;
+  /**
+   * Calculate the SNIR at the start of the non-HT PHY header and accumulate
+   * all SNIR changes in the SNIR vector.
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   *
+   * \return struct of SNR and PER
+   */
+  struct InterferenceHelper::SnrPer CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event) const;
+  /**
+   * Calculate the SNIR at the start of the HT PHY header and accumulate
+   * all SNIR changes in the SNIR vector.
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   *
+   * \return struct of SNR and PER
+   */
+  struct InterferenceHelper::SnrPer CalculateHtPhyHeaderSnrPer (Ptr<Event> event) const;
+  /**
+   * Calculate the PER of a part of the payload from the effective SNIR of
+   * the whole payload, instead of accumulating the success rates of the
+   * SNIR changes within that part.  The effective SNIR maps the SNIR changes
+   * over the payload with the exponential effective SNIR mapping (EESM)
+   * and is computed once per event.
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   * \param duration the duration of the part of the payload
+   *
+   * \return struct of effective SNR and PER
+   */
+  struct InterferenceHelper::SnrPer CalculateEffectivePayloadSnrPer (Ptr<Event> event, Time duration) const;
+
+  /**
+   * Notify that RX has started.
+   */
+  void NotifyRxStart ();
+  /**
+   * Notify that RX has ended.
+   */
+  void NotifyRxEnd ();
+  /**
+   * Erase all events.
+   */
+  void EraseEvents (void);
+
+
+private:
+  /**
+   * Noise and Interference (thus Ni) event.
+   */
+  class NiChange
+  {
+public:
+    /**
+     * Create a NiChange at the given time and the amount of NI change.
+     *
+     * \param power the power in watts
+     * \param event causes this NI change
+     */
+    NiChange (double power, Ptr<Event> event);
+    /**
+     * Return the power
+     *
+     * \return the power in watts
+     */
+    double GetPower (void) const;
+    /**
+     * Add a given amount of power.
+     *
+     * \param power the power to be added to the existing value in watts
+     */
+    void AddPower (double power);
+    /**
+     * Return the event causes the corresponding NI change
+     *
+     * \return the event
+     */
+    Ptr<Event> GetEvent (void) const;
+
+
+private:
+    double m_power; ///< power in watts
+    Ptr<Event> m_event; ///< event
+  };
+
+  /**
+   * typedef for a vector of NiChanges sorted by time
+   */
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
+
+  /**
+   * The NiChanges of a band, sorted by time in a vector, which is appended
+   * to most of the time since the changes are added at or after the
+   * current time.  The first change is always a zero power change at time
+   * 0; the changes erased after it are only skipped, and are removed from
+   * the vector once they make up half of it.
+   */
+  class NiChangeList
+  {
+public:
+    NiChangeList ();
+    /**
+     * \return an iterator to the first change
+     */
+    NiChanges::iterator Begin (void);
+    /**
+     * \return an iterator to the first change
+     */
+    NiChanges::const_iterator Begin (void) const;
+    /**
+     * \return an iterator past the last change
+     */
+    NiChanges::iterator End (void);
+    /**
+     * \return an iterator past the last change
+     */
+    NiChanges::const_iterator End (void) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the first change not before moment
+     */
+    NiChanges::const_iterator LowerBound (Time moment) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the first change after moment
+     */
+    NiChanges::const_iterator UpperBound (Time moment) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the last change not after moment
+     */
+    NiChanges::const_iterator GetPrevious (Time moment) const;
+    /**
+     * Add a change after the changes at the same time.
+     *
+     * \param moment the time of the change
+     * \param change the change
+     * \return the iterator of the new change
+     */
+    NiChanges::iterator Insert (Time moment, NiChange change);
+    /**
+     * Erase the changes until moment, but the first zero power change.
+     *
+     * \param moment the time of the last change to erase
+     */
+    void EraseUntil (Time moment);
+    /**
+     * Erase all the changes, but the first zero power change.
+     */
+    void Clear (void);
+
+private:
+    NiChanges m_changes; //!< the changes, the skipped ones included
+    std::size_t m_first; //!< index of the zero power change
+  };
+  /**
+   * Append the given Event.
+   *
+   * \param event
+   */
+  void AppendEvent (Ptr<Event> event);
+  /**
+   * Calculate noise and interference power in W.
+   *
+   * \param event the event
+   *
+   * \return noise and interference power
+   */
+  double CalculateNoiseInterferenceW (Ptr<Event> event) const;
+  /**
+   * Return the NiChanges over the duration of an event, from its start to
+   * its end.  They are kept until the NiChanges are modified, for the
+   * next MPDUs of an A-MPDU.
+   *
+   * \param event the event
+   *
+   * \return the NiChanges of the event
+   */
+  const NiChanges & GetEventNiChanges (Ptr<Event> event) const;
+  /**
+   * \param niChanges the NiChanges of a band
+   * \param energyW the minimum energy (W) requested
+   *
+   * \returns the expected amount of time the energy of the band will be
+   *          higher than the requested threshold.
+   */
+  static Time GetEnergyDuration (const NiChangeList &niChanges, double energyW);
+  /**
+   * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
+   *
+   * \param signal signal power, W
+   * \param noiseInterference noise and interference power, W
+   * \param channelWidth signal width in MHz
+   *
+   * \return SNR in linear scale
+   */
+  double CalculateSnr (double signal, double noiseInterference, uint16_t channelWidth) const;
+  /**
+   * Calculate the success rate of the chunk given the SINR, duration, and Wi-Fi mode.
+   * The duration and mode are used to calculate how many bits are present in the chunk.
+   *
+   * \param snir the SINR
+   * \param duration the duration of the chunk
+   * \param mode the WifiMode
+   * \param txVector the TXVECTOR
+   *
+   * \return the success rate
+   */
+  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const;
+  /**
+   * Calculate the success rate of the payload chunk given the SINR, duration, and Wi-Fi mode.
+   * The duration and mode are used to calculate how many bits are present in the chunk.
+   *
+   * \param snir the SINR
+   * \param duration the duration of the chunk
+   * \param txVector the TXVECTOR
+   *
+   * \return the success rate
+   */
+  double CalculatePayloadChunkSuccessRate (double snir, Time duration, WifiTxVector txVector) const;
+  /**
+   * Map the SNIR changes over the payload of the event to a single SNIR,
+   * with the exponential effective SNIR mapping (EESM):
+   * -beta ln (sum_i d_i / D exp (-snir_i / beta)).
+   *
+   * \param event the event
+   * \param ni the NiChanges of the event
+   *
+   * \return the effective SNIR of the payload in linear scale
+   */
+  double CalculateEffectiveSnr (Ptr<const Event> event, const NiChanges *ni) const;
+  /**
+   * Return the EESM parameter of a mode, from the Chernoff bound of the
+   * symbol error rate of its constellation: 1 for BPSK, 2 (M - 1) / 3 for
+   * a square M-QAM.
+   *
+   * \param mode the Wi-Fi mode
+   *
+   * \return the EESM parameter
+   */
+  static double GetEesmBeta (WifiMode mode);
+  /**
+   * Calculate the error rate of the given PHY payload only in the provided time
+   * window (thus enabling per MPDU PER information). The PHY payload can be divided into
+   * multiple chunks (e.g. due to interference from other transmissions).
+   *
+   * \param event the event
+   * \param ni the NiChanges
+   * \param window time window (pair of start and end times) of PHY payload to focus on
+   *
+   * \return the error rate of the payload
+   */
+  double CalculatePayloadPer (Ptr<const Event> event, const NiChanges *ni, std::pair<Time, Time> window) const;
+  /**
+   * Calculate the error rate of the non-HT PHY header. The non-HT PHY header
+   * can be divided into multiple chunks (e.g. due to interference from other transmissions).
+   *
+   * \param event the event
+   * \param ni the NiChanges
+   *
+   * \return the error rate of the non-HT PHY header
+   */
+  double CalculateNonHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const;
+  /**
+   * Calculate the error rate of the HT PHY header. TheHT PHY header
+   * can be divided into multiple chunks (e.g. due to interference from other transmissions).
+   *
+   * \param event the event
+   * \param ni the NiChanges
+   *
+   * \return the error rate of the HT PHY header
+   */
+  double CalculateHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const;
+
+  double m_noiseFigure; /**< noise figure (linear) */
+  Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
+  uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
+  /// Experimental: needed for energy duration calculation
+  NiChangeList m_niChanges;
+  std::vector<NiChangeList> m_subBandNiChanges; ///< NiChanges of the 20 MHz sub-bands
+  double m_firstPower; ///< first power in watts
+  bool m_rxing; ///< flag whether it is in receiving state
+  uint64_t m_niChangesVersion; ///< incremented when the NiChanges are modified
+  mutable Ptr<Event> m_cachedEvent; ///< event whose NiChanges are cached
+  mutable uint64_t m_cachedVersion; ///< version of the NiChanges cached
+  mutable NiChanges m_cachedNiChanges; ///< NiChanges of the cached event
+  mutable double m_cachedEffectiveSnr; ///< effective SNIR of the cached event payload, negative if not computed
+};
+
+} //namespace ns3
+
+#endif /* INTERFERENCE_HELPER_H */
@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef IPV4_END_POINT_DEMUX_H
+#define IPV4_END_POINT_DEMUX_H
+
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include "ns3/ipv4-address.h"
+#include "ipv4-interface.h"
+
+namespace ns3 {
+
+class Ipv4EndPoint;
+
+/**
+ * \ingroup ipv4
+ *
+ * \brief Demultiplexes packets to various transport layer endpoints
+ *
+ * This class serves as a lookup table to match partial or full information
+ * about a four-tuple to an ns3::Ipv4EndPoint.  It internally contains a list
+ * of endpoints, and has APIs to add and find endpoints in this demux.  This
+ * code is shared in common to TCP and UDP protocols in ns3.  This demux
+ * sits between ns3's layer four and the socket layer
+ *
+ * Besides the list, the endpoints are indexed in a hash table keyed by
+ * local port, peer address and peer port. Connected endpoints sit in the
+ * bucket of their four-tuple, and the endpoints with a wildcard peer
+ * (e.g., listening sockets) in the bucket of their local port with the
+ * peer set to (any, 0). A lookup then only inspects two buckets, so the
+ * cost does not depend on the number of connections of the node. The
+ * endpoints notify the demux when their peer changes.
+ */
+
+class Ipv4EndPointDemux {
+public:
+  /**
+   * \brief Container of the IPv4 endpoints.
+   */
+  typedef std::list<Ipv4EndPoint *> EndPoints;
+
+  /**
+   * \brief Iterator to the container of the IPv4 endpoints.
+   */
+  typedef std::list<Ipv4EndPoint *>::iterator EndPointsI;
+
+  Ipv4EndPointDemux ();
+  ~Ipv4EndPointDemux ();
+
+  /**
+   * \brief Get the entire list of end points registered.
+   * \return list of Ipv4EndPoint
+   */
+  EndPoints GetAllEndPoints (void);
+
+  /**
+   * \brief Lookup for port local.
+   * \param port port to test
+   * \return true if a port local is in EndPoints, false otherwise
+   */
+  bool LookupPortLocal (uint16_t port);
+
+  /**
+   * \brief Lookup for address and port.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param addr address to test
+   * \param port port to test
+   * \return true if there is a match in EndPoints, false otherwise
+   */
+  bool LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port);
+
+  /**
+   * \brief lookup for a match with all the parameters.
+   *
+   * The function will return a list of most-matching EndPoints, in this order:
+   *   -# Full match
+   *   -# All but local address
+   *   -# Only local port and local address match
+   *   -# Only local port match
+   *
+   * EndPoint with disabled Rx are skipped.
+   *
+   * \param daddr destination address to test
+   * \param dport destination port to test
+   * \param saddr source address to test
+   * \param sport source port to test
+   * \param incomingInterface the incoming interface
+   * \return list of IPv4EndPoints (could be 0 element)
+   */
+  EndPoints Lookup (Ipv4Address daddr, 
+                    uint16_t dport, 
+                    Ipv4Address saddr, 
+                    uint16_t sport,
+                    Ptr<Ipv4Interface> incomingInterface);
+
+  /**
+   * \brief simple lookup for a match with all the parameters.
+   * \param daddr destination address to test
+   * \param dport destination port to test
+   * \param saddr source address to test
+   * \param sport source port to test
+   * \return IPv4EndPoint (0 if not found)
+   */
+  Ipv4EndPoint *SimpleLookup (Ipv4Address daddr, 
+                              uint16_t dport, 
+                              Ipv4Address saddr, 
+                              uint16_t sport);
+
+  /**
+   * \brief Allocate a Ipv4EndPoint.
+   * \return an empty Ipv4EndPoint instance
+   */
+  Ipv4EndPoint *Allocate (void);
+
+  /**
+   * \brief Allocate a Ipv4EndPoint.
+   * \param address IPv4 address
+   * \return an Ipv4EndPoint instance
+   */
+  Ipv4EndPoint *Allocate (Ipv4Address address);
+
+  /**
+   * \brief Allocate a Ipv4EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param port local port
+   * \return an Ipv4EndPoint instance
+   */
+  Ipv4EndPoint *Allocate (Ptr<NetDevice> boundNetDevice, uint16_t port);
+
+  /**
+   * \brief Allocate a Ipv4EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param address local address
+   * \param port local port
+   * \return an Ipv4EndPoint instance
+   */
+  Ipv4EndPoint *Allocate (Ptr<NetDevice> boundNetDevice, Ipv4Address address, uint16_t port);
+
+  /**
+   * \brief Allocate a Ipv4EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param localAddress local address
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return an Ipv4EndPoint instance
+   */
+  Ipv4EndPoint *Allocate (Ptr<NetDevice> boundNetDevice,
+                          Ipv4Address localAddress, uint16_t localPort,
+                          Ipv4Address peerAddress, uint16_t peerPort);
+
+  /**
+   * \brief Remove a end point.
+   * \param endPoint the end point to remove
+   */
+  void DeAllocate (Ipv4EndPoint *endPoint);
+
+private:
+  friend class Ipv4EndPoint;
+
+  /**
+   * \brief Key of the endpoint index.
+   */
+  struct EndPointKey
+  {
+    uint16_t m_localPort;      //!< Local port
+    Ipv4Address m_peerAddress; //!< Peer address, any for a wildcard peer
+    uint16_t m_peerPort;       //!< Peer port, 0 for a wildcard peer
+
+    /**
+     * \brief Comparison operator
+     * \param other key to compare
+     * \return true if the keys are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the endpoint index keys.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Hash a key
+     * \param key the key
+     * \return the hash of the key
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the containers of the demux.
+   */
+  struct EndPointEntry
+  {
+    EndPointsI m_list;         //!< Position in m_endPoints
+    EndPointKey m_key;         //!< Bucket of the index holding the endpoint
+    EndPointsI m_bucket;       //!< Position in the bucket
+  };
+
+  /**
+   * \brief Add a newly allocated endpoint to the list and to the index.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Add an endpoint to the bucket matching its current four-tuple.
+   * \param entry the entry of the endpoint
+   * \param endPoint the end point
+   */
+  void Index (EndPointEntry &entry, Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from its bucket.
+   * \param entry the entry of the endpoint
+   */
+  void Unindex (const EndPointEntry &entry);
+
+  /**
+   * \brief Move an endpoint to the bucket of its new four-tuple.
+   *
+   * Called by the endpoint when its peer changes.
+   *
+   * \param endPoint the end point
+   */
+  void Rehash (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Get the bucket of the index for a key.
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket, 0 if empty
+   */
+  const EndPoints *GetBucket (uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const;
+
+  /**
+   * \brief Allocate an ephemeral port.
+   * \returns the ephemeral port
+   */
+  uint16_t AllocateEphemeralPort (void);
+
+  /**
+   * \brief The ephemeral port.
+   */
+  uint16_t m_ephemeral;
+
+  /**
+   * \brief The last ephemeral port.
+   */
+  uint16_t m_portLast;
+
+  /**
+   * \brief The first ephemeral port.
+   */
+  uint16_t m_portFirst;
+
+  /**
+   * \brief A list of IPv4 end points.
+   */
+  EndPoints m_endPoints;
+
+  /**
+   * \brief Index of the end points by local port and peer.
+   */
+  std::unordered_map<EndPointKey, EndPoints, EndPointKeyHash> m_index;
+
+  /**
+   * \brief Position of each end point in the list and in the index.
+   */
+  std::unordered_map<Ipv4EndPoint *, EndPointEntry> m_entries;
+
+  /**
+   * \brief Number of end points using each local port.
+   */
+  std::unordered_map<uint16_t, uint32_t> m_localPorts;
+};
+
+} // namespace ns3
+
+#endif /* IPV4_END_POINTS_H */
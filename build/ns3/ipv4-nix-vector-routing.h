@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 The Georgia Institute of Technology 
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Josh Pelkey <jpelkey@gatech.edu>
+ */
+
+#ifndef IPV4_NIX_VECTOR_ROUTING_H
+#define IPV4_NIX_VECTOR_ROUTING_H
+
+#include <map>
+#include <unordered_map>
+
+#include "ns3/channel.h"
+#include "ns3/node-container.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device-container.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/nix-vector.h"
+#include "ns3/bridge-net-device.h"
+#include "ns3/nstime.h"
+#include "ns3/nix-vector-topology.h"
+
+namespace ns3 {
+
+/**
+ * \defgroup nix-vector-routing Nix-Vector Routing
+ *
+ * Nix-vector routing is a simulation specific routing protocol and is
+ * intended for large network topologies.
+ */
+
+/**
+ * \ingroup nix-vector-routing
+ * Nix-vector routing protocol
+ */
+class Ipv4NixVectorRouting : public Ipv4RoutingProtocol
+{
+public:
+  Ipv4NixVectorRouting ();
+  ~Ipv4NixVectorRouting ();
+  /**
+   * @brief The Interface ID of the Global Router interface.
+   * @return The Interface ID
+   * @see Object::GetObject ()
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * @brief Set the Node pointer of the node for which this
+   * routing protocol is to be placed
+   *
+   * @param node Node pointer
+   */
+  void SetNode (Ptr<Node> node);
+
+  /**
+   * @brief Called when run-time address changes occur
+   * which iterates through the node list and flushes any
+   * nix vector caches
+   *
+   * \internal
+   * \c const is used here due to need to potentially flush the cache
+   * in const methods such as PrintRoutingTable.  Caches are stored in
+   * mutable variables and flushed in const methods.
+   */
+  void FlushGlobalNixRoutingCache (void) const;
+
+private:
+  /// Nix-vector cached for a destination
+  struct NixCacheEntry
+  {
+    Ptr<NixVector> nixVector; //!< Nix-vector to the destination, null if there is no path
+    uint32_t version;         //!< Version of the topology the nix-vector was built with
+  };
+
+  /// Ipv4Route cached for a destination
+  struct RouteCacheEntry
+  {
+    Ptr<Ipv4Route> route;     //!< Route to the destination
+    uint32_t nixIndex;        //!< Neighbor index the route was built for
+  };
+
+  /// Map of Ipv4Address to cached NixVector
+  typedef std::map<Ipv4Address, NixCacheEntry> NixMap_t;
+  /// Map of Ipv4Address to cached Ipv4Route
+  typedef std::map<Ipv4Address, RouteCacheEntry> Ipv4RouteMap_t;
+
+  /**
+   * Flushes the cache which stores nix-vector based on
+   * destination IP
+   */
+  void FlushNixCache (void) const;
+
+  /**
+   * Flushes the cache which stores the Ipv4 route
+   * based on the destination IP
+   */
+  void FlushIpv4RouteCache (void) const;
+
+  /**
+   * Upon a run-time topology change caches are
+   * flushed and the total number of neighbors is
+   * reset to zero
+   */
+  void ResetTotalNeighbors (void);
+
+  /**
+   * Takes in the source node and dest IP and calls GetNodeByIp,
+   * and builds the nix-vector from the shortest path tree of the
+   * source, accounting for any output interface specified
+   *
+   * \param source Source node
+   * \param dest Destination node address
+   * \param oif Preferred output interface
+   * \returns The NixVector to be used in routing.
+   */
+  Ptr<NixVector> GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif);
+
+  /**
+   * Checks the cache based on dest IP for the nix-vector.  A nix-vector
+   * built before a topology change is not returned, so that it is rebuilt.
+   * \param address Address to check
+   * \returns The NixVector to be used in routing.
+   */
+  Ptr<NixVector> GetNixVectorInCache (Ipv4Address address);
+
+  /**
+   * Checks the cache based on dest IP for the Ipv4Route
+   * \param address Address to check
+   * \param nixIndex Neighbor index extracted from the nix-vector
+   * \returns The cached route, or null if it was built for another neighbor.
+   */
+  Ptr<Ipv4Route> GetIpv4RouteInCache (Ipv4Address address, uint32_t nixIndex);
+
+  /**
+   * Finds the node corresponding to the given Ipv4Address,
+   * with the index of the addresses of all the nodes
+   * \param dest destination node IP
+   * \return The node with the specified IP.
+   */
+  Ptr<Node> GetNodeByIp (Ipv4Address dest);
+
+  /**
+   * Special variation of BuildNixVector for when a node is sending to itself
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns true on success, false otherwise.
+   */
+  bool BuildNixVectorLocal (Ptr<NixVector> nixVector);
+
+  /**
+   * Simple iterates through the nodes net-devices and determines
+   * how many neighbors it has
+   * \returns the number of neighbors.
+   */
+  uint32_t FindTotalNeighbors (void);
+
+  /**
+   * Nix index is with respect to the neighbors.  The net-device index must be
+   * derived from this
+   * \param [in] nodeIndex Nix Node index
+   * \param [out] gatewayIp IP address of the gateway
+   * \returns the index of the NetDevice in the node.
+   */
+  uint32_t FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address & gatewayIp);
+
+  void DoDispose (void);
+
+  /* From Ipv4RoutingProtocol */
+  virtual Ptr<Ipv4Route> RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr);
+  virtual bool RouteInput (Ptr<const Packet> p, const Ipv4Header &header, Ptr<const NetDevice> idev,
+                           UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                           LocalDeliverCallback lcb, ErrorCallback ecb);
+  virtual void NotifyInterfaceUp (uint32_t interface);
+  virtual void NotifyInterfaceDown (uint32_t interface);
+  virtual void NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address);
+  virtual void SetIpv4 (Ptr<Ipv4> ipv4);
+  virtual void PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
+ 
+  /**
+   * Flushes routing caches if required.
+   */
+  void CheckCacheStateAndFlush (void) const;
+
+  /**
+   * Flag to mark when caches are dirty and need to be flushed.  
+   * Used for lazy cleanup of caches when there are many address changes.
+   */
+  static bool g_isCacheDirty;
+
+  /**
+   * Graph and shortest path trees of the IPv4 topology, shared by
+   * all the nodes.
+   */
+  static NixVectorTopology g_topology;
+
+  /** Index of the node of each address, rebuilt after address changes */
+  static std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> g_addressIndex;
+
+  /** Cache stores nix-vectors based on destination ip */
+  mutable NixMap_t m_nixCache;
+
+  /** Cache stores Ipv4Routes based on destination ip */
+  mutable Ipv4RouteMap_t m_ipv4RouteCache;
+
+  Ptr<Ipv4> m_ipv4; //!< IPv4 object
+  Ptr<Node> m_node; //!< Node object
+
+  /** Total neighbors used for nix-vector to determine number of bits */
+  uint32_t m_totalNeighbors;
+};
+} // namespace ns3
+
+#endif /* IPV4_NIX_VECTOR_ROUTING_H */
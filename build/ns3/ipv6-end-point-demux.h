@@ -0,0 +1,287 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007-2009 Strasbourg University
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Sebastien Vincent <vincent@clarinet.u-strasbg.fr>
+ */
+
+#ifndef IPV6_END_POINT_DEMUX_H
+#define IPV6_END_POINT_DEMUX_H
+
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include "ns3/ipv6-address.h"
+#include "ipv6-interface.h"
+
+namespace ns3 {
+
+class Ipv6EndPoint;
+
+/**
+ * \ingroup ipv6
+ *
+ * \brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, the endpoints are indexed in a hash table keyed
+ * by local port, peer address and peer port, the endpoints with a wildcard
+ * peer being in the bucket of their local port with the peer set to
+ * (any, 0). A lookup only inspects the bucket of the four-tuple and the
+ * wildcard one.
+ */
+class Ipv6EndPointDemux
+{
+public:
+  /**
+   * \brief Container of the IPv6 endpoints.
+   */
+  typedef std::list<Ipv6EndPoint *>EndPoints;
+
+  /**
+   * \brief Iterator to the container of the IPv6 endpoints.
+   */
+  typedef std::list<Ipv6EndPoint *>::iterator EndPointsI;
+
+  Ipv6EndPointDemux ();
+  ~Ipv6EndPointDemux ();
+
+  /**
+   * \brief Lookup for port local.
+   * \param port port to test
+   * \return true if a port local is in EndPoints, false otherwise
+   */
+  bool LookupPortLocal (uint16_t port);
+
+  /**
+   * \brief Lookup for address and port.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param addr address to test
+   * \param port port to test
+   * \return true if there is a match in EndPoints, false otherwise
+   */
+  bool LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port);
+
+  /**
+   * \brief lookup for a match with all the parameters.
+   *
+   * The function will return a list of most-matching EndPoints, in this order:
+   *   -# Full match
+   *   -# All but local address
+   *   -# Only local port and local address match
+   *   -# Only local port match
+   *
+   * EndPoint with disabled Rx are skipped.
+   *
+   * \param dst destination address to test
+   * \param dport destination port to test
+   * \param src source address to test
+   * \param sport source port to test
+   * \param incomingInterface the incoming interface
+   * \return list of IPv6EndPoints (could be 0 element)
+   */
+  EndPoints Lookup (Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport, Ptr<Ipv6Interface> incomingInterface);
+
+  /**
+   * \brief Simple lookup for a four-tuple match.
+   * \param dst destination address to test
+   * \param dport destination port to test
+   * \param src source address to test
+   * \param sport source port to test
+   * \return match or 0 if not found
+   */
+  Ipv6EndPoint* SimpleLookup (Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport);
+
+  /**
+   * \brief Allocate a Ipv6EndPoint.
+   * \return an empty Ipv6EndPoint instance
+   */
+  Ipv6EndPoint * Allocate (void);
+
+  /**
+   * \brief Allocate a Ipv6EndPoint.
+   * \param address IPv6 address
+   * \return an Ipv6EndPoint instance
+   */
+  Ipv6EndPoint * Allocate (Ipv6Address address);
+
+  /**
+   * \brief Allocate a Ipv6EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param port local port
+   * \return an Ipv6EndPoint instance
+   */
+  Ipv6EndPoint * Allocate (Ptr<NetDevice> boundNetDevice, uint16_t port);
+
+  /**
+   * \brief Allocate a Ipv6EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param address local address
+   * \param port local port
+   * \return an Ipv6EndPoint instance
+   */
+  Ipv6EndPoint * Allocate (Ptr<NetDevice> boundNetDevice, Ipv6Address address, uint16_t port);
+
+  /**
+   * \brief Allocate a Ipv6EndPoint.
+   * \param boundNetDevice Bound NetDevice (if any)
+   * \param localAddress local address
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return an Ipv6EndPoint instance
+   */
+  Ipv6EndPoint * Allocate (Ptr<NetDevice> boundNetDevice,
+                           Ipv6Address localAddress, uint16_t localPort,
+                           Ipv6Address peerAddress, uint16_t peerPort);
+
+  /**
+   * \brief Remove a end point.
+   * \param endPoint the end point to remove
+   */
+  void DeAllocate (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Get the entire list of end points registered.
+   * \return list of Ipv6EndPoint
+   */
+  EndPoints GetEndPoints () const;
+
+private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief Key of the endpoint index.
+   */
+  struct EndPointKey
+  {
+    uint16_t m_localPort;      //!< Local port
+    Ipv6Address m_peerAddress; //!< Peer address, any for a wildcard peer
+    uint16_t m_peerPort;       //!< Peer port, 0 for a wildcard peer
+
+    /**
+     * \brief Comparison operator
+     * \param other key to compare
+     * \return true if the keys are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the endpoint index keys.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Hash a key
+     * \param key the key
+     * \return the hash of the key
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the containers of the demux.
+   */
+  struct EndPointEntry
+  {
+    EndPointsI m_list;         //!< Position in m_endPoints
+    EndPointKey m_key;         //!< Bucket of the index holding the endpoint
+    EndPointsI m_bucket;       //!< Position in the bucket
+  };
+
+  /**
+   * \brief Add a newly allocated endpoint to the list and to the index.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Add an endpoint to the bucket matching its current four-tuple.
+   * \param entry the entry of the endpoint
+   * \param endPoint the end point
+   */
+  void Index (EndPointEntry &entry, Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from its bucket.
+   * \param entry the entry of the endpoint
+   */
+  void Unindex (const EndPointEntry &entry);
+
+  /**
+   * \brief Move an endpoint to the bucket of its new four-tuple.
+   *
+   * Called by the endpoint when its local port or its peer changes.
+   *
+   * \param endPoint the end point
+   */
+  void Rehash (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Get the bucket of the index for a key.
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket, 0 if empty
+   */
+  const EndPoints *GetBucket (uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const;
+
+  /**
+   * \brief Allocate a ephemeral port.
+   * \return a port
+   */
+  uint16_t AllocateEphemeralPort ();
+
+  /**
+   * \brief The ephemeral port.
+   */
+  uint16_t m_ephemeral;
+
+  /**
+   * \brief The first ephemeral port.
+   */
+  uint16_t m_portFirst;
+
+  /**
+   * \brief The last ephemeral port.
+   */
+  uint16_t m_portLast;
+
+  /**
+   * \brief A list of IPv6 end points.
+   */
+  EndPoints m_endPoints;
+
+  /**
+   * \brief Index of the end points by local port and peer.
+   */
+  std::unordered_map<EndPointKey, EndPoints, EndPointKeyHash> m_index;
+
+  /**
+   * \brief Position of each end point in the list and in the index.
+   */
+  std::unordered_map<Ipv6EndPoint *, EndPointEntry> m_entries;
+
+  /**
+   * \brief Number of end points using each local port.
+   */
+  std::unordered_map<uint16_t, uint32_t> m_localPorts;
+};
+
+} /* namespace ns3 */
+
+#endif /* IPV6_END_POINT_DEMUX_H */
+
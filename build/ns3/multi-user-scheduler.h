@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTI_USER_SCHEDULER_H
+#define MULTI_USER_SCHEDULER_H
+
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/traced-callback.h"
+#include "he-ru.h"
+#include "wifi-tx-vector.h"
+
+namespace ns3 {
+
+class ApWifiMac;
+class QosTxop;
+class WifiNetDevice;
+
+/**
+ * \ingroup wifi
+ *
+ * MultiUserScheduler is an abstract base class defining the API that HE
+ * APs can use to determine the format of their next transmission: a
+ * single-user PPDU, a DL MU PPDU carrying a PSDU to each of a set of
+ * stations, or a Trigger frame soliciting HE TB PPDUs from a set of
+ * stations.  The scheduler is notified every time an EDCA function of the
+ * AP gains channel access and decides, through SelectTxFormat (), which
+ * stations are served and, through ComputeDlMuInfo () and ComputeUlMuInfo (),
+ * the RU, the TXVECTOR and the amount of data of each of them.
+ *
+ * A scheduler is expected to visit each associated station at most once per
+ * TXOP; the per-station queue inspection relies on the per-receiver lookups
+ * of the WifiMacQueue.
+ */
+class MultiUserScheduler : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  MultiUserScheduler ();
+  virtual ~MultiUserScheduler ();
+
+  /// Enumeration of the possible transmission formats
+  enum TxFormat
+  {
+    NO_TX = 0,
+    SU_TX,
+    DL_MU_TX,
+    UL_MU_TX
+  };
+
+  /// Information about a station served by a multi-user PPDU
+  struct UserInfo
+  {
+    uint16_t aid;           //!< association ID of the station
+    Mac48Address address;   //!< MAC address of the station
+    HeRu::RuSpec ru;        //!< RU assigned to the station
+    WifiTxVector txVector;  //!< TXVECTOR (mode, NSS, guard interval) used in the RU
+    uint8_t tid;            //!< TID of the data sent to the station (DL only)
+    uint32_t nMpdus;        //!< number of MPDUs sent to the station (DL only)
+    uint32_t psduSize;      //!< size in bytes of the PSDU sent to or solicited from the station
+  };
+
+  /// The stations served by a DL MU PPDU or solicited by a Trigger frame
+  struct MuInfo
+  {
+    uint16_t channelWidth;        //!< bandwidth (MHz) of the PPDU(s)
+    Time ppduDuration;            //!< duration of the DL MU PPDU or of the HE TB PPDUs
+    std::vector<UserInfo> users;  //!< the stations and their RU
+  };
+
+  /**
+   * Connect the scheduler to the given device, which must hold an AP, and
+   * register it to the EDCA functions of the AP.
+   *
+   * \param device the WifiNetDevice of the AP
+   */
+  void ConnectWifiNetDevice (const Ptr<WifiNetDevice> device);
+
+  /**
+   * Notify the scheduler that the given EDCA function of the AP gained
+   * channel access.  The scheduler determines the format of the next
+   * transmission and, for a multi-user transmission, the stations served.
+   *
+   * \param edca the EDCA function that gained channel access
+   * \return the format of the next transmission
+   */
+  TxFormat NotifyAccessGranted (Ptr<QosTxop> edca);
+
+  /**
+   * \return the information about the last DL MU PPDU scheduled
+   */
+  const MuInfo & GetDlMuInfo (void) const;
+  /**
+   * \return the information about the last HE TB PPDUs solicited
+   */
+  const MuInfo & GetUlMuInfo (void) const;
+
+  /**
+   * TracedCallback signature for the scheduling of multi-user transmissions.
+   *
+   * \param [in] info the stations served and their RU
+   */
+  typedef void (* MuInfoTracedCallback)(const MuInfo &info);
+
+
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Compute the payload duration of a PSDU sent in the given RU.  The data
+   * rate in the RU is the data rate of the mode in 20 MHz scaled by the
+   * number of data subcarriers of the RU.
+   *
+   * \param psduSize the size of the PSDU in bytes
+   * \param txVector the TXVECTOR used in the RU
+   * \param ruType the type of the RU
+   * \return the duration of the data symbols
+   */
+  static Time GetPayloadDuration (uint32_t psduSize, const WifiTxVector &txVector, HeRu::RuType ruType);
+  /**
+   * Compute the largest PSDU that can be sent in the given RU within the
+   * given payload duration.
+   *
+   * \param duration the duration of the data symbols
+   * \param txVector the TXVECTOR used in the RU
+   * \param ruType the type of the RU
+   * \return the size of the PSDU in bytes
+   */
+  static uint32_t GetMaxPsduSize (Time duration, const WifiTxVector &txVector, HeRu::RuType ruType);
+
+  Ptr<ApWifiMac> m_apMac;   //!< the AP wifi MAC
+  Ptr<QosTxop> m_edca;      //!< the EDCA function that gained channel access
+  Time m_availableTime;     //!< the time available for the frame exchange
+
+
+private:
+  /**
+   * Select the format of the next transmission.
+   *
+   * \return the format of the next transmission
+   */
+  virtual TxFormat SelectTxFormat (void) = 0;
+  /**
+   * Compute the stations served by the next DL MU PPDU, along with their
+   * RU and data.  Called when SelectTxFormat () returns DL_MU_TX.
+   *
+   * \return the information about the DL MU PPDU
+   */
+  virtual MuInfo ComputeDlMuInfo (void) = 0;
+  /**
+   * Compute the stations solicited by the next Trigger frame, along with
+   * their RU.  Called when SelectTxFormat () returns UL_MU_TX.
+   *
+   * \return the information about the HE TB PPDUs
+   */
+  virtual MuInfo ComputeUlMuInfo (void) = 0;
+
+  Time m_maxPpduDuration;                 //!< maximum duration of a PPDU when the TXOP limit is null
+  MuInfo m_dlInfo;                        //!< information about the last DL MU PPDU
+  MuInfo m_ulInfo;                        //!< information about the last HE TB PPDUs
+  TracedCallback<const MuInfo &> m_dlMuTrace; //!< trace of the DL MU PPDUs scheduled
+  TracedCallback<const MuInfo &> m_ulMuTrace; //!< trace of the HE TB PPDUs solicited
+};
+
+} //namespace ns3
+
+#endif /* MULTI_USER_SCHEDULER_H */
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NIX_VECTOR_TOPOLOGY_H
+#define NIX_VECTOR_TOPOLOGY_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/net-device-container.h"
+#include "ns3/nix-vector.h"
+#include "ns3/bridge-net-device.h"
+
+namespace ns3 {
+
+class SystemMutex;
+
+/**
+ * \ingroup nix-vector-routing
+ *
+ * \brief Graph of the nodes, and shortest path trees, shared by the
+ * nix-vector routing protocols of all the nodes.
+ *
+ * The graph is built from the NodeList into compact adjacency arrays of
+ * node indices, and each source node has a breadth first search tree,
+ * stored as the parent index of every node.  The tree of a source is
+ * computed once and serves all its destinations, instead of one search per
+ * destination.  The trees are either computed when a node first needs
+ * one, or all at once, on several threads, when the "NixVectorPrecompute"
+ * global value is true.  The trees take 4 bytes per node per source.
+ *
+ * When an interface goes down, only the trees using the links of the
+ * interface are dropped: the searches of the other trees did not use these
+ * links, so they would give the same trees.  Any other change drops all
+ * the trees.  The version of the topology is incremented on each change,
+ * so the routing protocols can revalidate the nix-vectors they cached.
+ *
+ * There is one instance for IPv4 and one for IPv6, which differ by the
+ * interfaces considered up.
+ */
+class NixVectorTopology
+{
+public:
+  /**
+   * \param ipv6 true to follow the state of the IPv6 interfaces,
+   * false for IPv4
+   */
+  NixVectorTopology (bool ipv6);
+  ~NixVectorTopology ();
+
+  /**
+   * \returns the version of the topology, incremented on each change
+   */
+  uint32_t GetVersion (void) const;
+
+  /**
+   * \brief Record that an interface went up.
+   *
+   * New shorter paths may exist anywhere, so all the trees are dropped.
+   */
+  void NotifyInterfaceUp (void);
+
+  /**
+   * \brief Record that an interface went down.
+   * \param device the device of the interface
+   */
+  void NotifyInterfaceDown (Ptr<NetDevice> device);
+
+  /**
+   * \brief Drop the graph and all the trees.
+   */
+  void Clear (void);
+
+  /**
+   * \brief Build the nix-vector from a node to another.
+   * \param [in] source Source node
+   * \param [in] dest Destination node
+   * \param [in] oif specific output interface to use from source node, if not null
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns false if there is no path, true o.w.
+   */
+  bool BuildNixVector (Ptr<Node> source, Ptr<Node> dest, Ptr<NetDevice> oif, Ptr<NixVector> nixVector);
+
+  /**
+   * Given a net-device returns all the adjacent net-devices,
+   * essentially getting the neighbors on that channel
+   * \param [in] netDevice the NetDevice attached to the channel.
+   * \param [in] channel the channel to check
+   * \param [out] netDeviceContainer the NetDeviceContainer of the NetDevices in the channel.
+   */
+  static void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
+
+  /**
+   * Determine if the NetDevice is bridged
+   * \param nd the NetDevice to check
+   * \returns the bridging NetDevice (or null if the NetDevice is not bridged)
+   */
+  static Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd);
+
+private:
+  /**
+   * \brief Check if the searches can go through a device.
+   * \param node the node of the device
+   * \param device the device
+   * \returns true if the IP interface of the device and its link are up
+   */
+  bool IsUp (Ptr<Node> node, Ptr<NetDevice> device) const;
+
+  /**
+   * \brief Rebuild the graph if needed, and compute all the trees if
+   * they are precomputed.
+   */
+  void Update (void);
+
+  /**
+   * \brief Build the adjacency arrays from the NodeList.
+   */
+  void BuildGraph (void);
+
+  /**
+   * \brief Breadth first search from a node.
+   *
+   * Only reads the adjacency arrays, so several threads can run it.
+   *
+   * \param [in] source Source node index
+   * \param [in] first first neighbor of the source
+   * \param [in] last past the last neighbor of the source
+   * \param [out] tree the parent index of each node
+   */
+  void ComputeTree (uint32_t source, const uint32_t *first, const uint32_t *last,
+                    std::vector<uint32_t> &tree) const;
+
+  /**
+   * \brief Compute the trees of some sources.
+   * \param sources the source node indices
+   */
+  void ComputeTrees (const std::vector<uint32_t> &sources);
+
+  /**
+   * \brief Compute trees of the queue until it is empty.
+   */
+  void TreeWorker (void);
+
+  /**
+   * \brief Walk a tree from the destination to the source and add the
+   * neighbor indices to the nix-vector.
+   * \param [in] tree the tree of the source
+   * \param [in] source Source node index
+   * \param [in] dest Destination node index
+   * \param [out] nixVector the NixVector to be used for routing
+   * \returns false if dest is not in the tree, true o.w.
+   */
+  bool BuildNixVector (const std::vector<uint32_t> &tree, uint32_t source, uint32_t dest,
+                       Ptr<NixVector> nixVector) const;
+
+  bool m_ipv6;              //!< Follow the IPv6 interfaces instead of IPv4
+  uint32_t m_version;       //!< Version of the topology
+  bool m_graphDirty;        //!< The graph must be rebuilt
+  uint32_t m_nNodes;        //!< Number of nodes of the graph
+
+  /// Start of the neighbors of each node in m_bfsNeighbors
+  std::vector<uint32_t> m_bfsOffsets;
+  /// Neighbors through the devices which are up, in search order
+  std::vector<uint32_t> m_bfsNeighbors;
+  /// Start of the neighbors of each node in m_nixNeighbors
+  std::vector<uint32_t> m_nixOffsets;
+  /// Neighbors through all the devices, in nix index order
+  std::vector<uint32_t> m_nixNeighbors;
+  /// Tree of each source node, empty if not computed
+  std::vector<std::vector<uint32_t> > m_trees;
+
+  SystemMutex *m_treeMutex;          //!< Protects the queue of trees to compute
+  std::vector<uint32_t> m_treeQueue; //!< Sources of the trees to compute
+  uint32_t m_treeNext;               //!< Next tree of the queue
+};
+
+} // namespace ns3
+
+#endif /* NIX_VECTOR_TOPOLOGY_H */
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef PREFIX_ROUTE_INDEX_H
+#define PREFIX_ROUTE_INDEX_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup internet
+ *
+ * \brief Keep the first bits of an IPv4 address.
+ * \param address the address
+ * \param prefixLength the number of bits to keep
+ * \return the network part of the address
+ */
+inline Ipv4Address
+PrefixRouteIndexCombine (Ipv4Address address, uint8_t prefixLength)
+{
+  uint32_t mask = prefixLength == 0 ? 0 : 0xffffffff << (32 - prefixLength);
+  return Ipv4Address (address.Get () & mask);
+}
+
+/**
+ * \ingroup internet
+ *
+ * \brief Keep the first bits of an IPv6 address.
+ * \param address the address
+ * \param prefixLength the number of bits to keep
+ * \return the network part of the address
+ */
+inline Ipv6Address
+PrefixRouteIndexCombine (Ipv6Address address, uint8_t prefixLength)
+{
+  uint8_t buf[16];
+  address.GetBytes (buf);
+  for (uint8_t i = 0; i < 16; i++)
+    {
+      if (prefixLength >= 8 * (i + 1))
+        {
+          continue;
+        }
+      if (prefixLength > 8 * i)
+        {
+          buf[i] &= static_cast<uint8_t> (0xff << (8 * (i + 1) - prefixLength));
+        }
+      else
+        {
+          buf[i] = 0;
+        }
+    }
+  return Ipv6Address (buf);
+}
+
+/**
+ * \ingroup internet
+ *
+ * \brief Longest prefix match index of a routing table.
+ *
+ * The routes are stored in one hash table per prefix length, keyed by the
+ * destination network. A lookup probes the tables of the prefix lengths in
+ * use, from the longest to the shortest, so its cost is bounded by the
+ * number of distinct prefix lengths of the table instead of the number of
+ * routes. The routes to the same network are kept in insertion order in a
+ * bucket, which allows the routing protocols to apply their own tie
+ * breaking (ECMP, metrics, output interface).
+ *
+ * The index does not own the routes: the routing protocols keep their route
+ * lists, and rebuild the index when the lists change.
+ *
+ * \tparam Address the address type (Ipv4Address or Ipv6Address)
+ * \tparam AddressHash hash function of the addresses
+ * \tparam MaxLength the number of bits of the addresses
+ * \tparam Entry the type of the entries stored in the buckets
+ */
+template <typename Address, typename AddressHash, uint8_t MaxLength, typename Entry>
+class PrefixRouteIndex
+{
+public:
+  /// Routes to the same network, in insertion order
+  typedef std::vector<Entry> Bucket;
+
+  PrefixRouteIndex ()
+    : m_tables (MaxLength + 1)
+  {
+  }
+
+  /**
+   * \brief Remove all the entries.
+   */
+  void Clear (void)
+  {
+    for (typename std::vector<Table>::iterator i = m_tables.begin (); i != m_tables.end (); i++)
+      {
+        i->clear ();
+      }
+    m_lengths.clear ();
+  }
+
+  /**
+   * \brief Add an entry after the ones to the same network.
+   * \param network destination network (the host bits are ignored)
+   * \param prefixLength length of the network prefix
+   * \param entry the entry
+   */
+  void Add (Address network, uint8_t prefixLength, Entry entry)
+  {
+    NS_ASSERT (prefixLength <= MaxLength);
+    Table &table = m_tables[prefixLength];
+    if (table.empty ())
+      {
+        // keep the lengths in use sorted from the longest
+        typename std::vector<uint8_t>::iterator i = m_lengths.begin ();
+        while (i != m_lengths.end () && *i > prefixLength)
+          {
+            i++;
+          }
+        m_lengths.insert (i, prefixLength);
+      }
+    table[PrefixRouteIndexCombine (network, prefixLength)].push_back (entry);
+  }
+
+  /**
+   * \brief Visit the buckets matching an address, from the longest prefix.
+   *
+   * The visitor is called as visitor (prefixLength, bucket) and returns true
+   * to stop the lookup, e.g., when the bucket holds a usable route.
+   *
+   * \param address the address to look up
+   * \param visitor the visitor
+   * \return true if the visitor stopped the lookup
+   */
+  template <typename Visitor>
+  bool Lookup (Address address, Visitor visitor) const
+  {
+    for (std::vector<uint8_t>::const_iterator i = m_lengths.begin (); i != m_lengths.end (); i++)
+      {
+        const Table &table = m_tables[*i];
+        typename Table::const_iterator bucket = table.find (PrefixRouteIndexCombine (address, *i));
+        if (bucket != table.end () && visitor (*i, bucket->second))
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+private:
+  /// Buckets of a prefix length, by destination network
+  typedef std::unordered_map<Address, Bucket, AddressHash> Table;
+
+  std::vector<Table> m_tables;    //!< One table per prefix length
+  std::vector<uint8_t> m_lengths; //!< Prefix lengths in use, from the longest
+};
+
+} // namespace ns3
+
+#endif /* PREFIX_ROUTE_INDEX_H */
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RR_MULTI_USER_SCHEDULER_H
+#define RR_MULTI_USER_SCHEDULER_H
+
+#include "multi-user-scheduler.h"
+#include "wifi-mac-queue-item.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * RrMultiUserScheduler is a simple OFDMA scheduler that serves the
+ * associated HE stations in round robin, in the order of their association
+ * IDs.  On every channel access, it alternates, if UL OFDMA is enabled,
+ * between soliciting HE TB PPDUs from the next NStations stations and
+ * sending a DL MU PPDU to the next (at most) NStations stations having
+ * queued data, for a TID of the access category, under a Block Ack
+ * agreement.  All the stations get a RU of the same size, the largest one
+ * leaving no RU unused.  A single-user PPDU is sent when less than two
+ * stations have data, unless ForceDlOfdma is set.
+ *
+ * The round robin resumes after the last station served, so that a channel
+ * access visits each associated station at most once.
+ */
+class RrMultiUserScheduler : public MultiUserScheduler
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  RrMultiUserScheduler ();
+  virtual ~RrMultiUserScheduler ();
+
+
+protected:
+  void DoDispose (void);
+
+
+private:
+  TxFormat SelectTxFormat (void);
+  MuInfo ComputeDlMuInfo (void);
+  MuInfo ComputeUlMuInfo (void);
+
+  /// A station with queued data for the EDCA function that gained channel access
+  struct Candidate
+  {
+    uint16_t aid;                             //!< association ID of the station
+    Mac48Address address;                     //!< MAC address of the station
+    uint8_t tid;                              //!< TID of the queued data (DL only)
+    Ptr<const WifiMacQueueItem> mpdu;         //!< first queued MPDU (DL only)
+    WifiTxVector txVector;                    //!< TXVECTOR used to send data to the station
+  };
+
+  /**
+   * Find the next (at most) NStations HE stations with data queued, for a
+   * TID of the access category of the EDCA function that gained channel
+   * access, under an established Block Ack agreement, and sent with HE modes.
+   */
+  void FindDlCandidates (void);
+  /**
+   * Find the next (at most) NStations associated HE stations whose data
+   * are sent with HE modes.
+   */
+  void FindUlCandidates (void);
+  /**
+   * Assign equal-sized RUs to the first candidates, as many as the RUs.
+   *
+   * \param candidates the candidates
+   * \param info the information to fill
+   * \return the type of the RUs
+   */
+  HeRu::RuType AssignRus (const std::vector<Candidate> &candidates, MuInfo &info) const;
+
+  uint8_t m_nStations;                   //!< maximum number of stations served by a multi-user PPDU
+  bool m_forceDlOfdma;                   //!< send DL MU PPDUs even to a single station
+  bool m_enableUlOfdma;                  //!< solicit HE TB PPDUs
+  uint32_t m_ulPsduSize;                 //!< size of the PSDUs solicited from the stations
+  TxFormat m_lastTxFormat;               //!< format of the last transmission
+  uint16_t m_lastDlAid;                  //!< AID of the last station served in DL
+  uint16_t m_lastUlAid;                  //!< AID of the last station solicited in UL
+  std::vector<Candidate> m_dlCandidates; //!< stations with data found by SelectTxFormat
+  std::vector<Candidate> m_ulCandidates; //!< stations to solicit found by SelectTxFormat
+};
+
+} //namespace ns3
+
+#endif /* RR_MULTI_USER_SCHEDULER_H */
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SWEEP_DRIVER_H
+#define SWEEP_DRIVER_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SweepDriver declaration.
+ */
+
+#include <list>
+#include <stdint.h>
+
+#include "nstime.h"
+#include "callback.h"
+#include "event-id.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Run the branches of a parameter sweep from a snapshot of a
+ * running simulation.
+ *
+ * The runs of a sweep often share a warm-up period, such as TCP ramp-up or
+ * routing convergence, before their parameters make them diverge.  At the
+ * time given to Schedule (), the process is forked once per branch: the
+ * state of the simulation, including the nodes, the devices and the pending
+ * events, is shared copy-on-write by the branches, so the warm-up is only
+ * simulated once.  Each branch process calls the setup callback with its
+ * index, to apply its parameters, and continues the simulation.  The
+ * original process is the snapshot: it waits for the branches, then stops
+ * its own simulation, so that Simulator::Run () returns.
+ *
+ * \code
+ *   void SetupBranch (uint32_t branch)
+ *   {
+ *     Config::Set ("/NodeList/0/DeviceList/0/DataRate", DataRateValue (rates[branch]));
+ *   }
+ *
+ *   SweepDriver sweep;
+ *   sweep.Schedule (Seconds (200), 16, MakeCallback (&SetupBranch));
+ *   Simulator::Stop (Seconds (300));
+ *   Simulator::Run ();
+ *   if (sweep.IsBranch ())
+ *     {
+ *       // Write the results of branch sweep.GetBranch ()
+ *     }
+ *   Simulator::Destroy ();
+ *   return sweep.GetFailures () > 0;
+ * \endcode
+ *
+ * The branches are separate processes, so they must write their results
+ * to files of their own.  The files opened before the fork, such as trace
+ * files, are shared by the branches, whose writes would be interleaved:
+ * the traces of the branches should be enabled by the setup callback.
+ * The pending output of the standard streams is flushed before the fork.
+ * The threads other than the simulation thread are not copied into the
+ * branches, so the fork is not supported with the realtime or distributed
+ * simulators, nor with the asynchronous pcap writes.  Since the random
+ * variables already created keep their streams, the branches draw the
+ * same numbers unless the setup callback changes them.
+ *
+ * This needs fork (), so it is only available on POSIX systems.
+ */
+class SweepDriver
+{
+public:
+  /** Callback setting up a branch, given its index. */
+  typedef Callback<void, uint32_t> BranchCallback;
+
+  /** Value of GetBranch () in the snapshot process. */
+  static const uint32_t NO_BRANCH = 0xffffffff;
+
+  SweepDriver ();
+  ~SweepDriver ();
+
+  /**
+   * \brief Set the number of branches run at the same time.
+   * \param maxParallel the number of branches, or 0 for the number of
+   *        processors
+   */
+  void SetMaxParallel (uint32_t maxParallel);
+
+  /**
+   * \brief Schedule the fork of the branches.
+   * \param at the time of the fork, relative to the current time
+   * \param nBranches the number of branches
+   * \param setup called in each branch, with its index, right after the fork
+   */
+  void Schedule (Time at, uint32_t nBranches, BranchCallback setup);
+
+  /**
+   * \returns true in the processes of the branches
+   */
+  bool IsBranch (void) const;
+
+  /**
+   * \returns the index of the branch of this process, or NO_BRANCH in the
+   * snapshot process
+   */
+  uint32_t GetBranch (void) const;
+
+  /**
+   * \returns the number of branches which did not exit successfully, in
+   * the snapshot process
+   */
+  uint32_t GetFailures (void) const;
+
+private:
+  /**
+   * \brief Fork the branches, and wait for them in the snapshot process.
+   */
+  void Fork (void);
+
+  /**
+   * \brief Wait for the oldest running branch.
+   */
+  void WaitOldest (void);
+
+  uint32_t m_maxParallel;       //!< Number of branches run at the same time
+  uint32_t m_nBranches;         //!< Number of branches
+  BranchCallback m_setup;       //!< Setup of the branches
+  EventId m_event;              //!< The fork
+  uint32_t m_branch;            //!< Branch of this process
+  uint32_t m_failures;          //!< Branches which failed
+  std::list<int> m_running;     //!< Process ids of the running branches
+};
+
+} // namespace ns3
+
+#endif /* SWEEP_DRIVER_H */
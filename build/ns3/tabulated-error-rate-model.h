@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABULATED_ERROR_RATE_MODEL_H
+#define TABULATED_ERROR_RATE_MODEL_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "error-rate-model.h"
+#include "wifi-mode.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * \brief An error rate model interpolating precomputed tables of another
+ * error rate model.
+ *
+ * For each WifiMode, the chunk success rates of the wrapped model, set with
+ * the ErrorRateModel attribute, are computed once, on a grid of SNRs spaced
+ * by SnrStep dB from MinSnr to MaxSnr and of chunk lengths of 2^0 to 2^26
+ * bits.  A chunk success rate is then obtained by bilinear interpolation of
+ * the logarithm of the tabulated rates, which costs one log10 and one exp
+ * instead of the erfc, pow and series computations of the wrapped model.
+ * The interpolation in the chunk length is exact for the models whose
+ * success rate is the per-bit success rate to the power of the number of
+ * bits, as all the models of this module.  An SNR outside of the grid is
+ * given to the wrapped model.
+ *
+ * The table of a mode is generated the first time the mode is used, or by
+ * Generate (), and can be saved to and loaded from a file.  The tables are
+ * shared by all the instances wrapping a model of the same type, with the
+ * same attribute values, and using the same grid.  The wrapped model must
+ * only depend on the TXVECTOR through the mode.
+ *
+ * With the default grid, the absolute error on the chunk success rate of
+ * the NIST, YANS and DSSS models is below 0.001 for chunks of more than two
+ * bits.  It reaches 0.02 for chunks of one or two bits, near the SNR where
+ * the coded BER bound of the NIST model reaches 1, and is not bounded
+ * within one step of a discontinuity of the wrapped model, such as the one
+ * at 10 dB of the CCK models built without GSL.  The error decreases with
+ * the square of SnrStep.
+ */
+class TabulatedErrorRateModel : public ErrorRateModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TabulatedErrorRateModel ();
+  virtual ~TabulatedErrorRateModel ();
+
+  /**
+   * \param model the error rate model to tabulate
+   */
+  void SetErrorRateModel (Ptr<ErrorRateModel> model);
+  /**
+   * \return the error rate model tabulated
+   */
+  Ptr<ErrorRateModel> GetErrorRateModel (void) const;
+
+  /**
+   * Generate the table of the given mode, if it does not exist yet.
+   *
+   * \param mode the Wi-Fi mode
+   */
+  void Generate (WifiMode mode);
+  /**
+   * Save the tables generated so far.
+   *
+   * \param filename the name of the file
+   */
+  void Save (std::string filename) const;
+  /**
+   * Load the tables saved by Save ().  The grid of the file must be the
+   * grid of this model.
+   *
+   * \param filename the name of the file
+   */
+  void Load (std::string filename);
+
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /// The tabulated chunk success rates of a mode
+  struct Table
+  {
+    WifiMode mode;                  //!< the Wi-Fi mode
+    std::vector<double> logSuccess; //!< logarithms of the success rates, by SNR then length
+  };
+  /// The tables, indexed by mode UID
+  typedef std::unordered_map<uint32_t, Table> Tables;
+
+  /**
+   * \param mode the Wi-Fi mode
+   * \return the table of the mode, generated if needed
+   */
+  const Table & GetTable (WifiMode mode) const;
+  /**
+   * \return the tables shared by the models equivalent to this one
+   */
+  std::shared_ptr<Tables> GetTables (void) const;
+  /**
+   * \return the number of points of the SNR grid
+   */
+  uint32_t GetNSnrs (void) const;
+
+  static const uint32_t N_LENGTHS = 27; //!< number of chunk lengths (2^0 to 2^26 bits)
+
+  Ptr<ErrorRateModel> m_model;             //!< error rate model tabulated
+  double m_minSnr;                         //!< first SNR of the grid (dB)
+  double m_maxSnr;                         //!< last SNR of the grid (dB)
+  double m_snrStep;                        //!< step of the SNR grid (dB)
+  mutable uint32_t m_nSnrs;                //!< number of points of the SNR grid
+  mutable std::shared_ptr<Tables> m_tables; //!< tables of this model
+};
+
+} //namespace ns3
+
+#endif /* TABULATED_ERROR_RATE_MODEL_H */
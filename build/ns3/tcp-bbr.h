@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef TCPBBR_H
+#define TCPBBR_H
+
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief BBR (Bottleneck Bandwidth and Round-trip propagation time) v1
+ *
+ * BBR builds a model of the path from the rate samples computed by
+ * TcpRateOps: the bottleneck bandwidth (BtlBw) is the windowed maximum of
+ * the delivery rate over the last BwWindowLength rounds, and the round-trip
+ * propagation time (RTprop) is the minimum RTT over the last RttWindowLength.
+ * The sender paces at pacing_gain * BtlBw and limits the data in flight to
+ * cwnd_gain * BtlBw * RTprop, going through the STARTUP, DRAIN, PROBE_BW and
+ * PROBE_RTT modes.
+ *
+ * The algorithm follows net/ipv4/tcp_bbr.c in Linux, with the quantities in
+ * bytes instead of packets. The long-term bandwidth sampling (policer
+ * detection) and the ack aggregation compensation are not implemented.
+ *
+ * BBR controls cwnd and pacing rate through CongControl, so it needs pacing:
+ * Init enables it on the socket.
+ */
+class TcpBbr : public TcpCongestionOps
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief BBR modes
+   */
+  typedef enum
+  {
+    BBR_STARTUP,   //!< Ramp up sending rate rapidly to fill pipe
+    BBR_DRAIN,     //!< Drain any queue created during startup
+    BBR_PROBE_BW,  //!< Discover, share bandwidth: pace around estimated bandwidth
+    BBR_PROBE_RTT, //!< Cut inflight to min to probe min_rtt
+  } BbrMode_t;
+
+  /**
+   * \brief Literal names of BBR modes for use in log messages
+   */
+  static const char* const BbrModeName[BBR_PROBE_RTT + 1];
+
+  /**
+   * \brief Constructor
+   */
+  TcpBbr ();
+
+  /**
+   * \brief Copy constructor
+   * \param sock the object to copy
+   */
+  TcpBbr (const TcpBbr &sock);
+
+  virtual ~TcpBbr ();
+
+  /**
+   * \brief Assign a fixed random variable stream number to the random variables
+   * used by this model.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  virtual std::string GetName () const;
+  virtual void Init (Ptr<TcpSocketState> tcb);
+  virtual uint32_t GetSsThresh (Ptr<const TcpSocketState> tcb,
+                                uint32_t bytesInFlight);
+  virtual void IncreaseWindow (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked);
+  virtual void CongestionStateSet (Ptr<TcpSocketState> tcb,
+                                   const TcpSocketState::TcpCongState_t newState);
+  virtual void CwndEvent (Ptr<TcpSocketState> tcb,
+                          const TcpSocketState::TcpCAEvent_t event);
+  virtual bool HasCongControl () const;
+  virtual void CongControl (Ptr<TcpSocketState> tcb,
+                            const TcpRateOps::TcpRateConnection &rc,
+                            const TcpRateOps::TcpRateSample &rs);
+  virtual void ReduceCwnd (Ptr<TcpSocketState> tcb);
+  virtual Ptr<TcpCongestionOps> Fork ();
+
+  /**
+   * \brief Get the current mode
+   * \return the BBR mode
+   */
+  BbrMode_t GetMode () const;
+
+  /**
+   * \brief Get the bottleneck bandwidth estimate
+   * \return the windowed maximum of the delivery rate
+   */
+  DataRate GetBtlBw () const;
+
+  /**
+   * \brief Get the round-trip propagation time estimate
+   * \return the windowed minimum of the RTT, Time::Max () if unknown
+   */
+  Time GetRtProp () const;
+
+  /**
+   * \brief Has the pipe been filled during STARTUP?
+   * \return true if the bandwidth stopped growing during STARTUP
+   */
+  bool IsFullBwReached () const;
+
+private:
+  /**
+   * \brief Initialize the state, at the first transmission or ACK
+   * \param tcb internal congestion state
+   */
+  void InitState (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Update the round counter and the bandwidth filter
+   * \param rc rate information of the connection
+   * \param rs rate sample of the ACK
+   */
+  void UpdateBw (const TcpRateOps::TcpRateConnection &rc,
+                 const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Advance the PROBE_BW gain cycle when the phase is over
+   * \param tcb internal congestion state
+   * \param rs rate sample of the ACK
+   */
+  void UpdateCyclePhase (Ptr<const TcpSocketState> tcb,
+                         const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Detect that STARTUP filled the pipe
+   * \param rs rate sample of the ACK
+   */
+  void CheckFullBwReached (const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Move from STARTUP to DRAIN, and from DRAIN to PROBE_BW
+   * \param tcb internal congestion state
+   */
+  void CheckDrain (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Update the RTprop filter, entering and leaving PROBE_RTT
+   * \param tcb internal congestion state
+   * \param rc rate information of the connection
+   * \param rs rate sample of the ACK
+   */
+  void UpdateMinRtt (Ptr<TcpSocketState> tcb,
+                     const TcpRateOps::TcpRateConnection &rc,
+                     const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Leave PROBE_RTT once it lasted long enough
+   * \param tcb internal congestion state
+   */
+  void CheckProbeRttDone (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Set the pacing and cwnd gains for the current mode
+   */
+  void UpdateGains ();
+
+  /**
+   * \brief Enter PROBE_BW at a random phase of the gain cycle
+   */
+  void ResetProbeBwMode ();
+
+  /**
+   * \brief Go back to STARTUP or PROBE_BW after PROBE_RTT
+   */
+  void ResetMode ();
+
+  /**
+   * \brief Set the pacing rate from the bandwidth estimate
+   * \param tcb internal congestion state
+   * \param gain pacing gain
+   */
+  void SetPacingRate (Ptr<TcpSocketState> tcb, double gain);
+
+  /**
+   * \brief Set the pacing rate from cwnd and the smoothed RTT
+   * \param tcb internal congestion state
+   */
+  void InitPacingRate (Ptr<TcpSocketState> tcb);
+
+  /**
+   * \brief Update cwnd towards the target inflight
+   * \param tcb internal congestion state
+   * \param rc rate information of the connection
+   * \param rs rate sample of the ACK
+   */
+  void SetCwnd (Ptr<TcpSocketState> tcb,
+                const TcpRateOps::TcpRateConnection &rc,
+                const TcpRateOps::TcpRateSample &rs);
+
+  /**
+   * \brief Apply packet conservation on entering recovery, and restore cwnd
+   * on leaving it
+   * \param tcb internal congestion state
+   * \param rc rate information of the connection
+   * \param rs rate sample of the ACK
+   * \param cwnd the new cwnd (output)
+   * \return true if cwnd is set by packet conservation
+   */
+  bool SetCwndToRecoverOrRestore (Ptr<TcpSocketState> tcb,
+                                  const TcpRateOps::TcpRateConnection &rc,
+                                  const TcpRateOps::TcpRateSample &rs,
+                                  uint32_t *cwnd);
+
+  /**
+   * \brief Remember cwnd before a loss or PROBE_RTT, to restore it later
+   * \param tcb internal congestion state
+   */
+  void SaveCwnd (Ptr<const TcpSocketState> tcb);
+
+  /**
+   * \brief Bandwidth-delay product
+   * \param tcb internal congestion state
+   * \param gain gain applied to the BDP
+   * \return gain * BtlBw * RTprop, in bytes
+   */
+  uint32_t Bdp (Ptr<const TcpSocketState> tcb, double gain) const;
+
+  /**
+   * \brief Target inflight, accounting for the segments queued below TCP
+   * \param tcb internal congestion state
+   * \param gain gain applied to the BDP
+   * \return the target inflight, in bytes
+   */
+  uint32_t Inflight (Ptr<const TcpSocketState> tcb, double gain) const;
+
+  /**
+   * \brief Update the windowed maximum bandwidth filter
+   * \param round current round
+   * \param bw bandwidth sample
+   */
+  void UpdateMaxBw (uint32_t round, DataRate bw);
+
+  /**
+   * \brief Sample of the windowed maximum filter
+   */
+  struct MaxBwSample
+  {
+    uint32_t m_round {0};   //!< Round of the sample
+    DataRate m_bw {0};      //!< Bandwidth sample
+  };
+
+  // Configuration
+  double   m_highGain {2.885};                //!< Gain of STARTUP, 2/ln(2)
+  uint32_t m_bwWindowLength {10};             //!< Length of the BtlBw filter, in rounds
+  Time     m_rtPropWindowLength {Seconds (10)}; //!< Length of the RTprop filter
+  Time     m_probeRttDuration {MilliSeconds (200)}; //!< Minimum time spent in PROBE_RTT
+  Ptr<UniformRandomVariable> m_uv;            //!< Random phase of the gain cycle
+
+  // State
+  bool      m_initialized {false};            //!< True once InitState has run
+  BbrMode_t m_mode {BBR_STARTUP};             //!< Current mode
+  MaxBwSample m_maxBw[3];                     //!< Best, second best and third best samples of the BtlBw filter
+  Time      m_minRtt {Time::Max ()};          //!< RTprop estimate
+  Time      m_minRttStamp {0};                //!< Time m_minRtt was updated
+  Time      m_probeRttDoneStamp {0};          //!< End of PROBE_RTT, zero if not started
+  bool      m_probeRttRoundDone {false};      //!< A round elapsed during PROBE_RTT
+  uint32_t  m_roundCount {0};                 //!< Number of rounds
+  uint64_t  m_nextRoundDelivered {0};         //!< Delivered count marking the end of the round
+  bool      m_roundStart {false};             //!< The current ACK starts a round
+  bool      m_packetConservation {false};     //!< Packet conservation during the first round of recovery
+  TcpSocketState::TcpCongState_t m_prevCaState {TcpSocketState::CA_OPEN}; //!< Congestion state at the previous ACK
+  uint32_t  m_priorCwnd {0};                  //!< cwnd before loss recovery or PROBE_RTT
+  bool      m_idleRestart {false};            //!< Restarting after an idle period
+  bool      m_hasSeenRtt {false};             //!< The pacing rate has been set from an RTT sample
+  bool      m_fullBwReached {false};          //!< STARTUP filled the pipe
+  DataRate  m_fullBw {0};                     //!< Bandwidth at the last STARTUP growth check
+  uint32_t  m_fullBwCount {0};                //!< Rounds without bandwidth growth
+  uint32_t  m_cycleIndex {0};                 //!< Phase of the PROBE_BW gain cycle
+  Time      m_cycleStamp {0};                 //!< Start of the current phase
+  double    m_pacingGain {1};                 //!< Current pacing gain
+  double    m_cwndGain {1};                   //!< Current cwnd gain
+};
+
+} // namespace ns3
+
+#endif // TCPBBR_H
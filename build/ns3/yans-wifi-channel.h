@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef YANS_WIFI_CHANNEL_H
+#define YANS_WIFI_CHANNEL_H
+
+#include <vector>
+#include "ns3/channel.h"
+
+namespace ns3 {
+
+class NetDevice;
+class PropagationLossModel;
+class PropagationDelayModel;
+class SpatialGrid;
+class MobilityModel;
+class YansWifiPhy;
+class Packet;
+class Time;
+class WifiPpdu;
+
+/**
+ * \brief a channel to interconnect ns3::YansWifiPhy objects.
+ * \ingroup wifi
+ *
+ * This class is expected to be used in tandem with the ns3::YansWifiPhy
+ * class and supports an ns3::PropagationLossModel and an
+ * ns3::PropagationDelayModel.  By default, no propagation models are set;
+ * it is the caller's responsibility to set them before using the channel.
+ *
+ * The signals received below the sensitivity of a PHY are dropped when they
+ * are sent, without scheduling their reception.  When the MaxRange attribute
+ * is set, the PHYs farther from the sender are not even looked at: the PHYs
+ * are kept in a SpatialGrid of their positions, so that the cost of a
+ * transmission depends on the number of PHYs in range rather than on the
+ * number of PHYs on the channel.  The range must be larger than the distance
+ * at which the propagation loss model can bring a signal above the
+ * sensitivity of the PHYs.
+ */
+class YansWifiChannel : public Channel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  YansWifiChannel ();
+  virtual ~YansWifiChannel ();
+
+  //inherited from Channel.
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+  /**
+   * Adds the given YansWifiPhy to the PHY list
+   *
+   * \param phy the YansWifiPhy to be added to the PHY list
+   */
+  void Add (Ptr<YansWifiPhy> phy);
+
+  /**
+   * \param loss the new propagation loss model.
+   */
+  void SetPropagationLossModel (const Ptr<PropagationLossModel> loss);
+  /**
+   * \param delay the new propagation delay model.
+   */
+  void SetPropagationDelayModel (const Ptr<PropagationDelayModel> delay);
+
+  /**
+   * \param sender the PHY object from which the packet is originating.
+   * \param ppdu the PPDU to send
+   * \param txPowerDbm the TX power associated to the packet, in dBm
+   *
+   * This method should not be invoked by normal users. It is
+   * currently invoked only from YansWifiPhy::StartTx.  The channel
+   * attempts to deliver the PPDU to all other YansWifiPhy objects
+   * on the channel (except for the sender).
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   *
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+
+private:
+  /**
+   * A vector of pointers to YansWifiPhy.
+   */
+  typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+
+  /**
+   * This method is scheduled by Send for each associated YansWifiPhy.
+   * The method then calls the corresponding YansWifiPhy that the first
+   * bit of the PPDU has arrived.
+   *
+   * \param receiver the device to which the packet is destined
+   * \param ppdu the PPDU being sent
+   * \param txPowerDbm the TX power associated to the packet being sent (dBm)
+   */
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
+
+  /**
+   * Add a PHY to the receivers of a PPDU, unless it is the sender or is
+   * tuned to another channel.
+   *
+   * \param sender the PHY object from which the packet is originating
+   * \param receiver the PHY which may receive the PPDU
+   */
+  void AddReceiver (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const;
+
+  /**
+   * Schedule the reception of a PPDU by a PHY if its reception power is
+   * above the sensitivity of the PHY.
+   *
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the PHY receiving the PPDU
+   * \param receiverMobility the mobility model of the receiver
+   * \param ppdu the PPDU to send
+   * \param rxPowerDbm the power of the PPDU at the receiver, in dBm
+   */
+  void SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+               Ptr<MobilityModel> receiverMobility, Ptr<const WifiPpdu> ppdu,
+               double rxPowerDbm) const;
+
+  /**
+   * Add the PHYs connected since the last transmission to the grid, or
+   * build it again if the range has changed.
+   */
+  void UpdateGrid (void) const;
+
+  PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
+  Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
+  Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Distance beyond which the PHYs are not looked at, or 0
+  mutable Ptr<SpatialGrid> m_grid;     //!< Positions of the PHYs, if the range is limited
+  mutable std::vector<uint32_t> m_neighbors; //!< Indices of the PHYs in range of a transmission
+  mutable PhyList m_receivers;         //!< PHYs receiving the current transmission
+  mutable std::vector<Ptr<MobilityModel> > m_receiverMobilities; //!< Mobility models of the receivers
+  mutable std::vector<double> m_rxPowersDbm; //!< Reception powers of the receivers, in dBm
+};
+
+} //namespace ns3
+
+#endif /* YANS_WIFI_CHANNEL_H */
@@ -21,10 +21,10 @@
 //            0.01 ms
 
 // This programs illustrates how TCP pacing can be used and how user can set
-// pacing rate. The program gives information about each flow like transmitted
-// and received bytes (packets) and throughput of that flow. Currently, it is 
-// using TCP NewReno but in future after having congestion control algorithms 
-// which can change pacing rate can be used.
+// the maximum pacing rate. The program gives information about each flow like
+// transmitted and received bytes (packets) and throughput of that flow. It is
+// using TCP NewReno, whose pacing rate follows cwnd / RTT up to the maximum
+// pacing rate; TcpBbr sets the pacing rate from its bandwidth estimate.
 
 #include <string>
 #include <fstream>
@@ -24,8 +24,12 @@
 #include "object-ptr-container.h"
 #include "names.h"
 #include "pointer.h"
+#include "boolean.h"
+#include "simulator.h"
 #include "log.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 /**
@@ -38,8 +42,29 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Config");
 
+/**
+ * \ingroup config
+ * \brief Enable the cache of the objects matched by the Config paths.
+ *
+ * The cache is not invalidated when objects are attached to each other
+ * through their C++ setters, so it is only enabled by the scripts which
+ * do not do that between Config lookups of the same path, or which call
+ * Config::InvalidateLookupCache () when they do.
+ */
+static GlobalValue g_configLookupCache ("ConfigLookupCache",
+                                        "Cache the objects matched by the Config paths",
+                                        BooleanValue (false),
+                                        MakeBooleanChecker ());
+
 namespace Config {
 
+/**
+ * \ingroup config-impl
+ * Generation of the object graph, incremented on each change
+ * which might change the matches of the Config paths.
+ */
+static uint64_t g_lookupGeneration = 0;
+
 MatchContainer::MatchContainer ()
 {
   NS_LOG_FUNCTION (this);
@@ -182,6 +207,8 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into a list of index ranges.
  */
 class ArrayMatcher
 {
@@ -199,8 +226,22 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Get the indices matching the Config path, if there are only a few.
+   *
+   * \param [out] indices The matching indices, in increasing order.
+   * \returns \c false if the specification matches too many indices to
+   *          list them, such as a wildcard.
+   */
+  bool GetIndices (std::vector<std::size_t> *indices) const;
 
 private:
+  /**
+   * Parse a Config path specification into index ranges.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -209,79 +250,120 @@ private:
    * \returns \c true if the string could be converted.
    */
   bool StringToUint32 (std::string str, uint32_t *value) const;
+
+  /** Maximum number of indices listed by GetIndices(). */
+  static const std::size_t MAX_INDICES = 64;
+
   /** The Config path element. */
   std::string m_element;
+  /** Whether the element is a wildcard. */
+  bool m_any;
+  /** The matching index ranges, bounds included. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_any = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      Parse (element.substr (0, tmp - 0));
+      Parse (element.substr (tmp + 1, element.size () - (tmp + 1)));
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
           && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && min <= max)
+        {
+          m_ranges.push_back (std::make_pair (min, max));
+        }
+      return;
+    }
+  uint32_t value;
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_any)
+    {
+      NS_LOG_DEBUG ("Array " << i << " matches *");
+      return true;
+    }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (i >= range->first && i <= range->second)
         {
           NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
           return true;
         }
-      else
+    }
+  NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
+  return false;
+}
+
+bool
+ArrayMatcher::GetIndices (std::vector<std::size_t> *indices) const
+{
+  NS_LOG_FUNCTION (this << indices);
+  if (m_any)
+    {
+      return false;
+    }
+  std::size_t n = 0;
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      n += static_cast<std::size_t> (range->second) - range->first + 1;
+      if (n > MAX_INDICES)
         {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
           return false;
         }
     }
-  uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  indices->clear ();
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-      return true;
+      for (std::size_t i = range->first; i <= range->second; ++i)
+        {
+          indices->push_back (i);
+        }
     }
-  NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-  return false;
+  std::sort (indices->begin (), indices->end ());
+  indices->erase (std::unique (indices->begin (), indices->end ()), indices->end ());
+  return true;
 }
 
 bool
@@ -297,6 +379,9 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is split into its elements once, when the resolver is
+ * constructed.
  */
 class Resolver
 {
@@ -325,18 +410,20 @@ private:
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] level The index of the next element of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t level, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] level The index of the element of the Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] info The container attribute.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t level, Ptr<Object> root,
+                       const struct TypeId::AttributeInformation &info);
   /**
    * Handle one object found on the path.
    *
@@ -361,6 +448,8 @@ private:
   std::vector<std::string> m_workStack;
   /** The Config path. */
   std::string m_path;
+  /** The elements of the Config path, between the slashes. */
+  std::vector<std::string> m_items;
 
 };  // class Resolver
 
@@ -369,6 +458,14 @@ Resolver::Resolver (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
   Canonicalize ();
+
+  std::string::size_type start = 1;
+  while (start < m_path.size ())
+    {
+      std::string::size_type next = m_path.find ("/", start);
+      m_items.push_back (m_path.substr (start, next - start));
+      start = next + 1;
+    }
 }
 Resolver::~Resolver ()
 {
@@ -399,7 +496,7 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -425,13 +522,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t level, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << level << root);
 
-  if (next == std::string::npos)
+  if (level == m_items.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -447,8 +542,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const std::string &item = m_items[level];
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +553,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (level + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +573,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (level + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -510,7 +603,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (level + 1, object);
       m_workStack.pop_back ();
     }
   else
@@ -549,7 +642,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                     }
                   foundMatch = true;
                   m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
+                  DoResolve (level + 1, object);
                   m_workStack.pop_back ();
                 }
               // attempt to cast to an object vector.
@@ -557,12 +650,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                 dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
               if (vectorChecker != 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
+                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath ());
                   foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
                   m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
+                  DoArrayResolve (level + 1, root, info);
                   m_workStack.pop_back ();
                 }
               // this could be anything else and we don't know what to do with it.
@@ -582,20 +673,44 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t level, Ptr<Object> root,
+                          const struct TypeId::AttributeInformation &info)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << level << root << info.name);
+  if (level == m_items.size ())
+    {
+      return;
+    }
+
+  ArrayMatcher matcher = ArrayMatcher (m_items[level]);
+
+  //
+  // A few indices, such as /NodeList/3, are looked up directly in the
+  // container, instead of matching every object of the container.
+  //
+  std::vector<std::size_t> indices;
+  const ObjectPtrContainerAccessor *accessor =
+    dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info.accessor));
+  if (accessor != 0 && matcher.GetIndices (&indices))
     {
+      for (std::vector<std::size_t>::const_iterator i = indices.begin (); i != indices.end (); ++i)
+        {
+          Ptr<Object> object = accessor->GetItem (PeekPointer (root), *i);
+          if (object == 0)
+            {
+              continue;
+            }
+          std::ostringstream oss;
+          oss << *i;
+          m_workStack.push_back (oss.str ());
+          DoResolve (level + 1, object);
+          m_workStack.pop_back ();
+        }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  ObjectPtrContainerValue container;
+  root->GetAttribute (info.name, container);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -604,7 +719,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (level + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -644,7 +759,14 @@ public:
   /** \copydoc Config::GetRootNamespaceObject() */
   Ptr<Object> GetRootNamespaceObject (std::size_t i) const;
 
+  /** Constructor. */
+  ConfigImpl ();
+
 private:
+  /**
+   * Release the objects of the lookup cache at the end of the simulation.
+   */
+  void DestroyCache (void);
   /**
    * Break a Config path into the leading path and the last leaf token.
    * \param [in] path The Config path.
@@ -660,8 +782,39 @@ private:
   /** The list of Config path roots. */
   Roots m_roots;
 
+  /** Container type of the lookup cache, indexed by Config path. */
+  typedef std::map<std::string, MatchContainer> Cache;
+
+  /** Maximum number of paths in the lookup cache. */
+  static const std::size_t MAX_CACHE_SIZE = 4096;
+
+  /** The matches of the last Config paths looked up. */
+  Cache m_cache;
+  /** Object graph generation of the lookup cache. */
+  uint64_t m_cacheGeneration;
+  /** Number of simulation events executed when the cache was filled. */
+  uint64_t m_cacheEventCount;
+  /** Whether DestroyCache() is scheduled. */
+  bool m_cacheDestroyScheduled;
+
 };  // class ConfigImpl
 
+ConfigImpl::ConfigImpl ()
+  : m_cacheGeneration (0),
+    m_cacheEventCount (0),
+    m_cacheDestroyScheduled (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ConfigImpl::DestroyCache (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cache.clear ();
+  m_cacheDestroyScheduled = false;
+}
+
 void
 ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
 {
@@ -751,6 +904,34 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+
+  //
+  // The matches are valid until the object graph changes, or a simulation
+  // event runs, since the events can change it without notice.  Nothing is
+  // cached before the simulator implementation exists, so that the lookups
+  // do not create it before the SimulatorImplementationType and
+  // SchedulerType global values are set.
+  //
+  BooleanValue useCache;
+  g_configLookupCache.GetValue (useCache);
+  useCache.Set (useCache.Get () && Simulator::HasImplementation ());
+  if (!m_cache.empty ()
+      && (!useCache.Get ()
+          || m_cacheGeneration != g_lookupGeneration
+          || m_cacheEventCount != Simulator::GetEventCount ()))
+    {
+      m_cache.clear ();
+    }
+  if (useCache.Get ())
+    {
+      Cache::const_iterator cached = m_cache.find (path);
+      if (cached != m_cache.end ())
+        {
+          NS_LOG_LOGIC ("Cached matches for path=" << path);
+          return cached->second;
+        }
+    }
+
   class LookupMatchesResolver : public Resolver
   {
 public:
@@ -778,7 +959,31 @@ public:
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  MatchContainer matches = MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+
+  //
+  // No match is not cached: the objects are often looked up before they
+  // are created.
+  //
+  if (useCache.Get () && matches.GetN () > 0)
+    {
+      if (m_cache.size () >= MAX_CACHE_SIZE)
+        {
+          m_cache.clear ();
+        }
+      if (m_cache.empty ())
+        {
+          m_cacheGeneration = g_lookupGeneration;
+          m_cacheEventCount = Simulator::GetEventCount ();
+        }
+      if (!m_cacheDestroyScheduled)
+        {
+          Simulator::ScheduleDestroy (&ConfigImpl::DestroyCache, this);
+          m_cacheDestroyScheduled = true;
+        }
+      m_cache.insert (std::make_pair (path, matches));
+    }
+  return matches;
 }
 
 void
@@ -786,6 +991,7 @@ ConfigImpl::RegisterRootNamespaceObject (Ptr<Object> obj)
 {
   NS_LOG_FUNCTION (this << obj);
   m_roots.push_back (obj);
+  InvalidateLookupCache ();
 }
 
 void
@@ -798,6 +1004,7 @@ ConfigImpl::UnregisterRootNamespaceObject (Ptr<Object> obj)
       if (*i == obj)
         {
           m_roots.erase (i);
+          InvalidateLookupCache ();
           return;
         }
     }
@@ -962,6 +1169,11 @@ Ptr<Object> GetRootNamespaceObject (uint32_t i)
   return ConfigImpl::Get ()->GetRootNamespaceObject (i);
 }
 
+void InvalidateLookupCache (void)
+{
+  ++g_lookupGeneration;
+}
+
 } // namespace Config
 
 } // namespace ns3
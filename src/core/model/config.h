@@ -317,6 +317,19 @@ std::size_t GetRootNamespaceObjectN (void);
  */
 Ptr<Object> GetRootNamespaceObject (uint32_t i);
 
+/**
+ * \ingroup config
+ * Invalidate the objects cached by the lookups of the Config paths.
+ *
+ * The results of LookupMatches, and of the Set and Connect functions,
+ * are cached until an object is created, disposed or aggregated, an
+ * attribute is set, a name or a root namespace object is added, or a
+ * simulation event runs.  The code which changes the object graph in
+ * other ways, such as adding an existing object to a container, calls
+ * this function.
+ */
+void InvalidateLookupCache (void);
+
 } // namespace Config
 
 } // namespace ns3
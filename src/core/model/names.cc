@@ -16,12 +16,13 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-#include <map>
+#include <unordered_map>
 #include "object.h"
 #include "log.h"
 #include "assert.h"
 #include "abort.h"
 #include "names.h"
+#include "config.h"
 #include "singleton.h"
 
 /**
@@ -75,8 +76,11 @@ public:
   /** The object corresponding to this NameNode. */
   Ptr<Object> m_object;
 
+  /** Container type of the children, hashed by name. */
+  typedef std::unordered_map<std::string, NameNode *> NameMap;
+
   /** Children of this NameNode. */
-  std::map<std::string, NameNode *> m_nameMap;
+  NameMap m_nameMap;
 };
 
 NameNode::NameNode ()
@@ -269,8 +273,14 @@ private:
   /** The root NameNode. */
   NameNode m_root;
 
+  /**
+   * Container type of the NameNodes, hashed by object.  The NameNodes
+   * hold a reference to their object.
+   */
+  typedef std::unordered_map<Object *, NameNode *> ObjectMap;
+
   /** Map from object pointers to their NameNodes. */
-  std::map<Ptr<Object>, NameNode *> m_objectMap;
+  ObjectMap m_objectMap;
 };
 
 NamesPriv::NamesPriv ()
@@ -297,13 +307,14 @@ NamesPriv::Clear (void)
   // Every name is associated with an object in the object map, so freeing the
   // NameNodes in this map will free all of the memory allocated for the NameNodes
   //
-  for (std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.begin (); i != m_objectMap.end (); ++i)
+  for (ObjectMap::iterator i = m_objectMap.begin (); i != m_objectMap.end (); ++i)
     {
       delete i->second;
       i->second = 0;
     }
 
   m_objectMap.clear ();
+  Config::InvalidateLookupCache ();
 
   m_root.m_parent = 0;
   m_root.m_name = "Names";
@@ -414,7 +425,8 @@ NamesPriv::Add (Ptr<Object> context, std::string name, Ptr<Object> object)
 
   NameNode *newNode = new NameNode (node, name, object);
   node->m_nameMap[name] = newNode;
-  m_objectMap[object] = newNode;
+  m_objectMap[PeekPointer (object)] = newNode;
+  Config::InvalidateLookupCache ();
 
   return true;
 }
@@ -516,7 +528,7 @@ NamesPriv::Rename (Ptr<Object> context, std::string oldname, std::string newname
       return false;
     }
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (oldname);
+  NameNode::NameMap::iterator i = node->m_nameMap.find (oldname);
   if (i == node->m_nameMap.end ())
     {
       NS_LOG_LOGIC ("Old name does not exist in name map");
@@ -537,6 +549,7 @@ NamesPriv::Rename (Ptr<Object> context, std::string oldname, std::string newname
       node->m_nameMap.erase (i);
       changeNode->m_name = newname;
       node->m_nameMap[newname] = changeNode;
+      Config::InvalidateLookupCache ();
       return true;
     }
 }
@@ -546,7 +559,7 @@ NamesPriv::FindName (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  ObjectMap::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map");
@@ -564,7 +577,7 @@ NamesPriv::FindPath (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  ObjectMap::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map");
@@ -640,7 +653,7 @@ NamesPriv::Find (std::string path)
           // There are no remaining slashes so this is the last segment of the
           // specified name.  We're done when we find it
           //
-          std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (remaining);
+          NameNode::NameMap::iterator i = node->m_nameMap.find (remaining);
           if (i == node->m_nameMap.end ())
             {
               NS_LOG_LOGIC ("Name does not exist in name map");
@@ -661,7 +674,7 @@ NamesPriv::Find (std::string path)
           offset = remaining.find ("/");
           std::string segment = remaining.substr (0, offset);
 
-          std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (segment);
+          NameNode::NameMap::iterator i = node->m_nameMap.find (segment);
           if (i == node->m_nameMap.end ())
             {
               NS_LOG_LOGIC ("Name does not exist in name map");
@@ -715,7 +728,7 @@ NamesPriv::Find (Ptr<Object> context, std::string name)
         }
     }
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (name);
+  NameNode::NameMap::iterator i = node->m_nameMap.find (name);
   if (i == node->m_nameMap.end ())
     {
       NS_LOG_LOGIC ("Name does not exist in name map");
@@ -733,7 +746,7 @@ NamesPriv::IsNamed (Ptr<Object> object)
 {
   NS_LOG_FUNCTION (this << object);
 
-  std::map<Ptr<Object>, NameNode *>::iterator i = m_objectMap.find (object);
+  ObjectMap::iterator i = m_objectMap.find (PeekPointer (object));
   if (i == m_objectMap.end ())
     {
       NS_LOG_LOGIC ("Object does not exist in object map, returning NameNode 0");
@@ -751,7 +764,7 @@ NamesPriv::IsDuplicateName (NameNode *node, std::string name)
 {
   NS_LOG_FUNCTION (this << node << name);
 
-  std::map<std::string, NameNode *>::iterator i = node->m_nameMap.find (name);
+  NameNode::NameMap::iterator i = node->m_nameMap.find (name);
   if (i == node->m_nameMap.end ())
     {
       NS_LOG_LOGIC ("Name does not exist in name map");
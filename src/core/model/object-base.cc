@@ -22,6 +22,7 @@
 #include "trace-source-accessor.h"
 #include "attribute-construction-list.h"
 #include "string.h"
+#include "config.h"
 #include "ns3/core-config.h"
 
 #include <cstdlib>  // getenv
@@ -81,6 +82,8 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
   // loop over the inheritance tree back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
+  // the environment is looked up once for all the attributes
+  const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
   TypeId tid = GetInstanceTypeId ();
   do
     {
@@ -126,7 +129,6 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
             }
 
           // No matching attribute value so we try to look at the env var.
-          const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
           if (envVar != 0 && std::strlen (envVar) > 0)
             {
               std::string env = envVar;
@@ -178,6 +180,8 @@ ObjectBase::DoSet (Ptr<const AttributeAccessor> accessor,
       return false;
     }
   bool ok = accessor->Set (this, *v);
+  // the attribute might hold an object found by the Config paths
+  Config::InvalidateLookupCache ();
   return ok;
 }
 
@@ -110,6 +110,21 @@ MakeObjectMapAccessor (U T::*memberVector)
       // quiet compiler.
       return 0;
     }
+    virtual Ptr<Object> GetItem (const ObjectBase *object, std::size_t index) const
+    {
+      const T *obj = dynamic_cast<const T *> (object);
+      if (obj == 0)
+        {
+          return 0;
+        }
+      typename U::const_iterator j =
+        (obj->*m_memberVector).find (static_cast<typename U::key_type> (index));
+      if (j == (obj->*m_memberVector).end () || static_cast<std::size_t> ((*j).first) != index)
+        {
+          return 0;
+        }
+      return (*j).second;
+    }
     U T::*m_memberVector;
   } *spec = new MemberStdContainer ();
   spec->m_memberVector = memberVector;
@@ -127,6 +127,26 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
     }
   return true;
 }
+Ptr<Object>
+ObjectPtrContainerAccessor::GetItem (const ObjectBase *object, std::size_t index) const
+{
+  NS_LOG_FUNCTION (this << object << index);
+  std::size_t n;
+  if (!DoGetN (object, &n))
+    {
+      return 0;
+    }
+  for (std::size_t i = 0; i < n; i++)
+    {
+      std::size_t k;
+      Ptr<Object> o = DoGet (object, i, &k);
+      if (k == index)
+        {
+          return o;
+        }
+    }
+  return 0;
+}
 bool
 ObjectPtrContainerAccessor::HasGetter (void) const
 {
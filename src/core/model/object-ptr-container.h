@@ -229,6 +229,17 @@ public:
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
 
+  /**
+   * Get an instance from the container, identified by its index,
+   * without getting the whole container.
+   *
+   * \param [in] object The container object.
+   * \param [in] index The index of the instance, as in the
+   *            ObjectPtrContainerValue.
+   * \returns The instance, or 0 if the container has no such index.
+   */
+  virtual Ptr<Object> GetItem (const ObjectBase *object, std::size_t index) const;
+
 private:
   /**
    * Get the number of instances in the container.
@@ -272,6 +283,16 @@ MakeObjectPtrContainerAccessor (Ptr<U> (T::*get)(INDEX) const,
       *index = i;
       return (obj->*m_get)(i);
     }
+    virtual Ptr<Object> GetItem (const ObjectBase *object, std::size_t index) const
+    {
+      std::size_t n;
+      if (!DoGetN (object, &n) || index >= n)
+        {
+          return 0;
+        }
+      const T *obj = static_cast<const T *> (object);
+      return (obj->*m_get)(index);
+    }
     Ptr<U> (T::*m_get)(INDEX) const;
     INDEX (T::*m_getN)(void) const;
   } *spec = new MemberGetters ();
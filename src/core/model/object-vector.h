@@ -20,6 +20,7 @@
 #ifndef OBJECT_VECTOR_H
 #define OBJECT_VECTOR_H
 
+#include <iterator>
 #include "object.h"
 #include "ptr.h"
 #include "attribute.h"
@@ -95,21 +96,24 @@ MakeObjectVectorAccessor (U T::*memberVector)
     virtual Ptr<Object> DoGet (const ObjectBase *object, std::size_t i, std::size_t *index) const
     {
       const T *obj = static_cast<const T *> (object);
-      typename U::const_iterator begin = (obj->*m_memberVector).begin ();
-      typename U::const_iterator end = (obj->*m_memberVector).end ();
-      std::size_t k = 0;
-      for (typename U::const_iterator j = begin; j != end; j++, k++)
+      NS_ASSERT (i < (obj->*m_memberVector).size ());
+      // constant time for the random access containers
+      typename U::const_iterator j = (obj->*m_memberVector).begin ();
+      std::advance (j, i);
+      *index = i;
+      return *j;
+    }
+    virtual Ptr<Object> GetItem (const ObjectBase *object, std::size_t index) const
+    {
+      std::size_t n;
+      if (!DoGetN (object, &n) || index >= n)
         {
-          if (k == i)
-            {
-              *index = k;
-              return *j;
-              break;
-            }
+          return 0;
         }
-      NS_ASSERT (false);
-      // quiet compiler.
-      return 0;
+      const T *obj = static_cast<const T *> (object);
+      typename U::const_iterator j = (obj->*m_memberVector).begin ();
+      std::advance (j, index);
+      return *j;
     }
     U T::*m_memberVector;
   } *spec = new MemberStdContainer ();
@@ -25,6 +25,7 @@
 #include "attribute.h"
 #include "log.h"
 #include "string.h"
+#include "config.h"
 #include <vector>
 #include <sstream>
 #include <cstdlib>
@@ -103,6 +104,7 @@ Object::Object ()
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  Config::InvalidateLookupCache ();
 }
 Object::~Object ()
 {
@@ -137,6 +139,7 @@ Object::Object (const Object &o)
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  Config::InvalidateLookupCache ();
 }
 void
 Object::Construct (const AttributeConstructionList &attributes)
@@ -222,6 +225,7 @@ Object::Dispose (void)
    * user code.
    */
   NS_LOG_FUNCTION (this);
+  Config::InvalidateLookupCache ();
 restart:
   uint32_t n = m_aggregates->n;
   for (uint32_t i = 0; i < n; i++)
@@ -256,6 +260,7 @@ Object::AggregateObject (Ptr<Object> o)
   NS_ASSERT (!o->m_disposed);
   NS_ASSERT (CheckLoose ());
   NS_ASSERT (o->CheckLoose ());
+  Config::InvalidateLookupCache ();
 
   Object *other = PeekPointer (o);
   // first create the new aggregate buffer.
@@ -332,6 +332,12 @@ Simulator::GetEventCount (void)
   return GetImpl ()->GetEventCount ();
 }
 
+bool
+Simulator::HasImplementation (void)
+{
+  return *PeekImpl () != 0;
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
@@ -205,6 +205,16 @@ public:
    */
   static uint64_t GetEventCount (void);
 
+  /**
+   * Check whether the simulator implementation exists, without
+   * creating it.
+   *
+   * The implementation is created by the first call which needs it, using
+   * the SimulatorImplementationType and SchedulerType global values.
+   * \returns \c true if the implementation was created and not destroyed.
+   */
+  static bool HasImplementation (void);
+
 
   /**
    * @name Schedule events (in the same context) to run at a future time.
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "sweep-driver.h"
+#include "simulator.h"
+#include "log.h"
+#include "fatal-error.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SweepDriver implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SweepDriver");
+
+const uint32_t SweepDriver::NO_BRANCH;
+
+SweepDriver::SweepDriver ()
+  : m_maxParallel (0),
+    m_nBranches (0),
+    m_branch (NO_BRANCH),
+    m_failures (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SweepDriver::~SweepDriver ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+SweepDriver::SetMaxParallel (uint32_t maxParallel)
+{
+  NS_LOG_FUNCTION (this << maxParallel);
+  m_maxParallel = maxParallel;
+}
+
+void
+SweepDriver::Schedule (Time at, uint32_t nBranches, BranchCallback setup)
+{
+  NS_LOG_FUNCTION (this << at << nBranches);
+  NS_ASSERT_MSG (!m_event.IsRunning (), "SweepDriver::Schedule(): the branches are already scheduled");
+  m_nBranches = nBranches;
+  m_setup = setup;
+  m_event = Simulator::Schedule (at, &SweepDriver::Fork, this);
+}
+
+bool
+SweepDriver::IsBranch (void) const
+{
+  return m_branch != NO_BRANCH;
+}
+
+uint32_t
+SweepDriver::GetBranch (void) const
+{
+  return m_branch;
+}
+
+uint32_t
+SweepDriver::GetFailures (void) const
+{
+  return m_failures;
+}
+
+void
+SweepDriver::WaitOldest (void)
+{
+  NS_LOG_FUNCTION (this);
+  int pid = m_running.front ();
+  m_running.pop_front ();
+
+  int status;
+  while (waitpid (pid, &status, 0) < 0)
+    {
+      if (errno != EINTR)
+        {
+          NS_FATAL_ERROR ("SweepDriver::WaitOldest(): waitpid failed: " << std::strerror (errno));
+        }
+    }
+  if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+    {
+      NS_LOG_WARN ("Branch process " << pid << " failed with status " << status);
+      ++m_failures;
+    }
+}
+
+void
+SweepDriver::Fork (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t maxParallel = m_maxParallel;
+  if (maxParallel == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      maxParallel = nProcessors > 0 ? nProcessors : 1;
+    }
+
+  for (uint32_t branch = 0; branch < m_nBranches; ++branch)
+    {
+      if (m_running.size () >= maxParallel)
+        {
+          WaitOldest ();
+        }
+
+      //
+      // Else the output buffered before the fork would be written by the
+      // snapshot and by each branch.
+      //
+      std::cout.flush ();
+      std::cerr.flush ();
+      std::clog.flush ();
+      std::fflush (0);
+
+      pid_t pid = fork ();
+      if (pid < 0)
+        {
+          NS_FATAL_ERROR ("SweepDriver::Fork(): fork failed: " << std::strerror (errno));
+        }
+      if (pid == 0)
+        {
+          m_branch = branch;
+          m_running.clear ();
+          NS_LOG_LOGIC ("Branch " << branch << " starts at " << Simulator::Now ().As (Time::S));
+          if (!m_setup.IsNull ())
+            {
+              m_setup (branch);
+            }
+          return;
+        }
+      NS_LOG_LOGIC ("Branch " << branch << " forked as process " << pid);
+      m_running.push_back (pid);
+    }
+
+  while (!m_running.empty ())
+    {
+      WaitOldest ();
+    }
+  NS_LOG_LOGIC (m_nBranches << " branches done, " << m_failures << " failed");
+  Simulator::Stop ();
+}
+
+} // namespace ns3
@@ -23,7 +23,7 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -51,7 +51,10 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * \brief TypeId information manager
  *
  * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * are performed by hash tables to the vector index.  The Attributes and
+ * TraceSources of a type id and of its parents are indexed by name in
+ * hash tables of the type id, built on the first lookup and rebuilt
+ * after a type id changes.
  *
  * \internal
  * <b>Hash Chaining</b>
@@ -78,6 +81,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -229,6 +234,14 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (uint16_t uid, std::size_t i) const;
+  /**
+   * Find an Attribute of a type id or of its parents, by name.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \returns The Attribute, valid until the next type id change, or 0
+   *          if there is no such Attribute.
+   */
+  const struct TypeId::AttributeInformation * FindAttribute (uint16_t uid, const std::string &name) const;
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -264,6 +277,14 @@ public:
    * \returns Detailed information about the requested trace source.
    */
   struct TypeId::TraceSourceInformation GetTraceSource (uint16_t uid, std::size_t i) const;
+  /**
+   * Find a TraceSource of a type id or of its parents, by name.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \returns The TraceSource, valid until the next type id change, or 0
+   *          if there is no such TraceSource.
+   */
+  const struct TypeId::TraceSourceInformation * FindTraceSource (uint16_t uid, const std::string &name) const;
   /**
    * Check if this TypeId should not be listed in documentation.
    * \param [in] uid The id.
@@ -293,6 +314,9 @@ private:
    */
   static TypeId::hash_t Hasher (const std::string name);
 
+  /** Type of the by-name indices of the Attributes and TraceSources: type id and position. */
+  typedef std::unordered_map<std::string, std::pair<uint16_t, std::size_t> > indexmap_t;
+
   /** The information record about a single type id. */
   struct IidInformation
   {
@@ -320,6 +344,12 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /** The Attributes of this type id and of its parents, by name. */
+    indexmap_t attributeIndex;
+    /** The TraceSources of this type id and of its parents, by name. */
+    indexmap_t traceSourceIndex;
+    /** Value of IidManager::m_indexGeneration when the indices were built. */
+    uint32_t indexGeneration;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
@@ -330,20 +360,32 @@ private:
    * \returns The information record.
    */
   struct IidManager::IidInformation * LookupInformation (uint16_t uid) const;
+  /**
+   * Build the by-name indices of a type id, unless they are up to date.
+   * \param [in] uid The id.
+   * \returns The information record.
+   */
+  struct IidManager::IidInformation * LookupIndexedInformation (uint16_t uid) const;
 
   /** The container of all type id records. */
   std::vector<struct IidInformation> m_information;
 
   /** Type of the by-name index. */
-  typedef std::map<std::string, uint16_t> namemap_t;
+  typedef std::unordered_map<std::string, uint16_t> namemap_t;
   /** The by-name index. */
   namemap_t m_namemap;
 
   /** Type of the by-hash index. */
-  typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
+  typedef std::unordered_map<TypeId::hash_t, uint16_t> hashmap_t;
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /**
+   * Generation of the type ids, incremented when an Attribute, a
+   * TraceSource or a parent is added, to rebuild the by-name indices.
+   */
+  uint32_t m_indexGeneration;
+
 
   /** IidManager constants. */
   enum
@@ -380,6 +422,12 @@ IidManager::Hasher (const std::string name)
  */
 #define IIDL IID << ": "
 
+IidManager::IidManager ()
+  : m_indexGeneration (1)
+{
+  NS_LOG_FUNCTION (IID);
+}
+
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
@@ -443,6 +491,7 @@ IidManager::AllocateUid (std::string name)
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
   information.supportLevel = TypeId::SUPPORTED;
+  information.indexGeneration = 0;
   m_information.push_back (information);
   std::size_t tuid = m_information.size ();
   NS_ASSERT (tuid <= 0xffff);
@@ -464,6 +513,44 @@ IidManager::LookupInformation (uint16_t uid) const
   return const_cast<struct IidInformation *> (&m_information[uid - 1]);
 }
 
+struct IidManager::IidInformation *
+IidManager::LookupIndexedInformation (uint16_t uid) const
+{
+  NS_LOG_FUNCTION (IID << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->indexGeneration == m_indexGeneration)
+    {
+      return information;
+    }
+  NS_LOG_LOGIC (IIDL << "indexing " << information->name);
+  information->attributeIndex.clear ();
+  information->traceSourceIndex.clear ();
+  uint16_t current = uid;
+  while (true)
+    {
+      // the names are unique along the inheritance tree
+      struct IidInformation *currentInformation = LookupInformation (current);
+      for (std::size_t i = 0; i < currentInformation->attributes.size (); ++i)
+        {
+          information->attributeIndex.insert (std::make_pair (currentInformation->attributes[i].name,
+                                                              std::make_pair (current, i)));
+        }
+      for (std::size_t i = 0; i < currentInformation->traceSources.size (); ++i)
+        {
+          information->traceSourceIndex.insert (std::make_pair (currentInformation->traceSources[i].name,
+                                                                std::make_pair (current, i)));
+        }
+      if (currentInformation->parent == current || currentInformation->parent == 0)
+        {
+          // top of inheritance tree, or no parent set
+          break;
+        }
+      current = currentInformation->parent;
+    }
+  information->indexGeneration = m_indexGeneration;
+  return information;
+}
+
 void
 IidManager::SetParent (uint16_t uid, uint16_t parent)
 {
@@ -471,6 +558,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  ++m_indexGeneration;
 }
 void
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -681,6 +769,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  ++m_indexGeneration;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void
@@ -715,6 +804,19 @@ IidManager::GetAttribute (uint16_t uid, std::size_t i) const
   return information->attributes[i];
 }
 
+const struct TypeId::AttributeInformation *
+IidManager::FindAttribute (uint16_t uid, const std::string &name) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  indexmap_t::const_iterator it = information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      return 0;
+    }
+  return &LookupInformation (it->second.first)->attributes[it->second.second];
+}
+
 bool
 IidManager::HasTraceSource (uint16_t uid,
                             std::string name)
@@ -773,6 +875,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  ++m_indexGeneration;
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -793,6 +896,19 @@ IidManager::GetTraceSource (uint16_t uid, std::size_t i) const
   NS_LOG_LOGIC (IIDL << information->name);
   return information->traceSources[i];
 }
+
+const struct TypeId::TraceSourceInformation *
+IidManager::FindTraceSource (uint16_t uid, const std::string &name) const
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  indexmap_t::const_iterator it = information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      return 0;
+    }
+  return &LookupInformation (it->second.first)->traceSources[it->second.second];
+}
 bool
 IidManager::MustHideFromDocumentation (uint16_t uid) const
 {
@@ -883,39 +999,29 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do
+  const struct TypeId::AttributeInformation *tmp = IidManager::Get ()->FindAttribute (m_tid, name);
+  if (tmp == 0)
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return false;
+    }
+  if (tmp->supportLevel == TypeId::SUPPORTED)
+    {
+      *info = *tmp;
+      return true;
+    }
+  else if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp->supportMsg << std::endl;
+      *info = *tmp;
+      return true;
+    }
+  else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp->supportMsg);
     }
-  while (nextTid != tid);
   return false;
 }
 
@@ -1137,40 +1243,29 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do
+  const struct TypeId::TraceSourceInformation *tmp = IidManager::Get ()->FindTraceSource (m_tid, name);
+  if (tmp == 0)
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return 0;
+    }
+  if (tmp->supportLevel == TypeId::SUPPORTED)
+    {
+      *info = *tmp;
+      return tmp->accessor;
+    }
+  else if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "TraceSource '" << name << "' is deprecated: "
+                << tmp->supportMsg << std::endl;
+      *info = *tmp;
+      return tmp->accessor;
+    }
+  else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("TraceSource '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp->supportMsg);
     }
-  while (nextTid != tid);
   return 0;
 }
 
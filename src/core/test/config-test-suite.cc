@@ -29,7 +29,9 @@
 #include "ns3/object-vector.h"
 #include "ns3/names.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "ns3/unused.h"
 
 
@@ -840,6 +842,103 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test the direct lookup of indices and the cache of the Config paths.
+ */
+class LookupCacheConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LookupCacheConfigTestCase ();
+  /** Destructor. */
+  virtual ~LookupCacheConfigTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+};
+
+LookupCacheConfigTestCase::LookupCacheConfigTestCase ()
+  : TestCase ("Check that the lookups of the Config paths follow the changes of the objects")
+{}
+
+void
+LookupCacheConfigTestCase::DoRun (void)
+{
+  //
+  // A named root, which does not match the paths of the other test cases.
+  //
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Names::Add ("LookupCacheRoot", root);
+  Config::SetGlobal ("ConfigLookupCache", BooleanValue (true));
+  Simulator::Destroy ();
+
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject> ();
+  root->AddNodeB (obj0);
+  root->AddNodeB (obj1);
+  root->AddNodeB (obj2);
+
+  //
+  // The indices are looked up directly, in increasing order.
+  //
+  Config::MatchContainer matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodesB/2|[0-1]|1");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 3, "Incorrect number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (0), obj0, "Incorrect first match");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (1), obj1, "Incorrect second match");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (2), obj2, "Incorrect third match");
+  NS_TEST_EXPECT_MSG_EQ (matches.GetMatchedPath (2), "/Names/LookupCacheRoot/NodesB/2/", "Incorrect matched path");
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodesB/3");
+  NS_TEST_EXPECT_MSG_EQ (matches.GetN (), 0, "No object at this index");
+
+  //
+  // The lookups do not create the simulator implementation, so that its
+  // type can still be chosen.
+  //
+  NS_TEST_EXPECT_MSG_EQ (Simulator::HasImplementation (), false,
+                         "A lookup created the simulator implementation");
+  Simulator::Now ();
+
+  //
+  // Creating an object invalidates the cached matches.
+  //
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodesB/*");
+  NS_TEST_EXPECT_MSG_EQ (matches.GetN (), 3, "Incorrect number of matches");
+  Ptr<ConfigTestObject> obj3 = CreateObject<ConfigTestObject> ();
+  root->AddNodeB (obj3);
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodesB/*");
+  NS_TEST_EXPECT_MSG_EQ (matches.GetN (), 4, "The new object is not matched");
+
+  //
+  // An event can change the objects without notice.
+  //
+  root->SetNodeA (obj0);
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodeA");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Incorrect number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (0), obj0, "Incorrect match");
+  Simulator::Schedule (Seconds (1), &ConfigTestObject::SetNodeA, root, obj1);
+  Simulator::Run ();
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodeA");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Incorrect number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (0), obj1, "The match changed by the event is not found");
+
+  //
+  // As can the code calling InvalidateLookupCache.
+  //
+  root->SetNodeA (obj2);
+  Config::InvalidateLookupCache ();
+  matches = Config::LookupMatches ("/Names/LookupCacheRoot/NodeA");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Incorrect number of matches");
+  NS_TEST_EXPECT_MSG_EQ (matches.Get (0), obj2, "The invalidated match is not updated");
+
+  Simulator::Destroy ();
+  Names::Clear ();
+  Config::SetGlobal ("ConfigLookupCache", BooleanValue (false));
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +957,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new LookupCacheConfigTestCase);
 }
 
 /**
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/sweep-driver.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * SweepDriver test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that the branches continue the simulation from the snapshot, with
+ * their own parameters, and that the snapshot collects their status.
+ */
+class SweepDriverTestCase : public TestCase
+{
+public:
+  SweepDriverTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Add the increment to the counter.
+   */
+  void Tick (void);
+
+  /**
+   * Set up a branch.
+   * \param branch the index of the branch
+   */
+  void Setup (uint32_t branch);
+
+  /**
+   * \param branch the index of a branch
+   * \returns the name of the file of the branch
+   */
+  std::string GetFilename (uint32_t branch);
+
+  uint32_t m_counter;   //!< Sum of the increments
+  uint32_t m_increment; //!< Increment of the branch
+};
+
+SweepDriverTestCase::SweepDriverTestCase ()
+  : TestCase ("Check the branches of a sweep forked from a running simulation"),
+    m_counter (0),
+    m_increment (1)
+{
+}
+
+void
+SweepDriverTestCase::Tick (void)
+{
+  m_counter += m_increment;
+}
+
+void
+SweepDriverTestCase::Setup (uint32_t branch)
+{
+  if (branch == 3)
+    {
+      _exit (3);
+    }
+  m_increment = branch + 1;
+}
+
+std::string
+SweepDriverTestCase::GetFilename (uint32_t branch)
+{
+  std::ostringstream oss;
+  oss << "branch-" << branch;
+  return CreateTempDirFilename (oss.str ());
+}
+
+void
+SweepDriverTestCase::DoRun (void)
+{
+  for (uint32_t i = 0; i < 5; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (500 + 1000 * i), &SweepDriverTestCase::Tick, this);
+    }
+
+  SweepDriver sweep;
+  sweep.SetMaxParallel (2);
+  sweep.Schedule (Seconds (2), 4, MakeCallback (&SweepDriverTestCase::Setup, this));
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+
+  if (sweep.IsBranch ())
+    {
+      //
+      // The branch must not go back to the test runner.
+      //
+      std::ofstream out (GetFilename (sweep.GetBranch ()).c_str ());
+      out << m_counter << " " << Simulator::Now ().GetSeconds () << std::endl;
+      out.close ();
+      _exit (0);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (sweep.GetBranch (), uint32_t (0xffffffff), "The snapshot is not a branch");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (2), "The snapshot must stop at the fork");
+  NS_TEST_EXPECT_MSG_EQ (m_counter, 2, "The snapshot must not run the events after the fork");
+  NS_TEST_EXPECT_MSG_EQ (sweep.GetFailures (), 1, "One branch fails");
+  Simulator::Destroy ();
+
+  for (uint32_t branch = 0; branch < 3; ++branch)
+    {
+      std::ifstream in (GetFilename (branch).c_str ());
+      NS_TEST_ASSERT_MSG_EQ (in.good (), true, "No result for branch " << branch);
+      uint32_t counter = 0;
+      double now = 0;
+      in >> counter >> now;
+      NS_TEST_EXPECT_MSG_EQ (counter, 2 + 3 * (branch + 1), "Incorrect result for branch " << branch);
+      NS_TEST_EXPECT_MSG_EQ (now, 5, "Branch " << branch << " must run until the end");
+      std::remove (GetFilename (branch).c_str ());
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The SweepDriver test suite.
+ */
+class SweepDriverTestSuite : public TestSuite
+{
+public:
+  SweepDriverTestSuite ();
+};
+
+SweepDriverTestSuite::SweepDriverTestSuite ()
+  : TestSuite ("sweep-driver", UNIT)
+{
+  AddTestCase (new SweepDriverTestCase, TestCase::QUICK);
+}
+
+static SweepDriverTestSuite g_sweepDriverTestSuite; //!< Static variable for test initialization
+
+}  // namespace tests
+
+}  // namespace ns3
@@ -334,6 +334,90 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+//----------------------------
+//
+// Attribute and TraceSource lookup test
+
+class AttributeLookupTestCase : public TestCase
+{
+public:
+  AttributeLookupTestCase ();
+  virtual ~AttributeLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+AttributeLookupTestCase::AttributeLookupTestCase ()
+  : TestCase ("Check the lookup of Attributes and TraceSources by name")
+{}
+
+AttributeLookupTestCase::~AttributeLookupTestCase ()
+{}
+
+void
+AttributeLookupTestCase::DoRun (void)
+{
+  // Every supported Attribute and TraceSource is found from the type
+  // id declaring it, and from the type ids inheriting it.
+  for (uint16_t i = 0; i < TypeId::GetRegisteredN (); ++i)
+    {
+      TypeId tid = TypeId::GetRegistered (i);
+      TypeId declaring = tid;
+      while (true)
+        {
+          for (std::size_t j = 0; j < declaring.GetAttributeN (); ++j)
+            {
+              struct TypeId::AttributeInformation expected = declaring.GetAttribute (j);
+              if (expected.supportLevel != TypeId::SUPPORTED)
+                {
+                  continue;
+                }
+              struct TypeId::AttributeInformation ainfo;
+              NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (expected.name, &ainfo), true,
+                                     "Attribute " << expected.name << " not found from " << tid.GetName ());
+              NS_TEST_ASSERT_MSG_EQ (ainfo.accessor, expected.accessor,
+                                     "Wrong attribute " << expected.name << " found from " << tid.GetName ());
+            }
+          for (std::size_t j = 0; j < declaring.GetTraceSourceN (); ++j)
+            {
+              struct TypeId::TraceSourceInformation expected = declaring.GetTraceSource (j);
+              if (expected.supportLevel != TypeId::SUPPORTED)
+                {
+                  continue;
+                }
+              NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName (expected.name), expected.accessor,
+                                     "Trace source " << expected.name << " not found from " << tid.GetName ());
+            }
+          if (declaring.GetParent () == declaring || declaring.GetParent ().GetUid () == 0)
+            {
+              break;
+            }
+          declaring = declaring.GetParent ();
+        }
+      struct TypeId::AttributeInformation ainfo;
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("NoSuchAttribute", &ainfo), false,
+                             "Unexpected attribute found from " << tid.GetName ());
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName ("NoSuchTraceSource"), 0,
+                             "Unexpected trace source found from " << tid.GetName ());
+    }
+
+  // An Attribute added after a lookup is found.
+  static TypeId tid = TypeId ("AttributeLookupTestObject")
+    .SetParent<Object> ();
+  struct TypeId::AttributeInformation ainfo;
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("MaxN", &ainfo), false,
+                         "Attribute found before it is added");
+  tid.AddAttribute ("MaxN", "",
+                    EmptyAttributeValue (),
+                    MakeEmptyAttributeAccessor (),
+                    MakeEmptyAttributeChecker ());
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("MaxN", &ainfo), true,
+                         "Attribute added after a lookup not found");
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -447,6 +531,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new AttributeLookupTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
@@ -0,0 +1,155 @@
+from __future__ import division, print_function
+import sys
+import csv
+import time
+
+## @file
+#  Loads the CSV records written by FlowMonitor::StartPeriodicExport
+#  (or FlowMonitorHelper::EnablePeriodicExport), and prints the totals of
+#  each flow.  With --follow, keeps reading the records appended to the file
+#  while the simulation runs, and prints the totals after each export.
+#
+#  Usage: flowmon-load-csv.py [--follow] FILE
+
+## The columns of the records, after time and flowId
+COUNTERS = ('txPackets', 'txBytes', 'rxPackets', 'rxBytes', 'lostPackets',
+            'timesForwarded', 'delaySum', 'jitterSum')
+
+## Flow
+class Flow(object):
+    ## class variables
+    ## @var flowId
+    #  flow ID
+    ## @var counters
+    #  sums of the counters of the records, in the COUNTERS order
+    ## @var firstRxTime
+    #  time of the first record with received packets (ns)
+    ## @var lastRxTime
+    #  time of the last record with received packets (ns)
+    ## @var __slots__
+    #  class variable list
+    __slots__ = ['flowId', 'counters', 'firstRxTime', 'lastRxTime']
+    def __init__(self, flowId):
+        '''The initializer.
+        @param self The object pointer.
+        @param flowId The flow ID.
+        '''
+        self.flowId = flowId
+        self.counters = [0] * len(COUNTERS)
+        self.firstRxTime = None
+        self.lastRxTime = None
+
+    def add(self, tm, values):
+        '''Add the counters of a record.
+        @param self The object pointer.
+        @param tm The time of the record (ns).
+        @param values The counters of the record.
+        '''
+        counters = self.counters
+        for i, value in enumerate(values):
+            counters[i] += value
+        if values[2]:
+            if self.firstRxTime is None:
+                self.firstRxTime = tm
+            self.lastRxTime = tm
+
+    def __getattr__(self, name):
+        '''Get a counter by name.
+        @param self The object pointer.
+        @param name The counter name.
+        @return the counter
+        '''
+        try:
+            return self.counters[COUNTERS.index(name)]
+        except ValueError:
+            raise AttributeError(name)
+
+
+def load_records(lines, flows):
+    '''Add the records to the flows.
+    @param lines Iterable of the CSV lines.
+    @param flows Dictionary flowId -> Flow, updated.
+    @return the time of the last record (ns), or None
+    '''
+    last = None
+    for row in csv.reader(lines):
+        if not row or row[0] == 'time':
+            continue
+        tm = int(row[0])
+        flowId = int(row[1])
+        flow = flows.get(flowId)
+        if flow is None:
+            flow = flows[flowId] = Flow(flowId)
+        flow.add(tm, [int(x) for x in row[2:]])
+        last = tm
+    return last
+
+
+def load(file_name):
+    '''Load a CSV file.
+    @param file_name The file name.
+    @return a dictionary flowId -> Flow
+    '''
+    flows = {}
+    with open(file_name) as file_obj:
+        load_records(file_obj, flows)
+    return flows
+
+
+def print_flows(flows):
+    '''Print the totals of the flows.
+    @param flows Dictionary flowId -> Flow.
+    '''
+    for flowId in sorted(flows):
+        flow = flows[flowId]
+        print("FlowID: %i" % flowId)
+        print("\tTX packets: %i, RX packets: %i, lost packets: %i"
+              % (flow.txPackets, flow.rxPackets, flow.lostPackets))
+        if flow.rxPackets:
+            print("\tMean Delay: %.2f ms" % (flow.delaySum / flow.rxPackets * 1e-6))
+            print("\tMean Hop count: %.2f" % (flow.timesForwarded / flow.rxPackets + 1))
+            print("\tPacket Loss Ratio: %.2f %%"
+                  % (flow.lostPackets / (flow.rxPackets + flow.lostPackets) * 100))
+        if flow.lastRxTime is not None and flow.lastRxTime > flow.firstRxTime:
+            # the records only give the interval of the last packet
+            duration = (flow.lastRxTime - flow.firstRxTime) * 1e-9
+            print("\tRX bitrate: %.2f kbit/s (approx.)" % (flow.rxBytes * 8 / duration * 1e-3))
+
+
+def follow(file_name, flows, poll_interval=1.0):
+    '''Read the records appended to a file, forever.
+    @param file_name The file name.
+    @param flows Dictionary flowId -> Flow, updated.
+    @param poll_interval Time between two reads (s).
+    '''
+    with open(file_name) as file_obj:
+        pending = ''
+        while True:
+            data = file_obj.read()
+            if not data:
+                time.sleep(poll_interval)
+                continue
+            # keep an incomplete last line for the next read
+            lines = (pending + data).split('\n')
+            pending = lines.pop()
+            if load_records(lines, flows) is not None:
+                print_flows(flows)
+                sys.stdout.flush()
+
+
+def main(argv):
+    if len(argv) == 3 and argv[1] == '--follow':
+        try:
+            follow(argv[2], {})
+        except KeyboardInterrupt:
+            pass
+    elif len(argv) == 2:
+        print_flows(load(argv[1]))
+    else:
+        print("Usage: %s [--follow] FILE" % argv[0], file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
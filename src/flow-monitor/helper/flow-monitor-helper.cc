@@ -174,5 +174,12 @@ FlowMonitorHelper::SerializeToXmlFile (std::string fileName, bool enableHistogra
     }
 }
 
+void
+FlowMonitorHelper::EnablePeriodicExport (std::string fileName, Time interval, bool purgeFlows)
+{
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (fileName, std::ios::out);
+  GetMonitor ()->StartPeriodicExport (stream, interval, purgeFlows);
+}
+
 
 } // namespace ns3
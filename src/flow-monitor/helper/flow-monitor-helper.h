@@ -112,6 +112,16 @@ public:
    */
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /**
+   * Periodically write the flow statistics to a file, in CSV format
+   * \param fileName name or path of the output file that will be created
+   * \param interval the time between two exports
+   * \param purgeFlows if true, remove the idle flows after their export
+   *
+   * \see FlowMonitor::StartPeriodicExport
+   */
+  void EnablePeriodicExport (std::string fileName, Time interval, bool purgeFlows = false);
+
 private:
   /**
    * \brief Copy constructor
@@ -21,11 +21,15 @@
 #include "flow-monitor.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include <fstream>
 #include <sstream>
+#include <unordered_set>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
+#define MIN_TRACKED_PACKETS_SIZE 64
 
 namespace ns3 {
 
@@ -45,6 +49,16 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (10.0)),
                    MakeTimeAccessor (&FlowMonitor::m_maxPerHopDelay),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxTrackedPackets", ("The maximum number of packets in flight that are tracked, 0 if not limited.  "
+                                         "The packets sent while the limit is reached are not monitored."),
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlowMonitor::m_maxTrackedPackets),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PacketSampling", ("Monitor one packet out of N in each flow.  "
+                                      "All the statistics then refer to the monitored packets only."),
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FlowMonitor::m_packetSampling),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddAttribute ("StartTime", ("The time when the monitoring starts."),
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&FlowMonitor::Start),
@@ -80,7 +94,9 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_exportPurgeFlows (false),
+    m_nTrackedPackets (0),
+    m_enabled (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -91,6 +107,8 @@ FlowMonitor::DoDispose (void)
   NS_LOG_FUNCTION (this);
   Simulator::Cancel (m_startEvent);
   Simulator::Cancel (m_stopEvent);
+  Simulator::Cancel (m_exportEvent);
+  m_exportStream = 0;
   for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin ();
       iter != m_classifiers.end ();
       iter ++)
@@ -102,6 +120,9 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_trackedPackets.clear ();
+  m_nTrackedPackets = 0;
+  m_lastSeenIntervals.clear ();
   Object::DoDispose ();
 }
 
@@ -109,6 +130,10 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
   NS_LOG_FUNCTION (this);
+  if (flowId < m_flowStatsIndex.size () && m_flowStatsIndex[flowId] != 0)
+    {
+      return *m_flowStatsIndex[flowId];
+    }
   FlowStatsContainerI iter;
   iter = m_flowStats.find (flowId);
   if (iter == m_flowStats.end ())
@@ -127,14 +152,179 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
-      return ref;
+      iter = m_flowStats.find (flowId);
     }
-  else
+  // the classifiers allocate the flow identifiers sequentially, so the
+  // index stays dense; do not let an unusual identifier blow it up
+  if (flowId <= 2 * m_flowStats.size () + 1024)
+    {
+      if (flowId >= m_flowStatsIndex.size ())
+        {
+          m_flowStatsIndex.resize (flowId + 1, 0);
+        }
+      m_flowStatsIndex[flowId] = &iter->second;
+    }
+  return iter->second;
+}
+
+inline bool
+FlowMonitor::IsSampled (FlowPacketId packetId) const
+{
+  return packetId % m_packetSampling == 0;
+}
+
+/**
+ * \brief Slot of a packet in the table of the tracked packets
+ * \param flowId the flow identification
+ * \param packetId the packet identifier
+ * \param mask the number of slots minus one
+ * \return the first slot to probe
+ */
+static inline uint32_t
+GetTrackedPacketSlot (FlowId flowId, FlowPacketId packetId, uint32_t mask)
+{
+  uint64_t key = (static_cast<uint64_t> (flowId) << 32) | packetId;
+  key *= 0x9e3779b97f4a7c15ULL;
+  return static_cast<uint32_t> (key >> 32) & mask;
+}
+
+/**
+ * \brief Interval of the last seen time of the tracked packets
+ * \param time the last seen time
+ * \return the interval index
+ */
+static inline int64_t
+GetLastSeenInterval (Time time)
+{
+  return time.GetTimeStep () / PERIODIC_CHECK_INTERVAL.GetTimeStep ();
+}
+
+FlowMonitor::TrackedPacket*
+FlowMonitor::FindTrackedPacket (FlowId flowId, FlowPacketId packetId)
+{
+  if (m_nTrackedPackets == 0)
+    {
+      return 0;
+    }
+  uint32_t mask = m_trackedPackets.size () - 1;
+  for (uint32_t i = GetTrackedPacketSlot (flowId, packetId, mask); ; i = (i + 1) & mask)
     {
-      return iter->second;
+      TrackedPacket &tracked = m_trackedPackets[i];
+      if (tracked.flowId == 0)
+        {
+          return 0;
+        }
+      if (tracked.flowId == flowId && tracked.packetId == packetId)
+        {
+          return &tracked;
+        }
     }
 }
 
+FlowMonitor::TrackedPacket*
+FlowMonitor::AddTrackedPacket (FlowId flowId, FlowPacketId packetId)
+{
+  NS_ASSERT_MSG (flowId != 0, "Flow identifier 0 is reserved");
+  Time now = Simulator::Now ();
+  TrackedPacket *tracked = FindTrackedPacket (flowId, packetId);
+  if (tracked != 0)
+    {
+      SetLastSeenTime (*tracked, now);
+      tracked->firstSeenTime = now;
+      return tracked;
+    }
+  if (m_maxTrackedPackets != 0 && m_nTrackedPackets >= m_maxTrackedPackets)
+    {
+      return 0;
+    }
+  if (2 * (m_nTrackedPackets + 1) > m_trackedPackets.size ())
+    {
+      ResizeTrackedPackets (std::max<uint32_t> (MIN_TRACKED_PACKETS_SIZE, 2 * m_trackedPackets.size ()));
+    }
+  uint32_t mask = m_trackedPackets.size () - 1;
+  uint32_t i = GetTrackedPacketSlot (flowId, packetId, mask);
+  while (m_trackedPackets[i].flowId != 0)
+    {
+      i = (i + 1) & mask;
+    }
+  tracked = &m_trackedPackets[i];
+  tracked->flowId = flowId;
+  tracked->packetId = packetId;
+  tracked->firstSeenTime = now;
+  tracked->lastSeenTime = now;
+  m_lastSeenIntervals[GetLastSeenInterval (now)]++;
+  m_nTrackedPackets++;
+  return tracked;
+}
+
+void
+FlowMonitor::RemoveTrackedPacket (TrackedPacket *tracked)
+{
+  std::map<int64_t, uint32_t>::iterator interval = m_lastSeenIntervals.find (GetLastSeenInterval (tracked->lastSeenTime));
+  NS_ASSERT (interval != m_lastSeenIntervals.end ());
+  if (--interval->second == 0)
+    {
+      m_lastSeenIntervals.erase (interval);
+    }
+
+  // backward shift deletion: move back the following entries of the probe
+  // sequence that would not be found anymore
+  uint32_t mask = m_trackedPackets.size () - 1;
+  uint32_t hole = tracked - &m_trackedPackets[0];
+  for (uint32_t i = (hole + 1) & mask; m_trackedPackets[i].flowId != 0; i = (i + 1) & mask)
+    {
+      uint32_t home = GetTrackedPacketSlot (m_trackedPackets[i].flowId, m_trackedPackets[i].packetId, mask);
+      // can the entry move back to the hole, i.e., is its home slot not
+      // between the hole (excluded) and its slot (included)?
+      if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+          m_trackedPackets[hole] = m_trackedPackets[i];
+          hole = i;
+        }
+    }
+  m_trackedPackets[hole].flowId = 0;
+  m_nTrackedPackets--;
+}
+
+void
+FlowMonitor::ResizeTrackedPackets (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT ((size & (size - 1)) == 0 && 2 * m_nTrackedPackets <= size);
+  std::vector<TrackedPacket> old (size);
+  old.swap (m_trackedPackets);
+  uint32_t mask = size - 1;
+  for (std::vector<TrackedPacket>::const_iterator iter = old.begin (); iter != old.end (); iter++)
+    {
+      if (iter->flowId != 0)
+        {
+          uint32_t i = GetTrackedPacketSlot (iter->flowId, iter->packetId, mask);
+          while (m_trackedPackets[i].flowId != 0)
+            {
+              i = (i + 1) & mask;
+            }
+          m_trackedPackets[i] = *iter;
+        }
+    }
+}
+
+void
+FlowMonitor::SetLastSeenTime (TrackedPacket &tracked, Time now)
+{
+  int64_t oldInterval = GetLastSeenInterval (tracked.lastSeenTime);
+  int64_t newInterval = GetLastSeenInterval (now);
+  tracked.lastSeenTime = now;
+  if (oldInterval != newInterval)
+    {
+      std::map<int64_t, uint32_t>::iterator interval = m_lastSeenIntervals.find (oldInterval);
+      NS_ASSERT (interval != m_lastSeenIntervals.end ());
+      if (--interval->second == 0)
+        {
+          m_lastSeenIntervals.erase (interval);
+        }
+      m_lastSeenIntervals[newInterval]++;
+    }
+}
 
 void
 FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetId, uint32_t packetSize)
@@ -145,11 +335,19 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
-  tracked.firstSeenTime = now;
-  tracked.lastSeenTime = tracked.firstSeenTime;
-  tracked.timesForwarded = 0;
+  if (!IsSampled (packetId))
+    {
+      return;
+    }
+  TrackedPacket *tracked = AddTrackedPacket (flowId, packetId);
+  if (tracked == 0)
+    {
+      NS_LOG_WARN ("Too many tracked packets, not monitoring (flowId=" << flowId << ", packetId=" << packetId
+                                                                    << ").");
+      return;
+    }
+  Time now = tracked->firstSeenTime;
+  tracked->timesForwarded = 0;
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -175,19 +373,22 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
-  if (tracked == m_trackedPackets.end ())
+  if (!IsSampled (packetId))
+    {
+      return;
+    }
+  TrackedPacket *tracked = FindTrackedPacket (flowId, packetId);
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
       return;
     }
 
-  tracked->second.timesForwarded++;
-  tracked->second.lastSeenTime = Simulator::Now ();
+  tracked->timesForwarded++;
+  SetLastSeenTime (*tracked, Simulator::Now ());
 
-  Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
+  Time delay = (Simulator::Now () - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 }
 
@@ -201,8 +402,12 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked == m_trackedPackets.end ())
+  if (!IsSampled (packetId))
+    {
+      return;
+    }
+  TrackedPacket *tracked = FindTrackedPacket (flowId, packetId);
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
@@ -210,7 +415,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     }
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
+  Time delay = (now - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
   FlowStats &stats = GetStatsForFlow (flowId);
@@ -249,12 +454,12 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
+  stats.timesForwarded += tracked->timesForwarded;
 
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  RemoveTrackedPacket (tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -267,6 +472,10 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  if (!IsSampled (packetId))
+    {
+      return;
+    }
 
   probe->AddPacketDropStats (flowId, packetSize, reasonCode);
 
@@ -281,14 +490,14 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked != m_trackedPackets.end ())
+  TrackedPacket *tracked = FindTrackedPacket (flowId, packetId);
+  if (tracked != 0)
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      RemoveTrackedPacket (tracked);
     }
 }
 
@@ -305,24 +514,36 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
   NS_LOG_FUNCTION (this << maxDelay.GetSeconds ());
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // nothing to do unless some packet was last seen maxDelay ago
+  if (m_lastSeenIntervals.empty ()
+      || m_lastSeenIntervals.begin ()->first * PERIODIC_CHECK_INTERVAL.GetTimeStep () > (now - maxDelay).GetTimeStep ())
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      return;
+    }
+
+  for (uint32_t i = 0; i < m_trackedPackets.size (); i++)
+    {
+      // the removal of a packet moves another one into its slot
+      while (m_trackedPackets[i].flowId != 0 && now - m_trackedPackets[i].lastSeenTime >= maxDelay)
         {
           // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
+          NS_ASSERT (m_flowStats.find (m_trackedPackets[i].flowId) != m_flowStats.end ());
+          GetStatsForFlow (m_trackedPackets[i].flowId).lostPackets++;
 
           // we won't track it anymore
-          m_trackedPackets.erase (iter++);
-        }
-      else
-        {
-          iter++;
+          RemoveTrackedPacket (&m_trackedPackets[i]);
         }
     }
+
+  uint32_t size = m_trackedPackets.size ();
+  while (size > MIN_TRACKED_PACKETS_SIZE && 8 * m_nTrackedPackets < size)
+    {
+      size /= 2;
+    }
+  if (size != m_trackedPackets.size ())
+    {
+      ResizeTrackedPackets (size);
+    }
 }
 
 void
@@ -520,6 +741,123 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
   os.close ();
 }
 
+void
+FlowMonitor::StartPeriodicExport (Ptr<OutputStreamWrapper> stream, Time interval, bool purgeFlows)
+{
+  NS_LOG_FUNCTION (this << stream << interval.GetSeconds () << purgeFlows);
+  NS_ABORT_MSG_IF (!interval.IsStrictlyPositive (), "The export interval must be positive");
+  StopPeriodicExport ();
+  m_exportStream = stream;
+  m_exportInterval = interval;
+  m_exportPurgeFlows = purgeFlows;
+  // the first records hold what the flows did before the export started
+  m_exportedFlowStats.clear ();
+  *m_exportStream->GetStream () << "time,flowId,txPackets,txBytes,rxPackets,rxBytes,"
+                                << "lostPackets,timesForwarded,delaySum,jitterSum\n";
+  m_exportEvent = Simulator::Schedule (interval, &FlowMonitor::PeriodicExportFlowStats, this);
+}
+
+void
+FlowMonitor::StopPeriodicExport ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_exportStream == 0)
+    {
+      return;
+    }
+  Simulator::Cancel (m_exportEvent);
+  ExportFlowStats ();
+  m_exportStream = 0;
+  m_exportedFlowStats.clear ();
+}
+
+void
+FlowMonitor::PeriodicExportFlowStats ()
+{
+  ExportFlowStats ();
+  m_exportEvent = Simulator::Schedule (m_exportInterval, &FlowMonitor::PeriodicExportFlowStats, this);
+}
+
+void
+FlowMonitor::ExportFlowStats ()
+{
+  NS_LOG_FUNCTION (this);
+  std::ostream *os = m_exportStream->GetStream ();
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+
+  std::unordered_set<FlowId> inFlight;
+  if (m_exportPurgeFlows)
+    {
+      for (std::vector<TrackedPacket>::const_iterator iter = m_trackedPackets.begin ();
+           iter != m_trackedPackets.end (); iter++)
+        {
+          if (iter->flowId != 0)
+            {
+              inFlight.insert (iter->flowId);
+            }
+        }
+    }
+
+  for (FlowStatsContainerI flowI = m_flowStats.begin (); flowI != m_flowStats.end (); )
+    {
+      const FlowStats &stats = flowI->second;
+      std::pair<std::map<FlowId, ExportedFlowStats>::iterator, bool> insert
+        = m_exportedFlowStats.insert (std::make_pair (flowI->first, ExportedFlowStats ()));
+      ExportedFlowStats &last = insert.first->second;
+      if (insert.second)
+        {
+          last.delaySum = Seconds (0);
+          last.jitterSum = Seconds (0);
+          last.txBytes = 0;
+          last.rxBytes = 0;
+          last.txPackets = 0;
+          last.rxPackets = 0;
+          last.lostPackets = 0;
+          last.timesForwarded = 0;
+        }
+
+      if (stats.txPackets != last.txPackets || stats.rxPackets != last.rxPackets
+          || stats.lostPackets != last.lostPackets)
+        {
+          *os << now << ',' << flowI->first
+              << ',' << stats.txPackets - last.txPackets
+              << ',' << stats.txBytes - last.txBytes
+              << ',' << stats.rxPackets - last.rxPackets
+              << ',' << stats.rxBytes - last.rxBytes
+              << ',' << stats.lostPackets - last.lostPackets
+              << ',' << stats.timesForwarded - last.timesForwarded
+              << ',' << (stats.delaySum - last.delaySum).GetNanoSeconds ()
+              << ',' << (stats.jitterSum - last.jitterSum).GetNanoSeconds ()
+              << '\n';
+          last.delaySum = stats.delaySum;
+          last.jitterSum = stats.jitterSum;
+          last.txBytes = stats.txBytes;
+          last.rxBytes = stats.rxBytes;
+          last.txPackets = stats.txPackets;
+          last.rxPackets = stats.rxPackets;
+          last.lostPackets = stats.lostPackets;
+          last.timesForwarded = stats.timesForwarded;
+        }
+      else if (m_exportPurgeFlows && inFlight.find (flowI->first) == inFlight.end ())
+        {
+          NS_LOG_DEBUG ("Removing idle flow " << flowI->first);
+          if (flowI->first < m_flowStatsIndex.size ())
+            {
+              m_flowStatsIndex[flowI->first] = 0;
+            }
+          for (FlowProbeContainerI probe = m_flowProbes.begin (); probe != m_flowProbes.end (); probe++)
+            {
+              (*probe)->RemoveStats (flowI->first);
+            }
+          m_exportedFlowStats.erase (insert.first);
+          m_flowStats.erase (flowI++);
+          continue;
+        }
+      flowI++;
+    }
+  os->flush ();
+}
+
 
 } // namespace ns3
 
@@ -31,6 +31,7 @@
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
+#include "ns3/output-stream-wrapper.h"
 
 namespace ns3 {
 
@@ -46,6 +47,13 @@ namespace ns3 {
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * The packets in flight are tracked in an open addressing hash table of
+ * 32-byte entries, kept at most half full, so that a tracked packet costs at
+ * most 64 bytes.  The MaxTrackedPackets attribute bounds the number of
+ * tracked packets, and the PacketSampling attribute restricts the monitoring
+ * to one packet out of N in each flow.  The lost packets are searched only
+ * when some packets were last seen before the MaxPerHopDelay, which is known
+ * from the number of tracked packets last seen in each 1 second interval.
  */
 class FlowMonitor : public Object
 {
@@ -258,6 +266,30 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Periodically write to a stream, in CSV format, what each flow did since
+  /// the previous export.  After a header line, there is one record per flow
+  /// that sent, received or lost packets during the interval:
+  /// time,flowId,txPackets,txBytes,rxPackets,rxBytes,lostPackets,timesForwarded,delaySum,jitterSum
+  /// where the times are in nanoseconds, and the other fields are the
+  /// increments of the FlowStats counters.  The stream is flushed after each
+  /// export, so that the records can be followed while the simulation runs.
+  ///
+  /// If purgeFlows is true, the flows that did nothing during the interval
+  /// and have no packet in flight are removed from the FlowMonitor and the
+  /// probes.  This bounds the statistics kept by the FlowMonitor, but not
+  /// the memory used overall: the flow classifiers still keep one entry per
+  /// flow seen in the simulation, so that the FlowIds stay unique.
+  /// GetFlowStats and SerializeToXmlStream then only
+  /// report the active flows, and the statistics of a flow that becomes active
+  /// again restart from zero.
+  /// \param stream the output stream
+  /// \param interval the time between two exports
+  /// \param purgeFlows if true, remove the idle flows after their export
+  void StartPeriodicExport (Ptr<OutputStreamWrapper> stream, Time interval, bool purgeFlows = false);
+
+  /// Write the records of the last interval, and stop the periodic export
+  void StopPeriodicExport ();
+
 
 protected:
 
@@ -271,16 +303,45 @@ private:
   {
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
+    FlowId flowId; //!< flow of the packet, 0 if the entry is free
+    FlowPacketId packetId; //!< identifier of the packet in the flow
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// FlowId --> FlowStats, for the small flow identifiers
+  std::vector<FlowStats *> m_flowStatsIndex;
 
-  /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-  TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /// Counters of a flow at the previous periodic export
+  struct ExportedFlowStats
+  {
+    Time delaySum;           //!< Sum of the delays
+    Time jitterSum;          //!< Sum of the jitters
+    uint64_t txBytes;        //!< Transmitted bytes
+    uint64_t rxBytes;        //!< Received bytes
+    uint32_t txPackets;      //!< Transmitted packets
+    uint32_t rxPackets;      //!< Received packets
+    uint32_t lostPackets;    //!< Lost packets
+    uint32_t timesForwarded; //!< Forwarding count
+  };
+
+  /// FlowId --> counters at the previous periodic export
+  std::map<FlowId, ExportedFlowStats> m_exportedFlowStats;
+  Ptr<OutputStreamWrapper> m_exportStream; //!< Stream of the periodic export
+  Time m_exportInterval;                   //!< Interval of the periodic export
+  bool m_exportPurgeFlows;                 //!< Remove the idle flows after their export
+  EventId m_exportEvent;                   //!< Next periodic export
+
+  /// Tracked packets, an open addressing hash table with linear probing
+  /// keyed by (FlowId,PacketId)
+  std::vector<TrackedPacket> m_trackedPackets;
+  uint32_t m_nTrackedPackets; //!< Number of tracked packets
+  /// Number of tracked packets by interval of their last seen time
+  std::map<int64_t, uint32_t> m_lastSeenIntervals;
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
+  uint32_t m_maxTrackedPackets; //!< Maximum number of tracked packets, 0 if not limited
+  uint32_t m_packetSampling; //!< Monitor one packet out of m_packetSampling in each flow
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
   // note: this is needed only for serialization
@@ -302,6 +363,42 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Write the records of the periodic export
+  void ExportFlowStats ();
+
+  /// Periodic function to export the flow statistics
+  void PeriodicExportFlowStats ();
+
+  /// Is a packet monitored, with the sampling?
+  /// \param packetId the packet identifier
+  /// \returns true if the packet is monitored
+  bool IsSampled (FlowPacketId packetId) const;
+
+  /// Find a tracked packet
+  /// \param flowId the flow identification
+  /// \param packetId the packet identifier
+  /// \returns the tracked packet, or 0 if the packet is not tracked
+  TrackedPacket* FindTrackedPacket (FlowId flowId, FlowPacketId packetId);
+
+  /// Start tracking a packet, or find it if it is already tracked
+  /// \param flowId the flow identification
+  /// \param packetId the packet identifier
+  /// \returns the tracked packet, or 0 if MaxTrackedPackets are tracked
+  TrackedPacket* AddTrackedPacket (FlowId flowId, FlowPacketId packetId);
+
+  /// Stop tracking a packet
+  /// \param tracked the tracked packet
+  void RemoveTrackedPacket (TrackedPacket *tracked);
+
+  /// Resize the table of the tracked packets
+  /// \param size the new number of entries, a power of two
+  void ResizeTrackedPackets (uint32_t size);
+
+  /// Update the last seen time of a tracked packet
+  /// \param tracked the tracked packet
+  /// \param now the current time
+  void SetLastSeenTime (TrackedPacket &tracked, Time now);
 };
 
 
@@ -96,6 +96,16 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 
 
 
+size_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &t) const
+{
+  Ipv4AddressHash addressHash;
+  size_t h = addressHash (t.sourceAddress);
+  h = h * 31 + addressHash (t.destinationAddress);
+  h = h * 31 + t.protocol;
+  return h * 31 + ((static_cast<uint32_t> (t.sourcePort) << 16) | t.destinationPort);
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
 }
@@ -148,35 +158,45 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-    = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
+  std::pair<std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::iterator, bool> insert
+    = m_flowMap.insert (std::make_pair (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
+  FlowInfo *flow;
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
+      NS_ASSERT (newFlowId == m_flows.size () + 1);
       insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      m_flows.push_back (FlowInfo ());
+      flow = &m_flows.back ();
+      flow->tuple = tuple;
+      flow->lastPacketId = 0;
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      flow = &m_flows[insert.first->second - 1];
+      flow->lastPacketId++;
     }
 
   // increment the counter of packets with the same DSCP value
   Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >::iterator counter = flow->dscpCounts.begin ();
+  while (counter != flow->dscpCounts.end () && counter->first < dscp)
+    {
+      counter++;
+    }
+  if (counter != flow->dscpCounts.end () && counter->first == dscp)
+    {
+      counter->second++;
+    }
+  else
     {
-      m_flowDscpMap[insert.first->second][dscp] ++;
+      flow->dscpCounts.insert (counter, std::make_pair (dscp, 1));
     }
 
   *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_packetId = flow->lastPacketId;
 
   return true;
 }
@@ -185,17 +205,11 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
-  return retval;
+  return m_flows[flowId - 1].tuple;
 }
 
 bool
@@ -208,16 +222,13 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
-  std::sort (v.begin (), v.end (), SortByCount ());
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (m_flows[flowId - 1].dscpCounts);
+  std::stable_sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
 
@@ -227,29 +238,23 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::vector<FlowInfo>::const_iterator iter = m_flows.begin (); iter != m_flows.end (); iter++)
     {
       Indent (os, indent);
-      os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+      os << "<Flow flowId=\"" << iter - m_flows.begin () + 1 << "\""
+         << " sourceAddress=\"" << iter->tuple.sourceAddress << "\""
+         << " destinationAddress=\"" << iter->tuple.destinationAddress << "\""
+         << " protocol=\"" << int(iter->tuple.protocol) << "\""
+         << " sourcePort=\"" << iter->tuple.sourcePort << "\""
+         << " destinationPort=\"" << iter->tuple.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      for (std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >::const_iterator i = iter->dscpCounts.begin ();
+           i != iter->dscpCounts.end (); i++)
         {
-          for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
@@ -22,7 +22,8 @@
 #define IPV4_FLOW_CLASSIFIER_H
 
 #include <stdint.h>
-#include <map>
+#include <vector>
+#include <unordered_map>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
@@ -49,6 +50,16 @@ public:
     uint16_t destinationPort;       //!< Destination port
   };
 
+  /// Hash function of the five-tuples
+  class FiveTupleHash
+  {
+  public:
+    /// Hash function
+    /// \param t the five-tuple
+    /// \return the hash of the five-tuple
+    size_t operator() (const FiveTuple &t) const;
+  };
+
   Ipv4FlowClassifier ();
 
   /// \brief try to classify the packet into flow-id and packet-id
@@ -92,12 +103,19 @@ public:
 
 private:
 
+  /// State of a flow
+  struct FlowInfo
+  {
+    FiveTuple tuple;            //!< Five-tuple of the flow
+    FlowPacketId lastPacketId;  //!< Identifier of the last packet
+    /// (DSCP value, packet count) pairs, sorted by DSCP value
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > dscpCounts;
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// Flows, indexed by FlowId - 1
+  std::vector<FlowInfo> m_flows;
 
 };
 
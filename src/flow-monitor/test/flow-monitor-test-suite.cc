@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/test.h"
+#include <sstream>
+
+using namespace ns3;
+
+static const uint32_t N_FLOWS = 100; //!< Number of flows of the test
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowProbe reporting the packets of the test
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor packet tracking test
+ *
+ * Sends packets of many flows through a FlowMonitor, and checks the
+ * received, dropped and lost packet counters, with and without sampling and
+ * limit on the number of tracked packets.
+ */
+class FlowMonitorTrackingTestCase : public TestCase
+{
+public:
+  FlowMonitorTrackingTestCase ();
+
+private:
+  /**
+   * \brief Report the transmission of packets.
+   * \param monitor the FlowMonitor
+   * \param probe the probe
+   * \param first the first packet identifier
+   * \param last the last packet identifier (excluded)
+   */
+  void Send (Ptr<FlowMonitor> monitor, Ptr<FlowProbe> probe, FlowPacketId first, FlowPacketId last);
+  /**
+   * \brief Report the reception or drop of the packets of a flow.
+   * \param monitor the FlowMonitor
+   * \param probe the probe
+   * \param flowId the flow
+   * \param first the first packet identifier
+   * \param last the last packet identifier (excluded)
+   * \param drop true to drop the packets
+   */
+  void Receive (Ptr<FlowMonitor> monitor, Ptr<FlowProbe> probe, FlowId flowId,
+                FlowPacketId first, FlowPacketId last, bool drop);
+  virtual void DoRun (void);
+};
+
+FlowMonitorTrackingTestCase::FlowMonitorTrackingTestCase ()
+  : TestCase ("FlowMonitor packet tracking")
+{
+}
+
+void
+FlowMonitorTrackingTestCase::Send (Ptr<FlowMonitor> monitor, Ptr<FlowProbe> probe,
+                                   FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId packetId = first; packetId < last; packetId++)
+    {
+      for (FlowId flowId = 1; flowId <= N_FLOWS; flowId++)
+        {
+          monitor->ReportFirstTx (probe, flowId, packetId, 100);
+        }
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::Receive (Ptr<FlowMonitor> monitor, Ptr<FlowProbe> probe, FlowId flowId,
+                                      FlowPacketId first, FlowPacketId last, bool drop)
+{
+  for (FlowPacketId packetId = first; packetId < last; packetId++)
+    {
+      if (drop)
+        {
+          monitor->ReportDrop (probe, flowId, packetId, 100, 1);
+        }
+      else
+        {
+          monitor->ReportForwarding (probe, flowId, packetId, 100);
+          monitor->ReportLastRx (probe, flowId, packetId, 100);
+        }
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::DoRun (void)
+{
+  // packets 0-99 sent at 0 s, packets 100-199 at 5 s; flow 1 receives the
+  // packets 0-49 and drops the packets 50-59 at 1 s, the other ones are lost
+  // after the MaxPerHopDelay (10 s) if they are not received at 12 s
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  Send (monitor, probe, 0, 100);
+  Simulator::Schedule (Seconds (1), &FlowMonitorTrackingTestCase::Receive, this, monitor, probe, 1, 0, 50, false);
+  Simulator::Schedule (Seconds (1), &FlowMonitorTrackingTestCase::Receive, this, monitor, probe, 1, 50, 60, true);
+  Simulator::Schedule (Seconds (5), &FlowMonitorTrackingTestCase::Send, this, monitor, probe, 100, 200);
+  Simulator::Schedule (Seconds (12), &FlowMonitorTrackingTestCase::Receive, this, monitor, probe, 2, 0, 200, false);
+  Simulator::Stop (Seconds (13));
+  Simulator::Run ();
+
+  const FlowMonitor::FlowStatsContainer &stats = monitor->GetFlowStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), N_FLOWS, "Wrong number of flows");
+  FlowMonitor::FlowStatsContainerCI flow1 = stats.find (1);
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.txPackets, 200, "Wrong number of packets sent");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.rxPackets, 50, "Wrong number of packets received");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.delaySum, Seconds (50), "Wrong delay");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.timesForwarded, 50, "Wrong number of forwards");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.packetsDropped.size (), 2, "Wrong drop reasons");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.packetsDropped[1], 10, "Wrong number of packets dropped");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.lostPackets, 50, "Wrong number of packets lost");
+  // flow 2 received the packets sent at 5 s, not the ones lost at 10 s
+  FlowMonitor::FlowStatsContainerCI flow2 = stats.find (2);
+  NS_TEST_ASSERT_MSG_EQ (flow2->second.rxPackets, 100, "Wrong number of packets received");
+  NS_TEST_ASSERT_MSG_EQ (flow2->second.lostPackets, 100, "Wrong number of packets lost");
+  NS_TEST_ASSERT_MSG_EQ (stats.find (N_FLOWS)->second.lostPackets, 100, "Wrong number of packets lost");
+
+  monitor->CheckForLostPackets (Seconds (0));
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.lostPackets, 150, "Wrong number of packets lost");
+  NS_TEST_ASSERT_MSG_EQ (flow2->second.lostPackets, 100, "Wrong number of packets lost");
+  NS_TEST_ASSERT_MSG_EQ (stats.find (N_FLOWS)->second.lostPackets, 200, "Wrong number of packets lost");
+  Simulator::Destroy ();
+
+  // one packet out of 4 is monitored
+  monitor = CreateObject<FlowMonitor> ();
+  monitor->SetAttribute ("PacketSampling", UintegerValue (4));
+  probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  Send (monitor, probe, 0, 100);
+  Receive (monitor, probe, 1, 0, 50, false);
+  monitor->CheckForLostPackets (Seconds (0));
+  flow1 = monitor->GetFlowStats ().find (1);
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.txPackets, 25, "Wrong number of sampled packets sent");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.rxPackets, 13, "Wrong number of sampled packets received");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.lostPackets, 12, "Wrong number of sampled packets lost");
+  Simulator::Destroy ();
+
+  // the packets sent while MaxTrackedPackets are in flight are not monitored
+  monitor = CreateObject<FlowMonitor> ();
+  monitor->SetAttribute ("MaxTrackedPackets", UintegerValue (150));
+  probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  Send (monitor, probe, 0, 2);
+  Receive (monitor, probe, 1, 0, 2, false);
+  Send (monitor, probe, 2, 3);
+  flow1 = monitor->GetFlowStats ().find (1);
+  FlowMonitor::FlowStatsContainerCI flowN = monitor->GetFlowStats ().find (N_FLOWS);
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.txPackets, 3, "Wrong number of packets sent");
+  NS_TEST_ASSERT_MSG_EQ (flow1->second.rxPackets, 2, "Wrong number of packets received");
+  NS_TEST_ASSERT_MSG_EQ (flowN->second.txPackets, 1, "Packet sent beyond MaxTrackedPackets");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor periodic export test
+ *
+ * Checks the records of the periodic export, and the removal of the idle
+ * flows.
+ */
+class FlowMonitorExportTestCase : public TestCase
+{
+public:
+  FlowMonitorExportTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorExportTestCase::FlowMonitorExportTestCase ()
+  : TestCase ("FlowMonitor periodic export")
+{
+}
+
+void
+FlowMonitorExportTestCase::DoRun (void)
+{
+  // flows 1 and 2 send two packets at 0.5 s, received at 1.5 s, and flow 1
+  // sends one more packet at 3.5 s, lost at 13.5 s
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  std::ostringstream oss;
+  monitor->StartPeriodicExport (Create<OutputStreamWrapper> (&oss), Seconds (1), true);
+  for (FlowId flowId = 1; flowId <= 2; flowId++)
+    {
+      for (FlowPacketId packetId = 0; packetId < 2; packetId++)
+        {
+          Simulator::Schedule (MilliSeconds (500), &FlowMonitor::ReportFirstTx, monitor, probe, flowId, packetId, 100);
+          Simulator::Schedule (MilliSeconds (1500), &FlowMonitor::ReportLastRx, monitor, probe, flowId, packetId, 100);
+        }
+    }
+  Simulator::Schedule (MilliSeconds (3500), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 2, 100);
+  Simulator::Stop (Seconds (15));
+  Simulator::Run ();
+  monitor->StopPeriodicExport ();
+
+  std::string expected =
+    "time,flowId,txPackets,txBytes,rxPackets,rxBytes,lostPackets,timesForwarded,delaySum,jitterSum\n"
+    "1000000000,1,2,200,0,0,0,0,0,0\n"
+    "1000000000,2,2,200,0,0,0,0,0,0\n"
+    "2000000000,1,0,0,2,200,0,0,2000000000,0\n"
+    "2000000000,2,0,0,2,200,0,0,2000000000,0\n"
+    "4000000000,1,1,100,0,0,0,0,0,0\n"
+    "14000000000,1,0,0,0,0,1,0,0,0\n";
+  NS_TEST_ASSERT_MSG_EQ (oss.str (), expected, "Wrong export");
+  // both flows were idle at 15 s
+  NS_TEST_ASSERT_MSG_EQ (monitor->GetFlowStats ().size (), 0, "Idle flows not removed");
+  NS_TEST_ASSERT_MSG_EQ (probe->GetStats ().size (), 0, "Idle flows not removed from the probe");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowMonitorTrackingTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorExportTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
@@ -82,6 +82,10 @@ public:
    * Users must first call PopulateRoutingTables() and then may subsequently
    * call RecomputeRoutingTables() at any later time in the simulation.
    *
+   * Only the routers whose SPF tree may have changed since the routes were
+   * computed have their routes removed and recomputed, see
+   * GlobalRouteManager::UpdateRoutes().
+   *
    */
   static void RecomputeRoutingTables (void);
 private:
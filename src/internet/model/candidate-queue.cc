@@ -66,7 +66,8 @@ operator<< (std::ostream& os, const CandidateQueue& q)
 }
 
 CandidateQueue::CandidateQueue()
-  : m_candidates ()
+  : m_candidates (&CandidateQueue::CompareSPFVertex),
+    m_index ()
 {
   NS_LOG_FUNCTION (this);
 }
@@ -94,11 +95,9 @@ CandidateQueue::Push (SPFVertex *vNew)
 {
   NS_LOG_FUNCTION (this << vNew);
 
-  CandidateList_t::iterator i = std::upper_bound (
-      m_candidates.begin (), m_candidates.end (), vNew,
-      &CandidateQueue::CompareSPFVertex
-      );
-  m_candidates.insert (i, vNew);
+  // equivalent vertices are inserted after the ones already queued
+  CandidateList_t::iterator i = m_candidates.insert (vNew);
+  m_index[vNew->GetVertexId ()] = i;
 }
 
 SPFVertex *
@@ -110,8 +109,9 @@ CandidateQueue::Pop (void)
       return 0;
     }
 
-  SPFVertex *v = m_candidates.front ();
-  m_candidates.pop_front ();
+  SPFVertex *v = *m_candidates.begin ();
+  m_candidates.erase (m_candidates.begin ());
+  m_index.erase (v->GetVertexId ());
   return v;
 }
 
@@ -124,7 +124,7 @@ CandidateQueue::Top (void) const
       return 0;
     }
 
-  return m_candidates.front ();
+  return *m_candidates.begin ();
 }
 
 bool
@@ -145,18 +145,12 @@ SPFVertex *
 CandidateQueue::Find (const Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this);
-  CandidateList_t::const_iterator i = m_candidates.begin ();
-
-  for (; i != m_candidates.end (); i++)
+  CandidateIndex_t::const_iterator i = m_index.find (addr);
+  if (i == m_index.end ())
     {
-      SPFVertex *v = *i;
-      if (v->GetVertexId () == addr)
-        {
-          return v;
-        }
+      return 0;
     }
-
-  return 0;
+  return *i->second;
 }
 
 void
@@ -164,7 +158,29 @@ CandidateQueue::Reorder (void)
 {
   NS_LOG_FUNCTION (this);
 
-  m_candidates.sort (&CandidateQueue::CompareSPFVertex);
+  // re-inserting the vertices in their current order keeps the order of the
+  // equivalent ones, as a stable sort would
+  CandidateList_t candidates (&CandidateQueue::CompareSPFVertex);
+  for (CandidateList_t::iterator i = m_candidates.begin (); i != m_candidates.end (); i++)
+    {
+      m_index[(*i)->GetVertexId ()] = candidates.insert (candidates.end (), *i);
+    }
+  m_candidates.swap (candidates);
+  NS_LOG_LOGIC ("After reordering the CandidateQueue");
+  NS_LOG_LOGIC (*this);
+}
+
+void
+CandidateQueue::Reorder (SPFVertex *v)
+{
+  NS_LOG_FUNCTION (this << v);
+
+  CandidateIndex_t::iterator i = m_index.find (v->GetVertexId ());
+  NS_ASSERT_MSG (i != m_index.end () && *i->second == v, "Vertex not in the CandidateQueue");
+  // erasing by iterator does not compare the vertices, so the vertex can be
+  // removed even though its distance is no longer consistent with its place
+  m_candidates.erase (i->second);
+  i->second = m_candidates.insert (v);
   NS_LOG_LOGIC ("After reordering the CandidateQueue");
   NS_LOG_LOGIC (*this);
 }
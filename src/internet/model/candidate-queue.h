@@ -22,7 +22,8 @@
 #define CANDIDATE_QUEUE_H
 
 #include <stdint.h>
-#include <list>
+#include <set>
+#include <unordered_map>
 #include "ns3/ipv4-address.h"
 
 namespace ns3 {
@@ -47,6 +48,11 @@ class SPFVertex;
  * for a Find () operation, the dynamic nature of the data and the derived
  * requirement for a Reorder () operation led us to implement this simple 
  * enhanced priority queue.
+ *
+ * The vertices are kept in an ordered multiset, and indexed by vertex ID, so
+ * that Push, Pop, Find and Reorder (v) are logarithmic or constant in the
+ * number of candidates.  Vertices at the same distance are popped in the
+ * order they were pushed, network vertices first.
  */
 class CandidateQueue
 {
@@ -154,6 +160,16 @@ public:
  */
   void Reorder (void);
 
+/**
+ * @brief Reorders the Candidate Queue after the distance of one of its
+ * vertices decreased.
+ * This is the same as Reorder (), without re-sorting the vertices whose
+ * distance did not change.
+ * @see SPFVertex
+ * @param v The vertex whose m_distanceFromRoot changed.
+ */
+  void Reorder (SPFVertex *v);
+
 private:
 /**
  * Candidate Queue copy construction is disallowed (not implemented) to 
@@ -184,8 +200,13 @@ private:
  */
   static bool CompareSPFVertex (const SPFVertex* v1, const SPFVertex* v2);
 
-  typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
+  /// Ordering of the SPFVertex pointers in the queue
+  typedef bool (*CompareSPFVertex_t)(const SPFVertex*, const SPFVertex*);
+  typedef std::multiset<SPFVertex*, CompareSPFVertex_t> CandidateList_t; //!< container of SPFVertex pointers
+  /// SPFVertex candidates by vertex ID
+  typedef std::unordered_map<Ipv4Address, CandidateList_t::iterator, Ipv4AddressHash> CandidateIndex_t;
   CandidateList_t m_candidates;  //!< SPFVertex candidates
+  CandidateIndex_t m_index;      //!< Index of m_candidates by vertex ID
 
   /**
    * \brief Stream insertion operator.
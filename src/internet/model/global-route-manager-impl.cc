@@ -34,6 +34,14 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4-list-routing.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <unistd.h>
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#endif /* HAVE_PTHREAD_H */
 #include "global-router-interface.h"
 #include "global-route-manager-impl.h"
 #include "candidate-queue.h"
@@ -43,6 +51,20 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * \brief Number of threads computing the SPF trees of the routers.
+ *
+ * The routing tables do not depend on the number of threads.  The logging
+ * is not thread safe, so the calculations run in the simulation thread
+ * while the log components they use are enabled.
+ */
+static GlobalValue g_spfThreads ("GlobalRoutingSpfThreads",
+                                 "The number of threads computing the SPF trees of the "
+                                 "global routers, 0 for one thread per processor.",
+                                 UintegerValue (1),
+                                 MakeUintegerChecker<uint32_t> ());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -422,6 +444,7 @@ SPFVertex::ClearVertexProcessed (void)
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB ()
   :
     m_database (),
+    m_linkData (),
     m_extdatabase ()
 {
   NS_LOG_FUNCTION (this);
@@ -469,7 +492,25 @@ GlobalRouteManagerLSDB::Insert (Ipv4Address addr, GlobalRoutingLSA* lsa)
     } 
   else
     {
-      m_database.insert (LSDBPair_t (addr, lsa));
+      if (!m_database.insert (LSDBPair_t (addr, lsa)).second)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              continue;
+            }
+          // GetLSAByLinkData returns the LSA with the lowest link state ID
+          // when several of them match
+          LinkDataMap_t::iterator i = m_linkData.find (lr->GetLinkData ());
+          if (i == m_linkData.end () || addr < i->second->GetLinkStateId ())
+            {
+              m_linkData[lr->GetLinkData ()] = lsa;
+            }
+        }
     }
 }
 
@@ -494,15 +535,12 @@ GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 //
 // Look up an LSA by its address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LSDBMap_t::const_iterator i = m_database.find (addr);
+  if (i == m_database.end ())
     {
-      if (i->first == addr)
-        {
-          return i->second;
-        }
+      return 0;
     }
-  return 0;
+  return i->second;
 }
 
 GlobalRoutingLSA*
@@ -510,24 +548,168 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this << addr);
 //
-// Look up an LSA by its address.
+// Look up an LSA by the link data of its TransitNetwork link records.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LinkDataMap_t::const_iterator i = m_linkData.find (addr);
+  if (i == m_linkData.end ())
     {
-      GlobalRoutingLSA* temp = i->second;
-// Iterate among temp's Link Records
-      for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
+      return 0;
+    }
+  return i->second;
+}
+
+//
+// Two LSAs are the same if they would yield the same SPF trees and routes.
+// The SPF status is not compared.
+//
+static bool
+IsSameLSA (const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+  if (a->GetLSType () != b->GetLSType ()
+      || a->GetLinkStateId () != b->GetLinkStateId ()
+      || a->GetAdvertisingRouter () != b->GetAdvertisingRouter ()
+      || a->GetNetworkLSANetworkMask () != b->GetNetworkLSANetworkMask ()
+      || a->GetNLinkRecords () != b->GetNLinkRecords ()
+      || a->GetNAttachedRouters () != b->GetNAttachedRouters ())
+    {
+      return false;
+    }
+  for (uint32_t j = 0; j < a->GetNLinkRecords (); j++)
+    {
+      GlobalRoutingLinkRecord *la = a->GetLinkRecord (j);
+      GlobalRoutingLinkRecord *lb = b->GetLinkRecord (j);
+      if (la->GetLinkType () != lb->GetLinkType ()
+          || la->GetLinkId () != lb->GetLinkId ()
+          || la->GetLinkData () != lb->GetLinkData ()
+          || la->GetMetric () != lb->GetMetric ())
+        {
+          return false;
+        }
+    }
+  for (uint32_t j = 0; j < a->GetNAttachedRouters (); j++)
+    {
+      if (a->GetAttachedRouter (j) != b->GetAttachedRouter (j))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+GlobalRouteManagerLSDB::GetChangedLSAs (const GlobalRouteManagerLSDB* lsdb,
+                                        std::set<Ipv4Address>& changed) const
+{
+  NS_LOG_FUNCTION (this << lsdb);
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      GlobalRoutingLSA* other = lsdb->GetLSA (i->first);
+      if (other == 0 || !IsSameLSA (i->second, other))
+        {
+          changed.insert (i->first);
+        }
+    }
+  for (LSDBMap_t::const_iterator i = lsdb->m_database.begin (); i != lsdb->m_database.end (); i++)
+    {
+      if (GetLSA (i->first) == 0)
+        {
+          changed.insert (i->first);
+        }
+    }
+}
+
+bool
+GlobalRouteManagerLSDB::HasSameExtLSAs (const GlobalRouteManagerLSDB* lsdb) const
+{
+  NS_LOG_FUNCTION (this << lsdb);
+  if (m_extdatabase.size () != lsdb->m_extdatabase.size ())
+    {
+      return false;
+    }
+  for (uint32_t j = 0; j < m_extdatabase.size (); j++)
+    {
+      if (!IsSameLSA (m_extdatabase[j], lsdb->m_extdatabase[j]))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+/// Disjoint sets of LSAs: the parent of each LSA, the roots are their own parent
+typedef std::unordered_map<const GlobalRoutingLSA*, const GlobalRoutingLSA*> LSASets_t;
+
+//
+// Find the root of the set of an LSA, compressing the path to it.
+//
+static const GlobalRoutingLSA*
+FindLSASet (LSASets_t& sets, const GlobalRoutingLSA* lsa)
+{
+  const GlobalRoutingLSA* root = lsa;
+  while (sets[root] != root)
+    {
+      root = sets[root];
+    }
+  while (lsa != root)
+    {
+      const GlobalRoutingLSA* next = sets[lsa];
+      sets[lsa] = root;
+      lsa = next;
+    }
+  return root;
+}
+
+void
+GlobalRouteManagerLSDB::GetComponents (std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>& components) const
+{
+  NS_LOG_FUNCTION (this);
+//
+// Merge the sets of the LSAs along the links SPFNext () may follow.
+//
+  LSASets_t sets;
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      sets[i->second] = i->second;
+    }
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      GlobalRoutingLSA* lsa = i->second;
+      std::vector<const GlobalRoutingLSA*> neighbors;
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint
+              || lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              neighbors.push_back (GetLSA (lr->GetLinkId ()));
+            }
+        }
+      for (uint32_t j = 0; j < lsa->GetNAttachedRouters (); j++)
         {
-          GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
-          if ( lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork &&
-               lr->GetLinkData () == addr)
+          neighbors.push_back (GetLSAByLinkData (lsa->GetAttachedRouter (j)));
+        }
+      for (uint32_t j = 0; j < neighbors.size (); j++)
+        {
+          if (neighbors[j] != 0)
             {
-              return temp;
+              sets[FindLSASet (sets, lsa)] = FindLSASet (sets, neighbors[j]);
             }
         }
     }
-  return 0;
+//
+// Number the sets.
+//
+  std::unordered_map<const GlobalRoutingLSA*, uint32_t> labels;
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      const GlobalRoutingLSA* root = FindLSASet (sets, i->second);
+      std::unordered_map<const GlobalRoutingLSA*, uint32_t>::iterator label = labels.find (root);
+      if (label == labels.end ())
+        {
+          label = labels.insert (std::make_pair (root, labels.size ())).first;
+        }
+      components[i->first] = label->second;
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -536,9 +718,24 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 //
 // ---------------------------------------------------------------------------
 
+GlobalRouteManagerImpl::SPFContext::SPFContext (Ipv4Address root)
+  : m_root (root),
+    m_spfroot (0),
+    m_checkStub (true),
+    m_stub (false),
+    m_neighbor (),
+    m_interfaces (),
+    m_status (),
+    m_routes (),
+    m_routing (0)
+{
+}
+
 GlobalRouteManagerImpl::GlobalRouteManagerImpl () 
   :
-    m_spfroot (0)
+    m_routesValid (false),
+    m_spfNext (0),
+    m_spfMutex (0)
 {
   NS_LOG_FUNCTION (this);
   m_lsdb = new GlobalRouteManagerLSDB ();
@@ -562,6 +759,7 @@ GlobalRouteManagerImpl::DebugUseLsdb (GlobalRouteManagerLSDB* lsdb)
       delete m_lsdb;
     }
   m_lsdb = lsdb;
+  m_routesValid = false;
 }
 
 void
@@ -577,19 +775,8 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
         {
           continue;
         }
-      Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-      uint32_t j = 0;
-      uint32_t nRoutes = gr->GetNRoutes ();
-      NS_LOG_LOGIC ("Deleting " << gr->GetNRoutes ()<< " routes from node " << node->GetId ());
-      // Each time we delete route 0, the route index shifts downward
-      // We can delete all routes if we delete the route numbered 0
-      // nRoutes times
-      for (j = 0; j < nRoutes; j++)
-        {
-          NS_LOG_LOGIC ("Deleting global route " << j << " from node " << node->GetId ());
-          gr->RemoveRoute (0);
-        }
-      NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
+      NS_LOG_LOGIC ("Deleting routes from node " << node->GetId ());
+      DeleteRoutes (router->GetRoutingProtocol ());
     }
   if (m_lsdb)
     {
@@ -597,6 +784,24 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
       delete m_lsdb;
       m_lsdb = new GlobalRouteManagerLSDB ();
     }
+  m_routesValid = false;
+  m_roots.clear ();
+}
+
+void
+GlobalRouteManagerImpl::DeleteRoutes (Ptr<Ipv4GlobalRouting> gr)
+{
+  NS_LOG_FUNCTION (this << gr);
+  uint32_t j = 0;
+  uint32_t nRoutes = gr->GetNRoutes ();
+  // Each time we delete route 0, the route index shifts downward
+  // We can delete all routes if we delete the route numbered 0
+  // nRoutes times
+  for (j = 0; j < nRoutes; j++)
+    {
+      gr->RemoveRoute (0);
+    }
+  NS_LOG_LOGIC ("Deleted " << j << " global routes");
 }
 
 //
@@ -699,6 +904,7 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 // Walk the list of nodes in the system.
 //
   NS_LOG_INFO ("About to start SPF calculation");
+  std::vector<SPFContext*> contexts;
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
@@ -723,12 +929,284 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 //
       if (rtr && rtr->GetNumLSAs () )
         {
-          SPFCalculate (rtr->GetRouterId ());
+          contexts.push_back (CreateSPFContext (rtr->GetRouterId (), node));
         }
     }
+  m_roots.clear ();
+  RunSPFCalculations (contexts);
+  m_routesValid = true;
   NS_LOG_INFO ("Finished SPF calculation");
 }
 
+//
+// Incremental version of DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+// and InitializeRoutes (), used when the topology changes during the
+// simulation.
+//
+// The routes of a root are computed from the LSAs of its SPF tree, which are
+// all in its connected component, and, for a stub root, from its own LSA
+// and the one of its neighbor.  When none of these LSAs changed, the routes
+// of the root are still valid.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_routesValid)
+    {
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      InitializeRoutes ();
+      return;
+    }
+
+  GlobalRouteManagerLSDB* old = m_lsdb;
+  m_lsdb = new GlobalRouteManagerLSDB ();
+  BuildGlobalRoutingDatabase ();
+
+  bool sameExternals = m_lsdb->HasSameExtLSAs (old);
+  std::set<Ipv4Address> changed;
+  m_lsdb->GetChangedLSAs (old, changed);
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> components;
+  old->GetComponents (components);
+  std::set<uint32_t> changedComponents;
+  for (std::set<Ipv4Address>::const_iterator i = changed.begin (); i != changed.end (); i++)
+    {
+      std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator c = components.find (*i);
+      if (c != components.end ())
+        {
+          changedComponents.insert (c->second);
+        }
+    }
+  delete old;
+  NS_LOG_LOGIC (changed.size () << " LSAs changed in " << changedComponents.size () << " components");
+
+  std::vector<SPFContext*> contexts;
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      if (rtr == 0 || node->GetSystemId () != Simulator::GetSystemId ())
+        {
+          continue;
+        }
+      Ipv4Address root = rtr->GetRouterId ();
+      std::map<Ipv4Address, SPFRootState>::iterator state = m_roots.find (root);
+      bool affected = !sameExternals || changed.count (root) || state == m_roots.end ();
+      if (!affected && state->second.m_stub)
+        {
+          affected = changed.count (state->second.m_neighbor);
+        }
+      else if (!affected)
+        {
+          std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator c = components.find (root);
+          affected = c == components.end () || changedComponents.count (c->second);
+        }
+      if (!affected)
+        {
+          // the outgoing interfaces are found among the addresses of the root
+          std::vector<std::vector<Ipv4Address> > interfaces;
+          GetInterfaceAddresses (node, interfaces);
+          affected = interfaces != state->second.m_interfaces;
+        }
+      if (!affected)
+        {
+          continue;
+        }
+      NS_LOG_LOGIC ("Recomputing the routes of node " << node->GetId ());
+      if (state != m_roots.end ())
+        {
+          m_roots.erase (state);
+        }
+      DeleteRoutes (rtr->GetRoutingProtocol ());
+      if (rtr->GetNumLSAs ())
+        {
+          contexts.push_back (CreateSPFContext (root, node));
+        }
+    }
+  NS_LOG_INFO ("Recomputing " << contexts.size () << " SPF trees");
+  RunSPFCalculations (contexts);
+}
+
+GlobalRouteManagerImpl::SPFContext*
+GlobalRouteManagerImpl::CreateSPFContext (Ipv4Address root, Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << root << node);
+  SPFContext* ctx = new SPFContext (root);
+  if (node == 0)
+    {
+      return ctx;
+    }
+  Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
+  NS_ASSERT (router);
+  ctx->m_routing = router->GetRoutingProtocol ();
+  NS_ASSERT (ctx->m_routing);
+//
+// The SPF calculation looks up the outgoing interfaces among the addresses
+// of the root.  Copy them, the worker threads must not touch the node.
+//
+  GetInterfaceAddresses (node, ctx->m_interfaces);
+  return ctx;
+}
+
+void
+GlobalRouteManagerImpl::GetInterfaceAddresses (Ptr<Node> node, std::vector<std::vector<Ipv4Address> >& interfaces) const
+{
+  NS_LOG_FUNCTION (this << node);
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::GetInterfaceAddresses (): "
+                 "GetObject for <Ipv4> interface failed");
+  interfaces.resize (ipv4->GetNInterfaces ());
+  for (uint32_t i = 0; i < ipv4->GetNInterfaces (); i++)
+    {
+      interfaces[i].clear ();
+      for (uint32_t j = 0; j < ipv4->GetNAddresses (i); j++)
+        {
+          interfaces[i].push_back (ipv4->GetAddress (i, j).GetLocal ());
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::RunSPFCalculations (std::vector<SPFContext*>& contexts)
+{
+  NS_LOG_FUNCTION (this << contexts.size ());
+  uint32_t nThreads = 1;
+#ifdef HAVE_PTHREAD_H
+  UintegerValue threads;
+  g_spfThreads.GetValue (threads);
+  nThreads = threads.Get ();
+  if (nThreads == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = nProcessors > 0 ? nProcessors : 1;
+    }
+  nThreads = std::min<uint32_t> (nThreads, contexts.size ());
+  if (nThreads > 1 && IsSPFLogEnabled ())
+    {
+      NS_LOG_LOGIC ("Logging enabled, running the SPF calculations in the simulation thread");
+      nThreads = 1;
+    }
+  if (nThreads > 1)
+    {
+      NS_LOG_LOGIC ("Running " << contexts.size () << " SPF calculations on " << nThreads << " threads");
+      SystemMutex mutex;
+      m_spfMutex = &mutex;
+      m_spfQueue = contexts;
+      m_spfNext = 0;
+      std::vector<Ptr<SystemThread> > workers;
+      for (uint32_t i = 0; i < nThreads; i++)
+        {
+          workers.push_back (Create<SystemThread> (MakeCallback (&GlobalRouteManagerImpl::SPFWorker, this)));
+          workers.back ()->Start ();
+        }
+      for (uint32_t i = 0; i < nThreads; i++)
+        {
+          workers[i]->Join ();
+        }
+      m_spfQueue.clear ();
+      m_spfMutex = 0;
+    }
+#endif /* HAVE_PTHREAD_H */
+//
+// The routes are installed in the order of the roots, from this thread, so
+// the routing tables do not depend on the number of threads.
+//
+  for (uint32_t i = 0; i < contexts.size (); i++)
+    {
+      if (nThreads <= 1)
+        {
+          SPFCalculate (*contexts[i]);
+        }
+      InstallRoutes (*contexts[i]);
+      SPFRootState& state = m_roots[contexts[i]->m_root];
+      state.m_stub = contexts[i]->m_stub;
+      state.m_neighbor = contexts[i]->m_neighbor;
+      state.m_interfaces.swap (contexts[i]->m_interfaces);
+      delete contexts[i];
+    }
+  contexts.clear ();
+}
+
+bool
+GlobalRouteManagerImpl::IsSPFLogEnabled (void)
+{
+//
+// The SPF calculations log through these components, whose output would be
+// written concurrently by the worker threads.
+//
+  static const char* names[] = { "GlobalRouteManagerImpl", "GlobalRouter", "CandidateQueue" };
+  LogComponent::ComponentList* components = LogComponent::GetComponentList ();
+  for (uint32_t i = 0; i < sizeof (names) / sizeof (names[0]); i++)
+    {
+      LogComponent::ComponentList::const_iterator it = components->find (names[i]);
+      if (it != components->end () && !it->second->IsNoneEnabled ())
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+GlobalRouteManagerImpl::SPFWorker (void)
+{
+#ifdef HAVE_PTHREAD_H
+  for (;;)
+    {
+      SPFContext* ctx;
+      {
+        CriticalSection cs (*m_spfMutex);
+        if (m_spfNext == m_spfQueue.size ())
+          {
+            return;
+          }
+        ctx = m_spfQueue[m_spfNext++];
+      }
+      SPFCalculate (*ctx);
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+GlobalRouteManagerImpl::InstallRoutes (SPFContext& ctx)
+{
+  NS_LOG_FUNCTION (this << ctx.m_root);
+  if (ctx.m_routing == 0)
+    {
+      NS_LOG_LOGIC ("Can't find root node " << ctx.m_root);
+      return;
+    }
+  for (std::vector<SPFRoute>::const_iterator i = ctx.m_routes.begin (); i != ctx.m_routes.end (); i++)
+    {
+      switch (i->m_type)
+        {
+        case SPFRoute::HOST:
+          ctx.m_routing->AddHostRouteTo (i->m_dest, i->m_nextHop, i->m_interface);
+          break;
+        case SPFRoute::NETWORK:
+          ctx.m_routing->AddNetworkRouteTo (i->m_dest, i->m_mask, i->m_nextHop, i->m_interface);
+          break;
+        case SPFRoute::EXTERNAL:
+          ctx.m_routing->AddASExternalRouteTo (i->m_dest, i->m_mask, i->m_nextHop, i->m_interface);
+          break;
+        }
+    }
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetStatus (const SPFContext& ctx, const GlobalRoutingLSA* lsa) const
+{
+  std::unordered_map<const GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus>::const_iterator i = ctx.m_status.find (lsa);
+  if (i == ctx.m_status.end ())
+    {
+      return GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+    }
+  return i->second;
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section 
 // 16.1 (2) for further details.
@@ -743,7 +1221,7 @@ GlobalRouteManagerImpl::InitializeRoutes ()
 // vertex already on the candidate list, store the new (lower) cost.
 //
 void
-GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
+GlobalRouteManagerImpl::SPFNext (SPFContext& ctx, SPFVertex* v, CandidateQueue& candidate)
 {
   NS_LOG_FUNCTION (this << v << &candidate);
 
@@ -835,7 +1313,8 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 // If the link is to a router that is already in the shortest path first tree
 // then we have it covered -- ignore it.
 //
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
+      GlobalRoutingLSA::SPFStatus w_status = GetStatus (ctx, w_lsa);
+      if (w_status == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE) 
         {
           NS_LOG_LOGIC ("Skipping ->  LSA "<< 
                         w_lsa->GetLinkStateId () << " already in SPF tree");
@@ -860,7 +1339,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
       NS_LOG_LOGIC ("Considering w_lsa " << w_lsa->GetLinkStateId ());
 
 // Is there already vertex w in candidate list?
-      if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+      if (w_status == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
 // Calculate nexthop to w
 // We need to figure out how to actually get to the new router represented
@@ -870,9 +1349,9 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 
 // prepare vertex w
           w = new SPFVertex (w_lsa);
-          if (SPFNexthopCalculation (v, w, l, distance))
+          if (SPFNexthopCalculation (ctx, v, w, l, distance))
             {
-              w_lsa->SetStatus (GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+              ctx.m_status[w_lsa] = GlobalRoutingLSA::LSA_SPF_CANDIDATE;
 //
 // Push this new vertex onto the priority queue (ordered by distance from the
 // root node).
@@ -887,7 +1366,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
             NS_ASSERT_MSG (0, "SPFNexthopCalculation never " 
                            << "return false, but it does now!");
         }
-      else if (w_lsa->GetStatus () == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+      else if (w_status == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
 //
 // We have already considered the link represented by <w>.  What wse have to
@@ -934,7 +1413,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 
 // prepare vertex w
               w = new SPFVertex (w_lsa);
-              SPFNexthopCalculation (v, w, l, distance);
+              SPFNexthopCalculation (ctx, v, w, l, distance);
               cw->MergeRootExitDirections (w);
               cw->MergeParent (w);
 // SPFVertexAddParent (w) is necessary as the destructor of 
@@ -953,13 +1432,13 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 // N.B. the nexthop_calculation is conditional, if it finds a valid nexthop
 // it will call spf_add_parents, which will flush the old parents
 //
-              if (SPFNexthopCalculation (v, cw, l, distance))
+              if (SPFNexthopCalculation (ctx, v, cw, l, distance))
                 {
 //
 // If we've changed the cost to get to the vertex represented by <w>, we 
 // must reorder the priority queue keyed to that cost.
 //
-                  candidate.Reorder ();
+                  candidate.Reorder (cw);
                 }
             } // new lower cost path found
         } // end W is already on the candidate list
@@ -978,6 +1457,7 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
 //
 int
 GlobalRouteManagerImpl::SPFNexthopCalculation (
+  SPFContext& ctx,
   SPFVertex* v, 
   SPFVertex* w,
   GlobalRoutingLinkRecord* l,
@@ -1016,7 +1496,7 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
 // The point-to-point link information is only useful in this calculation when
 // we are examining the root node. 
 //
-  if (v == m_spfroot)
+  if (v == ctx.m_spfroot)
     {
 //
 // In this case <v> is the root node, which means it is the starting point
@@ -1061,7 +1541,7 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
 // from the perspective of <v> -- remember that <l> is the link "from"
 // <v> "to" <w>.
 //
-          uint32_t outIf = FindOutgoingInterfaceId (l->GetLinkData ());
+          uint32_t outIf = FindOutgoingInterfaceId (ctx, l->GetLinkData ());
 
           w->SetRootExitDirection (nextHop, outIf);
           w->SetDistanceFromRoot (distance);
@@ -1079,8 +1559,8 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
           GlobalRoutingLSA* w_lsa = w->GetLSA ();
           NS_ASSERT (w_lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA);
 // Find outgoing interface ID for this network
-          uint32_t outIf = FindOutgoingInterfaceId (w_lsa->GetLinkStateId (), 
-                                                    w_lsa->GetNetworkLSANetworkMask () );
+          uint32_t outIf = FindOutgoingInterfaceId (ctx, w_lsa->GetLinkStateId (), 
+                                                         w_lsa->GetNetworkLSANetworkMask () );
 // Set the next hop to 0.0.0.0 meaning "not exist"
           Ipv4Address nextHop = Ipv4Address::GetZero ();
           w->SetRootExitDirection (nextHop, outIf);
@@ -1096,7 +1576,7 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
   else if (v->GetVertexType () == SPFVertex::VertexNetwork) 
     {
 // See if any of v's parents are the root
-      if (v->GetParent () == m_spfroot)
+      if (v->GetParent () == ctx.m_spfroot)
         {
 // 16.1.1 para 5. ...the parent vertex is a network that
 // directly connects the calculating router to the destination
@@ -1246,7 +1726,21 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate (Ipv4Address root)
 {
   NS_LOG_FUNCTION (this << root);
-  SPFCalculate (root);
+  Ptr<Node> node;
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<GlobalRouter> rtr = (*i)->GetObject<GlobalRouter> ();
+      if (rtr && rtr->GetRouterId () == root)
+        {
+          node = *i;
+          break;
+        }
+    }
+  std::vector<SPFContext*> contexts;
+  contexts.push_back (CreateSPFContext (root, node));
+  contexts.back ()->m_checkStub = NodeList::GetNNodes () > 0;
+  RunSPFCalculations (contexts);
 }
 
 //
@@ -1256,8 +1750,9 @@ GlobalRouteManagerImpl::DebugSPFCalculate (Ipv4Address root)
 // to be run
 //
 bool
-GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
+GlobalRouteManagerImpl::CheckForStubNode (SPFContext& ctx)
 {
+  Ipv4Address root = ctx.m_root;
   NS_LOG_FUNCTION (this << root);
   GlobalRoutingLSA *rlsa = m_lsdb->GetLSA (root);
   Ipv4Address myRouterId = rlsa->GetLinkStateId ();
@@ -1319,15 +1814,17 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
               if (lr->GetLinkId () == myRouterId)
                 {
                   // Next hop is stored in the LinkID field of lr
-                  Ptr<GlobalRouter> router = rlsa->GetNode ()->GetObject<GlobalRouter> ();
-                  NS_ASSERT (router);
-                  Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-                  NS_ASSERT (gr);
-                  gr->AddNetworkRouteTo (Ipv4Address ("0.0.0.0"), Ipv4Mask ("0.0.0.0"), lr->GetLinkData (), 
-                                         FindOutgoingInterfaceId (transitLink->GetLinkData ()));
+                  SPFRoute route;
+                  route.m_type = SPFRoute::NETWORK;
+                  route.m_dest = Ipv4Address ("0.0.0.0");
+                  route.m_mask = Ipv4Mask ("0.0.0.0");
+                  route.m_nextHop = lr->GetLinkData ();
+                  route.m_interface = FindOutgoingInterfaceId (ctx, transitLink->GetLinkData ());
+                  ctx.m_routes.push_back (route);
+                  ctx.m_stub = true;
+                  ctx.m_neighbor = transitLink->GetLinkId ();
                   NS_LOG_LOGIC ("Inserting default route for node " << myRouterId << " to next hop " << 
-                                lr->GetLinkData () << " via interface " << 
-                                FindOutgoingInterfaceId (transitLink->GetLinkData ()));
+                                lr->GetLinkData () << " via interface " << route.m_interface);
                   return true;
                 }
             }
@@ -1338,15 +1835,17 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
 
 // quagga ospf_spf_calculate
 void
-GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
+GlobalRouteManagerImpl::SPFCalculate (SPFContext& ctx)
 {
+  Ipv4Address root = ctx.m_root;
   NS_LOG_FUNCTION (this << root);
 
   SPFVertex *v;
 //
-// Initialize the Link State Database.
+// The status of the LSAs is kept in the context rather than in the shared
+// Link State Database, all the LSAs start as LSA_SPF_NOT_EXPLORED.
 //
-  m_lsdb->Initialize ();
+  ctx.m_status.clear ();
 //
 // The candidate queue is a priority queue of SPFVertex objects, with the top
 // of the queue being the closest vertex in terms of distance from the root
@@ -1364,9 +1863,9 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // This vertex is the root of the SPF tree and it is distance 0 from the root.
 // We also mark this vertex as being in the SPF tree.
 //
-  m_spfroot= v;
+  ctx.m_spfroot = v;
   v->SetDistanceFromRoot (0);
-  v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+  ctx.m_status[v->GetLSA ()] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
   NS_LOG_LOGIC ("Starting SPFCalculate for node " << root);
 
 //
@@ -1376,10 +1875,11 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // reached.  Instead, short-circuit this computation and just install
 // a default route in the CheckForStubNode() method.
 //
-  if (NodeList::GetNNodes () > 0 && CheckForStubNode (root))
+  if (ctx.m_checkStub && CheckForStubNode (ctx))
     {
       NS_LOG_LOGIC ("SPFCalculate truncated for stub node " << root);
-      delete m_spfroot;
+      delete ctx.m_spfroot;
+      ctx.m_spfroot = 0;
       return;
     }
 
@@ -1399,7 +1899,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // shortest path).  If the new vertices represent shorter paths, we use them
 // and update the path cost.
 //
-      SPFNext (v, candidate);
+      SPFNext (ctx, v, candidate);
 //
 // RFC2328 16.1. (3). 
 //
@@ -1427,7 +1927,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // Update the status field of the vertex to indicate that it is in the SPF
 // tree.
 //
-      v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+      ctx.m_status[v->GetLSA ()] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
 //
 // The current vertex has a parent pointer.  By calling this rather oddly 
 // named method (blame quagga) we add the current vertex to the list of 
@@ -1466,11 +1966,11 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
       if (v->GetVertexType () == SPFVertex::VertexRouter)
         {
-          SPFIntraAddRouter (v);
+          SPFIntraAddRouter (ctx, v);
         }
       else if (v->GetVertexType () == SPFVertex::VertexNetwork)
         {
-          SPFIntraAddTransit (v);
+          SPFIntraAddTransit (ctx, v);
         }
       else
         {
@@ -1485,13 +1985,13 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
     }  // end for loop
 
 // Second stage of SPF calculation procedure
-  SPFProcessStubs (m_spfroot);
+  SPFProcessStubs (ctx, ctx.m_spfroot);
   for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
     {
-      m_spfroot->ClearVertexProcessed ();
+      ctx.m_spfroot->ClearVertexProcessed ();
       GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
       NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
-      ProcessASExternals (m_spfroot, extlsa);
+      ProcessASExternals (ctx, ctx.m_spfroot, extlsa);
     }
 
 //
@@ -1499,12 +1999,13 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 // the SPF tree.  Delete all of the vertices and corresponding resources.  Go
 // possibly do it again for the next router.
 //
-  delete m_spfroot;
-  m_spfroot = 0;
+  delete ctx.m_spfroot;
+  ctx.m_spfroot = 0;
+  ctx.m_status.clear ();
 }
 
 void
-GlobalRouteManagerImpl::ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extlsa)
+GlobalRouteManagerImpl::ProcessASExternals (SPFContext& ctx, SPFVertex* v, GlobalRoutingLSA* extlsa)
 {
   NS_LOG_FUNCTION (this << v << extlsa);
   NS_LOG_LOGIC ("Processing external for destination " << 
@@ -1518,7 +2019,7 @@ GlobalRouteManagerImpl::ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extl
       if ((rlsa->GetLinkStateId ()) == (extlsa->GetAdvertisingRouter ()))
         {
           NS_LOG_LOGIC ("Found advertising router to destination");
-          SPFAddASExternal (extlsa,v);
+          SPFAddASExternal (ctx, extlsa, v);
         }
     }
   for (uint32_t i = 0; i < v->GetNChildren (); i++)
@@ -1526,7 +2027,7 @@ GlobalRouteManagerImpl::ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extl
       if (!v->GetChild (i)->IsVertexProcessed ())
         {
           NS_LOG_LOGIC ("Vertex's child " << i << " not yet processed, processing...");
-          ProcessASExternals (v->GetChild (i), extlsa);
+          ProcessASExternals (ctx, v->GetChild (i), extlsa);
           v->GetChild (i)->SetVertexProcessed (true);
         }
     }
@@ -1538,15 +2039,15 @@ GlobalRouteManagerImpl::ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extl
 //
 
 void
-GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v)
+GlobalRouteManagerImpl::SPFAddASExternal (SPFContext& ctx, GlobalRoutingLSA *extlsa, SPFVertex *v)
 {
   NS_LOG_FUNCTION (this << extlsa << v);
 
-  NS_ASSERT_MSG (m_spfroot, "GlobalRouteManagerImpl::SPFAddASExternal (): Root pointer not set");
+  NS_ASSERT_MSG (ctx.m_spfroot, "GlobalRouteManagerImpl::SPFAddASExternal (): Root pointer not set");
 // Two cases to consider: We are advertising the external ourselves
 // => No need to add anything
 // OR find best path to the advertising router
-  if (v->GetVertexId () == m_spfroot->GetVertexId ())
+  if (v->GetVertexId () == ctx.m_spfroot->GetVertexId ())
     {
       NS_LOG_LOGIC ("External is on local host: " 
                     << v->GetVertexId () << "; returning");
@@ -1554,110 +2055,38 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
     }
   NS_LOG_LOGIC ("External is on remote host: " 
                 << extlsa->GetAdvertisingRouter () << "; installing");
-
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFAddASExternal (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = extlsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The routes are added to the root of the SPF tree, using the next hops and
+// outgoing interfaces found for reaching the advertising router <v>.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
-          continue;
+          SPFRoute route = { SPFRoute::EXTERNAL, tempip, tempmask, nextHop, static_cast<uint32_t> (outIf) };
+          ctx.m_routes.push_back (route);
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " add external network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+      else
         {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = extlsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add external network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 
@@ -1665,7 +2094,7 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
 // stub link records will exist for point-to-point interfaces and for
 // broadcast interfaces for which no neighboring router can be found
 void
-GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
+GlobalRouteManagerImpl::SPFProcessStubs (SPFContext& ctx, SPFVertex* v)
 {
   NS_LOG_FUNCTION (this << v);
   NS_LOG_LOGIC ("Processing stubs for " << v->GetVertexId ());
@@ -1682,7 +2111,7 @@ GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
           if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
             {
               NS_LOG_LOGIC ("Found a Stub record to " << l->GetLinkId ());
-              SPFIntraAddStub (l, v);
+              SPFIntraAddStub (ctx, l, v);
               continue;
             }
         }
@@ -1691,7 +2120,7 @@ GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
     {
       if (!v->GetChild (i)->IsVertexProcessed ())
         {
-          SPFProcessStubs (v->GetChild (i));
+          SPFProcessStubs (ctx, v->GetChild (i));
           v->GetChild (i)->SetVertexProcessed (true);
         }
     }
@@ -1699,11 +2128,11 @@ GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
 
 // RFC2328 16.1. second stage. 
 void
-GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddStub (SPFContext& ctx, GlobalRoutingLinkRecord *l, SPFVertex* v)
 {
   NS_LOG_FUNCTION (this << l << v);
 
-  NS_ASSERT_MSG (m_spfroot, 
+  NS_ASSERT_MSG (ctx.m_spfroot, 
                  "GlobalRouteManagerImpl::SPFIntraAddStub (): Root pointer not set");
 
   // XXX simplifed logic for the moment.  There are two cases to consider:
@@ -1711,201 +2140,74 @@ GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex*
   //    (already handled above)
   // 2) the stub network is on a remote router, so I should use the
   // same next hop that I use to get to vertex v
-  if (v->GetVertexId () == m_spfroot->GetVertexId ())
+  if (v->GetVertexId () == ctx.m_spfroot->GetVertexId ())
     {
       NS_LOG_LOGIC ("Stub is on local host: " << v->GetVertexId () << "; returning");
       return;
     }
   NS_LOG_LOGIC ("Stub is on remote host: " << v->GetVertexId () << "; installing");
+  NS_ASSERT_MSG (v->GetLSA (), 
+                 "GlobalRouteManagerImpl::SPFIntraAddStub (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask (l->GetLinkData ().Get ());
+  Ipv4Address tempip = l->GetLinkId ();
+  tempip = tempip.CombineMask (tempmask);
 //
 // The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// going to write the actual routing table entries.  The vertex <v> has the
+// next hops and the outbound interfaces (m_rootOif) the root should use to
+// forward the packets toward the stub network, one for each equal cost path.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
+      if (outIf >= 0)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
+          SPFRoute route = { SPFRoute::NETWORK, tempip, tempmask, nextHop, static_cast<uint32_t> (outIf) };
+          ctx.m_routes.push_back (route);
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+      else
         {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask (l->GetLinkData ().Get ());
-          Ipv4Address tempip = l->GetLinkId ();
-          tempip = tempip.CombineMask (tempmask);
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
 // Return the interface number corresponding to a given IP address and mask
-// This is a wrapper around GetInterfaceForPrefix(), but we first
-// have to find the right node pointer to pass to that function.
+// This is the same as GetInterfaceForPrefix() on the root node, but on the
+// copy of the addresses of the root held by the context, as the worker
+// threads must not access the node.
 // If no such interface is found, return -1 (note:  unit test framework
 // for routing assumes -1 to be a legal return value)
 //
 int32_t
-GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
+GlobalRouteManagerImpl::FindOutgoingInterfaceId (const SPFContext& ctx, Ipv4Address a, Ipv4Mask amask)
 {
   NS_LOG_FUNCTION (this << a << amask);
-//
-// We have an IP address <a> and a vertex ID of the root of the SPF tree.
-// The question is what interface index does this address correspond to.
-// The answer is a little complicated since we have to find a pointer to
-// the node corresponding to the vertex ID, find the Ipv4 interface on that
-// node in order to iterate the interfaces and find the one corresponding to
-// the address in question.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-//
-// Walk the list of nodes in the system looking for the one corresponding to
-// the node at the root of the SPF tree.  This is the node for which we are
-// building the routing table.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  for (uint32_t i = 0; i < ctx.m_interfaces.size (); i++)
     {
-      Ptr<Node> node = *i;
-
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-//
-// If the node doesn't have a GlobalRouter interface it can't be the one
-// we're interested in.
-//
-      if (rtr == 0)
+      for (uint32_t j = 0; j < ctx.m_interfaces[i].size (); j++)
         {
-          continue;
-        }
-
-      if (rtr->GetRouterId () == routerId)
-        {
-//
-// This is the node we're building the routing table for.  We're going to need
-// the Ipv4 interface to look for the ipv4 interface index.  Since this node
-// is participating in routing IP version 4 packets, it certainly must have 
-// an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                         "GetObject for <Ipv4> interface failed");
-//
-// Look through the interfaces on this node for one that has the IP address
-// we're looking for.  If we find one, return the corresponding interface
-// index, or -1 if not found.
-//
-          int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
-
-#if 0
-          if (interface < 0)
+          if (ctx.m_interfaces[i][j].CombineMask (amask) == a.CombineMask (amask))
             {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
+              return i;
             }
-#endif 
-          return interface;
         }
     }
 //
 // Couldn't find it.
 //
-  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << routerId);
+  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find interface for " << a << " on root " << ctx.m_root);
   return -1;
 }
 
@@ -1926,77 +2228,24 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 // route.
 //
 void
-GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddRouter (SPFContext& ctx, SPFVertex* v)
 {
   NS_LOG_FUNCTION (this << v);
 
-  NS_ASSERT_MSG (m_spfroot, 
+  NS_ASSERT_MSG (ctx.m_spfroot, 
                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
 //
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
-    {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "GetObject for <Ipv4> interface failed");
-//
 // Get the Global Router Link State Advertisement from the vertex we're
 // adding the routes to.  The LSA will have a number of attached Global Router
 // Link Records corresponding to links off of that vertex / node.  We're going
 // to be interested in the records corresponding to point-to-point links.
 //
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                 "Expected valid LSA in SPFVertex* v");
 
-          uint32_t nLinkRecords = lsa->GetNLinkRecords ();
+  uint32_t nLinkRecords = lsa->GetNLinkRecords ();
 //
 // Iterate through the link records on the vertex to which we're going to add
 // routes.  To make sure we're being clear, we're going to add routing table
@@ -2005,18 +2254,18 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // the local side of the point-to-point links found on the node described by
 // the vertex <v>.
 //
-          NS_LOG_LOGIC (" Node " << node->GetId () <<
-                        " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
-          for (uint32_t j = 0; j < nLinkRecords; ++j)
-            {
+  NS_LOG_LOGIC (" Root " << ctx.m_root <<
+                " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
+  for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
 //
 // We are only concerned about point-to-point links
 //
-              GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
-              if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                  continue;
-                }
+      GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+      if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
+        {
+          continue;
+        }
 //
 // Here's why we did all of that work.  We're going to add a host route to the
 // host address found in the m_linkData field of the point-to-point link
@@ -2030,153 +2279,79 @@ GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
 // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
 // which the packets should be send for forwarding.
 //
-              Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-              if (router == 0)
-                {
-                  continue;
-                }
-              Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-              NS_ASSERT (gr);
-              // walk through all available exit directions due to ECMP,
-              // and add host route for each of the exit direction toward
-              // the vertex 'v'
-              for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-                {
-                  SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-                  Ipv4Address nextHop = exit.first;
-                  int32_t outIf = exit.second;
-                  if (outIf >= 0)
-                    {
-                      gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
-                                          outIf);
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " adding host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " and outgoing interface " << outIf);
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " NOT able to add host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " since outgoing interface id is negative " << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+      // walk through all available exit directions due to ECMP,
+      // and add host route for each of the exit direction toward
+      // the vertex 'v'
+      for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+        {
+          SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+          Ipv4Address nextHop = exit.first;
+          int32_t outIf = exit.second;
+          if (outIf >= 0)
+            {
+              SPFRoute route = { SPFRoute::HOST, lr->GetLinkData (), Ipv4Mask::GetOnes (), nextHop, static_cast<uint32_t> (outIf) };
+              ctx.m_routes.push_back (route);
+              NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                            " adding host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " and outgoing interface " << outIf);
             }
-//
-// Done adding the routes for the selected node.
-//
-          return;
-        }
+          else
+            {
+              NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                            " NOT able to add host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
+
 void
-GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddTransit (SPFContext& ctx, SPFVertex* v)
 {
   NS_LOG_FUNCTION (this << v);
 
-  NS_ASSERT_MSG (m_spfroot, 
+  NS_ASSERT_MSG (ctx.m_spfroot, 
                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
 //
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+// Get the Global Router Link State Advertisement from the vertex we're
+// adding the routes to.  The LSA of a network vertex gives the network
+// address and mask of the transit network.
+//
+  GlobalRoutingLSA *lsa = v->GetLSA ();
+  NS_ASSERT_MSG (lsa, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                 "Expected valid LSA in SPFVertex* v");
+  Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = lsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+  // walk through all available exit directions due to ECMP,
+  // and add host route for each of the exit direction toward
+  // the vertex 'v'
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
+      SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
+      Ipv4Address nextHop = exit.first;
+      int32_t outIf = exit.second;
 
-      if (rtr == 0)
+      if (outIf >= 0)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
+          SPFRoute route = { SPFRoute::NETWORK, tempip, tempmask, nextHop, static_cast<uint32_t> (outIf) };
+          ctx.m_routes.push_back (route);
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+      else
         {
-          NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "GetObject for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = lsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all available exit directions due to ECMP,
-          // and add host route for each of the exit direction toward
-          // the vertex 'v'
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative " << outIf);
-                }
-            }
+          NS_LOG_LOGIC ("(Route " << i << ") Root " << ctx.m_root <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative " << outIf);
         }
-    } 
+    }
 }
 
 // Derived from quagga ospf_vertex_add_parents ()
@@ -26,7 +26,9 @@
 #include <list>
 #include <queue>
 #include <map>
+#include <set>
 #include <vector>
+#include <unordered_map>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/ipv4-address.h"
@@ -38,6 +40,8 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Node;
+class SystemMutex;
 
 /**
  * \ingroup globalrouting
@@ -674,12 +678,45 @@ public:
    */
   uint32_t GetNumExtLSAs () const;
 
+  /**
+   * @brief Compare the router and network LSAs with the ones of another
+   * database.
+   *
+   * @param lsdb the database to compare with
+   * @param changed the link state IDs of the LSAs that differ, or exist in
+   * only one of the databases (output)
+   */
+  void GetChangedLSAs (const GlobalRouteManagerLSDB* lsdb,
+                       std::set<Ipv4Address>& changed) const;
+
+  /**
+   * @brief Compare the External LSAs with the ones of another database.
+   *
+   * @param lsdb the database to compare with
+   * @returns true if both databases hold the same External LSAs, in the
+   * same order
+   */
+  bool HasSameExtLSAs (const GlobalRouteManagerLSDB* lsdb) const;
+
+  /**
+   * @brief Label the router and network LSAs by connected component.
+   *
+   * Two LSAs are in the same component if there is a path between them,
+   * following the links in either direction.  The SPF tree of a root only
+   * holds LSAs of the component of the root.
+   *
+   * @param components the component of each link state ID (output)
+   */
+  void GetComponents (std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>& components) const;
 
 private:
   typedef std::map<Ipv4Address, GlobalRoutingLSA*> LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
   typedef std::pair<Ipv4Address, GlobalRoutingLSA*> LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
+  /// Router LSAs by the link data of their TransitNetwork link records
+  typedef std::unordered_map<Ipv4Address, GlobalRoutingLSA*, Ipv4AddressHash> LinkDataMap_t;
 
   LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+  LinkDataMap_t m_linkData; //!< index of m_database for GetLSAByLinkData ()
   std::vector<GlobalRoutingLSA*> m_extdatabase; //!< database of External Link State Advertisements
 
 /**
@@ -732,9 +769,28 @@ public:
 /**
  * @brief Compute routes using a Dijkstra SPF computation and populate
  * per-node forwarding tables
+ *
+ * The SPF trees of the routers are computed in parallel by the number of
+ * threads set by the GlobalRoutingSpfThreads global value.
  */
   virtual void InitializeRoutes ();
 
+/**
+ * @brief Rebuild the routing database, and recompute the routes of the
+ * routers whose SPF tree may have changed since the last computation.
+ *
+ * The new Link State Advertisements are compared with the ones of the
+ * previous database.  The routes of a router are deleted and recomputed
+ * when an LSA of its connected component changed (or, for a stub router,
+ * its own LSA or the one of its neighbor), or when the External LSAs
+ * changed.  The routes of the other routers are left untouched.
+ *
+ * If the routes were not computed yet, or were deleted, this is the same as
+ * DeleteGlobalRoutes (), BuildGlobalRoutingDatabase () and
+ * InitializeRoutes ().
+ */
+  virtual void UpdateRoutes ();
+
 /**
  * @brief Debugging routine; allow client code to supply a pre-built LSDB
  */
@@ -766,8 +822,132 @@ private:
  */
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
-  SPFVertex* m_spfroot; //!< the root node
+  /**
+   * \brief A route computed by an SPF calculation
+   */
+  struct SPFRoute
+  {
+    /// Kind of route, i.e., the Ipv4GlobalRouting method installing it
+    enum Type
+    {
+      HOST,     //!< AddHostRouteTo
+      NETWORK,  //!< AddNetworkRouteTo
+      EXTERNAL  //!< AddASExternalRouteTo
+    };
+    Type m_type;             //!< kind of route
+    Ipv4Address m_dest;      //!< destination host or network
+    Ipv4Mask m_mask;         //!< network mask
+    Ipv4Address m_nextHop;   //!< next hop
+    uint32_t m_interface;    //!< outgoing interface
+  };
+
+  /**
+   * \brief State of the SPF calculation of one root.
+   *
+   * The SPF calculation only reads the LSDB and writes to its context, so
+   * the calculations of different roots can run concurrently.  The routes
+   * are installed afterwards by the main thread, which also fills the
+   * fields holding ns-3 objects.
+   */
+  struct SPFContext
+  {
+    /**
+     * \brief Constructor
+     * \param root the router ID of the root
+     */
+    SPFContext (Ipv4Address root);
+
+    Ipv4Address m_root;       //!< router ID of the root
+    SPFVertex* m_spfroot;     //!< the root vertex
+    bool m_checkStub;         //!< shortcut the calculation of the stub roots
+    bool m_stub;              //!< the root is a stub, and only has a default route
+    Ipv4Address m_neighbor;   //!< the neighbor of a stub root
+    /// local addresses of the root, by interface, for FindOutgoingInterfaceId ()
+    std::vector<std::vector<Ipv4Address> > m_interfaces;
+    /// SPF status of the LSAs, LSA_SPF_NOT_EXPLORED if absent
+    std::unordered_map<const GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_status;
+    std::vector<SPFRoute> m_routes;    //!< routes of the root, in installation order
+    Ptr<Ipv4GlobalRouting> m_routing;  //!< routing protocol of the root (main thread only)
+  };
+
+  /**
+   * \brief What the routes of a root were computed from, besides the LSAs
+   * of its connected component.
+   */
+  struct SPFRootState
+  {
+    bool m_stub;             //!< the root is a stub
+    Ipv4Address m_neighbor;  //!< the neighbor of a stub root
+    std::vector<std::vector<Ipv4Address> > m_interfaces; //!< local addresses of the root, by interface
+  };
+
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+  bool m_routesValid; //!< the routes of m_lsdb are installed, UpdateRoutes () can be incremental
+  std::map<Ipv4Address, SPFRootState> m_roots; //!< state of the roots whose routes are installed
+  std::vector<SPFContext*> m_spfQueue; //!< SPF calculations left to the worker threads
+  uint32_t m_spfNext; //!< next calculation of m_spfQueue
+  SystemMutex* m_spfMutex; //!< protects m_spfNext
+
+  /**
+   * \brief Create the context of the SPF calculation of a router.
+   *
+   * \param root the router ID of the root
+   * \param node the node of the root, or 0 if unknown
+   * \returns the context, to be deleted by the caller
+   */
+  SPFContext* CreateSPFContext (Ipv4Address root, Ptr<Node> node);
+
+  /**
+   * \brief Get the local addresses of a node.
+   *
+   * \param node the node
+   * \param interfaces the addresses, by interface (output)
+   */
+  void GetInterfaceAddresses (Ptr<Node> node, std::vector<std::vector<Ipv4Address> >& interfaces) const;
+
+  /**
+   * \brief Run the SPF calculations, in parallel, and install the routes.
+   *
+   * \param contexts the calculations, which are deleted
+   */
+  void RunSPFCalculations (std::vector<SPFContext*>& contexts);
+
+  /**
+   * \brief Check whether the log components used by the SPF calculations
+   * are enabled.
+   *
+   * \returns true if the calculations must run in the simulation thread
+   */
+  static bool IsSPFLogEnabled (void);
+
+  /**
+   * \brief Body of the SPF worker threads: run the calculations of
+   * m_spfQueue until none is left.
+   */
+  void SPFWorker (void);
+
+  /**
+   * \brief Install the routes computed for a root in its routing protocol.
+   *
+   * \param ctx the SPF calculation
+   */
+  void InstallRoutes (SPFContext& ctx);
+
+  /**
+   * \brief Delete the routes of a router.
+   *
+   * \param gr the routing protocol of the router
+   */
+  void DeleteRoutes (Ptr<Ipv4GlobalRouting> gr);
+
+  /**
+   * \brief Get the SPF status of an LSA in a calculation.
+   *
+   * \param ctx the SPF calculation
+   * \param lsa the LSA
+   * \returns the status
+   */
+  GlobalRoutingLSA::SPFStatus GetStatus (const SPFContext& ctx, const GlobalRoutingLSA* lsa) const;
 
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
@@ -776,18 +956,18 @@ private:
    * can safely be added to the next-hop router and SPF does not need
    * to be run
    *
-   * \param root the root node
+   * \param ctx the SPF calculation
    * \returns true if the node is a stub
    */
-  bool CheckForStubNode (Ipv4Address root);
+  bool CheckForStubNode (SPFContext& ctx);
 
   /**
    * \brief Calculate the shortest path first (SPF) tree
    *
    * Equivalent to quagga ospf_spf_calculate
-   * \param root the root node
+   * \param ctx the SPF calculation
    */
-  void SPFCalculate (Ipv4Address root);
+  void SPFCalculate (SPFContext& ctx);
 
   /**
    * \brief Process Stub nodes
@@ -796,17 +976,19 @@ private:
    * stub link records will exist for point-to-point interfaces and for
    * broadcast interfaces for which no neighboring router can be found
    *
+   * \param ctx the SPF calculation
    * \param v vertex to be processed
    */
-  void SPFProcessStubs (SPFVertex* v);
+  void SPFProcessStubs (SPFContext& ctx, SPFVertex* v);
 
   /**
    * \brief Process Autonomous Systems (AS) External LSA
    *
+   * \param ctx the SPF calculation
    * \param v vertex to be processed
    * \param extlsa external LSA
    */
-  void ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extlsa);
+  void ProcessASExternals (SPFContext& ctx, SPFVertex* v, GlobalRoutingLSA* extlsa);
 
   /**
    * \brief Examine the links in v's LSA and update the list of candidates with any
@@ -826,10 +1008,11 @@ private:
    * vertices not already on the list.  If a lower-cost path is found to a
    * vertex already on the candidate list, store the new (lower) cost.
    *
+   * \param ctx the SPF calculation
    * \param v the vertex
    * \param candidate the SPF candidate queue
    */
-  void SPFNext (SPFVertex* v, CandidateQueue& candidate);
+  void SPFNext (SPFContext& ctx, SPFVertex* v, CandidateQueue& candidate);
 
   /**
    * \brief Calculate nexthop from root through V (parent) to vertex W (destination)
@@ -838,13 +1021,14 @@ private:
    * This method is derived from quagga ospf_nexthop_calculation() 16.1.1.
    * For now, this is greatly simplified from the quagga code
    *
+   * \param ctx the SPF calculation
    * \param v the parent
    * \param w the destination
    * \param l the link record
    * \param distance the target distance
    * \returns 1 on success
    */
-  int SPFNexthopCalculation (SPFVertex* v, SPFVertex* w, 
+  int SPFNexthopCalculation (SPFContext& ctx, SPFVertex* v, SPFVertex* w, 
                              GlobalRoutingLinkRecord* l, uint32_t distance);
 
   /**
@@ -904,47 +1088,52 @@ private:
    * a destination IP address, reachable from the root, to which we add a host
    * route.
    *
+   * \param ctx the SPF calculation
    * \param v the vertex
    *
    */
-  void SPFIntraAddRouter (SPFVertex* v);
+  void SPFIntraAddRouter (SPFContext& ctx, SPFVertex* v);
 
   /**
    * \brief Add a transit to the routing tables
    *
+   * \param ctx the SPF calculation
    * \param v the vertex
    */
-  void SPFIntraAddTransit (SPFVertex* v);
+  void SPFIntraAddTransit (SPFContext& ctx, SPFVertex* v);
 
   /**
    * \brief Add a stub to the routing tables
    *
+   * \param ctx the SPF calculation
    * \param l the global routing link record
    * \param v the vertex
    */
-  void SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex* v);
+  void SPFIntraAddStub (SPFContext& ctx, GlobalRoutingLinkRecord *l, SPFVertex* v);
 
   /**
    * \brief Add an external route to the routing tables
    *
+   * \param ctx the SPF calculation
    * \param extlsa the external LSA
    * \param v the vertex
    */
-  void SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v);
+  void SPFAddASExternal (SPFContext& ctx, GlobalRoutingLSA *extlsa, SPFVertex *v);
 
   /**
    * \brief Return the interface number corresponding to a given IP address and mask
    *
-   * This is a wrapper around GetInterfaceForPrefix(), but we first
-   * have to find the right node pointer to pass to that function.
+   * This is the same as Ipv4::GetInterfaceForPrefix() on the root node, but
+   * on the copy of its interface addresses held by the SPF calculation.
    * If no such interface is found, return -1 (note:  unit test framework
    * for routing assumes -1 to be a legal return value)
    *
+   * \param ctx the SPF calculation
    * \param a the target IP address
    * \param amask the target subnet mask
    * \return the outgoing interface number
    */
-  int32_t FindOutgoingInterfaceId (Ipv4Address a, 
+  int32_t FindOutgoingInterfaceId (const SPFContext& ctx, Ipv4Address a, 
                                    Ipv4Mask amask = Ipv4Mask ("255.255.255.255"));
 };
 
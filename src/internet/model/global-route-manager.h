@@ -65,6 +65,16 @@ public:
  */
   static void InitializeRoutes ();
 
+/**
+ * @brief Rebuild the routing database, and recompute the routes of the
+ * routers affected by the changes since the routes were computed.
+ *
+ * This is the same as DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+ * and InitializeRoutes (), except that the routes of the routers whose SPF
+ * tree did not change are left untouched.
+ */
+  static void UpdateRoutes ();
+
 private:
 /**
  * @brief Global Route Manager copy construction is disallowed.  There's no 
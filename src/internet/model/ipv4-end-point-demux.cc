@@ -40,29 +40,112 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
     {
       Ipv4EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_index.clear ();
+  m_entries.clear ();
+  m_localPorts.clear ();
 }
 
 bool
-Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+Ipv4EndPointDemux::EndPointKey::operator== (const EndPointKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  return m_localPort == other.m_localPort
+         && m_peerPort == other.m_peerPort
+         && m_peerAddress == other.m_peerAddress;
+}
+
+size_t
+Ipv4EndPointDemux::EndPointKeyHash::operator() (const EndPointKey &key) const
+{
+  size_t h = Ipv4AddressHash () (key.m_peerAddress);
+  h ^= ((static_cast<size_t> (key.m_localPort) << 16) | key.m_peerPort) * 0x9e3779b97f4a7c15ULL;
+  return h;
+}
+
+void
+Ipv4EndPointDemux::Insert (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  m_endPoints.push_back (endPoint);
+  EndPointEntry &entry = m_entries[endPoint];
+  entry.m_list = std::prev (m_endPoints.end ());
+  Index (entry, endPoint);
+  endPoint->m_demux = this;
+  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+}
+
+void
+Ipv4EndPointDemux::Index (EndPointEntry &entry, Ipv4EndPoint *endPoint)
+{
+  entry.m_key.m_localPort = endPoint->GetLocalPort ();
+  entry.m_key.m_peerAddress = endPoint->GetPeerAddress ();
+  entry.m_key.m_peerPort = endPoint->GetPeerPort ();
+  EndPoints &bucket = m_index[entry.m_key];
+  entry.m_bucket = bucket.insert (bucket.end (), endPoint);
+  m_localPorts[entry.m_key.m_localPort]++;
+}
+
+void
+Ipv4EndPointDemux::Unindex (const EndPointEntry &entry)
+{
+  auto bucket = m_index.find (entry.m_key);
+  NS_ASSERT (bucket != m_index.end ());
+  bucket->second.erase (entry.m_bucket);
+  if (bucket->second.empty ())
     {
-      if ((*i)->GetLocalPort  () == port) 
-        {
-          return true;
-        }
+      m_index.erase (bucket);
     }
-  return false;
+  auto port = m_localPorts.find (entry.m_key.m_localPort);
+  NS_ASSERT (port != m_localPorts.end () && port->second > 0);
+  if (--port->second == 0)
+    {
+      m_localPorts.erase (port);
+    }
+}
+
+void
+Ipv4EndPointDemux::Rehash (Ipv4EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_entries.find (endPoint);
+  NS_ASSERT (it != m_entries.end ());
+  Unindex (it->second);
+  Index (it->second, endPoint);
+}
+
+const Ipv4EndPointDemux::EndPoints *
+Ipv4EndPointDemux::GetBucket (uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const
+{
+  EndPointKey key;
+  key.m_localPort = localPort;
+  key.m_peerAddress = peerAddress;
+  key.m_peerPort = peerPort;
+  auto it = m_index.find (key);
+  if (it == m_index.end ())
+    {
+      return 0;
+    }
+  return &it->second;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return m_localPorts.find (port) != m_localPorts.end ();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
+  if (!LookupPortLocal (port))
+    {
+      return false;
+    }
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
     {
       if ((*i)->GetLocalPort () == port &&
@@ -86,8 +169,7 @@ Ipv4EndPointDemux::Allocate (void)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (Ipv4Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -102,8 +184,7 @@ Ipv4EndPointDemux::Allocate (Ipv4Address address)
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -125,8 +206,7 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv4Address address,
       return 0;
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -136,24 +216,22 @@ Ipv4EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                              Ipv4Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  const EndPoints *bucket = GetBucket (localPort, peerAddress, peerPort);
+  if (bucket != 0)
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
-          ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
         {
-          NS_LOG_WARN ("Duplicated endpoint.");
-          return 0;
+          if ((*i)->GetLocalAddress () == localAddress &&
+              ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+            {
+              NS_LOG_WARN ("Duplicated endpoint.");
+              return 0;
+            }
         }
     }
   Ipv4EndPoint *endPoint = new Ipv4EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
-
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -161,15 +239,16 @@ void
 Ipv4EndPointDemux::DeAllocate (Ipv4EndPoint *endPoint)
 {
   NS_LOG_FUNCTION (this << endPoint);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
+  auto it = m_entries.find (endPoint);
+  if (it == m_entries.end ())
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
     }
+  Unindex (it->second);
+  m_endPoints.erase (it->second.m_list);
+  m_entries.erase (it);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -208,119 +287,135 @@ Ipv4EndPointDemux::Lookup (Ipv4Address daddr, uint16_t dport,
   EndPoints retval4; // Exact match on all 4
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr << ":" << dport);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++) 
-    {
-      Ipv4EndPoint* endP = *i;
 
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
-
-      if (!endP->IsRxEnabled ())
-        {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
-          continue;
-        }
+  // Only the endpoints connected to the source and the ones with a wildcard
+  // peer can match (the peer must match either exactly or with wildcards).
+  const EndPoints *buckets[2] = { GetBucket (dport, saddr, sport), 0 };
+  if (saddr != Ipv4Address::GetAny () || sport != 0)
+    {
+      buckets[1] = GetBucket (dport, Ipv4Address::GetAny (), 0);
+    }
 
-      if (endP->GetLocalPort () != dport) 
+  for (const EndPoints *bucket : buckets)
+    {
+      if (bucket == 0)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
           continue;
         }
-      if (endP->GetBoundNetDevice ())
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
         {
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+          Ipv4EndPoint* endP = *i;
+
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                            << " because endpoint can not receive packets");
               continue;
             }
-        }
 
-      bool localAddressMatchesExact = false;
-      bool localAddressIsAny = false;
-      bool localAddressIsSubnetAny = false;
+          if (endP->GetLocalPort () != dport) 
+            {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
+              continue;
+            }
+          if (endP->GetBoundNetDevice ())
+            {
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      // We have 3 cases:
-      // 1) Exact local / destination address match
-      // 2) Local endpoint bound to Any -> matches anything
-      // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
+          bool localAddressMatchesExact = false;
+          bool localAddressIsAny = false;
+          bool localAddressIsSubnetAny = false;
 
-      if (endP->GetLocalAddress () == daddr)
-        {
-          // Case 1:
-          localAddressMatchesExact = true;
-        }
-      else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
-        {
-          // Case 2:
-          localAddressIsAny = true;
-        }
-      else
-        {
-          // Case 3:
-          for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
-            {
-              Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
+          // We have 3 cases:
+          // 1) Exact local / destination address match
+          // 2) Local endpoint bound to Any -> matches anything
+          // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g., x.y.z.255 in a /24 net) and direct destination match.
 
-              Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
-              if (endP->GetLocalAddress () == addrNetpart)
+          if (endP->GetLocalAddress () == daddr)
+            {
+              // Case 1:
+              localAddressMatchesExact = true;
+            }
+          else if (endP->GetLocalAddress () == Ipv4Address::GetAny ())
+            {
+              // Case 2:
+              localAddressIsAny = true;
+            }
+          else
+            {
+              // Case 3:
+              for (uint32_t i = 0; i < incomingInterface->GetNAddresses (); i++)
                 {
-                  NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+                  Ipv4InterfaceAddress addr = incomingInterface->GetAddress (i);
 
-                  Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
-                  if (addrNetpart == daddrNetPart)
+                  Ipv4Address addrNetpart = addr.GetLocal ().CombineMask (addr.GetMask ());
+                  if (endP->GetLocalAddress () == addrNetpart)
                     {
-                      localAddressIsSubnetAny = true;
+                      NS_LOG_LOGIC ("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress () << "/" << addr.GetMask ().GetPrefixLength ());
+
+                      Ipv4Address daddrNetPart = daddr.CombineMask (addr.GetMask ());
+                      if (addrNetpart == daddrNetPart)
+                        {
+                          localAddressIsSubnetAny = true;
+                        }
                     }
                 }
-            }
 
-          // if no match here, keep looking
-          if (!localAddressIsSubnetAny)
-            continue;
-        }
+              // if no match here, keep looking
+              if (!localAddressIsSubnetAny)
+                continue;
+            }
 
-      bool remotePortMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
+          bool remotePortMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePortMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv4Address::GetAny ();
 
-      // If remote does not match either with exact or wildcard,
-      // skip this one
-      if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        continue;
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        continue;
+          // If remote does not match either with exact or wildcard,
+          // skip this one
+          if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            continue;
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            continue;
 
-      bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+          bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-      if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-          NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval4.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-          NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-          NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-          NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
-          retval1.push_back (endP);
+          if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+              NS_LOG_LOGIC ("Found an endpoint for case 4, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval4.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+              NS_LOG_LOGIC ("Found an endpoint for case 3, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+              NS_LOG_LOGIC ("Found an endpoint for case 2, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+              NS_LOG_LOGIC ("Found an endpoint for case 1, adding " << endP->GetLocalAddress () << ":" << endP->GetLocalPort ());
+              retval1.push_back (endP);
+            }
         }
     }
 
@@ -343,6 +438,23 @@ Ipv4EndPointDemux::SimpleLookup (Ipv4Address daddr,
 {
   NS_LOG_FUNCTION (this << daddr << dport << saddr << sport);
 
+  // fast path: the exact match is in the bucket of the four-tuple
+  const EndPoints *bucket = GetBucket (dport, saddr, sport);
+  if (bucket != 0)
+    {
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
+        {
+          if ((*i)->GetLocalAddress () == daddr)
+            {
+              return *i;
+            }
+        }
+    }
+  if (!LookupPortLocal (dport))
+    {
+      return 0;
+    }
+
   // this code is a copy/paste version of an old BSD ip stack lookup
   // function.
   uint32_t genericity = 3;
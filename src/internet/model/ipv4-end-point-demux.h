@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
 #include "ns3/ipv4-address.h"
 #include "ipv4-interface.h"
 
@@ -40,6 +41,14 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * Besides the list, the endpoints are indexed in a hash table keyed by
+ * local port, peer address and peer port. Connected endpoints sit in the
+ * bucket of their four-tuple, and the endpoints with a wildcard peer
+ * (e.g., listening sockets) in the bucket of their local port with the
+ * peer set to (any, 0). A lookup then only inspects two buckets, so the
+ * cost does not depend on the number of connections of the node. The
+ * endpoints notify the demux when their peer changes.
  */
 
 class Ipv4EndPointDemux {
@@ -166,6 +175,84 @@ public:
   void DeAllocate (Ipv4EndPoint *endPoint);
 
 private:
+  friend class Ipv4EndPoint;
+
+  /**
+   * \brief Key of the endpoint index.
+   */
+  struct EndPointKey
+  {
+    uint16_t m_localPort;      //!< Local port
+    Ipv4Address m_peerAddress; //!< Peer address, any for a wildcard peer
+    uint16_t m_peerPort;       //!< Peer port, 0 for a wildcard peer
+
+    /**
+     * \brief Comparison operator
+     * \param other key to compare
+     * \return true if the keys are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the endpoint index keys.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Hash a key
+     * \param key the key
+     * \return the hash of the key
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the containers of the demux.
+   */
+  struct EndPointEntry
+  {
+    EndPointsI m_list;         //!< Position in m_endPoints
+    EndPointKey m_key;         //!< Bucket of the index holding the endpoint
+    EndPointsI m_bucket;       //!< Position in the bucket
+  };
+
+  /**
+   * \brief Add a newly allocated endpoint to the list and to the index.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Add an endpoint to the bucket matching its current four-tuple.
+   * \param entry the entry of the endpoint
+   * \param endPoint the end point
+   */
+  void Index (EndPointEntry &entry, Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from its bucket.
+   * \param entry the entry of the endpoint
+   */
+  void Unindex (const EndPointEntry &entry);
+
+  /**
+   * \brief Move an endpoint to the bucket of its new four-tuple.
+   *
+   * Called by the endpoint when its peer changes.
+   *
+   * \param endPoint the end point
+   */
+  void Rehash (Ipv4EndPoint *endPoint);
+
+  /**
+   * \brief Get the bucket of the index for a key.
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket, 0 if empty
+   */
+  const EndPoints *GetBucket (uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const;
 
   /**
    * \brief Allocate an ephemeral port.
@@ -192,6 +279,21 @@ private:
    * \brief A list of IPv4 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Index of the end points by local port and peer.
+   */
+  std::unordered_map<EndPointKey, EndPoints, EndPointKeyHash> m_index;
+
+  /**
+   * \brief Position of each end point in the list and in the index.
+   */
+  std::unordered_map<Ipv4EndPoint *, EndPointEntry> m_entries;
+
+  /**
+   * \brief Number of end points using each local port.
+   */
+  std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
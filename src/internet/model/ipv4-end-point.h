@@ -32,6 +32,7 @@ namespace ns3 {
 
 class Header;
 class Packet;
+class Ipv4EndPointDemux;
 
 /**
  * \ingroup ipv4
@@ -227,6 +228,12 @@ private:
    * \brief true if the endpoint can receive packets.
    */
   bool m_rxEnabled;
+  /**
+   * \brief The demux holding the endpoint, notified when the peer changes.
+   */
+  Ipv4EndPointDemux *m_demux;
+
+  friend class Ipv4EndPointDemux;
 };
 
 } // namespace ns3
@@ -59,7 +59,8 @@ Ipv4GlobalRouting::GetTypeId (void)
 
 Ipv4GlobalRouting::Ipv4GlobalRouting () 
   : m_randomEcmpRouting (false),
-    m_respondToInterfaceEvents (false)
+    m_respondToInterfaceEvents (false),
+    m_routeIndexValid (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -80,6 +81,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, nextHop, interface);
   m_hostRoutes.push_back (route);
+  m_routeIndexValid = false;
 }
 
 void 
@@ -90,6 +92,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, interface);
   m_hostRoutes.push_back (route);
+  m_routeIndexValid = false;
 }
 
 void 
@@ -105,6 +108,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_routeIndexValid = false;
 }
 
 void 
@@ -118,6 +122,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_routeIndexValid = false;
 }
 
 void 
@@ -146,13 +151,18 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
   typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
   RouteVec_t allRoutes;
 
+  if (!m_routeIndexValid)
+    {
+      BuildRouteIndex ();
+    }
+
   NS_LOG_LOGIC ("Number of m_hostRoutes = " << m_hostRoutes.size ());
-  for (HostRoutesCI i = m_hostRoutes.begin (); 
-       i != m_hostRoutes.end (); 
-       i++) 
+  HostRouteIndex::const_iterator hosts = m_hostRouteIndex.find (dest);
+  if (hosts != m_hostRouteIndex.end ())
     {
-      NS_ASSERT ((*i)->IsHost ());
-      if ((*i)->GetDest () == dest)
+      for (std::vector<Ipv4RoutingTableEntry *>::const_iterator i = hosts->second.begin ();
+           i != hosts->second.end ();
+           i++)
         {
           if (oif != 0)
             {
@@ -163,19 +173,16 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
                 }
             }
           allRoutes.push_back (*i);
-          NS_LOG_LOGIC (allRoutes.size () << "Found global host route" << *i); 
+          NS_LOG_LOGIC (allRoutes.size () << "Found global host route" << *i);
         }
     }
   if (allRoutes.size () == 0) // if no host route is found
     {
       NS_LOG_LOGIC ("Number of m_networkRoutes" << m_networkRoutes.size ());
-      for (NetworkRoutesI j = m_networkRoutes.begin (); 
-           j != m_networkRoutes.end (); 
-           j++) 
+      // the routes with the longest matching prefix are the candidates for ECMP
+      m_networkRouteIndex.Lookup (dest, [&] (uint8_t prefixLength, const NetworkRouteIndex::Bucket &bucket)
         {
-          Ipv4Mask mask = (*j)->GetDestNetworkMask ();
-          Ipv4Address entry = (*j)->GetDestNetwork ();
-          if (mask.IsMatch (dest, entry)) 
+          for (NetworkRouteIndex::Bucket::const_iterator j = bucket.begin (); j != bucket.end (); j++)
             {
               if (oif != 0)
                 {
@@ -188,7 +195,8 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
               allRoutes.push_back (*j);
               NS_LOG_LOGIC (allRoutes.size () << "Found global network route" << *j);
             }
-        }
+          return !allRoutes.empty ();
+        });
     }
   if (allRoutes.size () == 0)  // consider external if no host/network found
     {
@@ -245,6 +253,26 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+void
+Ipv4GlobalRouting::BuildRouteIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_hostRouteIndex.clear ();
+  m_networkRouteIndex.Clear ();
+  for (HostRoutesCI i = m_hostRoutes.begin (); i != m_hostRoutes.end (); i++)
+    {
+      NS_ASSERT ((*i)->IsHost ());
+      m_hostRouteIndex[(*i)->GetDest ()].push_back (*i);
+    }
+  for (NetworkRoutesCI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+    {
+      m_networkRouteIndex.Add ((*j)->GetDestNetwork (),
+                               (*j)->GetDestNetworkMask ().GetPrefixLength (),
+                               *j);
+    }
+  m_routeIndexValid = true;
+}
+
 uint32_t 
 Ipv4GlobalRouting::GetNRoutes (void) const
 {
@@ -321,6 +349,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
               NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
               delete *i;
               m_hostRoutes.erase (i);
+              m_routeIndexValid = false;
               NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
               return;
             }
@@ -338,6 +367,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
           delete *j;
           m_networkRoutes.erase (j);
+          m_routeIndexValid = false;
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
           return;
         }
@@ -392,6 +422,9 @@ Ipv4GlobalRouting::DoDispose (void)
     {
       delete (*l);
     }
+  m_hostRouteIndex.clear ();
+  m_networkRouteIndex.Clear ();
+  m_routeIndexValid = false;
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -537,9 +570,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -549,9 +580,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -561,9 +590,7 @@ Ipv4GlobalRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress ad
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -573,9 +600,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -28,6 +28,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "prefix-route-index.h"
 
 namespace ns3 {
 
@@ -268,10 +269,24 @@ private:
    */
   Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif = 0);
 
+  /**
+   * \brief Rebuild the indexes of the host and network routes.
+   */
+  void BuildRouteIndex (void);
+
+  /// index of the routes to hosts, by destination
+  typedef std::unordered_map<Ipv4Address, std::vector<Ipv4RoutingTableEntry *>, Ipv4AddressHash> HostRouteIndex;
+  /// index of the routes to networks
+  typedef PrefixRouteIndex<Ipv4Address, Ipv4AddressHash, 32, Ipv4RoutingTableEntry *> NetworkRouteIndex;
+
   HostRoutes m_hostRoutes;             //!< Routes to hosts
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
   ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+  HostRouteIndex m_hostRouteIndex;       //!< Index of m_hostRoutes
+  NetworkRouteIndex m_networkRouteIndex; //!< Longest prefix match index of m_networkRoutes
+  bool m_routeIndexValid;                //!< False if the routes changed since the indexes were built
+
   Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -54,7 +54,8 @@ Ipv4StaticRouting::GetTypeId (void)
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting () 
-  : m_ipv4 (0)
+  : m_routeIndexValid (false),
+    m_ipv4 (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -73,6 +74,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (make_pair (route,metric));
+  m_routeIndexValid = false;
 }
 
 void 
@@ -87,6 +89,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (make_pair (route,metric));
+  m_routeIndexValid = false;
 }
 
 void 
@@ -144,6 +147,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
                                                         networkMask,
                                                         outputInterface);
   m_networkRoutes.push_back (make_pair (route,0));
+  m_routeIndexValid = false;
 }
 
 uint32_t 
@@ -224,8 +228,6 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
 {
   NS_LOG_FUNCTION (this << dest << " " << oif);
   Ptr<Ipv4Route> rtentry = 0;
-  uint16_t longest_mask = 0;
-  uint32_t shortest_metric = 0xffffffff;
   /* when sending on local multicast, there have to be interface specified */
   if (dest.IsLocalMulticast ())
     {
@@ -240,19 +242,24 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
-       i++) 
+  if (!m_routeIndexValid)
     {
-      Ipv4RoutingTableEntry *j=i->first;
-      uint32_t metric =i->second;
-      Ipv4Mask mask = (j)->GetDestNetworkMask ();
-      uint16_t masklen = mask.GetPrefixLength ();
-      Ipv4Address entry = (j)->GetDestNetwork ();
-      NS_LOG_LOGIC ("Searching for route to " << dest << ", checking against route to " << entry << "/" << masklen);
-      if (mask.IsMatch (dest, entry)) 
+      BuildRouteIndex ();
+    }
+
+  // The index returns the matching routes from the longest mask: the first
+  // mask length with a route on the requested interface wins, and among its
+  // routes the one with the smallest metric (the last one in case of ties,
+  // the first one for host routes).
+  Ipv4RoutingTableEntry *route = 0;
+  m_networkRouteIndex.Lookup (dest, [&] (uint8_t masklen, const NetworkRouteIndex::Bucket &bucket)
+    {
+      uint32_t shortest_metric = 0xffffffff;
+      for (NetworkRouteIndex::Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
         {
-          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << masklen << ", metric " << metric);
+          Ipv4RoutingTableEntry *j = i->first;
+          uint32_t metric = i->second;
+          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << uint16_t (masklen) << ", metric " << metric);
           if (oif != 0)
             {
               if (oif != m_ipv4->GetNetDevice (j->GetInterface ()))
@@ -261,34 +268,29 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
                   continue;
                 }
             }
-          if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-              NS_LOG_LOGIC ("Previous match longer, skipping");
-              continue;
-            }
-          if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-              shortest_metric = 0xffffffff;
-            }
-          longest_mask = masklen;
           if (metric > shortest_metric)
             {
               NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
               continue;
             }
           shortest_metric = metric;
-          Ipv4RoutingTableEntry* route = (j);
-          uint32_t interfaceIdx = route->GetInterface ();
-          rtentry = Create<Ipv4Route> ();
-          rtentry->SetDestination (route->GetDest ());
-          rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
-          rtentry->SetGateway (route->GetGateway ());
-          rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+          route = j;
           if (masklen == 32)
             {
               break;
             }
         }
+      return route != 0;
+    });
+
+  if (route != 0)
+    {
+      uint32_t interfaceIdx = route->GetInterface ();
+      rtentry = Create<Ipv4Route> ();
+      rtentry->SetDestination (route->GetDest ());
+      rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
     }
   if (rtentry != 0)
     {
@@ -301,6 +303,20 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
   return rtentry;
 }
 
+void
+Ipv4StaticRouting::BuildRouteIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_networkRouteIndex.Clear ();
+  for (NetworkRoutesCI i = m_networkRoutes.begin (); i != m_networkRoutes.end (); i++)
+    {
+      m_networkRouteIndex.Add (i->first->GetDestNetwork (),
+                               i->first->GetDestNetworkMask ().GetPrefixLength (),
+                               *i);
+    }
+  m_routeIndexValid = true;
+}
+
 Ptr<Ipv4MulticastRoute>
 Ipv4StaticRouting::LookupStatic (
   Ipv4Address origin, 
@@ -449,6 +465,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
         {
           delete j->first;
           m_networkRoutes.erase (j);
+          m_routeIndexValid = false;
           return;
         }
       tmp++;
@@ -575,6 +592,8 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  m_networkRouteIndex.Clear ();
+  m_routeIndexValid = false;
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -615,6 +634,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
         }
       else
         {
@@ -662,6 +682,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
         }
       else
         {
@@ -31,6 +31,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "prefix-route-index.h"
 
 namespace ns3 {
 
@@ -394,11 +395,29 @@ private:
   Ptr<Ipv4MulticastRoute> LookupStatic (Ipv4Address origin, Ipv4Address group,
                                         uint32_t interface);
 
+  /**
+   * \brief Rebuild the longest prefix match index of the network routes.
+   */
+  void BuildRouteIndex (void);
+
+  /// Longest prefix match index of the network routes, with their metric
+  typedef PrefixRouteIndex<Ipv4Address, Ipv4AddressHash, 32, std::pair <Ipv4RoutingTableEntry *, uint32_t> > NetworkRouteIndex;
+
   /**
    * \brief the forwarding table for network.
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief Index of m_networkRoutes, used by the unicast lookups.
+   */
+  NetworkRouteIndex m_networkRouteIndex;
+
+  /**
+   * \brief False if the routes changed since the index was built.
+   */
+  bool m_routeIndexValid;
+
   /**
    * \brief the forwarding table for multicast.
    */
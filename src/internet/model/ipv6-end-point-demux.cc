@@ -40,27 +40,103 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux ()
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
     {
       Ipv6EndPoint *endPoint = *i;
+      endPoint->m_demux = 0;
       delete endPoint;
     }
   m_endPoints.clear ();
+  m_index.clear ();
+  m_entries.clear ();
+  m_localPorts.clear ();
 }
 
-bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+bool Ipv6EndPointDemux::EndPointKey::operator== (const EndPointKey &other) const
 {
-  NS_LOG_FUNCTION (this << port);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  return m_localPort == other.m_localPort
+         && m_peerPort == other.m_peerPort
+         && m_peerAddress == other.m_peerAddress;
+}
+
+size_t Ipv6EndPointDemux::EndPointKeyHash::operator() (const EndPointKey &key) const
+{
+  size_t h = Ipv6AddressHash () (key.m_peerAddress);
+  h ^= ((static_cast<size_t> (key.m_localPort) << 16) | key.m_peerPort) * 0x9e3779b97f4a7c15ULL;
+  return h;
+}
+
+void Ipv6EndPointDemux::Insert (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  m_endPoints.push_back (endPoint);
+  EndPointEntry &entry = m_entries[endPoint];
+  entry.m_list = std::prev (m_endPoints.end ());
+  Index (entry, endPoint);
+  endPoint->m_demux = this;
+  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+}
+
+void Ipv6EndPointDemux::Index (EndPointEntry &entry, Ipv6EndPoint *endPoint)
+{
+  entry.m_key.m_localPort = endPoint->GetLocalPort ();
+  entry.m_key.m_peerAddress = endPoint->GetPeerAddress ();
+  entry.m_key.m_peerPort = endPoint->GetPeerPort ();
+  EndPoints &bucket = m_index[entry.m_key];
+  entry.m_bucket = bucket.insert (bucket.end (), endPoint);
+  m_localPorts[entry.m_key.m_localPort]++;
+}
+
+void Ipv6EndPointDemux::Unindex (const EndPointEntry &entry)
+{
+  auto bucket = m_index.find (entry.m_key);
+  NS_ASSERT (bucket != m_index.end ());
+  bucket->second.erase (entry.m_bucket);
+  if (bucket->second.empty ())
     {
-      if ((*i)->GetLocalPort  () == port)
-        {
-          return true;
-        }
+      m_index.erase (bucket);
+    }
+  auto port = m_localPorts.find (entry.m_key.m_localPort);
+  NS_ASSERT (port != m_localPorts.end () && port->second > 0);
+  if (--port->second == 0)
+    {
+      m_localPorts.erase (port);
     }
-  return false;
+}
+
+void Ipv6EndPointDemux::Rehash (Ipv6EndPoint *endPoint)
+{
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_entries.find (endPoint);
+  NS_ASSERT (it != m_entries.end ());
+  Unindex (it->second);
+  Index (it->second, endPoint);
+}
+
+const Ipv6EndPointDemux::EndPoints* Ipv6EndPointDemux::GetBucket (uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const
+{
+  EndPointKey key;
+  key.m_localPort = localPort;
+  key.m_peerAddress = peerAddress;
+  key.m_peerPort = peerPort;
+  auto it = m_index.find (key);
+  if (it == m_index.end ())
+    {
+      return 0;
+    }
+  return &it->second;
+}
+
+bool Ipv6EndPointDemux::LookupPortLocal (uint16_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+  return m_localPorts.find (port) != m_localPorts.end ();
 }
 
 bool Ipv6EndPointDemux::LookupLocal (Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
   NS_LOG_FUNCTION (this << addr << port);
+  if (!LookupPortLocal (port))
+    {
+      return false;
+    }
   for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
     {
       if ((*i)->GetLocalPort () == port &&
@@ -83,8 +159,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate ()
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (Ipv6Address::GetAny (), port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -98,8 +173,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ipv6Address address)
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -119,8 +193,7 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice, Ipv6Ad
       return 0;
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (address, port);
-  m_endPoints.push_back (endPoint);
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
+  Insert (endPoint);
   return endPoint;
 }
 
@@ -129,39 +202,38 @@ Ipv6EndPoint* Ipv6EndPointDemux::Allocate (Ptr<NetDevice> boundNetDevice,
                                            Ipv6Address peerAddress, uint16_t peerPort)
 {
   NS_LOG_FUNCTION (this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  const EndPoints *bucket = GetBucket (localPort, peerAddress, peerPort);
+  if (bucket != 0)
     {
-      if ((*i)->GetLocalPort () == localPort &&
-          (*i)->GetLocalAddress () == localAddress &&
-          (*i)->GetPeerPort () == peerPort &&
-          (*i)->GetPeerAddress () == peerAddress &&
-          ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
         {
-          NS_LOG_WARN ("Duplicated endpoint.");
-          return 0;
+          if ((*i)->GetLocalAddress () == localAddress &&
+              ((*i)->GetBoundNetDevice () == boundNetDevice || (*i)->GetBoundNetDevice () == 0))
+            {
+              NS_LOG_WARN ("Duplicated endpoint.");
+              return 0;
+            }
         }
     }
   Ipv6EndPoint *endPoint = new Ipv6EndPoint (localAddress, localPort);
   endPoint->SetPeer (peerAddress, peerPort);
-  m_endPoints.push_back (endPoint);
-
-  NS_LOG_DEBUG ("Now have >>" << m_endPoints.size () << "<< endpoints.");
-
+  Insert (endPoint);
   return endPoint;
 }
 
 void Ipv6EndPointDemux::DeAllocate (Ipv6EndPoint *endPoint)
 {
-  NS_LOG_FUNCTION (this);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
+  NS_LOG_FUNCTION (this << endPoint);
+  auto it = m_entries.find (endPoint);
+  if (it == m_entries.end ())
     {
-      if (*i == endPoint)
-        {
-          delete endPoint;
-          m_endPoints.erase (i);
-          break;
-        }
+      return;
     }
+  Unindex (it->second);
+  m_endPoints.erase (it->second.m_list);
+  m_entries.erase (it);
+  endPoint->m_demux = 0;
+  delete endPoint;
 }
 
 /*
@@ -181,99 +253,115 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
   EndPoints retval4; /* Exact match on all 4 */
 
   NS_LOG_DEBUG ("Looking up endpoint for destination address " << daddr);
-  for (EndPointsI i = m_endPoints.begin (); i != m_endPoints.end (); i++)
-    {
-      Ipv6EndPoint* endP = *i;
 
-      NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
-                                                 << " daddr=" << endP->GetLocalAddress ()
-                                                 << " sport=" << endP->GetPeerPort ()
-                                                 << " saddr=" << endP->GetPeerAddress ());
+  /* Only the endpoints connected to the source and the ones with a wildcard
+     peer can match (the peer must match either exactly or with wildcards). */
+  const EndPoints *buckets[2] = { GetBucket (dport, saddr, sport), 0 };
+  if (saddr != Ipv6Address::GetAny () || sport != 0)
+    {
+      buckets[1] = GetBucket (dport, Ipv6Address::GetAny (), 0);
+    }
 
-      if (!endP->IsRxEnabled ())
+  for (const EndPoints *bucket : buckets)
+    {
+      if (bucket == 0)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                        << " because endpoint can not receive packets");
           continue;
         }
-
-      if (endP->GetLocalPort () != dport)
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
         {
-          NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                             << " because endpoint dport "
-                                             << endP->GetLocalPort ()
-                                             << " does not match packet dport " << dport);
-          continue;
-        }
+          Ipv6EndPoint* endP = *i;
 
-      if (endP->GetBoundNetDevice ())
-        {
-          if (!incomingInterface)
+          NS_LOG_DEBUG ("Looking at endpoint dport=" << endP->GetLocalPort ()
+                                                     << " daddr=" << endP->GetLocalAddress ()
+                                                     << " sport=" << endP->GetPeerPort ()
+                                                     << " saddr=" << endP->GetPeerAddress ());
+
+          if (!endP->IsRxEnabled ())
             {
+              NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                            << " because endpoint can not receive packets");
               continue;
             }
-          if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+
+          if (endP->GetLocalPort () != dport)
             {
               NS_LOG_LOGIC ("Skipping endpoint " << &endP
-                                                 << " because endpoint is bound to specific device and"
-                                                 << endP->GetBoundNetDevice ()
-                                                 << " does not match packet device " << incomingInterface->GetDevice ());
+                                                 << " because endpoint dport "
+                                                 << endP->GetLocalPort ()
+                                                 << " does not match packet dport " << dport);
               continue;
             }
-        }
 
-      /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-      NS_LOG_DEBUG ("dest addr " << daddr);
+          if (endP->GetBoundNetDevice ())
+            {
+              if (!incomingInterface)
+                {
+                  continue;
+                }
+              if (endP->GetBoundNetDevice () != incomingInterface->GetDevice ())
+                {
+                  NS_LOG_LOGIC ("Skipping endpoint " << &endP
+                                                     << " because endpoint is bound to specific device and"
+                                                     << endP->GetBoundNetDevice ()
+                                                     << " does not match packet device " << incomingInterface->GetDevice ());
+                  continue;
+                }
+            }
 
-      bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
-      bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
-      bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
+          /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+          NS_LOG_DEBUG ("dest addr " << daddr);
 
-      /* if no match here, keep looking */
-      if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-          continue;
-        }
-      bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
-      bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
-      bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
-      bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
-
-      /* If remote does not match either with exact or wildcard,i
-         skip this one */
-      if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-          continue;
-        }
-      if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-          continue;
-        }
+          bool localAddressMatchesWildCard = endP->GetLocalAddress () == Ipv6Address::GetAny ();
+          bool localAddressMatchesExact = endP->GetLocalAddress () == daddr;
+          bool localAddressMatchesAllRouters = endP->GetLocalAddress () == Ipv6Address::GetAllRoutersMulticast ();
 
-      /* Now figure out which return list to add this one to */
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-          retval1.push_back (endP);
-        }
-      if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
-          && remotePeerMatchesWildCard
-          && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-          retval2.push_back (endP);
-        }
-      if (localAddressMatchesWildCard
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All but local address */
-          retval3.push_back (endP);
-        }
-      if (localAddressMatchesExact
-          && remotePeerMatchesExact
-          && remoteAddressMatchesExact)
-        { /* All 4 match */
-          retval4.push_back (endP);
+          /* if no match here, keep looking */
+          if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+              continue;
+            }
+          bool remotePeerMatchesExact = endP->GetPeerPort () == sport;
+          bool remotePeerMatchesWildCard = endP->GetPeerPort () == 0;
+          bool remoteAddressMatchesExact = endP->GetPeerAddress () == saddr;
+          bool remoteAddressMatchesWildCard = endP->GetPeerAddress () == Ipv6Address::GetAny ();
+
+          /* If remote does not match either with exact or wildcard,i
+             skip this one */
+          if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+              continue;
+            }
+          if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+              continue;
+            }
+
+          /* Now figure out which return list to add this one to */
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+              retval1.push_back (endP);
+            }
+          if ((localAddressMatchesExact || (localAddressMatchesAllRouters))
+              && remotePeerMatchesWildCard
+              && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+              retval2.push_back (endP);
+            }
+          if (localAddressMatchesWildCard
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All but local address */
+              retval3.push_back (endP);
+            }
+          if (localAddressMatchesExact
+              && remotePeerMatchesExact
+              && remoteAddressMatchesExact)
+            { /* All 4 match */
+              retval4.push_back (endP);
+            }
         }
     }
 
@@ -290,6 +378,25 @@ Ipv6EndPointDemux::EndPoints Ipv6EndPointDemux::Lookup (Ipv6Address daddr, uint1
 
 Ipv6EndPoint* Ipv6EndPointDemux::SimpleLookup (Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+  NS_LOG_FUNCTION (this << dst << dport << src << sport);
+
+  /* fast path: the exact match is in the bucket of the four-tuple */
+  const EndPoints *bucket = GetBucket (dport, src, sport);
+  if (bucket != 0)
+    {
+      for (EndPoints::const_iterator i = bucket->begin (); i != bucket->end (); i++)
+        {
+          if ((*i)->GetLocalAddress () == dst)
+            {
+              return *i;
+            }
+        }
+    }
+  if (!LookupPortLocal (dport))
+    {
+      return 0;
+    }
+
   uint32_t genericity = 3;
   Ipv6EndPoint *generic = 0;
 
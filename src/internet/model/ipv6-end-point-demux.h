@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <unordered_map>
 #include "ns3/ipv6-address.h"
 #include "ipv6-interface.h"
 
@@ -34,6 +35,12 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, the endpoints are indexed in a hash table keyed
+ * by local port, peer address and peer port, the endpoints with a wildcard
+ * peer being in the bucket of their local port with the peer set to
+ * (any, 0). A lookup only inspects the bucket of the four-tuple and the
+ * wildcard one.
  */
 class Ipv6EndPointDemux
 {
@@ -153,6 +160,85 @@ public:
   EndPoints GetEndPoints () const;
 
 private:
+  friend class Ipv6EndPoint;
+
+  /**
+   * \brief Key of the endpoint index.
+   */
+  struct EndPointKey
+  {
+    uint16_t m_localPort;      //!< Local port
+    Ipv6Address m_peerAddress; //!< Peer address, any for a wildcard peer
+    uint16_t m_peerPort;       //!< Peer port, 0 for a wildcard peer
+
+    /**
+     * \brief Comparison operator
+     * \param other key to compare
+     * \return true if the keys are equal
+     */
+    bool operator== (const EndPointKey &other) const;
+  };
+
+  /**
+   * \brief Hash function of the endpoint index keys.
+   */
+  struct EndPointKeyHash
+  {
+    /**
+     * \brief Hash a key
+     * \param key the key
+     * \return the hash of the key
+     */
+    size_t operator() (const EndPointKey &key) const;
+  };
+
+  /**
+   * \brief Position of an endpoint in the containers of the demux.
+   */
+  struct EndPointEntry
+  {
+    EndPointsI m_list;         //!< Position in m_endPoints
+    EndPointKey m_key;         //!< Bucket of the index holding the endpoint
+    EndPointsI m_bucket;       //!< Position in the bucket
+  };
+
+  /**
+   * \brief Add a newly allocated endpoint to the list and to the index.
+   * \param endPoint the end point
+   */
+  void Insert (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Add an endpoint to the bucket matching its current four-tuple.
+   * \param entry the entry of the endpoint
+   * \param endPoint the end point
+   */
+  void Index (EndPointEntry &entry, Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Remove an endpoint from its bucket.
+   * \param entry the entry of the endpoint
+   */
+  void Unindex (const EndPointEntry &entry);
+
+  /**
+   * \brief Move an endpoint to the bucket of its new four-tuple.
+   *
+   * Called by the endpoint when its local port or its peer changes.
+   *
+   * \param endPoint the end point
+   */
+  void Rehash (Ipv6EndPoint *endPoint);
+
+  /**
+   * \brief Get the bucket of the index for a key.
+   * \param localPort local port
+   * \param peerAddress peer address
+   * \param peerPort peer port
+   * \return the bucket, 0 if empty
+   */
+  const EndPoints *GetBucket (uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const;
+
   /**
    * \brief Allocate a ephemeral port.
    * \return a port
@@ -178,6 +264,21 @@ private:
    * \brief A list of IPv6 end points.
    */
   EndPoints m_endPoints;
+
+  /**
+   * \brief Index of the end points by local port and peer.
+   */
+  std::unordered_map<EndPointKey, EndPoints, EndPointKeyHash> m_index;
+
+  /**
+   * \brief Position of each end point in the list and in the index.
+   */
+  std::unordered_map<Ipv6EndPoint *, EndPointEntry> m_entries;
+
+  /**
+   * \brief Number of end points using each local port.
+   */
+  std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
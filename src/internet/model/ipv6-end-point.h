@@ -34,6 +34,7 @@ namespace ns3
 
 class Header;
 class Packet;
+class Ipv6EndPointDemux;
 
 /**
  * \ingroup ipv6
@@ -236,6 +237,12 @@ private:
    * \brief true if the endpoint can receive packets.
    */
   bool m_rxEnabled;
+  /**
+   * \brief The demux holding the endpoint, notified when the peer changes.
+   */
+  Ipv6EndPointDemux *m_demux;
+
+  friend class Ipv6EndPointDemux;
 };
 
 } /* namespace ns3 */
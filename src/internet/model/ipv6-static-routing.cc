@@ -47,7 +47,8 @@ TypeId Ipv6StaticRouting::GetTypeId ()
 }
 
 Ipv6StaticRouting::Ipv6StaticRouting ()
-  : m_ipv6 (0)
+  : m_routeIndexValid (false),
+    m_ipv6 (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -152,6 +153,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface);
   m_networkRoutes.push_back (std::make_pair (route, metric));
+  m_routeIndexValid = false;
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -165,6 +167,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface, prefixToUse);
   m_networkRoutes.push_back (std::make_pair (route, metric));
+  m_routeIndexValid = false;
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface, uint32_t metric)
@@ -173,6 +176,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, interface);
   m_networkRoutes.push_back (std::make_pair (route, metric));
+  m_routeIndexValid = false;
 }
 
 void Ipv6StaticRouting::SetDefaultRoute (Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -197,6 +201,7 @@ void Ipv6StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   Ipv6Prefix networkMask = Ipv6Prefix (8);
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, outputInterface);
   m_networkRoutes.push_back (std::make_pair (route, 0));
+  m_routeIndexValid = false;
 }
 
 uint32_t Ipv6StaticRouting::GetNMulticastRoutes () const
@@ -285,8 +290,6 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
 {
   NS_LOG_FUNCTION (this << dst << interface);
   Ptr<Ipv6Route> rtentry = 0;
-  uint16_t longestMask = 0;
-  uint32_t shortestMetric = 0xffffffff;
 
   /* when sending on link-local multicast, there have to be interface specified */
   if (dst.IsLinkLocalMulticast ())
@@ -300,68 +303,66 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
       return rtentry;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  if (!m_routeIndexValid)
     {
-      Ipv6RoutingTableEntry* j = it->first;
-      uint32_t metric = it->second;
-      Ipv6Prefix mask = j->GetDestNetworkPrefix ();
-      uint16_t maskLen = mask.GetPrefixLength ();
-      Ipv6Address entry = j->GetDestNetwork ();
-
-      NS_LOG_LOGIC ("Searching for route to " << dst << ", mask length " << maskLen << ", metric " << metric);
+      BuildRouteIndex ();
+    }
 
-      if (mask.IsMatch (dst, entry))
+  /* The index returns the matching routes from the longest prefix: the first
+     prefix length with a route on the requested interface wins, and among its
+     routes the one with the smallest metric (the last one in case of ties,
+     the first one for host routes). */
+  Ipv6RoutingTableEntry* route = 0;
+  m_networkRouteIndex.Lookup (dst, [&] (uint8_t maskLen, const NetworkRouteIndex::Bucket &bucket)
+    {
+      uint32_t shortestMetric = 0xffffffff;
+      for (NetworkRouteIndex::Bucket::const_iterator it = bucket.begin (); it != bucket.end (); it++)
         {
-          NS_LOG_LOGIC ("Found global network route " << *j << ", mask length " << maskLen << ", metric " << metric);
+          Ipv6RoutingTableEntry* j = it->first;
+          uint32_t metric = it->second;
+          NS_LOG_LOGIC ("Found global network route " << *j << ", mask length " << uint16_t (maskLen) << ", metric " << metric);
 
           /* if interface is given, check the route will output on this interface */
-          if (!interface || interface == m_ipv6->GetNetDevice (j->GetInterface ()))
+          if (interface && interface != m_ipv6->GetNetDevice (j->GetInterface ()))
             {
-              if (maskLen < longestMask)
-                {
-                  NS_LOG_LOGIC ("Previous match longer, skipping");
-                  continue;
-                }
-
-              if (maskLen > longestMask)
-                {
-                  shortestMetric = 0xffffffff;
-                }
-
-              longestMask = maskLen;
-              if (metric > shortestMetric)
-                {
-                  NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
-                  continue;
-                }
-
-              shortestMetric = metric;
-              Ipv6RoutingTableEntry* route = j;
-              uint32_t interfaceIdx = route->GetInterface ();
-              rtentry = Create<Ipv6Route> ();
+              continue;
+            }
+          if (metric > shortestMetric)
+            {
+              NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
+              continue;
+            }
+          shortestMetric = metric;
+          route = j;
+          if (maskLen == 128)
+            {
+              break;
+            }
+        }
+      return route != 0;
+    });
 
-              if (route->GetGateway ().IsAny ())
-                {
-                  rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetDest ()));
-                }
-              else if (route->GetDest ().IsAny ()) /* default route */
-                {
-                  rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetPrefixToUse ().IsAny () ? dst : route->GetPrefixToUse ()));
-                }
-              else
-                {
-                  rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetGateway ()));
-                }
+  if (route)
+    {
+      uint32_t interfaceIdx = route->GetInterface ();
+      rtentry = Create<Ipv6Route> ();
 
-              rtentry->SetDestination (route->GetDest ());
-              rtentry->SetGateway (route->GetGateway ());
-              rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIdx));
-              if (maskLen == 128)
-                {
-                  break;
-                }
-            }
+      if (route->GetGateway ().IsAny ())
+        {
+          rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetDest ()));
         }
+      else if (route->GetDest ().IsAny ()) /* default route */
+        {
+          rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetPrefixToUse ().IsAny () ? dst : route->GetPrefixToUse ()));
+        }
+      else
+        {
+          rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIdx, route->GetGateway ()));
+        }
+
+      rtentry->SetDestination (route->GetDest ());
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIdx));
     }
 
   if (rtentry)
@@ -371,6 +372,20 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
   return rtentry;
 }
 
+void Ipv6StaticRouting::BuildRouteIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  m_networkRouteIndex.Clear ();
+  for (NetworkRoutesCI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+    {
+      // the lookup matches the mask, whatever the prefix length says
+      m_networkRouteIndex.Add (it->first->GetDestNetwork (),
+                               it->first->GetDestNetworkPrefix ().GetMinimumPrefixLength (),
+                               *it);
+    }
+  m_routeIndexValid = true;
+}
+
 void Ipv6StaticRouting::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -380,6 +395,8 @@ void Ipv6StaticRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_networkRouteIndex.Clear ();
+  m_routeIndexValid = false;
 
   for (MulticastRoutesI i = m_multicastRoutes.begin (); i != m_multicastRoutes.end (); i = m_multicastRoutes.erase (i))
     {
@@ -530,6 +547,7 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
         {
           delete it->first;
           m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
           return;
         }
       tmp++;
@@ -549,6 +567,7 @@ void Ipv6StaticRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uin
         {
           delete it->first;
           m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
           return;
         }
     }
@@ -674,6 +693,7 @@ void Ipv6StaticRouting::NotifyInterfaceDown (uint32_t i)
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
         }
       else
         {
@@ -719,6 +739,7 @@ void Ipv6StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAd
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          m_routeIndexValid = false;
         }
       else
         {
@@ -763,6 +784,7 @@ void Ipv6StaticRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv
             {
               delete j->first;
               j = m_networkRoutes.erase (j);
+              m_routeIndexValid = false;
             }
           else
             {
@@ -30,6 +30,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "prefix-route-index.h"
 
 namespace ns3 {
 
@@ -281,11 +282,29 @@ private:
    */
   Ptr<Ipv6MulticastRoute> LookupStatic (Ipv6Address origin, Ipv6Address group, uint32_t ifIndex);
 
+  /**
+   * \brief Rebuild the longest prefix match index of the network routes.
+   */
+  void BuildRouteIndex ();
+
+  /// Longest prefix match index of the network routes, with their metric
+  typedef PrefixRouteIndex<Ipv6Address, Ipv6AddressHash, 128, std::pair <Ipv6RoutingTableEntry *, uint32_t> > NetworkRouteIndex;
+
   /**
    * \brief the forwarding table for network.
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief Index of m_networkRoutes, used by the unicast lookups.
+   */
+  NetworkRouteIndex m_networkRouteIndex;
+
+  /**
+   * \brief False if the routes changed since the index was built.
+   */
+  bool m_routeIndexValid;
+
   /**
    * \brief the forwarding table for multicast.
    */
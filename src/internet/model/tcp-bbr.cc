@@ -0,0 +1,700 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "tcp-bbr.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpBbr");
+
+NS_OBJECT_ENSURE_REGISTERED (TcpBbr);
+
+const char* const
+TcpBbr::BbrModeName[TcpBbr::BBR_PROBE_RTT + 1] =
+{
+  "BBR_STARTUP", "BBR_DRAIN", "BBR_PROBE_BW", "BBR_PROBE_RTT"
+};
+
+namespace {
+
+const uint32_t CYCLE_LEN = 8;   //!< Number of phases of the PROBE_BW gain cycle
+const double PACING_GAIN[CYCLE_LEN] = { 1.25, 0.75, 1, 1, 1, 1, 1, 1 }; //!< PROBE_BW pacing gains
+const double CWND_GAIN = 2;     //!< cwnd gain in PROBE_BW
+const double PACING_MARGIN = 0.99; //!< Pace slightly below the estimated bandwidth
+const double FULL_BW_THRESH = 1.25; //!< Growth of the bandwidth which means the pipe is not full yet
+const uint32_t FULL_BW_COUNT = 3;   //!< Rounds without growth to consider the pipe full
+const uint32_t CWND_MIN_TARGET = 4; //!< Minimum cwnd, in segments
+
+} // anonymous namespace
+
+TypeId
+TcpBbr::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TcpBbr")
+    .SetParent<TcpCongestionOps> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<TcpBbr> ()
+    .AddAttribute ("HighGain", "Pacing and cwnd gain of the STARTUP mode",
+                   DoubleValue (2.885),
+                   MakeDoubleAccessor (&TcpBbr::m_highGain),
+                   MakeDoubleChecker<double> (1.0))
+    .AddAttribute ("BwWindowLength", "Length of the bottleneck bandwidth filter, in rounds",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&TcpBbr::m_bwWindowLength),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RttWindowLength", "Length of the round-trip propagation time filter",
+                   TimeValue (Seconds (10)),
+                   MakeTimeAccessor (&TcpBbr::m_rtPropWindowLength),
+                   MakeTimeChecker ())
+    .AddAttribute ("ProbeRttDuration", "Minimum time spent in the PROBE_RTT mode",
+                   TimeValue (MilliSeconds (200)),
+                   MakeTimeAccessor (&TcpBbr::m_probeRttDuration),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+TcpBbr::TcpBbr ()
+  : TcpCongestionOps ()
+{
+  NS_LOG_FUNCTION (this);
+  m_uv = CreateObject<UniformRandomVariable> ();
+}
+
+TcpBbr::TcpBbr (const TcpBbr &sock)
+  : TcpCongestionOps (sock),
+    m_highGain (sock.m_highGain),
+    m_bwWindowLength (sock.m_bwWindowLength),
+    m_rtPropWindowLength (sock.m_rtPropWindowLength),
+    m_probeRttDuration (sock.m_probeRttDuration)
+{
+  NS_LOG_FUNCTION (this);
+  m_uv = CreateObject<UniformRandomVariable> ();
+  m_uv->SetStream (sock.m_uv->GetStream ());
+}
+
+TcpBbr::~TcpBbr ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+int64_t
+TcpBbr::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_uv->SetStream (stream);
+  return 1;
+}
+
+std::string
+TcpBbr::GetName () const
+{
+  return "TcpBbr";
+}
+
+void
+TcpBbr::Init (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  if (!tcb->m_pacing)
+    {
+      NS_LOG_INFO ("BBR needs pacing, enabling it");
+      tcb->m_pacing = true;
+    }
+}
+
+void
+TcpBbr::InitState (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  m_initialized = true;
+  m_minRtt = tcb->m_minRtt;
+  m_minRttStamp = Simulator::Now ();
+  m_roundCount = 0;
+  m_nextRoundDelivered = 0;
+  for (MaxBwSample &s : m_maxBw)
+    {
+      s = MaxBwSample ();
+    }
+  m_cycleStamp = Simulator::Now ();
+  m_mode = BBR_STARTUP;
+  UpdateGains ();
+  InitPacingRate (tcb);
+}
+
+uint32_t
+TcpBbr::GetSsThresh (Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
+{
+  NS_LOG_FUNCTION (this << tcb << bytesInFlight);
+  // BBR does not use ssthresh to react to losses; just remember cwnd to
+  // restore it when the recovery is over
+  SaveCwnd (tcb);
+  return tcb->m_ssThresh;
+}
+
+void
+TcpBbr::IncreaseWindow (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
+{
+  NS_LOG_FUNCTION (this << tcb << segmentsAcked);
+  // cwnd is updated in CongControl
+}
+
+void
+TcpBbr::CongestionStateSet (Ptr<TcpSocketState> tcb,
+                            const TcpSocketState::TcpCongState_t newState)
+{
+  NS_LOG_FUNCTION (this << tcb << newState);
+  if (newState == TcpSocketState::CA_LOSS)
+    {
+      // After an RTO, the bandwidth has to be probed again from scratch
+      m_prevCaState = TcpSocketState::CA_LOSS;
+      m_fullBw = DataRate (0);
+      m_roundStart = true;
+    }
+}
+
+void
+TcpBbr::CwndEvent (Ptr<TcpSocketState> tcb,
+                   const TcpSocketState::TcpCAEvent_t event)
+{
+  NS_LOG_FUNCTION (this << tcb << event);
+  if (event != TcpSocketState::CA_EVENT_TX_START)
+    {
+      return;
+    }
+
+  if (!m_initialized)
+    {
+      InitState (tcb);
+      return;
+    }
+
+  // Restarting after idle: avoid a burst at the pacing gain of the cycle
+  m_idleRestart = true;
+  if (m_mode == BBR_PROBE_BW)
+    {
+      SetPacingRate (tcb, 1.0);
+    }
+  else if (m_mode == BBR_PROBE_RTT)
+    {
+      CheckProbeRttDone (tcb);
+    }
+}
+
+bool
+TcpBbr::HasCongControl () const
+{
+  return true;
+}
+
+void
+TcpBbr::CongControl (Ptr<TcpSocketState> tcb,
+                     const TcpRateOps::TcpRateConnection &rc,
+                     const TcpRateOps::TcpRateSample &rs)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  if (!m_initialized)
+    {
+      InitState (tcb);
+    }
+
+  UpdateBw (rc, rs);
+  UpdateCyclePhase (tcb, rs);
+  CheckFullBwReached (rs);
+  CheckDrain (tcb);
+  UpdateMinRtt (tcb, rc, rs);
+  UpdateGains ();
+
+  SetPacingRate (tcb, m_pacingGain);
+  SetCwnd (tcb, rc, rs);
+
+  NS_LOG_DEBUG (BbrModeName[m_mode] << " btlBw " << GetBtlBw () <<
+                " rtProp " << m_minRtt << " pacing rate " << tcb->m_currentPacingRate <<
+                " cwnd " << tcb->m_cWnd);
+}
+
+void
+TcpBbr::ReduceCwnd (Ptr<TcpSocketState> tcb)
+{
+  NS_LOG_FUNCTION (this << tcb);
+  // BBR v1 does not react to ECN
+}
+
+Ptr<TcpCongestionOps>
+TcpBbr::Fork (void)
+{
+  return CopyObject<TcpBbr> (this);
+}
+
+TcpBbr::BbrMode_t
+TcpBbr::GetMode () const
+{
+  return m_mode;
+}
+
+DataRate
+TcpBbr::GetBtlBw () const
+{
+  return m_maxBw[0].m_bw;
+}
+
+Time
+TcpBbr::GetRtProp () const
+{
+  return m_minRtt;
+}
+
+bool
+TcpBbr::IsFullBwReached () const
+{
+  return m_fullBwReached;
+}
+
+void
+TcpBbr::UpdateBw (const TcpRateOps::TcpRateConnection &rc,
+                  const TcpRateOps::TcpRateSample &rs)
+{
+  m_roundStart = false;
+  if (rs.m_delivered < 0 || !rs.m_interval.IsStrictlyPositive ())
+    {
+      return;
+    }
+
+  // A round ends when a segment sent after the start of the round is delivered
+  if (rs.m_priorDelivered >= m_nextRoundDelivered)
+    {
+      m_nextRoundDelivered = rc.m_delivered;
+      ++m_roundCount;
+      m_roundStart = true;
+      m_packetConservation = false;
+    }
+
+  DataRate bw (static_cast<uint64_t> (rs.m_delivered * 8.0 / rs.m_interval.GetSeconds ()));
+
+  // An app-limited sample can only increase the estimate: the application
+  // may have not sent enough to measure the bottleneck
+  if (!rs.m_isAppLimited || bw >= GetBtlBw ())
+    {
+      UpdateMaxBw (m_roundCount, bw);
+    }
+}
+
+void
+TcpBbr::UpdateMaxBw (uint32_t round, DataRate bw)
+{
+  // Kathleen Nichols' windowed min/max algorithm, as lib/win_minmax.c
+  MaxBwSample val;
+  val.m_round = round;
+  val.m_bw = bw;
+  const uint32_t win = m_bwWindowLength;
+
+  if (bw >= m_maxBw[0].m_bw || round - m_maxBw[2].m_round > win)
+    {
+      // New maximum, or nothing left in the window
+      m_maxBw[0] = m_maxBw[1] = m_maxBw[2] = val;
+      return;
+    }
+
+  if (bw >= m_maxBw[1].m_bw)
+    {
+      m_maxBw[2] = m_maxBw[1] = val;
+    }
+  else if (bw >= m_maxBw[2].m_bw)
+    {
+      m_maxBw[2] = val;
+    }
+
+  uint32_t dt = round - m_maxBw[0].m_round;
+  if (dt > win)
+    {
+      // The best sample expired: the second and third best move up
+      m_maxBw[0] = m_maxBw[1];
+      m_maxBw[1] = m_maxBw[2];
+      m_maxBw[2] = val;
+      if (round - m_maxBw[0].m_round > win)
+        {
+          m_maxBw[0] = m_maxBw[1];
+          m_maxBw[1] = m_maxBw[2];
+          m_maxBw[2] = val;
+        }
+    }
+  else if (m_maxBw[1].m_round == m_maxBw[0].m_round && dt > win / 4)
+    {
+      // A quarter of the window passed without a second best: take one
+      m_maxBw[2] = m_maxBw[1] = val;
+    }
+  else if (m_maxBw[2].m_round == m_maxBw[1].m_round && dt > win / 2)
+    {
+      m_maxBw[2] = val;
+    }
+}
+
+void
+TcpBbr::UpdateCyclePhase (Ptr<const TcpSocketState> tcb,
+                          const TcpRateOps::TcpRateSample &rs)
+{
+  if (m_mode != BBR_PROBE_BW)
+    {
+      return;
+    }
+
+  bool isFullLength = Simulator::Now () - m_cycleStamp > m_minRtt;
+  bool nextPhase;
+  if (m_pacingGain == 1)
+    {
+      nextPhase = isFullLength;
+    }
+  else if (m_pacingGain > 1)
+    {
+      // Probe until inflight reached the target, or losses show that the
+      // pipe is full
+      nextPhase = isFullLength && (rs.m_bytesLoss > 0
+                                   || rs.m_priorInFlight >= Inflight (tcb, m_pacingGain));
+    }
+  else
+    {
+      // Drain the queue created by the probe, possibly earlier
+      nextPhase = isFullLength || rs.m_priorInFlight <= Inflight (tcb, 1.0);
+    }
+
+  if (nextPhase)
+    {
+      m_cycleIndex = (m_cycleIndex + 1) % CYCLE_LEN;
+      m_cycleStamp = Simulator::Now ();
+    }
+}
+
+void
+TcpBbr::CheckFullBwReached (const TcpRateOps::TcpRateSample &rs)
+{
+  if (m_fullBwReached || !m_roundStart || rs.m_isAppLimited)
+    {
+      return;
+    }
+
+  if (GetBtlBw ().GetBitRate () >= m_fullBw.GetBitRate () * FULL_BW_THRESH)
+    {
+      m_fullBw = GetBtlBw ();
+      m_fullBwCount = 0;
+      return;
+    }
+
+  ++m_fullBwCount;
+  m_fullBwReached = m_fullBwCount >= FULL_BW_COUNT;
+  if (m_fullBwReached)
+    {
+      NS_LOG_INFO ("Pipe filled, bottleneck bandwidth " << GetBtlBw ());
+    }
+}
+
+void
+TcpBbr::CheckDrain (Ptr<TcpSocketState> tcb)
+{
+  if (m_mode == BBR_STARTUP && m_fullBwReached)
+    {
+      NS_LOG_INFO (BbrModeName[m_mode] << " -> " << BbrModeName[BBR_DRAIN]);
+      m_mode = BBR_DRAIN;
+      tcb->m_ssThresh = Inflight (tcb, 1.0);
+    }
+
+  if (m_mode == BBR_DRAIN && tcb->m_bytesInFlight <= Inflight (tcb, 1.0))
+    {
+      ResetProbeBwMode ();
+    }
+}
+
+void
+TcpBbr::UpdateMinRtt (Ptr<TcpSocketState> tcb,
+                      const TcpRateOps::TcpRateConnection &rc,
+                      const TcpRateOps::TcpRateSample &rs)
+{
+  bool filterExpired = Simulator::Now () > m_minRttStamp + m_rtPropWindowLength;
+  if (rs.m_rtt.IsStrictlyPositive () && (rs.m_rtt < m_minRtt || filterExpired))
+    {
+      m_minRtt = rs.m_rtt;
+      m_minRttStamp = Simulator::Now ();
+    }
+
+  if (m_probeRttDuration.IsStrictlyPositive () && filterExpired
+      && !m_idleRestart && m_mode != BBR_PROBE_RTT)
+    {
+      NS_LOG_INFO (BbrModeName[m_mode] << " -> " << BbrModeName[BBR_PROBE_RTT]);
+      m_mode = BBR_PROBE_RTT;
+      SaveCwnd (tcb);
+      m_probeRttDoneStamp = Time (0);
+    }
+
+  if (m_mode == BBR_PROBE_RTT)
+    {
+      if (m_probeRttDoneStamp.IsZero ()
+          && tcb->m_bytesInFlight <= CWND_MIN_TARGET * tcb->m_segmentSize)
+        {
+          // Stay at the minimum inflight for ProbeRttDuration and one round
+          m_probeRttDoneStamp = Simulator::Now () + m_probeRttDuration;
+          m_probeRttRoundDone = false;
+          m_nextRoundDelivered = rc.m_delivered;
+        }
+      else if (!m_probeRttDoneStamp.IsZero ())
+        {
+          if (m_roundStart)
+            {
+              m_probeRttRoundDone = true;
+            }
+          if (m_probeRttRoundDone)
+            {
+              CheckProbeRttDone (tcb);
+            }
+        }
+    }
+
+  if (rs.m_delivered > 0)
+    {
+      m_idleRestart = false;
+    }
+}
+
+void
+TcpBbr::CheckProbeRttDone (Ptr<TcpSocketState> tcb)
+{
+  if (m_probeRttDoneStamp.IsZero () || Simulator::Now () <= m_probeRttDoneStamp)
+    {
+      return;
+    }
+
+  m_minRttStamp = Simulator::Now ();
+  tcb->m_cWnd = std::max (tcb->m_cWnd.Get (), m_priorCwnd);
+  ResetMode ();
+}
+
+void
+TcpBbr::UpdateGains ()
+{
+  switch (m_mode)
+    {
+    case BBR_STARTUP:
+      m_pacingGain = m_highGain;
+      m_cwndGain = m_highGain;
+      break;
+    case BBR_DRAIN:
+      m_pacingGain = 1 / m_highGain;
+      m_cwndGain = m_highGain;
+      break;
+    case BBR_PROBE_BW:
+      m_pacingGain = PACING_GAIN[m_cycleIndex];
+      m_cwndGain = CWND_GAIN;
+      break;
+    case BBR_PROBE_RTT:
+      m_pacingGain = 1;
+      m_cwndGain = 1;
+      break;
+    }
+}
+
+void
+TcpBbr::ResetProbeBwMode ()
+{
+  NS_LOG_INFO (BbrModeName[m_mode] << " -> " << BbrModeName[BBR_PROBE_BW]);
+  m_mode = BBR_PROBE_BW;
+  // Start at a random phase, but never in the draining one
+  m_cycleIndex = CYCLE_LEN - 1 - m_uv->GetInteger (0, CYCLE_LEN - 2);
+  m_cycleIndex = (m_cycleIndex + 1) % CYCLE_LEN;
+  m_cycleStamp = Simulator::Now ();
+}
+
+void
+TcpBbr::ResetMode ()
+{
+  if (!m_fullBwReached)
+    {
+      NS_LOG_INFO (BbrModeName[m_mode] << " -> " << BbrModeName[BBR_STARTUP]);
+      m_mode = BBR_STARTUP;
+    }
+  else
+    {
+      ResetProbeBwMode ();
+    }
+}
+
+void
+TcpBbr::InitPacingRate (Ptr<TcpSocketState> tcb)
+{
+  Time rtt = tcb->m_lastRtt.Get ();
+  if (rtt.IsStrictlyPositive ())
+    {
+      m_hasSeenRtt = true;
+    }
+  else
+    {
+      rtt = MilliSeconds (1);
+    }
+
+  uint32_t cwnd = std::max (tcb->m_cWnd.Get (), tcb->m_segmentSize);
+  double rate = cwnd * 8.0 / rtt.GetSeconds () * m_highGain * PACING_MARGIN;
+  tcb->m_currentPacingRate = DataRate (std::min (static_cast<uint64_t> (rate),
+                                                 tcb->m_maxPacingRate.GetBitRate ()));
+}
+
+void
+TcpBbr::SetPacingRate (Ptr<TcpSocketState> tcb, double gain)
+{
+  if (!m_hasSeenRtt && tcb->m_lastRtt.Get ().IsStrictlyPositive ())
+    {
+      InitPacingRate (tcb);
+    }
+
+  uint64_t rate = static_cast<uint64_t> (GetBtlBw ().GetBitRate () * gain * PACING_MARGIN);
+  rate = std::min (rate, tcb->m_maxPacingRate.GetBitRate ());
+  if (rate == 0)
+    {
+      return;
+    }
+
+  // Until the pipe is full, do not slow down because of a sample
+  // lower than the estimate from the initial window
+  if (m_fullBwReached || rate > tcb->m_currentPacingRate.GetBitRate ())
+    {
+      tcb->m_currentPacingRate = DataRate (rate);
+    }
+}
+
+void
+TcpBbr::SaveCwnd (Ptr<const TcpSocketState> tcb)
+{
+  if (m_prevCaState < TcpSocketState::CA_RECOVERY && m_mode != BBR_PROBE_RTT)
+    {
+      m_priorCwnd = tcb->m_cWnd;
+    }
+  else
+    {
+      // Loss recovery or PROBE_RTT already reduced cwnd
+      m_priorCwnd = std::max (m_priorCwnd, tcb->m_cWnd.Get ());
+    }
+}
+
+uint32_t
+TcpBbr::Bdp (Ptr<const TcpSocketState> tcb, double gain) const
+{
+  if (m_minRtt == Time::Max ())
+    {
+      // No RTT sample yet: the initial window is the best guess
+      return tcb->m_initialCWnd * tcb->m_segmentSize;
+    }
+
+  double bdp = GetBtlBw () * m_minRtt / 8.0;
+  return static_cast<uint32_t> (bdp * gain);
+}
+
+uint32_t
+TcpBbr::Inflight (Ptr<const TcpSocketState> tcb, double gain) const
+{
+  uint32_t segSize = tcb->m_segmentSize;
+  uint32_t segs = (Bdp (tcb, gain) + segSize - 1) / segSize;
+
+  // Allow enough segments to keep the pipe full when the segments are
+  // queued below TCP, and round up to an even number to avoid stalling on
+  // delayed ACKs
+  segs += 3;
+  segs = (segs + 1) & ~1U;
+
+  // Be sure that the first phase of the cycle can actually probe
+  if (m_mode == BBR_PROBE_BW && m_cycleIndex == 0)
+    {
+      segs += 2;
+    }
+  return segs * segSize;
+}
+
+void
+TcpBbr::SetCwnd (Ptr<TcpSocketState> tcb,
+                 const TcpRateOps::TcpRateConnection &rc,
+                 const TcpRateOps::TcpRateSample &rs)
+{
+  uint32_t segSize = tcb->m_segmentSize;
+  uint32_t cwnd = tcb->m_cWnd;
+  uint32_t acked = rs.m_ackedSacked;
+
+  if (acked > 0 && !SetCwndToRecoverOrRestore (tcb, rc, rs, &cwnd))
+    {
+      uint32_t target = Inflight (tcb, m_cwndGain);
+      if (m_fullBwReached)
+        {
+          cwnd = std::min (cwnd + acked, target);
+        }
+      else if (cwnd < target || rc.m_delivered < tcb->m_initialCWnd * segSize)
+        {
+          // Until the pipe is full, grow as in slow start
+          cwnd = cwnd + acked;
+        }
+      cwnd = std::max (cwnd, CWND_MIN_TARGET * segSize);
+    }
+
+  if (m_mode == BBR_PROBE_RTT)
+    {
+      cwnd = std::min (cwnd, CWND_MIN_TARGET * segSize);
+    }
+
+  tcb->m_cWnd = cwnd;
+  tcb->m_cWndInfl = cwnd;
+}
+
+bool
+TcpBbr::SetCwndToRecoverOrRestore (Ptr<TcpSocketState> tcb,
+                                   const TcpRateOps::TcpRateConnection &rc,
+                                   const TcpRateOps::TcpRateSample &rs,
+                                   uint32_t *newCwnd)
+{
+  TcpSocketState::TcpCongState_t prevState = m_prevCaState;
+  TcpSocketState::TcpCongState_t state = tcb->m_congState;
+  uint32_t cwnd = tcb->m_cWnd;
+  uint32_t acked = rs.m_ackedSacked;
+
+  if (rs.m_bytesLoss > 0)
+    {
+      cwnd = std::max (cwnd > rs.m_bytesLoss ? cwnd - rs.m_bytesLoss : 0,
+                       tcb->m_segmentSize);
+    }
+
+  if (state == TcpSocketState::CA_RECOVERY && prevState != TcpSocketState::CA_RECOVERY)
+    {
+      // Packet conservation for the first round of recovery
+      m_packetConservation = true;
+      m_nextRoundDelivered = rc.m_delivered;
+      cwnd = tcb->m_bytesInFlight.Get () + acked;
+    }
+  else if (prevState >= TcpSocketState::CA_RECOVERY && state < TcpSocketState::CA_RECOVERY)
+    {
+      // Exiting loss recovery: restore cwnd
+      cwnd = std::max (cwnd, m_priorCwnd);
+      m_packetConservation = false;
+    }
+  m_prevCaState = state;
+
+  if (m_packetConservation)
+    {
+      *newCwnd = std::max (cwnd, tcb->m_bytesInFlight.Get () + acked);
+      return true;
+    }
+
+  *newCwnd = cwnd;
+  return false;
+}
+
+} // namespace ns3
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "tcp-rack-tlp.h"
+#include "tcp-tx-buffer.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpRackTlp");
+
+NS_OBJECT_ENSURE_REGISTERED (TcpRackTlp);
+
+TypeId
+TcpRackTlp::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TcpRackTlp")
+    .SetParent<Object> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<TcpRackTlp> ()
+    .AddAttribute ("ReoWndMultiplier",
+                   "Reordering window, in units of a quarter of the minimum RTT",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&TcpRackTlp::m_reoWndMult),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Tlp", "Send a tail loss probe when the PTO expires",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&TcpRackTlp::m_tlpEnabled),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+TcpRackTlp::TcpRackTlp () : Object ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TcpRackTlp::TcpRackTlp (const TcpRackTlp &other)
+  : Object (other),
+    m_reoWndMult (other.m_reoWndMult),
+    m_tlpEnabled (other.m_tlpEnabled)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TcpRackTlp::~TcpRackTlp ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TcpRackTlp::UpdateStats (const TcpTxItem *item, const Time &minRtt)
+{
+  NS_LOG_FUNCTION (this << item << minRtt);
+
+  SequenceNumber32 endSeq = item->GetStartSeq () + item->GetSeqSize ();
+  const Time &xmitTs = item->GetLastSent ();
+
+  // Step 3: detect reordering. Segments delivered by the same ACK are not
+  // compared among themselves, as the SACK blocks are not sorted.
+  if (!m_hasAckFack || endSeq > m_ackFack)
+    {
+      m_ackFack = endSeq;
+      m_hasAckFack = true;
+    }
+  if (m_hasFack && endSeq < m_fack && !item->IsRetrans ())
+    {
+      NS_LOG_INFO ("Segment ending at " << endSeq << " delivered after " << m_fack);
+      m_reorderingSeen = true;
+    }
+
+  // Step 2: update RACK.rtt, RACK.xmit_ts and RACK.end_seq
+  Time rtt = Simulator::Now () - xmitTs;
+  if (item->IsRetrans () && rtt < minRtt)
+    {
+      // The ACK is probably for the original transmission
+      return;
+    }
+
+  if (!m_hasSample || xmitTs > m_xmitTs || (xmitTs == m_xmitTs && endSeq > m_endSeq))
+    {
+      m_hasSample = true;
+      m_xmitTs = xmitTs;
+      m_endSeq = endSeq;
+      m_rtt = rtt;
+    }
+}
+
+Time
+TcpRackTlp::CalculateReoWnd (bool inRecovery, uint32_t sackedSegs, uint32_t dupThresh,
+                             const Time &srtt, const Time &minRtt) const
+{
+  if (!m_reorderingSeen && (inRecovery || sackedSegs >= dupThresh))
+    {
+      return Time (0);
+    }
+
+  if (minRtt == Time::Max ())
+    {
+      return srtt;
+    }
+
+  return Min (minRtt * static_cast<int64_t> (m_reoWndMult) / 4, srtt);
+}
+
+Time
+TcpRackTlp::DetectLoss (Ptr<TcpTxBuffer> txBuffer, bool inRecovery, uint32_t dupThresh,
+                        uint32_t segmentSize, const Time &srtt, const Time &minRtt)
+{
+  NS_LOG_FUNCTION (this << inRecovery << srtt << minRtt);
+
+  if (m_hasAckFack)
+    {
+      if (!m_hasFack || m_ackFack > m_fack)
+        {
+          m_fack = m_ackFack;
+          m_hasFack = true;
+        }
+      m_hasAckFack = false;
+    }
+
+  if (!m_hasSample)
+    {
+      return Time (0);
+    }
+
+  m_reoWnd = CalculateReoWnd (inRecovery, txBuffer->GetSacked () / segmentSize,
+                              dupThresh, srtt, minRtt);
+
+  Time timeout = txBuffer->MarkLostSentBefore (m_xmitTs, m_endSeq, m_rtt + m_reoWnd);
+  NS_LOG_DEBUG ("RACK rtt " << m_rtt << " reo_wnd " << m_reoWnd <<
+                " lost " << txBuffer->GetLost () << " timeout " << timeout);
+  return timeout;
+}
+
+Time
+TcpRackTlp::CalculatePto (const Time &srtt, uint32_t flightSize, uint32_t segmentSize,
+                          const Time &delAckTimeout, const Time &rtoLeft) const
+{
+  Time pto = Seconds (1);
+  if (srtt.IsStrictlyPositive ())
+    {
+      pto = srtt * 2;
+      if (flightSize <= segmentSize)
+        {
+          pto += delAckTimeout;
+        }
+    }
+
+  if (rtoLeft.IsStrictlyPositive () && rtoLeft < pto)
+    {
+      pto = rtoLeft;
+    }
+  return pto;
+}
+
+void
+TcpRackTlp::TlpSent (const SequenceNumber32 &endSeq, bool isRetrans)
+{
+  NS_LOG_FUNCTION (this << endSeq << isRetrans);
+  m_tlpInProgress = true;
+  m_tlpIsRetrans = isRetrans;
+  m_tlpEndSeq = endSeq;
+}
+
+bool
+TcpRackTlp::TlpAckReceived (const SequenceNumber32 &ack)
+{
+  NS_LOG_FUNCTION (this << ack);
+  if (!m_tlpInProgress || ack < m_tlpEndSeq)
+    {
+      return false;
+    }
+
+  m_tlpInProgress = false;
+  return m_tlpIsRetrans;
+}
+
+void
+TcpRackTlp::ResetTlp ()
+{
+  NS_LOG_FUNCTION (this);
+  m_tlpInProgress = false;
+}
+
+bool
+TcpRackTlp::IsTlpEnabled () const
+{
+  return m_tlpEnabled;
+}
+
+bool
+TcpRackTlp::IsTlpInProgress () const
+{
+  return m_tlpInProgress;
+}
+
+Time
+TcpRackTlp::GetRtt () const
+{
+  return m_rtt;
+}
+
+Time
+TcpRackTlp::GetReoWnd () const
+{
+  return m_reoWnd;
+}
+
+bool
+TcpRackTlp::IsReorderingSeen () const
+{
+  return m_reorderingSeen;
+}
+
+} // namespace ns3
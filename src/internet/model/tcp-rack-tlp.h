@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef TCP_RACK_TLP_H
+#define TCP_RACK_TLP_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/sequence-number.h"
+
+namespace ns3 {
+
+class TcpTxItem;
+class TcpTxBuffer;
+
+/**
+ * \ingroup recoveryOps
+ *
+ * \brief RACK-TLP loss detection (RFC 8985)
+ *
+ * RACK (Recent ACKnowledgment) marks a segment as lost when a segment sent
+ * sufficiently later has been delivered: "sufficiently" is the RTT of the
+ * most recently sent segment delivered (RACK.rtt) plus a reordering window
+ * (RACK.reo_wnd). Losses are therefore detected by time instead of by
+ * counting duplicate ACKs, and reordering shorter than the window does not
+ * trigger spurious retransmissions. Segments sent too recently to be judged
+ * are checked again when the reordering timer expires.
+ *
+ * TLP (Tail Loss Probe) sends a probe segment when no ACK arrives for a
+ * Probe TimeOut (PTO), about two RTTs, so that a loss at the tail of a flight
+ * generates the SACK information RACK needs, instead of waiting for the RTO.
+ *
+ * This class keeps the RACK and TLP state and does the computations; the
+ * timers and the transmissions belong to TcpSocketBase, which feeds it with
+ * the delivered segments (UpdateStats) and asks for loss detection once per
+ * ACK (DetectLoss). The segments are marked in the TcpTxBuffer, through
+ * TcpTxBuffer::MarkLostSentBefore.
+ *
+ * The reordering window multiplier is constant (attribute
+ * ReoWndMultiplier): TcpSocketBase does not process DSACK blocks, so
+ * neither the adaptation of the window (RFC 8985, Section 6.2, step 4) nor the
+ * detection of a spurious TLP retransmission is possible. For the same
+ * reason, a TLP episode that ends with a retransmitted probe is always
+ * considered a loss (Section 7.4.2).
+ */
+class TcpRackTlp : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   */
+  TcpRackTlp ();
+
+  /**
+   * \brief Copy constructor
+   * \param other object to copy
+   */
+  TcpRackTlp (const TcpRackTlp &other);
+
+  virtual ~TcpRackTlp ();
+
+  /**
+   * \brief Update the RACK state with a delivered (ACKed or SACKed) segment
+   *
+   * Steps 2 and 3 of RFC 8985, Section 6.2. A retransmitted segment whose RTT
+   * is below the minimum RTT is not considered, since the ACK is probably
+   * for the original transmission.
+   *
+   * \param item the delivered segment
+   * \param minRtt the minimum RTT of the connection
+   */
+  void UpdateStats (const TcpTxItem *item, const Time &minRtt);
+
+  /**
+   * \brief Detect the lost segments after an ACK has been processed
+   *
+   * Steps 4 and 5 of RFC 8985, Section 6.2: update the reordering window and
+   * mark as lost the segments sent more than RACK.rtt + RACK.reo_wnd before
+   * the most recently sent segment delivered.
+   *
+   * \param txBuffer the transmission buffer of the connection
+   * \param inRecovery true if the connection is in fast or RTO recovery
+   * \param dupThresh the duplicate ACK threshold
+   * \param segmentSize the segment size
+   * \param srtt the smoothed RTT
+   * \param minRtt the minimum RTT
+   * \return the time after which the detection should be repeated (the
+   * reordering timeout), or zero if no segment is waiting for it
+   */
+  Time DetectLoss (Ptr<TcpTxBuffer> txBuffer, bool inRecovery, uint32_t dupThresh,
+                   uint32_t segmentSize, const Time &srtt, const Time &minRtt);
+
+  /**
+   * \brief Calculate the Probe TimeOut (RFC 8985, Section 7.2)
+   *
+   * \param srtt the smoothed RTT, zero if there is no RTT sample yet
+   * \param flightSize the data outstanding
+   * \param segmentSize the segment size
+   * \param delAckTimeout the worst case delayed ACK timeout of the receiver
+   * \param rtoLeft the time left before the RTO expires, zero if not running
+   * \return the PTO
+   */
+  Time CalculatePto (const Time &srtt, uint32_t flightSize, uint32_t segmentSize,
+                     const Time &delAckTimeout, const Time &rtoLeft) const;
+
+  /**
+   * \brief Record the transmission of a probe, starting a TLP episode
+   * \param endSeq SND.NXT after the probe has been sent
+   * \param isRetrans true if the probe is a retransmission
+   */
+  void TlpSent (const SequenceNumber32 &endSeq, bool isRetrans);
+
+  /**
+   * \brief Process a cumulative ACK for the TLP episode (RFC 8985, Section 7.4)
+   *
+   * \param ack the cumulative ACK
+   * \return true if the episode ended and its probe repaired a loss, so that
+   * the congestion controller must react
+   */
+  bool TlpAckReceived (const SequenceNumber32 &ack);
+
+  /**
+   * \brief Terminate the TLP episode (e.g., after an RTO)
+   */
+  void ResetTlp ();
+
+  /**
+   * \brief Are probes enabled?
+   * \return true if TLP is enabled
+   */
+  bool IsTlpEnabled () const;
+
+  /**
+   * \brief Is a probe waiting for its ACK?
+   * \return true if a TLP episode is in progress
+   */
+  bool IsTlpInProgress () const;
+
+  /**
+   * \brief Get the RTT of the most recently sent segment delivered
+   * \return RACK.rtt
+   */
+  Time GetRtt () const;
+
+  /**
+   * \brief Get the reordering window computed by the last DetectLoss
+   * \return RACK.reo_wnd
+   */
+  Time GetReoWnd () const;
+
+  /**
+   * \brief Has reordering been observed on the connection?
+   * \return RACK.reordering_seen
+   */
+  bool IsReorderingSeen () const;
+
+private:
+  /**
+   * \brief Compute the reordering window (RFC 8985, Section 6.2, step 4)
+   * \param inRecovery true if the connection is in fast or RTO recovery
+   * \param sackedSegs number of segments SACKed
+   * \param dupThresh the duplicate ACK threshold
+   * \param srtt the smoothed RTT
+   * \param minRtt the minimum RTT
+   * \return the reordering window
+   */
+  Time CalculateReoWnd (bool inRecovery, uint32_t sackedSegs, uint32_t dupThresh,
+                        const Time &srtt, const Time &minRtt) const;
+
+  // RACK state
+  bool m_hasSample {false};           //!< True once a delivered segment has been considered
+  Time m_xmitTs {0};                  //!< Transmission time of the most recently sent segment delivered
+  SequenceNumber32 m_endSeq {0};      //!< End sequence of the most recently sent segment delivered
+  Time m_rtt {0};                     //!< RTT of the most recently sent segment delivered
+  Time m_reoWnd {0};                  //!< Reordering window
+  uint32_t m_reoWndMult {1};          //!< Reordering window multiplier, in units of minRtt / 4
+  bool m_reorderingSeen {false};      //!< True if a segment has been delivered out of order
+  bool m_hasFack {false};             //!< True once m_fack is valid
+  SequenceNumber32 m_fack {0};        //!< Highest end sequence delivered by the previous ACKs
+  SequenceNumber32 m_ackFack {0};     //!< Highest end sequence delivered by the current ACK
+  bool m_hasAckFack {false};          //!< True if the current ACK delivered a segment
+
+  // TLP state
+  bool m_tlpEnabled {true};           //!< Send probes on PTO expiration
+  bool m_tlpInProgress {false};       //!< True if a TLP episode is in progress
+  bool m_tlpIsRetrans {false};        //!< True if the probe of the episode is a retransmission
+  SequenceNumber32 m_tlpEndSeq {0};   //!< SND.NXT when the probe has been sent
+};
+
+} // namespace ns3
+
+#endif // TCP_RACK_TLP_H
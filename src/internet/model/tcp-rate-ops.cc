@@ -260,6 +260,7 @@ operator<< (std::ostream & os, TcpRateLinux::TcpRateSample const & sample)
   os << " m_bytesLoss    = "  << sample.m_bytesLoss      << std::endl;
   os << " m_priorInFlight= "  << sample.m_priorInFlight  << std::endl;
   os << " m_ackedSacked  = "  << sample.m_ackedSacked    << std::endl;
+  os << " m_rtt          = "  << sample.m_rtt            << std::endl;
   return os;
 }
 
@@ -142,6 +142,7 @@ public:
     uint32_t      m_bytesLoss      {0};                //!< The amount of data marked as lost from the most recent ack received
     uint32_t      m_priorInFlight  {0};                //!< The value if bytes in flight prior to last received ack
     uint32_t      m_ackedSacked    {0};                //!< The amount of data acked and sacked in the last received ack
+    Time          m_rtt            {Seconds (0.0)};    //!< The RTT measured on the last received ack, zero if none (set by the socket)
     /**
      * \brief Is the sample valid?
      * \return true if the sample is valid, false otherwise.
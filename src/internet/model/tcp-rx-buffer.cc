@@ -155,8 +155,14 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
-  // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
+  // Remove overlapped bytes from packet. Buffered blocks never overlap each
+  // other, so no block starting before the one that contains (or precedes)
+  // headSeq can overlap the incoming data: start the scan from there.
+  BufIterator i = m_data.upper_bound (headSeq);
+  if (i != m_data.begin ())
+    {
+      --i;
+    }
   while (i != m_data.end () && i->first <= tailSeq)
     {
       SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
@@ -205,18 +211,16 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
   // Update variables
   m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
+  // Only a block starting exactly at nextRxSeq can advance it; follow the
+  // chain of contiguous blocks from there.
+  SequenceNumber32 oldNextRxSeq = m_nextRxSeq;
+  for (i = m_data.find (m_nextRxSeq); i != m_data.end () && i->first == m_nextRxSeq; ++i)
     {
-      if (i->first < m_nextRxSeq)
-        {
-          continue;
-        }
-      else if (i->first > m_nextRxSeq)
-        {
-          break;
-        };
       m_nextRxSeq = i->first + SequenceNumber32 (i->second->GetSize ());
       m_availBytes += i->second->GetSize ();
+    }
+  if (m_nextRxSeq != oldNextRxSeq)
+    {
       ClearSackList (m_nextRxSeq);
     }
   NS_LOG_LOGIC ("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -58,6 +58,7 @@
 #include "tcp-option-sack.h"
 #include "tcp-congestion-ops.h"
 #include "tcp-recovery-ops.h"
+#include "tcp-rack-tlp.h"
 #include "ns3/tcp-rate-ops.h"
 
 #include <math.h>
@@ -138,6 +139,12 @@ TcpSocketBase::GetTypeId (void)
                    MakeUintegerAccessor (&TcpSocketBase::SetRetxThresh,
                                          &TcpSocketBase::GetRetxThresh),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("RackTlp",
+                   "Enable RACK-TLP loss detection (RFC 8985), used only with SACK",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::SetRackTlp,
+                                        &TcpSocketBase::GetRackTlp),
+                   MakeBooleanChecker ())
     .AddAttribute ("LimitedTransmit", "Enable limited transmit",
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_limitedTx),
@@ -245,6 +252,7 @@ TcpSocketBase::TcpSocketBase (void)
   m_txBuffer = CreateObject<TcpTxBuffer> ();
   m_tcb      = CreateObject<TcpSocketState> ();
   m_rateOps  = CreateObject <TcpRateLinux> ();
+  m_rack     = CreateObject<TcpRackTlp> ();
 
   m_tcb->m_rxBuffer = CreateObject<TcpRxBuffer> ();
 
@@ -335,6 +343,7 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_recover (sock.m_recover),
     m_retxThresh (sock.m_retxThresh),
     m_limitedTx (sock.m_limitedTx),
+    m_rackEnabled (sock.m_rackEnabled),
     m_isFirstPartialAck (sock.m_isFirstPartialAck),
     m_txTrace (sock.m_txTrace),
     m_rxTrace (sock.m_rxTrace),
@@ -377,6 +386,7 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     }
 
   m_rateOps = CreateObject <TcpRateLinux> ();
+  m_rack = CopyObject (sock.m_rack);
   if (m_tcb->m_sendEmptyPacketCallback.IsNull ())
     {
       m_tcb->m_sendEmptyPacketCallback = MakeCallback (&TcpSocketBase::SendEmptyPacket, this);
@@ -1655,10 +1665,20 @@ TcpSocketBase::DupAck (uint32_t currentDelivered)
     }
   else if (m_tcb->m_congState == TcpSocketState::CA_DISORDER)
     {
+      // With RACK-TLP, loss recovery starts as soon as a segment is marked
+      // lost by time (RFC 8985, Section 6.2), regardless of the dupacks
+      if (IsRackActive ())
+        {
+          if (m_txBuffer->GetLost () > 0)
+            {
+              EnterRecovery (currentDelivered);
+              NS_ASSERT (m_tcb->m_congState == TcpSocketState::CA_RECOVERY);
+            }
+        }
       // RFC 6675, Section 5, continuing:
       // ... and take the following steps:
       // (1) If DupAcks >= DupThresh, go to step (4).
-      if ((m_dupAckCount == m_retxThresh) && (m_highRxAckMark >= m_recover))
+      else if ((m_dupAckCount == m_retxThresh) && (m_highRxAckMark >= m_recover))
         {
           EnterRecovery (currentDelivered);
           NS_ASSERT (m_tcb->m_congState == TcpSocketState::CA_RECOVERY);
@@ -1706,11 +1726,29 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
   // scoreboard MUST be updated via the Update () routine (done in ReadOptions)
   uint32_t bytesSacked = 0;
   uint64_t previousDelivered = m_rateOps->GetConnectionRate ().m_delivered;
+  uint32_t previousLost = m_txBuffer->GetLost ();
   ReadOptions (tcpHeader, &bytesSacked);
 
   SequenceNumber32 ackNumber = tcpHeader.GetAckNumber ();
   SequenceNumber32 oldHeadSequence = m_txBuffer->HeadSequence ();
-  m_txBuffer->DiscardUpTo (ackNumber, MakeCallback (&TcpRateOps::SkbDelivered, m_rateOps));
+  m_txBuffer->DiscardUpTo (ackNumber, MakeCallback (&TcpSocketBase::NotifyItemDelivered, this));
+
+  if (IsRackActive ())
+    {
+      if (m_rack->TlpAckReceived (ackNumber)
+          && (m_tcb->m_congState == TcpSocketState::CA_OPEN
+              || m_tcb->m_congState == TcpSocketState::CA_DISORDER)
+          && !m_congestionControl->HasCongControl ())
+        {
+          // RFC 8985, Section 7.4.2: without DSACK, the retransmitted probe
+          // is assumed to have repaired a loss
+          NS_LOG_DEBUG ("TLP episode ended by " << ackNumber << ", reducing cwnd");
+          m_tcb->m_ssThresh = m_congestionControl->GetSsThresh (m_tcb, BytesInFlight ());
+          m_tcb->m_cWnd = m_tcb->m_ssThresh;
+          m_tcb->m_cWndInfl = m_tcb->m_cWnd;
+        }
+      RackDetectLoss ();
+    }
 
   uint32_t currentDelivered = static_cast<uint32_t> (m_rateOps->GetConnectionRate ().m_delivered - previousDelivered);
 
@@ -1731,6 +1769,7 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
 
   // Update bytes in flight before processing the ACK for proper calculation of congestion window
   NS_LOG_INFO ("Update bytes in flight before processing the ACK.");
+  uint32_t priorInFlight = m_tcb->m_bytesInFlight.Get ();
   BytesInFlight ();
 
   // RFC 6675 Section 5: 2nd, 3rd paragraph and point (A), (B) implementation
@@ -1739,17 +1778,18 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
 
   if (m_congestionControl->HasCongControl ())
     {
-      uint32_t previousLost = m_txBuffer->GetLost ();
-      uint32_t priorInFlight = m_tcb->m_bytesInFlight.Get ();
-      uint32_t currentLost = m_txBuffer->GetLost ();
-      uint32_t lost = (currentLost > previousLost) ?
-            currentLost - previousLost :
-            previousLost - currentLost;
+      uint32_t lost = SafeSubtraction (m_txBuffer->GetLost (), previousLost);
       auto rateSample = m_rateOps->GenerateSample (currentDelivered, lost,
                                               false, priorInFlight, m_tcb->m_minRtt);
+      rateSample.m_rtt = m_rttSample;
       auto rateConn = m_rateOps->GetConnectionRate ();
+      BytesInFlight ();
       m_congestionControl->CongControl(m_tcb, rateConn, rateSample);
     }
+  else if (m_tcb->m_pacing)
+    {
+      UpdatePacingRate ();
+    }
 
   // If there is any data piggybacked, store it into m_rxBuffer
   if (packet->GetSize () > 0)
@@ -1760,6 +1800,11 @@ TcpSocketBase::ReceivedAck (Ptr<Packet> packet, const TcpHeader& tcpHeader)
   // RFC 6675, Section 5, point (C), try to send more data. NB: (C) is implemented
   // inside SendPendingData
   SendPendingData (m_connected);
+
+  if (IsRackActive () && ackNumber > oldHeadSequence)
+    {
+      TlpScheduleProbe ();
+    }
 }
 
 void
@@ -1881,13 +1926,18 @@ TcpSocketBase::ProcessAck(const SequenceNumber32 &ackNumber, bool scoreboardUpda
               NS_LOG_INFO ("Partial ACK. Manually setting head as lost");
               m_txBuffer->MarkHeadAsLost ();
             }
-          else
+          else if (!IsRackActive ())
             {
               // We received a partial ACK, if we retransmitted this segment
               // probably is better to retransmit it
               m_txBuffer->DeleteRetransmittedFlagFromHead ();
             }
-          DoRetransmit (); // Assume the next seq is lost. Retransmit lost packet
+          // With RACK-TLP, only the segments marked lost by time are
+          // retransmitted, by SendPendingData
+          if (!IsRackActive ())
+            {
+              DoRetransmit (); // Assume the next seq is lost. Retransmit lost packet
+            }
           m_tcb->m_cWndInfl = SafeSubtraction (m_tcb->m_cWndInfl, bytesAcked);
           if (!m_congestionControl->HasCongControl () && segsAcked >= 1)
             {
@@ -2901,17 +2951,7 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
 
   if (m_tcb->m_pacing)
     {
-      NS_LOG_INFO ("Pacing is enabled");
-      if (m_pacingTimer.IsExpired ())
-        {
-          NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_currentPacingRate);
-          NS_LOG_DEBUG ("Timer is in expired state, activate it " << m_tcb->m_currentPacingRate.CalculateBytesTxTime (sz));
-          m_pacingTimer.Schedule (m_tcb->m_currentPacingRate.CalculateBytesTxTime (sz));
-        }
-      else
-        {
-          NS_LOG_INFO ("Timer is already in running state");
-        }
+      PacingSent (sz);
     }
 
   if (withAck)
@@ -2974,7 +3014,7 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
       NS_LOG_LOGIC (this << " SendDataPacket Schedule ReTxTimeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_rto.Get ()).GetSeconds () );
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimerExpired, this);
     }
 
   m_txTrace (p, header, this);
@@ -3065,15 +3105,9 @@ TcpSocketBase::SendPendingData (bool withAck)
   // else branch to control silly window syndrome and Nagle)
   while (availableWindow > 0)
     {
-      if (m_tcb->m_pacing)
+      if (!PacingAllowsSend ())
         {
-          NS_LOG_INFO ("Pacing is enabled");
-          if (m_pacingTimer.IsRunning ())
-            {
-              NS_LOG_INFO ("Skipping Packet due to pacing" << m_pacingTimer.GetDelayLeft ());
-              break;
-            }
-          NS_LOG_INFO ("Timer is not running");
+          break;
         }
 
       if (m_tcb->m_congState == TcpSocketState::CA_OPEN
@@ -3156,17 +3190,6 @@ TcpSocketBase::SendPendingData (bool withAck)
                         " sent seq " << m_tcb->m_nextTxSequence <<
                         " size " << sz);
           ++nPacketsSent;
-          if (m_tcb->m_pacing)
-            {
-              NS_LOG_INFO ("Pacing is enabled");
-              if (m_pacingTimer.IsExpired ())
-                {
-                  NS_LOG_DEBUG ("Current Pacing Rate " << m_tcb->m_currentPacingRate);
-                  NS_LOG_DEBUG ("Timer is in expired state, activate it " << m_tcb->m_currentPacingRate.CalculateBytesTxTime (sz));
-                  m_pacingTimer.Schedule (m_tcb->m_currentPacingRate.CalculateBytesTxTime (sz));
-                  break;
-                }
-            }
         }
 
       // (C.4) The estimate of the amount of data outstanding in the
@@ -3192,6 +3215,11 @@ TcpSocketBase::SendPendingData (bool withAck)
         }
 
       NS_LOG_DEBUG ("SendPendingData sent " << nPacketsSent << " segments");
+
+      if (IsRackActive ())
+        {
+          TlpScheduleProbe ();
+        }
     }
   else
     {
@@ -3408,6 +3436,7 @@ TcpSocketBase::EstimateRtt (const TcpHeader& tcpHeader)
       m_history.pop_front (); // Remove
     }
 
+  m_rttSample = m;
   if (!m.IsZero ())
     {
       m_rtt->Measurement (m);                // Log the measurement
@@ -3432,17 +3461,31 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
 
   if (m_state != SYN_RCVD && resetRTO)
     { // Set RTO unless the ACK is received in SYN_RCVD state
-      NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
-                    (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
-      m_retxEvent.Cancel ();
       // On receiving a "New" ack we restart retransmission timer .. RFC 6298
       // RFC 6298, clause 2.4
       m_rto = Max (m_rtt->GetEstimate () + Max (m_clockGranularity, m_rtt->GetVariation () * 4), m_minRto);
+      Time deadline = Simulator::Now () + m_rto.Get ();
 
-      NS_LOG_LOGIC (this << " Schedule ReTxTimeout at time " <<
-                    Simulator::Now ().GetSeconds () << " to expire at time " <<
-                    (Simulator::Now () + m_rto.Get ()).GetSeconds ());
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      if (IsRackActive () && m_retxEvent.IsRunning ()
+          && Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent) <= deadline)
+        {
+          // Postpone the pending event instead of rescheduling it on every
+          // ACK: ReTxTimerExpired re-arms it until the deadline
+          NS_LOG_LOGIC (this << " Postpone ReTxTimeout to time " << deadline.GetSeconds ());
+          m_retxDeadline = deadline;
+          m_retxDeadlineUid = m_retxEvent.GetUid ();
+        }
+      else
+        {
+          NS_LOG_LOGIC (this << " Cancelled ReTxTimeout event which was set to expire at " <<
+                        (Simulator::Now () + Simulator::GetDelayLeft (m_retxEvent)).GetSeconds ());
+          m_retxEvent.Cancel ();
+
+          NS_LOG_LOGIC (this << " Schedule ReTxTimeout at time " <<
+                        Simulator::Now ().GetSeconds () << " to expire at time " <<
+                        deadline.GetSeconds ());
+          m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimerExpired, this);
+        }
     }
 
   // Note the highest ACK and tell app to send more
@@ -3465,6 +3508,20 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
     }
 }
 
+void
+TcpSocketBase::ReTxTimerExpired ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_retxEvent.GetUid () == m_retxDeadlineUid && m_retxDeadline > Simulator::Now ())
+    {
+      // The RTO has been postponed (see NewAck)
+      m_retxEvent = Simulator::Schedule (m_retxDeadline - Simulator::Now (),
+                                         &TcpSocketBase::ReTxTimerExpired, this);
+      return;
+    }
+  ReTxTimeout ();
+}
+
 // Retransmit timeout
 void
 TcpSocketBase::ReTxTimeout ()
@@ -3553,6 +3610,10 @@ TcpSocketBase::ReTxTimeout ()
   // that we received.
   m_txBuffer->SetSentListLost (resetSack);
 
+  // The RTO terminates any TLP episode, and makes the RACK timer useless
+  m_rack->ResetTlp ();
+  m_rackEvent.Cancel ();
+
   // From RFC 6675, Section 5.1
   // If an RTO occurs during loss recovery as specified in this document,
   // RecoveryPoint MUST be set to HighData.  Further, the new value of
@@ -3584,7 +3645,9 @@ TcpSocketBase::ReTxTimeout ()
   m_tcb->m_cWnd = m_tcb->m_segmentSize;
   m_tcb->m_cWndInfl = m_tcb->m_cWnd;
 
+  // The retransmission of the head leaves immediately
   m_pacingTimer.Cancel ();
+  m_pacingNextTx = Simulator::Now ();
 
   NS_LOG_DEBUG ("RTO. Reset cwnd to " <<  m_tcb->m_cWnd << ", ssthresh to " <<
                 m_tcb->m_ssThresh << ", restart from seqnum " <<
@@ -3601,6 +3664,165 @@ TcpSocketBase::ReTxTimeout ()
                  ") there is more than one segment (" << m_tcb->m_segmentSize << ")");
 }
 
+Time
+TcpSocketBase::GetRetxDelayLeft (void) const
+{
+  if (!m_retxEvent.IsRunning ())
+    {
+      return Time (0);
+    }
+  if (m_retxEvent.GetUid () == m_retxDeadlineUid && m_retxDeadline > Simulator::Now ())
+    {
+      return m_retxDeadline - Simulator::Now ();
+    }
+  return Simulator::GetDelayLeft (m_retxEvent);
+}
+
+bool
+TcpSocketBase::IsRackActive (void) const
+{
+  return m_rackEnabled && m_sackEnabled;
+}
+
+void
+TcpSocketBase::NotifyItemDelivered (TcpTxItem *item)
+{
+  m_rateOps->SkbDelivered (item);
+  if (IsRackActive ())
+    {
+      m_rack->UpdateStats (item, m_tcb->m_minRtt);
+    }
+}
+
+void
+TcpSocketBase::RackDetectLoss (void)
+{
+  NS_LOG_FUNCTION (this);
+  bool inRecovery = m_tcb->m_congState == TcpSocketState::CA_RECOVERY
+    || m_tcb->m_congState == TcpSocketState::CA_LOSS;
+
+  Time timeout = m_rack->DetectLoss (m_txBuffer, inRecovery, m_retxThresh,
+                                     m_tcb->m_segmentSize, m_rtt->GetEstimate (),
+                                     m_tcb->m_minRtt);
+  if (timeout.IsStrictlyPositive ())
+    {
+      RackArmTimer (timeout, false);
+    }
+  else if (!m_rackProbe)
+    {
+      m_rackEvent.Cancel ();
+    }
+}
+
+void
+TcpSocketBase::RackArmTimer (const Time &delay, bool probe)
+{
+  NS_LOG_FUNCTION (this << delay << probe);
+  Time deadline = Simulator::Now () + delay;
+  m_rackProbe = probe;
+  m_rackDeadline = deadline;
+
+  if (m_rackEvent.IsRunning ()
+      && Simulator::Now () + Simulator::GetDelayLeft (m_rackEvent) <= deadline)
+    {
+      // RackTimeout re-arms the pending event until the deadline
+      return;
+    }
+
+  m_rackEvent.Cancel ();
+  m_rackEvent = Simulator::Schedule (delay, &TcpSocketBase::RackTimeout, this);
+}
+
+void
+TcpSocketBase::TlpScheduleProbe (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // RFC 8985, Section 7.2: no probe in recovery, with SACKed segments (RACK
+  // will detect the losses), or while the reordering timer is pending
+  if (!m_rack->IsTlpEnabled () || m_rack->IsTlpInProgress ()
+      || m_tcb->m_congState != TcpSocketState::CA_OPEN
+      || m_txBuffer->GetSacked () > 0 || UnAckDataCount () == 0
+      || (m_rackEvent.IsRunning () && !m_rackProbe))
+    {
+      return;
+    }
+
+  Time pto = m_rack->CalculatePto (m_rtt->GetEstimate (), BytesInFlight (),
+                                   m_tcb->m_segmentSize, m_delAckTimeout,
+                                   GetRetxDelayLeft ());
+  RackArmTimer (pto, true);
+}
+
+void
+TcpSocketBase::RackTimeout (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_rackDeadline > Simulator::Now ())
+    {
+      m_rackEvent = Simulator::Schedule (m_rackDeadline - Simulator::Now (),
+                                         &TcpSocketBase::RackTimeout, this);
+      return;
+    }
+
+  if (m_state == CLOSED || m_state == TIME_WAIT || m_txBuffer->Size () == 0)
+    {
+      return;
+    }
+
+  if (m_rackProbe)
+    {
+      TlpSendProbe ();
+      return;
+    }
+
+  // Reordering timer (RFC 8985, Section 6.3)
+  RackDetectLoss ();
+  if (m_txBuffer->GetLost () > 0
+      && (m_tcb->m_congState == TcpSocketState::CA_OPEN
+          || m_tcb->m_congState == TcpSocketState::CA_DISORDER))
+    {
+      EnterRecovery (0);
+    }
+  SendPendingData (m_connected);
+}
+
+void
+TcpSocketBase::TlpSendProbe (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_tcb->m_congState != TcpSocketState::CA_OPEN || UnAckDataCount () == 0
+      || m_state < ESTABLISHED)
+    {
+      return;
+    }
+
+  // RFC 8985, Section 7.3: send a new segment if possible, otherwise
+  // retransmit the last one
+  bool isRetrans = true;
+  SequenceNumber32 seq = m_tcb->m_highTxMark - std::min (UnAckDataCount (), m_tcb->m_segmentSize);
+  if (m_txBuffer->SizeFromSequence (m_tcb->m_highTxMark) > 0
+      && UnAckDataCount () + m_tcb->m_segmentSize <= m_rWnd.Get ())
+    {
+      isRetrans = false;
+      seq = m_tcb->m_highTxMark;
+      m_tcb->m_nextTxSequence = seq;
+    }
+
+  NS_LOG_DEBUG ("PTO expired, sending " << (isRetrans ? "retransmitted" : "new") <<
+                " probe from " << seq);
+  uint32_t sz = SendDataPacket (seq, m_tcb->m_segmentSize, m_connected);
+  if (!isRetrans)
+    {
+      m_tcb->m_nextTxSequence += sz;
+    }
+  m_rack->TlpSent (m_tcb->m_highTxMark, isRetrans);
+
+  // After the probe, the RTO (and not another probe) protects the flight
+  m_retxEvent.Cancel ();
+  m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimerExpired, this);
+}
+
 void
 TcpSocketBase::DelAckTimeout (void)
 {
@@ -3725,6 +3947,7 @@ TcpSocketBase::CancelAllTimers ()
   m_timewaitEvent.Cancel ();
   m_sendPendingDataEvent.Cancel ();
   m_pacingTimer.Cancel ();
+  m_rackEvent.Cancel ();
 }
 
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
@@ -3998,7 +4221,7 @@ TcpSocketBase::ProcessOptionSack (const Ptr<const TcpOption> option)
   NS_LOG_FUNCTION (this << option);
 
   Ptr<const TcpOptionSack> s = DynamicCast<const TcpOptionSack> (option);
-  return m_txBuffer->Update (s->GetSackList (), MakeCallback (&TcpRateOps::SkbDelivered, m_rateOps));
+  return m_txBuffer->Update (s->GetSackList (), MakeCallback (&TcpSocketBase::NotifyItemDelivered, this));
 }
 
 void
@@ -4184,6 +4407,13 @@ TcpSocketBase::SetRetxThresh (uint32_t retxThresh)
   m_txBuffer->SetDupAckThresh (retxThresh);
 }
 
+void
+TcpSocketBase::SetRackTlp (bool enabled)
+{
+  m_rackEnabled = enabled;
+  m_txBuffer->SetDupAckLossMarking (!enabled);
+}
+
 void
 TcpSocketBase::UpdateCwnd (uint32_t oldValue, uint32_t newValue)
 {
@@ -4282,6 +4512,63 @@ TcpSocketBase::NotifyPacingPerformed (void)
   SendPendingData (m_connected);
 }
 
+void
+TcpSocketBase::PacingSent (uint32_t sz)
+{
+  NS_LOG_FUNCTION (this << sz);
+  // No credit is accumulated while idle: the schedule restarts from now
+  Time now = Simulator::Now ();
+  if (m_pacingNextTx < now)
+    {
+      m_pacingNextTx = now;
+    }
+  m_pacingNextTx += m_tcb->m_currentPacingRate.CalculateBytesTxTime (sz);
+  NS_LOG_DEBUG ("Pacing rate " << m_tcb->m_currentPacingRate <<
+                ", next departure at " << m_pacingNextTx);
+}
+
+bool
+TcpSocketBase::PacingAllowsSend (void)
+{
+  if (!m_tcb->m_pacing || m_pacingNextTx <= Simulator::Now ())
+    {
+      return true;
+    }
+
+  // The departure time only moves forward, so a pending timer never
+  // expires later than needed
+  if (!m_pacingTimer.IsRunning ())
+    {
+      m_pacingTimer.Schedule (m_pacingNextTx - Simulator::Now ());
+    }
+  NS_LOG_INFO ("Skipping Packet due to pacing, next departure at " << m_pacingNextTx);
+  return false;
+}
+
+void
+TcpSocketBase::UpdatePacingRate (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // As Linux: pace at a ratio of cwnd / srtt, larger in (early) slow start
+  // to leave room for the window growth
+  Time srtt = m_tcb->m_lastRtt.Get ();
+  if (!srtt.IsStrictlyPositive ())
+    {
+      return;
+    }
+
+  uint16_t ratio = m_tcb->m_cWnd < m_tcb->m_ssThresh / 2 ?
+    m_tcb->m_pacingSsRatio : m_tcb->m_pacingCaRatio;
+  uint32_t window = std::max (m_tcb->m_cWnd.Get (), m_tcb->m_bytesInFlight.Get ());
+  double rate = window * 8.0 * ratio / 100 / srtt.GetSeconds ();
+  uint64_t bps = std::min (static_cast<uint64_t> (rate), m_tcb->m_maxPacingRate.GetBitRate ());
+  if (bps > 0)
+    {
+      m_tcb->m_currentPacingRate = DataRate (bps);
+    }
+}
+
 void
 TcpSocketBase::SetUseEcn (TcpSocketState::UseEcn_t useEcn)
 {
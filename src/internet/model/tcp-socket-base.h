@@ -50,6 +50,8 @@ class TcpOption;
 class Ipv4Interface;
 class Ipv6Interface;
 class TcpRateOps;
+class TcpRackTlp;
+class TcpTxItem;
 
 /**
  * \ingroup tcp
@@ -317,6 +319,22 @@ public:
    */
   uint32_t GetRetxThresh (void) const { return m_retxThresh; }
 
+  /**
+   * \brief Enable or disable RACK-TLP loss detection (RFC 8985)
+   *
+   * RACK-TLP is used only if SACK is enabled on the connection. It replaces
+   * the dupack-based loss marking of the Tx buffer.
+   *
+   * \param enabled true to enable RACK-TLP
+   */
+  void SetRackTlp (bool enabled);
+
+  /**
+   * \brief Is RACK-TLP loss detection enabled?
+   * \return true if RACK-TLP is enabled
+   */
+  bool GetRackTlp (void) const { return m_rackEnabled; }
+
   /**
    * \brief Callback pointer for cWnd trace chaining
    */
@@ -1023,6 +1041,64 @@ protected:
    */
   virtual void ReTxTimeout (void);
 
+  /**
+   * \brief The retransmission timer expired
+   *
+   * Calls ReTxTimeout, unless the RTO has been postponed after the
+   * timer was armed (see NewAck): in that case, re-arm the timer.
+   */
+  void ReTxTimerExpired (void);
+
+  /**
+   * \brief Get the time left before the RTO expires
+   * \return the time left, zero if the retransmission timer is not running
+   */
+  Time GetRetxDelayLeft (void) const;
+
+  /**
+   * \brief Is RACK-TLP in use on this connection?
+   * \return true if RACK-TLP is enabled and SACK is in use
+   */
+  bool IsRackActive (void) const;
+
+  /**
+   * \brief Notify the delivery ((S)ACK) of an item of the Tx buffer
+   * \param item the item delivered
+   */
+  void NotifyItemDelivered (TcpTxItem *item);
+
+  /**
+   * \brief Run RACK loss detection, and arm the reordering timer if needed
+   */
+  void RackDetectLoss (void);
+
+  /**
+   * \brief Arm the RACK-TLP timer
+   *
+   * The timer is either the reordering timer or the probe timer. It is not
+   * rescheduled when it would expire later than the event already pending: in
+   * that case the event re-arms itself for the remaining time.
+   *
+   * \param delay time before the expiration
+   * \param probe true for the probe timer, false for the reordering timer
+   */
+  void RackArmTimer (const Time &delay, bool probe);
+
+  /**
+   * \brief Arm the probe timer, if a Tail Loss Probe can be sent (RFC 8985, Section 7.2)
+   */
+  void TlpScheduleProbe (void);
+
+  /**
+   * \brief The RACK-TLP timer expired
+   */
+  void RackTimeout (void);
+
+  /**
+   * \brief Send a Tail Loss Probe (RFC 8985, Section 7.3)
+   */
+  void TlpSendProbe (void);
+
   /**
    * \brief Action upon delay ACK timeout, i.e. send an ACK
    */
@@ -1169,6 +1245,34 @@ protected:
    */
   void NotifyPacingPerformed (void);
 
+  /**
+   * \brief Account a transmission in the pacing schedule
+   *
+   * Moves the earliest departure time of the next segment forward by the
+   * transmission time of \p sz bytes at the current pacing rate.
+   *
+   * \param sz size of the segment sent
+   */
+  void PacingSent (uint32_t sz);
+
+  /**
+   * \brief Can a segment leave now, given the pacing rate?
+   *
+   * If it cannot, the pacing timer is armed for the departure time; a single
+   * timer is pending at most, and only while data is held back.
+   *
+   * \return true if pacing is disabled or the departure time has come
+   */
+  bool PacingAllowsSend (void);
+
+  /**
+   * \brief Update the pacing rate from cwnd and the smoothed RTT
+   *
+   * Used when the congestion control does not set the pacing rate itself
+   * (i.e., it does not implement CongControl).
+   */
+  void UpdatePacingRate (void);
+
   /**
    * \brief Add Tags for the Socket
    * \param p Packet
@@ -1182,6 +1286,8 @@ protected:
   EventId           m_delAckEvent   {}; //!< Delayed ACK timeout event
   EventId           m_persistEvent  {}; //!< Persist event: Send 1 byte to probe for a non-zero Rx window
   EventId           m_timewaitEvent {}; //!< TIME_WAIT expiration event: Move this socket to CLOSED state
+  Time              m_retxDeadline  {0}; //!< Expiration time of the RTO, when later than m_retxEvent
+  uint32_t          m_retxDeadlineUid {0}; //!< Uid of the m_retxEvent that m_retxDeadline postpones
 
   // ACK management
   uint32_t          m_dupAckCount {0};     //!< Dupack counter
@@ -1261,6 +1367,13 @@ protected:
   Ptr<TcpRecoveryOps>    m_recoveryOps;       //!< Recovery Algorithm
   Ptr<TcpRateOps>        m_rateOps;           //!< Rate operations
 
+  // RACK-TLP
+  bool                   m_rackEnabled  {false}; //!< RACK-TLP loss detection enabled
+  Ptr<TcpRackTlp>        m_rack;                 //!< RACK-TLP state
+  EventId                m_rackEvent    {};      //!< RACK reordering timer or TLP probe timer
+  Time                   m_rackDeadline {0};     //!< Expiration time of the RACK-TLP timer
+  bool                   m_rackProbe    {false}; //!< True if the RACK-TLP timer is the probe timer
+
   // Guesses over the other connection end
   bool m_isFirstPartialAck {true}; //!< First partial ACK during RECOVERY
 
@@ -1273,6 +1386,9 @@ protected:
 
   // Pacing related variable
   Timer m_pacingTimer {Timer::CANCEL_ON_DESTROY}; //!< Pacing Event
+  Time  m_pacingNextTx {0};                        //!< Earliest departure time of the next paced segment
+
+  Time  m_rttSample {0}; //!< RTT measured on the last received ACK, zero if none
 
   // Parameters related to Explicit Congestion Notification
   TracedValue<SequenceNumber32> m_ecnEchoSeq {0};      //!< Sequence number of the last received ECN Echo
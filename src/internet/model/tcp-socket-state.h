@@ -183,6 +183,8 @@ public:
   bool                   m_pacing            {false}; //!< Pacing status
   DataRate               m_maxPacingRate     {0};    //!< Max Pacing rate
   DataRate               m_currentPacingRate {0};    //!< Current Pacing rate
+  uint16_t               m_pacingSsRatio     {0};    //!< SS pacing ratio, in percent of cwnd / srtt
+  uint16_t               m_pacingCaRatio     {0};    //!< CA pacing ratio, in percent of cwnd / srtt
 
   Time                   m_minRtt  {Time::Max ()};   //!< Minimum RTT observed throughout the connection
 
@@ -58,7 +58,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n),
+    m_lostUpTo (n), m_retransUpTo (n)
 {
 }
 
@@ -123,6 +124,12 @@ TcpTxBuffer::SetDupAckThresh (uint32_t dupAckThresh)
   m_dupAckThresh = dupAckThresh;
 }
 
+void
+TcpTxBuffer::SetDupAckLossMarking (bool enabled)
+{
+  m_dupAckLossMarking = enabled;
+}
+
 void
 TcpTxBuffer::SetSegmentSize (uint32_t segmentSize)
 {
@@ -161,6 +168,7 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  ResetWatermarks ();
 }
 
 bool
@@ -257,6 +265,7 @@ TcpTxBuffer::CopyFromSequence (uint32_t numBytes, const SequenceNumber32& seq)
     }
 
   outItem->m_lastSent = Simulator::Now ();
+  TsortedPush (outItem);
   NS_ASSERT_MSG (outItem->m_startSeq >= m_firstByteSeq,
                  "Returning an item " << *outItem << " with SND.UNA as " <<
                  m_firstByteSeq);
@@ -283,7 +292,7 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
   NS_ASSERT (it != m_appList.end ());
 
   m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  m_sentIndex[item->m_startSeq] = m_sentList.insert (m_sentList.end (), item);
   m_sentSize += item->m_packet->GetSize ();
 
   return item;
@@ -297,40 +306,56 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
+  // Find the item containing seq, and the (untouched) one before it
+  auto idx = m_sentIndex.upper_bound (seq);
+  NS_ASSERT (idx != m_sentIndex.begin ());
+  --idx;
+  SequenceNumber32 startOfItem = idx->first;
+  auto prev = idx;
+  if (prev != m_sentIndex.begin ())
+    {
+      --prev;
+    }
+  else
+    {
+      prev = m_sentIndex.end ();
+    }
+
+  auto it = idx->second;
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  if ((*it)->m_startSeq == seq)
     {
-      if ((*it)->m_startSeq == seq)
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked... there is the possibility to merge
+          if (! (*next)->m_sacked)
             {
-              // Next is not sacked... there is the possibility to merge
-              if (! (*next)->m_sacked)
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
-  TcpTxItem *item = GetPacketFromList (m_sentList, m_firstByteSeq, s, seq, &listEdited);
+  TcpTxItem *item = GetPacketFromList (m_sentList, it, startOfItem, s, seq, &listEdited);
+
+  if (listEdited)
+    {
+      ReindexSentList (startOfItem, seq + s, prev);
+    }
 
   if (! item->m_retrans)
     {
@@ -338,9 +363,100 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
       item->m_retrans = true;
     }
 
+  // Advance the retransmission watermark over the items that can not be
+  // selected anymore by NextSeg
+  if (item->m_startSeq <= m_retransUpTo)
+    {
+      for (auto r = m_sentIndex.lower_bound (m_retransUpTo); r != m_sentIndex.end (); ++r)
+        {
+          TcpTxItem *current = *(r->second);
+          if (!current->m_retrans && !current->m_sacked)
+            {
+              break;
+            }
+          m_retransUpTo = current->m_startSeq + current->m_packet->GetSize ();
+        }
+    }
+
   return item;
 }
 
+void
+TcpTxBuffer::ReindexSentList (const SequenceNumber32 &first, const SequenceNumber32 &last,
+                              SentIndex::const_iterator prev)
+{
+  NS_LOG_FUNCTION (this << first << last);
+
+  m_sentIndex.erase (m_sentIndex.lower_bound (first), m_sentIndex.lower_bound (last));
+
+  PacketList::iterator it;
+  if (prev == m_sentIndex.end ())
+    {
+      it = m_sentList.begin ();
+    }
+  else
+    {
+      it = prev->second;
+      ++it;
+    }
+
+  for (; it != m_sentList.end () && (*it)->m_startSeq <= last; ++it)
+    {
+      m_sentIndex[(*it)->m_startSeq] = it;
+    }
+}
+
+void
+TcpTxBuffer::TsortedPush (TcpTxItem *item)
+{
+  TsortedRemove (item);
+  item->m_tsortedIt = m_tsortedList.insert (m_tsortedList.end (), item);
+  item->m_tsorted = true;
+}
+
+void
+TcpTxBuffer::TsortedRemove (TcpTxItem *item)
+{
+  if (item->m_tsorted)
+    {
+      m_tsortedList.erase (item->m_tsortedIt);
+      item->m_tsorted = false;
+    }
+}
+
+void
+TcpTxBuffer::RebuildTsortedList ()
+{
+  NS_LOG_FUNCTION (this);
+  for (auto it = m_tsortedList.begin (); it != m_tsortedList.end (); ++it)
+    {
+      (*it)->m_tsorted = false;
+    }
+  m_tsortedList.clear ();
+
+  std::vector<TcpTxItem*> items;
+  for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
+    {
+      if (!(*it)->m_sacked && !((*it)->m_lost && !(*it)->m_retrans))
+        {
+          items.push_back (*it);
+        }
+    }
+  std::stable_sort (items.begin (), items.end (),
+                    [] (const TcpTxItem *a, const TcpTxItem *b) { return a->m_lastSent < b->m_lastSent; });
+  for (auto it = items.begin (); it != items.end (); ++it)
+    {
+      TsortedPush (*it);
+    }
+}
+
+void
+TcpTxBuffer::ResetWatermarks ()
+{
+  m_lostUpTo = m_firstByteSeq;
+  m_retransUpTo = m_firstByteSeq;
+}
+
 std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
 TcpTxBuffer::FindHighestSacked () const
 {
@@ -379,6 +495,14 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
   t1->m_retrans = t2->m_retrans;
   t1->m_lost = t2->m_lost;
 
+  // Both parts were sent at the same time
+  if (t2->m_tsorted)
+    {
+      TcpTxBuffer *self = const_cast<TcpTxBuffer*> (this);
+      t1->m_tsortedIt = self->m_tsortedList.insert (t2->m_tsortedIt, t1);
+      t1->m_tsorted = true;
+    }
+
   t2->m_startSeq += size;
 
   NS_LOG_INFO ("Split of size " << size << " result: t1 " << *t1 << " t2 " << *t2);
@@ -388,6 +512,15 @@ TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
                                 bool *listEdited) const
+{
+  return GetPacketFromList (list, list.begin (), listStartFrom, numBytes, seq, listEdited);
+}
+
+TcpTxItem*
+TcpTxBuffer::GetPacketFromList (PacketList &list, PacketList::iterator startFrom,
+                                const SequenceNumber32 &listStartFrom,
+                                uint32_t numBytes, const SequenceNumber32 &seq,
+                                bool *listEdited) const
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -421,14 +554,14 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   Ptr<Packet> currentPacket = nullptr;
   TcpTxItem *currentItem = nullptr;
   TcpTxItem *outItem = nullptr;
-  PacketList::iterator it = list.begin ();
+  PacketList::iterator it = startFrom;
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (&list != &m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -458,13 +591,14 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
               if (listEdited)
                 {
                   *listEdited = true;
                 }
 
-              return GetPacketFromList (list, listStartFrom, numBytes, seq, listEdited);
+              return GetPacketFromList (list, firstPartIt, beginOfCurrentPacket,
+                                        numBytes, seq, listEdited);
             }
           else
             {
@@ -513,7 +647,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                       *listEdited = true;
                     }
 
-                  return GetPacketFromList (list, listStartFrom, numBytes, seq, listEdited);
+                  return GetPacketFromList (list, startFrom, listStartFrom, numBytes, seq, listEdited);
                 }
             }
           else if (numBytes < currentPacket->GetSize ())
@@ -537,6 +671,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
         {
           // The end isn't inside current packet, but there is an exception for
           // the merge and recurse strategy...
+          PacketList::iterator currentIt = it;
           if (++it == list.end ())
             {
               // ...current is the last packet we sent. We have not more data;
@@ -562,7 +697,8 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               *listEdited = true;
             }
 
-          return GetPacketFromList (list, listStartFrom, numBytes, seq, listEdited);
+          return GetPacketFromList (list, currentIt, beginOfCurrentPacket,
+                                    numBytes, seq, listEdited);
         }
     }
 
@@ -611,6 +747,9 @@ TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
       t1->m_lastSent = t2->m_lastSent;
     }
 
+  // The merged item is about to be retransmitted, which links it again
+  const_cast<TcpTxBuffer*> (this)->TsortedRemove (t2);
+
   t1->m_packet->AddAtEnd (t2->m_packet);
 
   NS_LOG_INFO ("Situation after the merge: " << *t1);
@@ -683,6 +822,8 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
 
           RemoveFromCounts (item, pktSize);
 
+          m_sentIndex.erase (item->m_startSeq);
+          TsortedRemove (item);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -702,7 +843,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          m_sentIndex.erase (item->m_startSeq);
           item->m_startSeq += offset;
+          m_sentIndex[item->m_startSeq] = i;
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -732,6 +875,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           // when adding Reno dupacks in the count.
           head->m_sacked = false;
           m_sackedOut -= head->m_packet->GetSize ();
+          ResetWatermarks ();
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
           AddRenoSack ();
           MarkHeadAsLost ();
@@ -747,6 +891,17 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
       m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
     }
 
+  // Keep the watermarks inside the window, so they can be safely compared
+  // with the sequence numbers of the sent list
+  if (m_lostUpTo < m_firstByteSeq)
+    {
+      m_lostUpTo = m_firstByteSeq;
+    }
+  if (m_retransUpTo < m_firstByteSeq)
+    {
+      m_retransUpTo = m_firstByteSeq;
+    }
+
   NS_LOG_DEBUG ("Discarded up to " << seq << " lost: " << m_lostOut <<
                 " retrans: " << m_retrans << " sacked: " << m_sackedOut);
   NS_LOG_LOGIC ("Buffer status after discarding data " << *this);
@@ -766,15 +921,22 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return bytesSacked;
         }
 
+      // Items starting before the block can not be mapped over it: start from
+      // the first item that begins inside the block
+      SentIndex::iterator index_it = m_sentIndex.lower_bound ((*option_it).first);
+      if (index_it == m_sentIndex.end ())
+        {
+          continue;
+        }
+      PacketList::iterator item_it = index_it->second;
+      SequenceNumber32 beginOfCurrentPacket = index_it->first;
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
@@ -840,7 +1002,10 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
   if (bytesSacked > 0)
     {
       NS_ASSERT_MSG (m_highestSack.first != m_sentList.end(), "Buffer status: " << *this);
-      UpdateLostCount ();
+      if (m_dupAckLossMarking)
+        {
+          UpdateLostCount ();
+        }
     }
 
   NS_ASSERT ((*(m_sentList.begin ()))->m_sacked == false);
@@ -868,12 +1033,26 @@ TcpTxBuffer::UpdateLostCount ()
                    ", will start from item " << *(*m_highestSack.first));
     }
 
+  // Items starting before this point have been walked by a previous update
+  SequenceNumber32 lostUpTo = m_lostUpTo;
+
   for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
+
+      if (sacked >= m_dupAckThresh && item->m_startSeq < lostUpTo)
+        {
+          // Everything before has been already marked by a previous update
+          break;
+        }
+
       if (item->m_sacked)
         {
           sacked++;
+          if (sacked == m_dupAckThresh && m_lostUpTo < item->m_startSeq)
+            {
+              m_lostUpTo = item->m_startSeq;
+            }
         }
 
       if (sacked >= m_dupAckThresh)
@@ -905,38 +1084,101 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first item beginning at (or after) seq
+  auto index_it = m_sentIndex.lower_bound (seq);
+  if (index_it == m_sentIndex.end ())
+    {
+      return false;
+    }
+
+  for (PacketList::const_iterator it = index_it->second; it != m_sentList.end (); ++it)
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
+      if ((*it)->m_lost == true)
         {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
+        }
 
-          if ((*it)->m_sacked == true)
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
+        }
+    }
+
+  return false;
+}
+
+Time
+TcpTxBuffer::MarkLostSentBefore (const Time &xmitTs, const SequenceNumber32 &endSeq,
+                                 const Time &lossWindow)
+{
+  NS_LOG_FUNCTION (this << xmitTs << endSeq << lossWindow);
+  Time now = Simulator::Now ();
+  Time timeout = Time (0);
+
+  auto it = m_tsortedList.begin ();
+  while (it != m_tsortedList.end ())
+    {
+      TcpTxItem *item = *it;
+
+      if (item->m_sacked || (item->m_lost && !item->m_retrans))
+        {
+          // Delivered, or already waiting for a retransmission, which links
+          // it again
+          item->m_tsorted = false;
+          it = m_tsortedList.erase (it);
+          continue;
+        }
+
+      if (item->m_lastSent > xmitTs)
+        {
+          break;
+        }
+
+      SequenceNumber32 itemEnd = item->m_startSeq + item->m_packet->GetSize ();
+      if (item->m_lastSent == xmitTs && itemEnd >= endSeq)
+        {
+          // Sent with the delivered segment, but after it
+          ++it;
+          continue;
+        }
+
+      Time remaining = item->m_lastSent + lossWindow - now;
+      if (remaining.IsStrictlyPositive ())
+        {
+          timeout = Max (timeout, remaining);
+          ++it;
+          continue;
+        }
+
+      NS_LOG_INFO ("Item " << *item << " sent before " << xmitTs << " is lost");
+      if (!item->m_lost)
+        {
+          item->m_lost = true;
+          m_lostOut += item->m_packet->GetSize ();
+        }
+      if (item->m_retrans)
+        {
+          item->m_retrans = false;
+          m_retrans -= item->m_packet->GetSize ();
+          if (item->m_startSeq < m_retransUpTo)
             {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
+              m_retransUpTo = item->m_startSeq;
             }
         }
-
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+      item->m_tsorted = false;
+      it = m_tsortedList.erase (it);
     }
 
-  return false;
+  NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
+  ConsistencyCheck ();
+  return timeout;
 }
 
 bool
@@ -957,13 +1199,22 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
   TcpTxItem *item;
   SequenceNumber32 seqPerRule3;
   bool isSeqPerRule3Valid = false;
-  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Items starting before m_retransUpTo are retransmitted or sacked, and
+  // hence they can not satisfy any of the rules below
+  auto index_it = m_sentIndex.lower_bound (m_retransUpTo);
+  PacketList::const_iterator it = m_sentList.end ();
+  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq + m_sentSize;
+  if (index_it != m_sentIndex.end ())
+    {
+      it = index_it->second;
+      beginOfCurrentPkt = index_it->first;
+    }
+
+  for (; it != m_sentList.end (); ++it)
     {
       item = *it;
 
@@ -1189,6 +1440,9 @@ TcpTxBuffer::ResetRenoSack ()
     }
 
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  ResetWatermarks ();
+  // The items sacked were unlinked from the transmission time ordered list
+  RebuildTsortedList ();
 }
 
 void
@@ -1202,15 +1456,19 @@ TcpTxBuffer::ResetSentList ()
     {
       item = m_sentList.back ();
       item->m_retrans = item->m_sacked = item->m_lost = false;
+      item->m_tsorted = false;
       m_appList.push_front (item);
       m_sentList.pop_back ();
     }
+  m_sentIndex.clear ();
+  m_tsortedList.clear ();
 
   m_sentSize = 0;
   m_lostOut = 0;
   m_retrans = 0;
   m_sackedOut = 0;
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  ResetWatermarks ();
 }
 
 void
@@ -1222,12 +1480,23 @@ TcpTxBuffer::ResetLastSegmentSent ()
       TcpTxItem *item = m_sentList.back ();
 
       m_sentList.pop_back ();
+      m_sentIndex.erase (item->m_startSeq);
+      TsortedRemove (item);
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
         {
           m_retrans -= item->m_packet->GetSize ();
         }
       m_appList.insert (m_appList.begin (), item);
+
+      if (item->m_startSeq < m_lostUpTo)
+        {
+          m_lostUpTo = item->m_startSeq;
+        }
+      if (item->m_startSeq < m_retransUpTo)
+        {
+          m_retransUpTo = item->m_startSeq;
+        }
     }
   ConsistencyCheck ();
 }
@@ -1274,6 +1543,15 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
       (*it)->m_retrans = false;
     }
 
+  m_retransUpTo = m_firstByteSeq;
+
+  // Every item is now sacked, or waiting for a retransmission
+  for (auto it = m_tsortedList.begin (); it != m_tsortedList.end (); ++it)
+    {
+      (*it)->m_tsorted = false;
+    }
+  m_tsortedList.clear ();
+
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
   ConsistencyCheck ();
@@ -1306,6 +1584,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead ()
     {
       m_sentList.front ()->m_retrans = false;
       m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+      m_retransUpTo = m_firstByteSeq;
     }
   ConsistencyCheck ();
 }
@@ -1322,12 +1601,14 @@ TcpTxBuffer::MarkHeadAsLost ()
         {
           m_sentList.front ()->m_sacked = false;
           m_sackedOut -= m_sentList.front ()->m_packet->GetSize ();
+          m_retransUpTo = m_firstByteSeq;
         }
 
       if (m_sentList.front ()->m_retrans)
         {
           m_sentList.front ()->m_retrans = false;
           m_retrans -= m_sentList.front ()->m_packet->GetSize ();
+          m_retransUpTo = m_firstByteSeq;
         }
 
       if (! m_sentList.front()->m_lost)
@@ -1409,6 +1690,40 @@ TcpTxBuffer::ConsistencyCheck () const
                  " stored lost: " << m_lostOut);
   NS_ASSERT_MSG (retrans == m_retrans, " Counted retrans: " << retrans <<
                  " stored retrans: " << m_retrans);
+
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (),
+                 "Index size " << m_sentIndex.size () << " sent list size " <<
+                 m_sentList.size ());
+  for (auto it = m_sentIndex.begin (); it != m_sentIndex.end (); ++it)
+    {
+      NS_ASSERT_MSG (it->first == (*it->second)->m_startSeq,
+                     "Index entry " << it->first << " points to " << *(*it->second));
+      if ((*it->second)->m_startSeq < m_lostUpTo)
+        {
+          NS_ASSERT_MSG ((*it->second)->m_lost || (*it->second)->m_sacked,
+                         "Item " << *(*it->second) << " is below the lost mark " <<
+                         m_lostUpTo << " " << *this);
+        }
+      if ((*it->second)->m_startSeq < m_retransUpTo)
+        {
+          NS_ASSERT_MSG ((*it->second)->m_retrans || (*it->second)->m_sacked,
+                         "Item " << *(*it->second) << " is below the retrans mark " <<
+                         m_retransUpTo << " " << *this);
+        }
+    }
+
+  for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
+    {
+      NS_ASSERT_MSG ((*it)->m_tsorted || (*it)->m_sacked || ((*it)->m_lost && !(*it)->m_retrans),
+                     "Item " << *(*it) << " is not in the transmission time ordered list");
+    }
+  for (auto it = m_tsortedList.begin (); it != m_tsortedList.end (); ++it)
+    {
+      NS_ASSERT_MSG ((*it)->m_tsorted && (*it)->m_tsortedIt == it, "Broken link of " << *(*it));
+      auto next = std::next (it);
+      NS_ASSERT_MSG (next == m_tsortedList.end () || (*it)->m_lastSent <= (*next)->m_lastSent,
+                     "Item " << *(*it) << " linked before " << *(*next));
+    }
 }
 
 std::ostream &
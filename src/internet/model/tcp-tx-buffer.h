@@ -22,6 +22,8 @@
 #ifndef TCP_TX_BUFFER_H
 #define TCP_TX_BUFFER_H
 
+#include <map>
+
 #include "ns3/object.h"
 #include "ns3/traced-value.h"
 #include "ns3/sequence-number.h"
@@ -105,6 +107,27 @@ class Packet;
  * of the methods. To have a look how the calculations are made, please see
  * BytesInFlight method.
  *
+ * Scoreboard index
+ * ----------------
+ *
+ * With large windows, walking the sent list for every SACK block or every
+ * loss query dominates the per-ACK cost. Therefore, the items of the sent list
+ * are also indexed by their starting sequence number (m_sentIndex), so that
+ * Update, IsLost and the retransmission of a segment locate the first item of
+ * interest in logarithmic time. Two watermarks avoid re-walking the part of
+ * the sent list that cannot change anymore: every item starting below
+ * m_lostUpTo is lost or sacked (UpdateLostCount stops there), and every item
+ * starting below m_retransUpTo is retransmitted or sacked (NextSeg starts
+ * from there). Any operation that resets the flags of the items below a
+ * watermark pulls it back to SND.UNA.
+ *
+ * As in Linux (tsorted_sent_queue), the sent items are also linked in order
+ * of their last transmission (m_tsortedList): each transmission moves the item
+ * to the tail. Every sent item neither sacked nor waiting for a retransmission
+ * after being marked lost is in that list, so that MarkLostSentBefore stops
+ * at the first item sent after the one delivered. The items sacked or marked
+ * lost are unlinked when the walk reaches them.
+ *
  * Lost segments
  * -------------
  *
@@ -178,6 +201,18 @@ public:
    */
   void SetDupAckThresh (uint32_t dupAckThresh);
 
+  /**
+   * \brief Enable or disable the marking of lost segments on SACK reception
+   *
+   * When enabled (the default), Update marks as lost the segments with at
+   * least DupAckThresh SACKed segments above them (RFC 6675). Loss detection
+   * algorithms that work on time instead, such as RACK (see MarkLostSentBefore),
+   * disable it.
+   *
+   * \param enabled true to mark lost segments in Update
+   */
+  void SetDupAckLossMarking (bool enabled);
+
   /**
    * \brief Set the segment size
    * \param segmentSize the segment size
@@ -290,6 +325,31 @@ public:
    */
   bool IsLost (const SequenceNumber32 &seq) const;
 
+  /**
+   * \brief Mark as lost the segments sent too long before a delivered one
+   *
+   * Time-based loss detection of RACK (RFC 8985, Section 6.2, step 5). Every
+   * segment not SACKed, and not already waiting for a retransmission, that
+   * was sent before the segment identified by (xmitTs, endSeq) is lost if it
+   * was sent at least lossWindow ago. A lost retransmission loses its
+   * retransmitted flag, so it can be retransmitted again.
+   *
+   * The segments are walked in order of transmission (m_tsortedList), and the
+   * walk stops at the first one sent after xmitTs: the following ones have
+   * been sent even later. The segments marked lost, or found sacked, are
+   * unlinked on the way, so the walk only covers the segments still in flight
+   * that were sent before the delivered one.
+   *
+   * \param xmitTs transmission time of the most recently sent segment delivered
+   * \param endSeq end sequence of that segment
+   * \param lossWindow time after which a segment sent before it is lost
+   * (RACK.rtt + RACK.reo_wnd)
+   * \return the time left before the first of the remaining segments can be
+   * marked lost, or zero if no segment is waiting for it
+   */
+  Time MarkLostSentBefore (const Time &xmitTs, const SequenceNumber32 &endSeq,
+                           const Time &lossWindow);
+
   /**
    * \brief Get the next sequence number to transmit, according to RFC 6675
    *
@@ -385,6 +445,7 @@ private:
   friend std::ostream & operator<< (std::ostream & os, TcpTxBuffer const & tcpTxBuf);
 
   typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
+  typedef std::map<SequenceNumber32, PacketList::iterator> SentIndex; //!< index of the sent list, keyed by starting sequence
 
   /**
    * \brief Update the lost count
@@ -401,8 +462,8 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
+   * and updates the lost count. The walk starts from the highest sacked item
+   * and stops as soon as it reaches items already marked (m_lostUpTo).
    *
    */
   void UpdateLostCount ();
@@ -537,6 +598,73 @@ private:
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
                                 bool *listEdited = nullptr) const;
 
+  /**
+   * \brief Get a block (which is returned as Packet) from a list, starting the
+   * search from a given item
+   *
+   * Same as the other GetPacketFromList, but the walk begins at startFrom
+   * (which starts at startingSeq) instead of at the head of the list. Every
+   * item before startFrom is left untouched.
+   *
+   * \param list List to extract block from
+   * \param startFrom Item from which the search begins
+   * \param startingSeq Starting sequence of startFrom
+   * \param numBytes Bytes to extract, starting from requestedSeq
+   * \param requestedSeq Requested sequence
+   * \param listEdited output parameter which indicates if the list has been edited
+   * \return the item that contains the right packet
+   */
+  TcpTxItem* GetPacketFromList (PacketList &list, PacketList::iterator startFrom,
+                                const SequenceNumber32 &startingSeq,
+                                uint32_t numBytes, const SequenceNumber32 &requestedSeq,
+                                bool *listEdited) const;
+
+  /**
+   * \brief Re-synchronize the sent list index over a range of the sent list
+   *
+   * Used after fragmentation or merges of the items in the range
+   * [first, last], that invalidate the index entries pointing there.
+   *
+   * \param first starting sequence of the first item changed
+   * \param last sequence after which the items are unchanged
+   * \param prev index entry of the item just before first (unchanged), or
+   * m_sentIndex.end () if first is the head of the sent list
+   */
+  void ReindexSentList (const SequenceNumber32 &first, const SequenceNumber32 &last,
+                        SentIndex::const_iterator prev);
+
+  /**
+   * \brief Link an item at the tail of the transmission time ordered list
+   *
+   * To be called each time the item is sent. The item is unlinked first, if
+   * it is already in the list.
+   *
+   * \param item the item just sent
+   */
+  void TsortedPush (TcpTxItem *item);
+
+  /**
+   * \brief Unlink an item from the transmission time ordered list, if it is there
+   *
+   * \param item the item to unlink
+   */
+  void TsortedRemove (TcpTxItem *item);
+
+  /**
+   * \brief Link again, in order of transmission, all the sent items which
+   * must be in the transmission time ordered list
+   *
+   * To be called when the flags of unlinked items are reset.
+   */
+  void RebuildTsortedList ();
+
+  /**
+   * \brief Pull back the lost and retransmitted watermarks
+   *
+   * To be called each time the flags of items already walked may be reset.
+   */
+  void ResetWatermarks ();
+
   /**
    * \brief Merge two TcpTxItem
    *
@@ -576,6 +704,8 @@ private:
 
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
+  SentIndex m_sentIndex; //!< Items of m_sentList, indexed by starting sequence
+  PacketList m_tsortedList; //!< Items of m_sentList, in order of their last transmission
   uint32_t m_maxBuffer;  //!< Max number of data bytes in buffer (SND.WND)
   uint32_t m_size;       //!< Size of all data in this buffer
   uint32_t m_sentSize;   //!< Size of sent (and not discarded) segments
@@ -587,8 +717,12 @@ private:
   uint32_t m_sackedOut {0}; //!< Number of sacked bytes
   uint32_t m_retrans   {0}; //!< Number of retransmitted bytes
 
+  SequenceNumber32 m_lostUpTo;    //!< Items starting before this sequence are lost or sacked
+  SequenceNumber32 m_retransUpTo; //!< Items starting before this sequence are retransmitted or sacked
+
   uint32_t m_dupAckThresh {0}; //!< Duplicate Ack threshold from TcpSocketBase
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
+  bool m_dupAckLossMarking {true}; //!< Mark lost segments on SACK reception (RFC 6675)
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
 
   static Callback<void, TcpTxItem *> m_nullCb; //!< Null callback for an item
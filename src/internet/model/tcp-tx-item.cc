@@ -88,6 +88,12 @@ TcpTxItem::GetPacket (void) const
   return m_packet;
 }
 
+const SequenceNumber32 &
+TcpTxItem::GetStartSeq (void) const
+{
+  return m_startSeq;
+}
+
 const Time &
 TcpTxItem::GetLastSent (void) const
 {
@@ -19,6 +19,7 @@
 #ifndef TCP_TX_ITEM_H
 #define TCP_TX_ITEM_H
 
+#include <list>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/sequence-number.h"
@@ -71,6 +72,12 @@ public:
    */
   Ptr<const Packet> GetPacket (void) const;
 
+  /**
+   * \brief Get the sequence number of the first byte of the item
+   * \return the starting sequence (meaningful only once the item has been sent)
+   */
+  const SequenceNumber32 & GetStartSeq (void) const;
+
   /**
    * \brief Get a reference to the time the packet was sent for the last time
    * \return a reference to the last sent time
@@ -109,6 +116,8 @@ private:
   bool m_retrans       {false};      //!< Indicates if the segment is retransmitted
   Time m_lastSent      {Time::Max ()};//!< Timestamp of the time at which the segment has been sent last time
   bool m_sacked        {false};      //!< Indicates if the segment has been SACKed
+  bool m_tsorted       {false};      //!< Indicates if the item is in the transmission time ordered list
+  std::list<TcpTxItem*>::iterator m_tsortedIt; //!< Position in the transmission time ordered list
 
   RateInformation m_rateInfo;        //!< Rate information of the item
 };
@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-interface.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv4EndPointDemux lookup test
+ *
+ * Checks the best-match semantics of the lookups with a listening endpoint
+ * and several connected endpoints on the same local port, including
+ * endpoints whose peer is set after the allocation.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv4EndPointDemuxTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase ()
+  : TestCase ("Ipv4EndPointDemux lookup")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun (void)
+{
+  Ipv4EndPointDemux demux;
+  Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface> ();
+  Ipv4Address local ("10.0.0.1");
+  Ipv4Address any = Ipv4Address::GetAny ();
+
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), false, "Port 80 should be free");
+  Ipv4EndPoint *listener = demux.Allocate (0, 80);
+  NS_TEST_ASSERT_MSG_NE (listener, 0, "Listener allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (80), true, "Port 80 should be in use");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (0, 80), 0, "Duplicated listener allowed");
+
+  std::vector<Ipv4EndPoint *> connections;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Ipv4Address peer (0x0a010000 + i);
+      Ipv4EndPoint *endPoint = demux.Allocate (0, local, 80, peer, 1000 + i);
+      NS_TEST_ASSERT_MSG_NE (endPoint, 0, "Connection allocation failed");
+      connections.push_back (endPoint);
+    }
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (0, local, 80, Ipv4Address (0x0a010000), 1000), 0,
+                         "Duplicated connection allowed");
+
+  for (uint32_t i = 0; i < connections.size (); i++)
+    {
+      Ipv4Address peer (0x0a010000 + i);
+      Ipv4EndPointDemux::EndPoints found = demux.Lookup (local, 80, peer, 1000 + i, interface);
+      NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connection not found");
+      NS_TEST_ASSERT_MSG_EQ (found.front (), connections[i], "Wrong connection found");
+      NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (local, 80, peer, 1000 + i), connections[i],
+                             "Wrong connection found by SimpleLookup");
+    }
+
+  // an unknown peer goes to the listener
+  Ipv4EndPointDemux::EndPoints found = demux.Lookup (local, 80, Ipv4Address ("10.2.0.1"), 5000, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Listener not found");
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Wrong endpoint found");
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (local, 81, Ipv4Address ("10.2.0.1"), 5000, interface).size (), 0,
+                         "Endpoint found on an unused port");
+
+  // an endpoint connected after the allocation, as in TcpSocketBase::Connect
+  Ipv4EndPoint *client = demux.Allocate (local);
+  uint16_t clientPort = client->GetLocalPort ();
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (clientPort), true, "Ephemeral port not in use");
+  client->SetPeer (Ipv4Address ("10.3.0.1"), 8080);
+  found = demux.Lookup (local, clientPort, Ipv4Address ("10.3.0.1"), 8080, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connected client not found");
+  NS_TEST_ASSERT_MSG_EQ (found.front (), client, "Wrong endpoint found");
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (local, clientPort, Ipv4Address ("10.3.0.2"), 8080, interface).size (), 0,
+                         "Connected client matched a different peer");
+
+  // disabled endpoints are skipped
+  connections[0]->SetRxEnabled (false);
+  found = demux.Lookup (local, 80, Ipv4Address (0x0a010000), 1000, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Disabled endpoint not skipped");
+
+  demux.DeAllocate (connections[1]);
+  found = demux.Lookup (local, 80, Ipv4Address (0x0a010001), 1001, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Deallocated endpoint found");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetAllEndPoints ().size (), 101, "Wrong number of endpoints");
+
+  demux.DeAllocate (client);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (clientPort), false, "Ephemeral port still in use");
+  NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (local, 81, Ipv4Address ("10.2.0.1"), 5000), 0,
+                         "SimpleLookup found an endpoint on an unused port");
+  NS_TEST_ASSERT_MSG_EQ (demux.Lookup (any, 80, any, 0, interface).size (), 1,
+                         "Wildcard lookup failed");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Ipv6EndPointDemux lookup test
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+public:
+  Ipv6EndPointDemuxTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase ()
+  : TestCase ("Ipv6EndPointDemux lookup")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun (void)
+{
+  Ipv6EndPointDemux demux;
+  Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface> ();
+  Ipv6Address local ("2001:db8::1");
+  Ipv6Address peer ("2001:db8::2");
+
+  Ipv6EndPoint *listener = demux.Allocate (0, 80);
+  NS_TEST_ASSERT_MSG_NE (listener, 0, "Listener allocation failed");
+  Ipv6EndPoint *connection = demux.Allocate (0, local, 80, peer, 1000);
+  NS_TEST_ASSERT_MSG_NE (connection, 0, "Connection allocation failed");
+  NS_TEST_ASSERT_MSG_EQ (demux.Allocate (0, local, 80, peer, 1000), 0, "Duplicated connection allowed");
+
+  Ipv6EndPointDemux::EndPoints found = demux.Lookup (local, 80, peer, 1000, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connection not found");
+  NS_TEST_ASSERT_MSG_EQ (found.front (), connection, "Wrong connection found");
+  found = demux.Lookup (local, 80, peer, 1001, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Listener not found");
+
+  // the local port and the peer can change after the allocation
+  Ipv6EndPoint *client = demux.Allocate (local);
+  client->SetLocalPort (2000);
+  client->SetPeer (peer, 8080);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (2000), true, "New local port not in use");
+  found = demux.Lookup (local, 2000, peer, 8080, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Connected client not found");
+  NS_TEST_ASSERT_MSG_EQ (found.front (), client, "Wrong endpoint found");
+  NS_TEST_ASSERT_MSG_EQ (demux.SimpleLookup (local, 2000, peer, 8080), client, "Wrong endpoint found by SimpleLookup");
+
+  demux.DeAllocate (connection);
+  found = demux.Lookup (local, 80, peer, 1000, interface);
+  NS_TEST_ASSERT_MSG_EQ (found.front (), listener, "Deallocated endpoint found");
+  demux.DeAllocate (client);
+  NS_TEST_ASSERT_MSG_EQ (demux.LookupPortLocal (2000), false, "Local port still in use");
+  NS_TEST_ASSERT_MSG_EQ (demux.GetEndPoints ().size (), 1, "Wrong number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief EndPointDemux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+public:
+  EndPointDemuxTestSuite () : TestSuite ("end-point-demux", UNIT)
+  {
+    AddTestCase (new Ipv4EndPointDemuxTestCase, TestCase::QUICK);
+    AddTestCase (new Ipv6EndPointDemuxTestCase, TestCase::QUICK);
+  }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
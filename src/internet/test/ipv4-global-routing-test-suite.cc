@@ -42,6 +42,10 @@
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/bridge-helper.h"
+#include "ns3/global-route-manager.h"
+#include "ns3/global-router-interface.h"
+#include "ns3/global-value.h"
+#include "ns3/output-stream-wrapper.h"
 
 using namespace ns3;
 
@@ -1244,6 +1248,151 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting parallel and incremental SPF test
+ *
+ * Checks that the routing tables do not depend on the number of SPF
+ * threads, and that RecomputeRoutingTables after a link goes down gives the
+ * same routing tables as a full recomputation, while leaving the routers of
+ * the other connected components untouched.
+ */
+class Ipv4GlobalRoutingIncrementalTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingIncrementalTestCase ();
+
+private:
+  /**
+   * \brief Print the routing tables of some nodes.
+   * \param nodes the nodes
+   * \returns the routing tables
+   */
+  std::string GetRoutingTables (NodeContainer nodes);
+  /**
+   * \brief Delete and recompute all the routes.
+   */
+  void FullRecompute (void);
+  virtual void DoRun (void);
+};
+
+Ipv4GlobalRoutingIncrementalTestCase::Ipv4GlobalRoutingIncrementalTestCase ()
+  : TestCase ("Parallel and incremental global routing")
+{
+}
+
+std::string
+Ipv4GlobalRoutingIncrementalTestCase::GetRoutingTables (NodeContainer nodes)
+{
+  std::ostringstream oss;
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&oss);
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); i++)
+    {
+      (*i)->GetObject<Ipv4> ()->GetRoutingProtocol ()->PrintRoutingTable (stream);
+    }
+  return oss.str ();
+}
+
+void
+Ipv4GlobalRoutingIncrementalTestCase::FullRecompute (void)
+{
+  GlobalRouteManager::DeleteGlobalRoutes ();
+  GlobalRouteManager::BuildGlobalRoutingDatabase ();
+  GlobalRouteManager::InitializeRoutes ();
+}
+
+// A ring of five routers with a host on r0 and a LAN shared by r2 and two
+// hosts, and a chain of three routers x0 - x1 - x2 in another component. The
+// ring has an odd length, so that the shortest paths are unique:
+//
+//         h0
+//         |
+//    +--- r0 ---+
+//    |          |
+//    r1         r4
+//    |          |
+//    r2 ------- r3
+//    |
+//  ==+===+===+== LAN
+//        |   |
+//        h1  h2
+//
+void
+Ipv4GlobalRoutingIncrementalTestCase::DoRun (void)
+{
+  NodeContainer routers;
+  routers.Create (5);
+  NodeContainer hosts;
+  hosts.Create (3);
+  NodeContainer chain;
+  chain.Create (3);
+  NodeContainer grid (routers, hosts);
+
+  InternetStackHelper internet;
+  internet.Install (grid);
+  internet.Install (chain);
+
+  SimpleNetDeviceHelper devHelper;
+  devHelper.SetNetDevicePointToPointMode (true);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.255.252");
+  NetDeviceContainer r1r2;
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NetDeviceContainer d = devHelper.Install (NodeContainer (routers.Get (i), routers.Get ((i + 1) % 5)));
+      ipv4.Assign (d);
+      ipv4.NewNetwork ();
+      if (i == 1)
+        {
+          r1r2 = d;
+        }
+    }
+  ipv4.Assign (devHelper.Install (NodeContainer (hosts.Get (0), routers.Get (0))));
+  ipv4.SetBase ("10.2.0.0", "255.255.255.252");
+  ipv4.Assign (devHelper.Install (NodeContainer (chain.Get (0), chain.Get (1))));
+  ipv4.NewNetwork ();
+  ipv4.Assign (devHelper.Install (NodeContainer (chain.Get (1), chain.Get (2))));
+  devHelper.SetNetDevicePointToPointMode (false);
+  ipv4.SetBase ("10.3.0.0", "255.255.255.0");
+  ipv4.Assign (devHelper.Install (NodeContainer (routers.Get (2), hosts.Get (1), hosts.Get (2))));
+
+  // the routing tables do not depend on the number of threads
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (4));
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  std::string parallel = GetRoutingTables (grid);
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  FullRecompute ();
+  std::string sequential = GetRoutingTables (grid);
+  NS_TEST_ASSERT_MSG_EQ (parallel, sequential, "Parallel SPF gave different routes");
+  NS_TEST_ASSERT_MSG_NE (sequential.find ("10.3.0.0"), std::string::npos, "No route to the LAN");
+
+  // a route added to a router of the other component is kept by the
+  // incremental recomputation
+  Ptr<Ipv4GlobalRouting> x0 = chain.Get (0)->GetObject<GlobalRouter> ()->GetRoutingProtocol ();
+  x0->AddHostRouteTo (Ipv4Address ("192.168.0.1"), Ipv4Address ("10.2.0.2"), 1);
+  uint32_t x0Routes = x0->GetNRoutes ();
+
+  // take the r1 - r2 link down
+  Ptr<Ipv4> ipv4r1 = routers.Get (1)->GetObject<Ipv4> ();
+  ipv4r1->SetDown (ipv4r1->GetInterfaceForDevice (r1r2.Get (0)));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::string incremental = GetRoutingTables (grid);
+  NS_TEST_ASSERT_MSG_EQ (x0->GetNRoutes (), x0Routes, "Routes of an unaffected router recomputed");
+  NS_TEST_ASSERT_MSG_NE (incremental, sequential, "Routes not updated after the link went down");
+  FullRecompute ();
+  NS_TEST_ASSERT_MSG_EQ (incremental, GetRoutingTables (grid), "Incremental SPF gave different routes");
+
+  // and up again
+  ipv4r1->SetUp (ipv4r1->GetInterfaceForDevice (r1r2.Get (0)));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  NS_TEST_ASSERT_MSG_EQ (GetRoutingTables (grid), sequential, "Routes not restored after the link went up");
+
+  Config::SetGlobal ("GlobalRoutingSpfThreads", UintegerValue (1));
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1267,6 +1416,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingIncrementalTestCase, TestCase::QUICK);
   }
 
 static Ipv4GlobalRoutingTestSuite g_globalRoutingTestSuite; //!< Static variable for test initialization
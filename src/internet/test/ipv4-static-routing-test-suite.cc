@@ -22,6 +22,10 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-header.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
 #include "ns3/packet.h"
@@ -201,6 +205,100 @@ Ipv4StaticRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting longest prefix match Test
+ *
+ * Checks that the longest prefix wins whatever the order of the routes, that
+ * the metric breaks the ties, and that the lookups see the route changes.
+ */
+class Ipv4StaticRoutingLongestPrefixTestCase : public TestCase
+{
+public:
+  Ipv4StaticRoutingLongestPrefixTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Look up the gateway towards a destination.
+   * \param routing the routing protocol
+   * \param dest the destination
+   * \return the gateway, or 255.255.255.255 if there is no route
+   */
+  Ipv4Address GetGateway (Ptr<Ipv4StaticRouting> routing, std::string dest);
+};
+
+Ipv4StaticRoutingLongestPrefixTestCase::Ipv4StaticRoutingLongestPrefixTestCase ()
+  : TestCase ("Longest prefix match in static routing")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingLongestPrefixTestCase::GetGateway (Ptr<Ipv4StaticRouting> routing, std::string dest)
+{
+  Ipv4Header header;
+  header.SetDestination (Ipv4Address (dest.c_str ()));
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+  if (route == 0)
+    {
+      return Ipv4Address::GetBroadcast ();
+    }
+  return route->GetGateway ();
+}
+
+void
+Ipv4StaticRoutingLongestPrefixTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+
+  SimpleNetDeviceHelper devHelper;
+  NetDeviceContainer devices = devHelper.Install (node);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.0.0.0", "255.255.255.0");
+  ipv4.Assign (devices);
+
+  Ipv4StaticRoutingHelper helper;
+  Ptr<Ipv4StaticRouting> routing = helper.GetStaticRouting (node->GetObject<Ipv4> ());
+  uint32_t interface = 1;
+
+  routing->SetDefaultRoute (Ipv4Address ("10.0.0.1"), interface);
+  routing->AddNetworkRouteTo (Ipv4Address ("20.1.2.0"), Ipv4Mask ("/24"), Ipv4Address ("10.0.0.4"), interface);
+  routing->AddNetworkRouteTo (Ipv4Address ("20.0.0.0"), Ipv4Mask ("/8"), Ipv4Address ("10.0.0.2"), interface);
+  routing->AddNetworkRouteTo (Ipv4Address ("20.1.0.0"), Ipv4Mask ("/16"), Ipv4Address ("10.0.0.3"), interface, 10);
+  routing->AddNetworkRouteTo (Ipv4Address ("20.1.0.0"), Ipv4Mask ("/16"), Ipv4Address ("10.0.0.5"), interface, 5);
+  routing->AddHostRouteTo (Ipv4Address ("20.1.2.3"), Ipv4Address ("10.0.0.6"), interface);
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "30.0.0.1"), Ipv4Address ("10.0.0.1"), "Default route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "20.2.0.1"), Ipv4Address ("10.0.0.2"), "/8 route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "20.1.3.1"), Ipv4Address ("10.0.0.5"), "/16 route with the smallest metric not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "20.1.2.1"), Ipv4Address ("10.0.0.4"), "/24 route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "20.1.2.3"), Ipv4Address ("10.0.0.6"), "Host route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.0.0.9"), Ipv4Address ("0.0.0.0"), "Connected route not used");
+
+  // remove the host route and the /24 route
+  for (uint32_t i = 0; i < routing->GetNRoutes (); )
+    {
+      Ipv4RoutingTableEntry route = routing->GetRoute (i);
+      if (route.GetGateway () == Ipv4Address ("10.0.0.6") || route.GetGateway () == Ipv4Address ("10.0.0.4"))
+        {
+          routing->RemoveRoute (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "20.1.2.3"), Ipv4Address ("10.0.0.5"), "Removed routes still used");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -217,6 +315,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite ()
   : TestSuite ("ipv4-static-routing", UNIT)
 {
   AddTestCase (new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4StaticRoutingLongestPrefixTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite ipv4StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-bbr.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "tcp-general-test.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpBbrTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the BBR modes with synthetic rate samples
+ *
+ * Each round, 10 segments are delivered in 100 ms, i.e. 800 kb/s with an
+ * RTprop of 100 ms (BDP of 10 segments). The bandwidth does not grow, so
+ * the pipe is full after three rounds without growth: BBR goes through DRAIN
+ * to PROBE_BW. When the RTprop estimate expires, BBR enters PROBE_RTT,
+ * clamping cwnd to 4 segments, and returns to PROBE_BW after 200 ms and a
+ * round.
+ */
+class TcpBbrModeTestCase : public TestCase
+{
+public:
+  /** \brief Constructor */
+  TcpBbrModeTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Deliver a round of data
+   * \param inFlight bytes in flight after the ACK
+   */
+  void Round (uint32_t inFlight);
+  /** \brief Check STARTUP */
+  void CheckStartup ();
+  /** \brief Check DRAIN, then drain the queue */
+  void CheckDrain ();
+  /** \brief Check PROBE_BW */
+  void CheckProbeBw ();
+  /** \brief Check PROBE_RTT */
+  void CheckProbeRtt ();
+  /** \brief Check the end of PROBE_RTT */
+  void CheckProbeRttDone ();
+
+  const uint32_t m_segmentSize {1000};   //!< Segment size
+  const uint32_t m_roundBytes {10000};   //!< Bytes delivered per round
+  const Time m_rtt {MilliSeconds (100)}; //!< RTT
+  Ptr<TcpSocketState> m_tcb;             //!< Congestion state
+  Ptr<TcpBbr> m_bbr;                     //!< Congestion control
+  TcpRateOps::TcpRateConnection m_rc;    //!< Rate of the connection
+  TcpRateOps::TcpRateSample m_rs;        //!< Rate sample
+};
+
+TcpBbrModeTestCase::TcpBbrModeTestCase ()
+  : TestCase ("BBR mode transitions")
+{
+}
+
+void
+TcpBbrModeTestCase::DoRun ()
+{
+  m_tcb = CreateObject<TcpSocketState> ();
+  m_tcb->m_segmentSize = m_segmentSize;
+  m_tcb->m_initialCWnd = 10;
+  m_tcb->m_cWnd = 10 * m_segmentSize;
+  m_tcb->m_ssThresh = UINT32_MAX;
+  m_tcb->m_lastRtt = m_rtt;
+  m_tcb->m_minRtt = m_rtt;
+  m_tcb->m_maxPacingRate = DataRate ("4Gb/s");
+  m_tcb->m_currentPacingRate = m_tcb->m_maxPacingRate;
+
+  m_bbr = CreateObject<TcpBbr> ();
+  m_bbr->AssignStreams (1);
+  m_bbr->Init (m_tcb);
+  NS_TEST_ASSERT_MSG_EQ (m_tcb->m_pacing, true, "BBR enables pacing");
+
+  m_bbr->CwndEvent (m_tcb, TcpSocketState::CA_EVENT_TX_START);
+  // high gain * 10 segments / 100 ms, with the 1% margin
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_tcb->m_currentPacingRate.GetBitRate (), 2284920, 1,
+                             "Initial pacing rate not set from cwnd and srtt");
+
+  for (uint32_t i = 1; i <= 3; ++i)
+    {
+      Simulator::Schedule (m_rtt * i, &TcpBbrModeTestCase::Round, this, 20 * m_segmentSize);
+    }
+  Simulator::Schedule (m_rtt * 3, &TcpBbrModeTestCase::CheckStartup, this);
+  Simulator::Schedule (m_rtt * 4, &TcpBbrModeTestCase::Round, this, 20 * m_segmentSize);
+  Simulator::Schedule (m_rtt * 4, &TcpBbrModeTestCase::CheckDrain, this);
+  Simulator::Schedule (m_rtt * 5, &TcpBbrModeTestCase::CheckProbeBw, this);
+  Simulator::Schedule (Seconds (10.5), &TcpBbrModeTestCase::CheckProbeRtt, this);
+  Simulator::Schedule (Seconds (10.85), &TcpBbrModeTestCase::CheckProbeRttDone, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpBbrModeTestCase::Round (uint32_t inFlight)
+{
+  m_rs.m_priorDelivered = static_cast<uint32_t> (m_rc.m_delivered);
+  m_rc.m_delivered += m_roundBytes;
+  m_rs.m_delivered = m_roundBytes;
+  m_rs.m_interval = m_rtt;
+  m_rs.m_ackedSacked = m_roundBytes;
+  m_rs.m_priorInFlight = inFlight + m_roundBytes;
+  m_rs.m_rtt = m_rtt;
+  m_tcb->m_bytesInFlight = inFlight;
+
+  m_bbr->CongControl (m_tcb, m_rc, m_rs);
+}
+
+void
+TcpBbrModeTestCase::CheckStartup ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetMode (), TcpBbr::BBR_STARTUP, "Pipe full too early");
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetBtlBw (), DataRate (800000), "Wrong bandwidth estimate");
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetRtProp (), m_rtt, "Wrong RTprop estimate");
+  NS_TEST_ASSERT_MSG_EQ (m_tcb->m_cWnd, 40 * m_segmentSize, "cwnd grows as in slow start");
+}
+
+void
+TcpBbrModeTestCase::CheckDrain ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->IsFullBwReached (), true, "Pipe not full");
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetMode (), TcpBbr::BBR_DRAIN, "Not in DRAIN");
+  // BDP of 10 segments, plus 3, rounded to an even number of segments
+  NS_TEST_ASSERT_MSG_EQ (m_tcb->m_ssThresh, 14 * m_segmentSize, "ssthresh not set to the BDP");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_tcb->m_currentPacingRate.GetBitRate (), 274523, 1,
+                             "DRAIN paces at the inverse of the high gain");
+
+  // The queue drains
+  Simulator::Schedule (m_rtt / 2, &TcpBbrModeTestCase::Round, this, 10 * m_segmentSize);
+}
+
+void
+TcpBbrModeTestCase::CheckProbeBw ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetMode (), TcpBbr::BBR_PROBE_BW, "Not in PROBE_BW");
+  // The first phase of the cycle is never the draining one
+  uint64_t rate = m_tcb->m_currentPacingRate.GetBitRate ();
+  NS_TEST_ASSERT_MSG_EQ (((rate >= 791999 && rate <= 792000) || (rate >= 989999 && rate <= 990000)), true,
+                         "Unexpected pacing rate " << m_tcb->m_currentPacingRate);
+  NS_TEST_ASSERT_MSG_EQ ((m_tcb->m_cWnd.Get () >= 24 * m_segmentSize
+                          && m_tcb->m_cWnd.Get () <= 26 * m_segmentSize), true,
+                         "cwnd not bounded by twice the BDP: " << m_tcb->m_cWnd);
+
+  // Keep delivering, without any new RTprop sample
+  for (uint32_t i = 1; i <= 120; ++i)
+    {
+      Simulator::Schedule (m_rtt * i, &TcpBbrModeTestCase::Round, this, 10 * m_segmentSize);
+    }
+}
+
+void
+TcpBbrModeTestCase::CheckProbeRtt ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetMode (), TcpBbr::BBR_PROBE_RTT,
+                         "PROBE_RTT not entered after the RTprop expiration");
+  NS_TEST_ASSERT_MSG_EQ (m_tcb->m_cWnd, 4 * m_segmentSize, "cwnd not clamped in PROBE_RTT");
+
+  // The inflight drops to the minimum: PROBE_RTT lasts 200 ms from now
+  Round (4 * m_segmentSize);
+}
+
+void
+TcpBbrModeTestCase::CheckProbeRttDone ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_bbr->GetMode (), TcpBbr::BBR_PROBE_BW, "PROBE_RTT not left");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (m_tcb->m_cWnd.Get (), 24 * m_segmentSize,
+                               "cwnd not restored after PROBE_RTT");
+  Simulator::Stop ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check cwnd in loss recovery
+ *
+ * On entering fast recovery, BBR sets cwnd to the inflight plus the data
+ * delivered (packet conservation); when the recovery is over, it restores
+ * the cwnd saved before the loss.
+ */
+class TcpBbrRecoveryTestCase : public TestCase
+{
+public:
+  /** \brief Constructor */
+  TcpBbrRecoveryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TcpBbrRecoveryTestCase::TcpBbrRecoveryTestCase ()
+  : TestCase ("BBR packet conservation in recovery")
+{
+}
+
+void
+TcpBbrRecoveryTestCase::DoRun ()
+{
+  const uint32_t segmentSize = 1000;
+  Ptr<TcpSocketState> tcb = CreateObject<TcpSocketState> ();
+  tcb->m_segmentSize = segmentSize;
+  tcb->m_initialCWnd = 10;
+  tcb->m_cWnd = 20 * segmentSize;
+  tcb->m_ssThresh = UINT32_MAX;
+  tcb->m_maxPacingRate = DataRate ("4Gb/s");
+
+  Ptr<TcpBbr> bbr = CreateObject<TcpBbr> ();
+  bbr->Init (tcb);
+
+  TcpRateOps::TcpRateConnection rc;
+  TcpRateOps::TcpRateSample rs;
+  rs.m_delivered = -1;
+  rs.m_ackedSacked = segmentSize;
+
+  // Three duplicate ACKs: TcpSocketBase notifies the state change and asks
+  // for ssthresh
+  bbr->CongestionStateSet (tcb, TcpSocketState::CA_RECOVERY);
+  tcb->m_congState = TcpSocketState::CA_RECOVERY;
+  uint32_t ssThresh = bbr->GetSsThresh (tcb, 18 * segmentSize);
+  NS_TEST_ASSERT_MSG_EQ (ssThresh, UINT32_MAX, "BBR does not use ssthresh for losses");
+
+  tcb->m_bytesInFlight = 15 * segmentSize;
+  bbr->CongControl (tcb, rc, rs);
+  NS_TEST_ASSERT_MSG_EQ (tcb->m_cWnd, 16 * segmentSize, "No packet conservation");
+
+  tcb->m_bytesInFlight = 10 * segmentSize;
+  bbr->CongControl (tcb, rc, rs);
+  NS_TEST_ASSERT_MSG_EQ (tcb->m_cWnd, 16 * segmentSize, "cwnd must not shrink in recovery");
+
+  bbr->CongestionStateSet (tcb, TcpSocketState::CA_OPEN);
+  tcb->m_congState = TcpSocketState::CA_OPEN;
+  bbr->CongControl (tcb, rc, rs);
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (tcb->m_cWnd.Get (), 20 * segmentSize,
+                               "cwnd not restored after the recovery");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check that the data segments leave at the pacing rate
+ *
+ * The application writes faster than the pacing rate, and the channel has
+ * no rate limit: each data segment must leave at least the transmission time
+ * of the previous one, at the pacing rate in use at that time, after it.
+ */
+class TcpPacingSpacingTest : public TcpGeneralTest
+{
+public:
+  /**
+   * \brief Constructor
+   * \param congControl congestion control
+   * \param desc test description
+   */
+  TcpPacingSpacingTest (TypeId congControl, const std::string &desc);
+
+protected:
+  virtual void ConfigureEnvironment ();
+  virtual void ConfigureProperties ();
+  virtual void Tx (const Ptr<const Packet> p, const TcpHeader &h, SocketWho who);
+  virtual void FinalChecks ();
+
+private:
+  Time m_lastTx {0};         //!< Departure of the previous data segment
+  Time m_lastTxTime {0};     //!< Transmission time of the previous data segment
+  uint32_t m_dataSent {0};   //!< Data segments sent
+  bool m_rateChanged {false}; //!< True if the pacing rate left the maximum
+};
+
+TcpPacingSpacingTest::TcpPacingSpacingTest (TypeId congControl, const std::string &desc)
+  : TcpGeneralTest (desc)
+{
+  SetCongestionControl (congControl);
+}
+
+void
+TcpPacingSpacingTest::ConfigureEnvironment ()
+{
+  TcpGeneralTest::ConfigureEnvironment ();
+  SetAppPktCount (200);
+  SetAppPktInterval (MicroSeconds (10));
+  SetPropagationDelay (MilliSeconds (5));
+}
+
+void
+TcpPacingSpacingTest::ConfigureProperties ()
+{
+  TcpGeneralTest::ConfigureProperties ();
+  GetTcb (SENDER)->m_pacing = true;
+  GetTcb (SENDER)->m_maxPacingRate = DataRate ("100Mb/s");
+  GetTcb (SENDER)->m_currentPacingRate = GetTcb (SENDER)->m_maxPacingRate;
+}
+
+void
+TcpPacingSpacingTest::Tx (const Ptr<const Packet> p, const TcpHeader &h, SocketWho who)
+{
+  if (who != SENDER || p->GetSize () == 0)
+    {
+      return;
+    }
+
+  if (m_dataSent > 0)
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (Simulator::Now () - m_lastTx, m_lastTxTime,
+                                   "Segment " << h.GetSequenceNumber () << " not paced");
+    }
+
+  DataRate rate = GetTcb (SENDER)->m_currentPacingRate;
+  m_rateChanged |= (rate != GetTcb (SENDER)->m_maxPacingRate);
+  m_lastTx = Simulator::Now ();
+  m_lastTxTime = rate.CalculateBytesTxTime (p->GetSize ());
+  ++m_dataSent;
+}
+
+void
+TcpPacingSpacingTest::FinalChecks ()
+{
+  NS_TEST_ASSERT_MSG_GT (m_dataSent, 0, "No data sent");
+  NS_TEST_ASSERT_MSG_EQ (m_rateChanged, true, "The pacing rate never followed cwnd / RTT");
+  NS_TEST_ASSERT_MSG_EQ (GetTxBuffer (SENDER)->Size (), 0, "Data not delivered");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for BBR and pacing
+ */
+class TcpBbrTestSuite : public TestSuite
+{
+public:
+  TcpBbrTestSuite () : TestSuite ("tcp-bbr", UNIT)
+  {
+    AddTestCase (new TcpPacingSpacingTest (TcpNewReno::GetTypeId (), "Pacing with NewReno"),
+                 TestCase::QUICK);
+    AddTestCase (new TcpPacingSpacingTest (TcpBbr::GetTypeId (), "Pacing with BBR"),
+                 TestCase::QUICK);
+    // Run after the socket tests, which enable the packet metadata
+    AddTestCase (new TcpBbrModeTestCase (), TestCase::QUICK);
+    AddTestCase (new TcpBbrRecoveryTestCase (), TestCase::QUICK);
+  }
+};
+
+static TcpBbrTestSuite g_tcpBbrTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-rack-tlp.h"
+#include "ns3/tcp-tx-buffer.h"
+#include "ns3/boolean.h"
+#include "tcp-general-test.h"
+#include "tcp-error-model.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpRackTlpTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the RACK state and the time-based loss marking
+ *
+ * Ten segments are sent one millisecond apart; the sixth one is SACKed
+ * after 45 ms. The segments sent before it are not lost yet, as the
+ * reordering window (a quarter of the minimum RTT) has not elapsed; they
+ * are lost at the expiration of the reordering timeout returned by
+ * DetectLoss. Then, a late cumulative ACK reveals reordering.
+ */
+class TcpRackTlpLossTestCase : public TestCase
+{
+public:
+  /** \brief Constructor */
+  TcpRackTlpLossTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Send the next segment of the buffer
+   * \param seq sequence of the segment
+   */
+  void Send (SequenceNumber32 seq);
+  /** \brief SACK the sixth segment, and check that nothing is lost */
+  void SackSegment ();
+  /** \brief Check the losses after the reordering timeout */
+  void ReorderTimeout ();
+  /** \brief Deliver the head, which was not lost but only delayed */
+  void LateAck ();
+  /**
+   * \brief Delivery callback of the Tx buffer
+   * \param item the item delivered
+   */
+  void Delivered (TcpTxItem *item);
+
+  const uint32_t m_segmentSize {100};    //!< Segment size
+  const Time m_minRtt {MilliSeconds (40)}; //!< Minimum RTT of the connection
+  const Time m_srtt {MilliSeconds (45)};   //!< Smoothed RTT of the connection
+  SequenceNumber32 m_head {1};           //!< First sequence of the buffer
+  Ptr<TcpTxBuffer> m_txBuf;              //!< Tx buffer
+  Ptr<TcpRackTlp> m_rack;                //!< RACK-TLP state
+  Time m_timeout;                        //!< Reordering timeout returned by DetectLoss
+};
+
+TcpRackTlpLossTestCase::TcpRackTlpLossTestCase ()
+  : TestCase ("RACK time-based loss marking")
+{
+}
+
+void
+TcpRackTlpLossTestCase::DoRun ()
+{
+  m_txBuf = CreateObject<TcpTxBuffer> ();
+  m_rack = CreateObject<TcpRackTlp> ();
+  m_txBuf->SetHeadSequence (m_head);
+  m_txBuf->SetSegmentSize (m_segmentSize);
+  m_txBuf->SetDupAckThresh (3);
+  m_txBuf->SetDupAckLossMarking (false);
+  m_txBuf->Add (Create<Packet> (10 * m_segmentSize));
+
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (i), &TcpRackTlpLossTestCase::Send, this,
+                           m_head + m_segmentSize * i);
+    }
+  Simulator::Schedule (MilliSeconds (50), &TcpRackTlpLossTestCase::SackSegment, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpRackTlpLossTestCase::Send (SequenceNumber32 seq)
+{
+  m_txBuf->CopyFromSequence (m_segmentSize, seq);
+}
+
+void
+TcpRackTlpLossTestCase::Delivered (TcpTxItem *item)
+{
+  m_rack->UpdateStats (item, m_minRtt);
+}
+
+void
+TcpRackTlpLossTestCase::SackSegment ()
+{
+  Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+  sack->AddSackBlock (TcpOptionSack::SackBlock (m_head + m_segmentSize * 5,
+                                                m_head + m_segmentSize * 6));
+  m_txBuf->Update (sack->GetSackList (),
+                   MakeCallback (&TcpRackTlpLossTestCase::Delivered, this));
+
+  m_timeout = m_rack->DetectLoss (m_txBuf, false, 3, m_segmentSize, m_srtt, m_minRtt);
+
+  NS_TEST_ASSERT_MSG_EQ (m_rack->GetRtt (), MilliSeconds (45), "Wrong RACK.rtt");
+  NS_TEST_ASSERT_MSG_EQ (m_rack->GetReoWnd (), MilliSeconds (10),
+                         "The reordering window must be minRtt / 4");
+  NS_TEST_ASSERT_MSG_EQ (m_txBuf->GetLost (), 0, "Segments lost before the reordering window");
+  // The head, sent at 0 ms, is lost at 0 + 45 + 10 ms; the fifth segment at 4 + 45 + 10 ms
+  NS_TEST_ASSERT_MSG_EQ (m_timeout, MilliSeconds (9), "Wrong reordering timeout");
+
+  Simulator::Schedule (m_timeout, &TcpRackTlpLossTestCase::ReorderTimeout, this);
+}
+
+void
+TcpRackTlpLossTestCase::ReorderTimeout ()
+{
+  m_timeout = m_rack->DetectLoss (m_txBuf, false, 3, m_segmentSize, m_srtt, m_minRtt);
+
+  NS_TEST_ASSERT_MSG_EQ (m_timeout, Time (0), "No segment should wait for the timer");
+  NS_TEST_ASSERT_MSG_EQ (m_txBuf->GetLost (), 5 * m_segmentSize,
+                         "The segments sent before the SACKed one are lost");
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_txBuf->IsLost (m_head + m_segmentSize * i), (i < 5),
+                             "Wrong lost flag for segment " << i);
+    }
+
+  SequenceNumber32 next;
+  NS_TEST_ASSERT_MSG_EQ (m_txBuf->NextSeg (&next, true), true, "No segment to retransmit");
+  NS_TEST_ASSERT_MSG_EQ (next, m_head, "The head should be retransmitted first");
+
+  Simulator::Schedule (MilliSeconds (1), &TcpRackTlpLossTestCase::LateAck, this);
+}
+
+void
+TcpRackTlpLossTestCase::LateAck ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_rack->IsReorderingSeen (), false, "No reordering yet");
+
+  // The original head arrives: it was delayed, not lost
+  m_txBuf->DiscardUpTo (m_head + m_segmentSize,
+                        MakeCallback (&TcpRackTlpLossTestCase::Delivered, this));
+  m_rack->DetectLoss (m_txBuf, true, 3, m_segmentSize, m_srtt, m_minRtt);
+
+  NS_TEST_ASSERT_MSG_EQ (m_rack->IsReorderingSeen (), true,
+                         "The head has been delivered after the sixth segment");
+  NS_TEST_ASSERT_MSG_EQ (m_rack->GetReoWnd (), MilliSeconds (10),
+                         "With reordering, the window is used even in recovery");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Check the Probe TimeOut computation
+ */
+class TcpRackTlpPtoTestCase : public TestCase
+{
+public:
+  /** \brief Constructor */
+  TcpRackTlpPtoTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TcpRackTlpPtoTestCase::TcpRackTlpPtoTestCase ()
+  : TestCase ("TLP probe timeout")
+{
+}
+
+void
+TcpRackTlpPtoTestCase::DoRun ()
+{
+  Ptr<TcpRackTlp> rack = CreateObject<TcpRackTlp> ();
+  Time delAck = MilliSeconds (200);
+
+  NS_TEST_ASSERT_MSG_EQ (rack->CalculatePto (Time (0), 1000, 500, delAck, Time (0)),
+                         Seconds (1), "Without RTT samples, the PTO is one second");
+  NS_TEST_ASSERT_MSG_EQ (rack->CalculatePto (MilliSeconds (50), 1000, 500, delAck, Time (0)),
+                         MilliSeconds (100), "The PTO is two SRTT");
+  NS_TEST_ASSERT_MSG_EQ (rack->CalculatePto (MilliSeconds (50), 500, 500, delAck, Time (0)),
+                         MilliSeconds (300), "With one segment in flight, wait for the delayed ACK");
+  NS_TEST_ASSERT_MSG_EQ (rack->CalculatePto (MilliSeconds (50), 1000, 500, delAck, MilliSeconds (70)),
+                         MilliSeconds (70), "The PTO can not be later than the RTO");
+
+  rack->TlpSent (SequenceNumber32 (1001), true);
+  NS_TEST_ASSERT_MSG_EQ (rack->IsTlpInProgress (), true, "The probe starts an episode");
+  NS_TEST_ASSERT_MSG_EQ (rack->TlpAckReceived (SequenceNumber32 (501)), false,
+                         "The ACK does not cover the probe");
+  NS_TEST_ASSERT_MSG_EQ (rack->TlpAckReceived (SequenceNumber32 (1001)), true,
+                         "The retransmitted probe repaired a loss");
+  NS_TEST_ASSERT_MSG_EQ (rack->IsTlpInProgress (), false, "The episode is over");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Recover losses with RACK-TLP instead of the RTO
+ *
+ * One segment is dropped. When it is the last one, the tail loss probe
+ * retransmits it; otherwise, RACK marks it lost when the following segments
+ * are SACKed. In both cases, the RTO never expires.
+ */
+class TcpRackTlpRecoveryTest : public TcpGeneralTest
+{
+public:
+  /**
+   * \brief Constructor
+   * \param seqToDrop sequence number to drop
+   * \param expectRecovery true if fast recovery should be entered
+   * \param desc test description
+   */
+  TcpRackTlpRecoveryTest (uint32_t seqToDrop, bool expectRecovery, const std::string &desc);
+
+protected:
+  virtual void ConfigureEnvironment ();
+  virtual Ptr<TcpSocketMsgBase> CreateSenderSocket (Ptr<Node> node);
+  virtual Ptr<ErrorModel> CreateReceiverErrorModel ();
+  virtual void BeforeRTOExpired (const Ptr<const TcpSocketState> tcb, SocketWho who);
+  virtual void CongStateTrace (const TcpSocketState::TcpCongState_t oldValue,
+                               const TcpSocketState::TcpCongState_t newValue);
+  virtual void FinalChecks ();
+
+private:
+  uint32_t m_seqToDrop;     //!< Sequence number to drop
+  bool m_expectRecovery;    //!< True if fast recovery should be entered
+  bool m_rtoExpired {false}; //!< True if the RTO expired
+  bool m_recovery {false};  //!< True if fast recovery has been entered
+};
+
+TcpRackTlpRecoveryTest::TcpRackTlpRecoveryTest (uint32_t seqToDrop, bool expectRecovery,
+                                                const std::string &desc)
+  : TcpGeneralTest (desc),
+    m_seqToDrop (seqToDrop),
+    m_expectRecovery (expectRecovery)
+{
+}
+
+void
+TcpRackTlpRecoveryTest::ConfigureEnvironment ()
+{
+  TcpGeneralTest::ConfigureEnvironment ();
+  SetAppPktCount (100);
+  SetAppPktInterval (MicroSeconds (100));
+  SetPropagationDelay (MilliSeconds (10));
+}
+
+Ptr<TcpSocketMsgBase>
+TcpRackTlpRecoveryTest::CreateSenderSocket (Ptr<Node> node)
+{
+  Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket (node);
+  socket->SetAttribute ("RackTlp", BooleanValue (true));
+  return socket;
+}
+
+Ptr<ErrorModel>
+TcpRackTlpRecoveryTest::CreateReceiverErrorModel ()
+{
+  Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel> ();
+  errorModel->AddSeqToKill (SequenceNumber32 (m_seqToDrop));
+  return errorModel;
+}
+
+void
+TcpRackTlpRecoveryTest::BeforeRTOExpired (const Ptr<const TcpSocketState> tcb, SocketWho who)
+{
+  if (who == SENDER)
+    {
+      m_rtoExpired = true;
+    }
+}
+
+void
+TcpRackTlpRecoveryTest::CongStateTrace (const TcpSocketState::TcpCongState_t oldValue,
+                                        const TcpSocketState::TcpCongState_t newValue)
+{
+  if (newValue == TcpSocketState::CA_RECOVERY)
+    {
+      m_recovery = true;
+    }
+}
+
+void
+TcpRackTlpRecoveryTest::FinalChecks ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_rtoExpired, false, "The loss has been recovered by the RTO");
+  NS_TEST_ASSERT_MSG_EQ (m_recovery, m_expectRecovery, "Unexpected fast recovery");
+  NS_TEST_ASSERT_MSG_EQ (GetTxBuffer (SENDER)->Size (), 0, "Data not delivered");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for RACK-TLP
+ */
+class TcpRackTlpTestSuite : public TestSuite
+{
+public:
+  TcpRackTlpTestSuite () : TestSuite ("tcp-rack-tlp", UNIT)
+  {
+    AddTestCase (new TcpRackTlpRecoveryTest (10001, true, "RACK recovers a lost segment"),
+                 TestCase::QUICK);
+    AddTestCase (new TcpRackTlpRecoveryTest (49501, false, "TLP recovers the lost tail"),
+                 TestCase::QUICK);
+    // Run after the socket tests, which enable the packet metadata
+    AddTestCase (new TcpRackTlpLossTestCase (), TestCase::QUICK);
+    AddTestCase (new TcpRackTlpPtoTestCase (), TestCase::QUICK);
+  }
+};
+
+static TcpRackTlpTestSuite g_tcpRackTlpTestSuite; //!< Static variable for test initialization
@@ -44,6 +44,11 @@ private:
    * \brief Test the SACK list update.
    */
   void TestUpdateSACKList ();
+
+  /**
+   * \brief Test the reassembly of many out-of-order and overlapping segments.
+   */
+  void TestReassembly ();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase ()
@@ -55,6 +60,7 @@ void
 TcpRxBufferTestCase::DoRun ()
 {
   TestUpdateSACKList ();
+  TestReassembly ();
 }
 
 void
@@ -338,6 +344,63 @@ TcpRxBufferTestCase::TestUpdateSACKList ()
                          "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReassembly ()
+{
+  const uint32_t segSize = 100;
+  const uint32_t nSegs = 1000;
+  TcpRxBuffer rxBuf;
+  TcpHeader h;
+
+  rxBuf.SetMaxBufferSize (segSize * nSegs);
+  rxBuf.SetNextRxSequence (SequenceNumber32 (1));
+
+  // Every segment but the first, received in reverse order: each one is
+  // merged on the left of the single SACK block
+  for (uint32_t i = nSegs - 1; i > 0; --i)
+    {
+      h.SetSequenceNumber (SequenceNumber32 (1 + i * segSize));
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (Create<Packet> (segSize), h), true,
+                             "Segment should have been buffered");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (1),
+                         "Sequence number differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "No data should be available");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), (nSegs - 1) * segSize,
+                         "Buffer occupancy differs from expected");
+  TcpOptionSack::SackList sackList = rxBuf.GetSackList ();
+  NS_TEST_ASSERT_MSG_EQ (sackList.size (), 1,
+                         "SACK list should contain one element");
+  NS_TEST_ASSERT_MSG_EQ (sackList.begin ()->first, SequenceNumber32 (1 + segSize),
+                         "SACK block different than expected");
+  NS_TEST_ASSERT_MSG_EQ (sackList.begin ()->second, SequenceNumber32 (1 + nSegs * segSize),
+                         "SACK block different than expected");
+
+  // Duplicated and overlapping data is not buffered again
+  h.SetSequenceNumber (SequenceNumber32 (1 + 10 * segSize + segSize / 2));
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (Create<Packet> (segSize), h), false,
+                         "Overlapping segment should not have been buffered");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), (nSegs - 1) * segSize,
+                         "Buffer occupancy differs from expected");
+
+  // A first segment overlapping the second fills the hole
+  h.SetSequenceNumber (SequenceNumber32 (1));
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (Create<Packet> (segSize + segSize / 2), h), true,
+                         "Segment should have been buffered");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (1 + nSegs * segSize),
+                         "Sequence number differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), nSegs * segSize,
+                         "All data should be available");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 0,
+                         "SACK list should contain no element");
+
+  Ptr<Packet> out = rxBuf.Extract (nSegs * segSize);
+  NS_TEST_ASSERT_MSG_EQ (out->GetSize (), nSegs * segSize,
+                         "Extracted size differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "Buffer should be empty");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown ()
 {
@@ -49,6 +49,8 @@ private:
   void TestTransmittedBlock ();
   /** \brief Test the generation of the "next" block */
   void TestNextSeg ();
+  /** \brief Test the scoreboard with a large window and scattered losses */
+  void TestLargeWindow ();
 };
 
 TcpTxBufferTestCase::TcpTxBufferTestCase ()
@@ -81,11 +83,90 @@ TcpTxBufferTestCase::DoRun ()
                        &TcpTxBufferTestCase::TestTransmittedBlock, this);
   Simulator::Schedule (Seconds (0.0),
                        &TcpTxBufferTestCase::TestNextSeg, this);
+  Simulator::Schedule (Seconds (0.0),
+                       &TcpTxBufferTestCase::TestLargeWindow, this);
 
   Simulator::Run ();
   Simulator::Destroy ();
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow ()
+{
+  const uint32_t segmentSize = 100;
+  const uint32_t nSegs = 2000;
+  const uint32_t lossPeriod = 10;
+  TcpTxBuffer txBuf;
+  SequenceNumber32 head (1);
+  SequenceNumber32 ret;
+  Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack> ();
+  txBuf.SetHeadSequence (head);
+  txBuf.SetSegmentSize (segmentSize);
+  txBuf.SetDupAckThresh (3);
+  txBuf.SetMaxBufferSize (segmentSize * nSegs);
+
+  txBuf.Add (Create<Packet> (segmentSize * nSegs));
+  for (uint32_t i = 0; i < nSegs; ++i)
+    {
+      txBuf.CopyFromSequence (segmentSize, head + (segmentSize * i));
+    }
+
+  // Every lossPeriod-th segment is lost; the receiver SACKs each run of
+  // segments received between two holes
+  for (uint32_t i = 0; i < nSegs; i += lossPeriod)
+    {
+      sack->ClearSackList ();
+      sack->AddSackBlock (TcpOptionSack::SackBlock (head + (segmentSize * (i + 1)),
+                                                    head + (segmentSize * (i + lossPeriod))));
+      txBuf.Update (sack->GetSackList ());
+    }
+
+  uint32_t nLost = nSegs / lossPeriod;
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), (nSegs - nLost) * segmentSize,
+                         "Different sacked bytes than expected");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), nLost * segmentSize,
+                         "Different lost bytes than expected");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), 0,
+                         "Nothing should be in flight");
+
+  for (uint32_t i = 0; i < nSegs; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + (segmentSize * i)), (i % lossPeriod == 0),
+                             "Different IsLost than expected for segment " << i);
+    }
+
+  // NextSeg should return the holes in order, one after the other
+  for (uint32_t i = 0; i < nSegs; i += lossPeriod)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&ret, true), true,
+                             "No NextSeq while holes are left");
+      NS_TEST_ASSERT_MSG_EQ (ret, head + (segmentSize * i),
+                             "Different NextSeq than expected");
+      txBuf.CopyFromSequence (segmentSize, ret);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&ret, true), false,
+                         "Nothing should be left to retransmit");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetRetransmitsCount (), nLost * segmentSize,
+                         "Different retransmitted bytes than expected");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), nLost * segmentSize,
+                         "Only retransmissions should be in flight");
+
+  // Cumulative ACK of the first half of the window
+  txBuf.DiscardUpTo (head + (segmentSize * nSegs / 2));
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), nLost * segmentSize / 2,
+                         "Different lost bytes than expected after ACK");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), (nSegs - nLost) * segmentSize / 2,
+                         "Different sacked bytes than expected after ACK");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + (segmentSize * nSegs / 2)), true,
+                         "The new head should be lost");
+
+  txBuf.DiscardUpTo (head + (segmentSize * nSegs));
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), 0,
+                         "Nothing should be in flight after the final ACK");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.Size (), 0, "Buffer should be empty");
+}
+
 void
 TcpTxBufferTestCase::TestIsLost ()
 {
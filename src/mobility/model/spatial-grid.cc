@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "spatial-grid.h"
+#include "mobility-model.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatialGrid");
+
+SpatialGrid::SpatialGrid (double cellSize)
+  : m_cellSize (cellSize),
+    m_nItems (0)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT_MSG (cellSize > 0, "SpatialGrid: the size of the cells must be positive");
+}
+
+SpatialGrid::~SpatialGrid ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+double
+SpatialGrid::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+std::size_t
+SpatialGrid::GetN (void) const
+{
+  return m_nItems;
+}
+
+SpatialGrid::Cell
+SpatialGrid::GetCell (const Vector &position) const
+{
+  Cell cell;
+  cell.x = static_cast<int64_t> (std::floor (position.x / m_cellSize));
+  cell.y = static_cast<int64_t> (std::floor (position.y / m_cellSize));
+  cell.z = static_cast<int64_t> (std::floor (position.z / m_cellSize));
+  return cell;
+}
+
+void
+SpatialGrid::Add (uint32_t id, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << id << mobility);
+  NS_ASSERT (mobility != 0);
+  ++m_nItems;
+  std::unordered_map<const MobilityModel *, uint32_t>::iterator i = m_index.find (PeekPointer (mobility));
+  if (i != m_index.end ())
+    {
+      m_located[i->second].ids.push_back (id);
+      return;
+    }
+  uint32_t index = m_located.size ();
+  Located located;
+  located.mobility = mobility;
+  located.ids.push_back (id);
+  m_located.push_back (located);
+  m_index[PeekPointer (mobility)] = index;
+  Insert (index);
+  mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&SpatialGrid::CourseChanged, this));
+}
+
+void
+SpatialGrid::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Located>::iterator i = m_located.begin (); i != m_located.end (); ++i)
+    {
+      i->mobility->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&SpatialGrid::CourseChanged, this));
+    }
+  m_located.clear ();
+  m_index.clear ();
+  m_cells.clear ();
+  m_moving.clear ();
+  m_nItems = 0;
+}
+
+void
+SpatialGrid::Insert (uint32_t index)
+{
+  Located &located = m_located[index];
+  Vector velocity = located.mobility->GetVelocity ();
+  located.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+  if (located.moving)
+    {
+      located.slot = m_moving.size ();
+      m_moving.push_back (index);
+      return;
+    }
+  located.position = located.mobility->GetPosition ();
+  located.cell = GetCell (located.position);
+  std::vector<uint32_t> &cell = m_cells[located.cell];
+  located.slot = cell.size ();
+  cell.push_back (index);
+}
+
+void
+SpatialGrid::Erase (uint32_t index)
+{
+  Located &located = m_located[index];
+  std::vector<uint32_t> *models = &m_moving;
+  CellMap::iterator cell = m_cells.end ();
+  if (!located.moving)
+    {
+      cell = m_cells.find (located.cell);
+      NS_ASSERT (cell != m_cells.end ());
+      models = &cell->second;
+    }
+  // move the last model of the cell into the slot of the erased one
+  NS_ASSERT ((*models)[located.slot] == index);
+  uint32_t last = models->back ();
+  (*models)[located.slot] = last;
+  m_located[last].slot = located.slot;
+  models->pop_back ();
+  if (cell != m_cells.end () && cell->second.empty ())
+    {
+      m_cells.erase (cell);
+    }
+}
+
+void
+SpatialGrid::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::unordered_map<const MobilityModel *, uint32_t>::const_iterator i = m_index.find (PeekPointer (mobility));
+  NS_ASSERT (i != m_index.end ());
+  Erase (i->second);
+  Insert (i->second);
+}
+
+void
+SpatialGrid::AddNeighbors (const Located &located, const Vector &itemPosition,
+                           const Vector &position, double range2,
+                           std::vector<uint32_t> &ids)
+{
+  double dx = itemPosition.x - position.x;
+  double dy = itemPosition.y - position.y;
+  double dz = itemPosition.z - position.z;
+  if (dx * dx + dy * dy + dz * dz <= range2)
+    {
+      ids.insert (ids.end (), located.ids.begin (), located.ids.end ());
+    }
+}
+
+void
+SpatialGrid::GetNeighbors (const Vector &position, double range, std::vector<uint32_t> &ids) const
+{
+  NS_LOG_FUNCTION (this << position << range);
+  ids.clear ();
+  double range2 = range * range;
+  Cell low = GetCell (Vector (position.x - range, position.y - range, position.z - range));
+  Cell high = GetCell (Vector (position.x + range, position.y + range, position.z + range));
+  double nCells = double (high.x - low.x + 1) * double (high.y - low.y + 1) * double (high.z - low.z + 1);
+  if (nCells > m_cells.size ())
+    {
+      // fewer cells are occupied than crossed by the range
+      for (CellMap::const_iterator i = m_cells.begin (); i != m_cells.end (); ++i)
+        {
+          const Cell &cell = i->first;
+          if (cell.x < low.x || cell.x > high.x
+              || cell.y < low.y || cell.y > high.y
+              || cell.z < low.z || cell.z > high.z)
+            {
+              continue;
+            }
+          for (std::vector<uint32_t>::const_iterator j = i->second.begin (); j != i->second.end (); ++j)
+            {
+              AddNeighbors (m_located[*j], m_located[*j].position, position, range2, ids);
+            }
+        }
+    }
+  else
+    {
+      Cell cell;
+      for (cell.x = low.x; cell.x <= high.x; ++cell.x)
+        {
+          for (cell.y = low.y; cell.y <= high.y; ++cell.y)
+            {
+              for (cell.z = low.z; cell.z <= high.z; ++cell.z)
+                {
+                  CellMap::const_iterator i = m_cells.find (cell);
+                  if (i == m_cells.end ())
+                    {
+                      continue;
+                    }
+                  for (std::vector<uint32_t>::const_iterator j = i->second.begin (); j != i->second.end (); ++j)
+                    {
+                      AddNeighbors (m_located[*j], m_located[*j].position, position, range2, ids);
+                    }
+                }
+            }
+        }
+    }
+  for (std::vector<uint32_t>::const_iterator i = m_moving.begin (); i != m_moving.end (); ++i)
+    {
+      AddNeighbors (m_located[*i], m_located[*i].mobility->GetPosition (), position, range2, ids);
+    }
+  std::sort (ids.begin (), ids.end ());
+  NS_LOG_LOGIC (ids.size () << " of " << m_nItems << " items in range");
+}
+
+} // namespace ns3
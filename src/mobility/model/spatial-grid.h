@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Uniform grid of the positions of mobility models, to find the
+ * models close to a position without looking at all of them.
+ *
+ * The users, such as the channels, identify their items with integer ids,
+ * several of which can share a mobility model.  The models with a zero
+ * velocity are kept in the cubic cells of the grid, and are moved between
+ * the cells when they notify a course change.  The models with a non-zero
+ * velocity are kept out of the grid, and their distance is computed by each
+ * query.  The positions of the models with a zero velocity are assumed to
+ * change only with a course change notification.
+ *
+ * The cells should be about the size of the ranges of the queries: a
+ * query looks at the items of the cells crossed by its range.
+ */
+class SpatialGrid : public SimpleRefCount<SpatialGrid>
+{
+public:
+  /**
+   * \param cellSize the size of the cells, in meters
+   */
+  SpatialGrid (double cellSize);
+  ~SpatialGrid ();
+
+  /**
+   * \returns the size of the cells, in meters
+   */
+  double GetCellSize (void) const;
+
+  /**
+   * \brief Add an item.
+   * \param id the id of the item
+   * \param mobility the mobility model giving the position of the item
+   */
+  void Add (uint32_t id, Ptr<MobilityModel> mobility);
+
+  /**
+   * \brief Remove all the items.
+   */
+  void Clear (void);
+
+  /**
+   * \returns the number of items
+   */
+  std::size_t GetN (void) const;
+
+  /**
+   * \brief Find the items close to a position.
+   * \param position the position
+   * \param range the maximum distance of the items, in meters
+   * \param ids the ids of the items at most range away from the position,
+   *        in increasing order
+   */
+  void GetNeighbors (const Vector &position, double range, std::vector<uint32_t> &ids) const;
+
+private:
+  /// Coordinates of a cell
+  struct Cell
+  {
+    int64_t x; //!< Index along the x axis
+    int64_t y; //!< Index along the y axis
+    int64_t z; //!< Index along the z axis
+    /**
+     * \param o another cell
+     * \returns true if the cells are the same
+     */
+    bool operator == (const Cell &o) const
+    {
+      return x == o.x && y == o.y && z == o.z;
+    }
+  };
+
+  /// Hash of the coordinates of a cell
+  struct CellHash
+  {
+    /**
+     * \param cell the cell
+     * \returns the hash of its coordinates
+     */
+    std::size_t operator () (const Cell &cell) const
+    {
+      return static_cast<std::size_t> (cell.x * 73856093 ^ cell.y * 19349663 ^ cell.z * 83492791);
+    }
+  };
+
+  /// A mobility model and the items it locates
+  struct Located
+  {
+    Ptr<MobilityModel> mobility;  //!< The mobility model
+    std::vector<uint32_t> ids;    //!< The items
+    Vector position;              //!< The position, if the model does not move
+    bool moving;                  //!< Whether the model has a non-zero velocity
+    Cell cell;                    //!< The cell, if the model does not move
+    std::size_t slot;             //!< Index in the cell or in the moving models
+  };
+
+  /// Located models of the cells
+  typedef std::unordered_map<Cell, std::vector<uint32_t>, CellHash> CellMap;
+
+  /**
+   * \param position a position
+   * \returns the cell of the position
+   */
+  Cell GetCell (const Vector &position) const;
+
+  /**
+   * \brief Put a located model in its cell, or with the moving models.
+   * \param index the index of the located model
+   */
+  void Insert (uint32_t index);
+
+  /**
+   * \brief Take a located model out of its cell, or of the moving models.
+   * \param index the index of the located model
+   */
+  void Erase (uint32_t index);
+
+  /**
+   * \brief Add the items of a located model close to a position.
+   * \param located the located model
+   * \param itemPosition the position of the model
+   * \param position the position of the query
+   * \param range2 the square of the range of the query
+   * \param ids the ids found
+   */
+  static void AddNeighbors (const Located &located, const Vector &itemPosition,
+                            const Vector &position, double range2,
+                            std::vector<uint32_t> &ids);
+
+  /**
+   * \brief Move a model whose course changed.
+   * \param mobility the mobility model
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  double m_cellSize;                 //!< Size of the cells
+  std::size_t m_nItems;              //!< Number of items
+  std::vector<Located> m_located;    //!< The located models
+  std::unordered_map<const MobilityModel *, uint32_t> m_index; //!< Indices of the located models
+  CellMap m_cells;                   //!< Located models of the cells
+  std::vector<uint32_t> m_moving;    //!< Located models which move
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_H */
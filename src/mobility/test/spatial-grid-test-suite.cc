@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/spatial-grid.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Compare the neighbors found by a SpatialGrid with the distances
+ * computed from all the mobility models, while the models move.
+ */
+class SpatialGridTestCase : public TestCase
+{
+public:
+  SpatialGridTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the neighbors of all the models.
+   * \param range the range of the queries
+   */
+  void Check (double range);
+
+  Ptr<SpatialGrid> m_grid;                     //!< The grid
+  std::vector<Ptr<MobilityModel> > m_models;   //!< Mobility model of each item
+};
+
+SpatialGridTestCase::SpatialGridTestCase ()
+  : TestCase ("Check the neighbors found by the spatial grid")
+{
+}
+
+void
+SpatialGridTestCase::Check (double range)
+{
+  std::vector<uint32_t> found;
+  for (uint32_t i = 0; i < m_models.size (); ++i)
+    {
+      Vector position = m_models[i]->GetPosition ();
+      m_grid->GetNeighbors (position, range, found);
+      std::vector<uint32_t> expected;
+      for (uint32_t j = 0; j < m_models.size (); ++j)
+        {
+          if (CalculateDistance (position, m_models[j]->GetPosition ()) <= range)
+            {
+              expected.push_back (j);
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (found.size (), expected.size (),
+                             "Wrong number of neighbors of " << i << " in " << range << " m at " << Simulator::Now ().As (Time::S));
+      for (uint32_t k = 0; k < found.size (); ++k)
+        {
+          NS_TEST_ASSERT_MSG_EQ (found[k], expected[k], "Wrong neighbor of " << i << " in " << range << " m");
+        }
+    }
+}
+
+void
+SpatialGridTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> coordinate = CreateObject<UniformRandomVariable> ();
+  coordinate->SetStream (1);
+  coordinate->SetAttribute ("Min", DoubleValue (-500));
+  coordinate->SetAttribute ("Max", DoubleValue (500));
+
+  m_grid = Create<SpatialGrid> (100);
+  for (uint32_t i = 0; i < 200; ++i)
+    {
+      Ptr<MobilityModel> model;
+      if (i % 4 == 0)
+        {
+          Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+          moving->SetVelocity (Vector (coordinate->GetValue () / 10, coordinate->GetValue () / 10, 0));
+          model = moving;
+        }
+      else
+        {
+          model = CreateObject<ConstantPositionMobilityModel> ();
+        }
+      model->SetPosition (Vector (coordinate->GetValue (), coordinate->GetValue (), coordinate->GetValue () / 50));
+      m_models.push_back (model);
+    }
+  // two items share the last model
+  m_models.push_back (m_models.back ());
+  for (uint32_t i = 0; i < m_models.size (); ++i)
+    {
+      m_grid->Add (i, m_models[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_grid->GetN (), m_models.size (), "Wrong number of items");
+
+  Check (50);
+  Check (150);
+  Check (5000);
+
+  // the moving models move, some models stop, and the static ones jump
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  for (uint32_t i = 0; i < m_models.size (); i += 3)
+    {
+      Ptr<ConstantVelocityMobilityModel> moving = DynamicCast<ConstantVelocityMobilityModel> (m_models[i]);
+      if (moving)
+        {
+          moving->SetVelocity (Vector (0, 0, 0));
+        }
+      else
+        {
+          m_models[i]->SetPosition (Vector (coordinate->GetValue (), coordinate->GetValue (), 0));
+        }
+    }
+  Check (50);
+  Check (150);
+
+  m_grid->Clear ();
+  NS_TEST_ASSERT_MSG_EQ (m_grid->GetN (), 0, "The grid must be empty");
+  std::vector<uint32_t> found;
+  m_grid->GetNeighbors (Vector (0, 0, 0), 5000, found);
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 0, "No neighbors in an empty grid");
+
+  Simulator::Destroy ();
+  m_grid = 0;
+  m_models.clear ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief SpatialGrid TestSuite
+ */
+class SpatialGridTestSuite : public TestSuite
+{
+public:
+  SpatialGridTestSuite ();
+};
+
+SpatialGridTestSuite::SpatialGridTestSuite ()
+  : TestSuite ("spatial-grid", UNIT)
+{
+  AddTestCase (new SpatialGridTestCase, TestCase::QUICK);
+}
+
+static SpatialGridTestSuite g_spatialGridTestSuite; //!< Static variable for test initialization
@@ -19,6 +19,9 @@
 #include <stdint.h>
 #include <string>
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <functional>
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
@@ -28,6 +31,12 @@
 #include "ns3/names.h"
 #include "ns3/net-device.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file-wrapper.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 
 #include "trace-helper.h"
 
@@ -35,6 +44,96 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceHelper");
 
+/**
+ * \ingroup network
+ * \brief Name of the pcapng file all the pcap traces are written to.
+ */
+static GlobalValue g_pcapSharedFile = GlobalValue ("PcapSharedFile",
+                                                   "If not empty, the pcap traces are written to this single pcapng "
+                                                   "file, as interfaces named after the files they would have been "
+                                                   "written to.",
+                                                   StringValue (""),
+                                                   MakeStringChecker ());
+
+/**
+ * \ingroup network
+ * \brief Whether the ascii traces write the uid and size of the packets
+ * instead of printing them.
+ */
+static GlobalValue g_asciiTraceCompact = GlobalValue ("AsciiTraceCompact",
+                                                      "Whether the ascii traces only write the uid and the size "
+                                                      "of the packets, instead of printing them.",
+                                                      BooleanValue (false),
+                                                      MakeBooleanChecker ());
+
+/**
+ * \ingroup network
+ * \brief Fraction of the events written to the ascii traces.
+ */
+static GlobalValue g_asciiTraceSampleInterval = GlobalValue ("AsciiTraceSampleInterval",
+                                                             "The ascii traces write one event out of this number.",
+                                                             UintegerValue (1),
+                                                             MakeUintegerChecker<uint32_t> (1));
+
+/**
+ * \ingroup network
+ * \brief Number of events of each traced object written to the ascii traces.
+ */
+static GlobalValue g_asciiTraceFirstPerFlow = GlobalValue ("AsciiTraceFirstPerFlow",
+                                                           "If not zero, the ascii traces only write this number of "
+                                                           "events of each traced object.",
+                                                           UintegerValue (0),
+                                                           MakeUintegerChecker<uint32_t> ());
+
+/**
+ * \ingroup network
+ * \brief Start of the events written to the ascii traces.
+ */
+static GlobalValue g_asciiTraceStart = GlobalValue ("AsciiTraceStart",
+                                                    "The ascii traces write the events from this time.",
+                                                    TimeValue (Seconds (0)),
+                                                    MakeTimeChecker ());
+
+/**
+ * \ingroup network
+ * \brief End of the events written to the ascii traces.
+ */
+static GlobalValue g_asciiTraceStop = GlobalValue ("AsciiTraceStop",
+                                                   "If not zero, the ascii traces write the events before this time.",
+                                                   TimeValue (Seconds (0)),
+                                                   MakeTimeChecker ());
+
+/**
+ * \brief Sampling of an ascii trace stream, and its counters.
+ */
+struct AsciiTraceSampler
+{
+  Ptr<OutputStreamWrapper> m_stream;  //!< The stream, kept until the sampling is dropped
+  AsciiTraceSampling m_sampling;      //!< The sampling
+  uint32_t m_selected;                //!< Events selected since the last one written
+  std::unordered_map<uint64_t, uint32_t> m_flowEvents; //!< Events of each flow
+};
+
+/**
+ * \returns the sampling of the streams which have one, by stream
+ */
+static std::unordered_map<OutputStreamWrapper *, AsciiTraceSampler> &
+GetSamplers (void)
+{
+  static std::unordered_map<OutputStreamWrapper *, AsciiTraceSampler> samplers;
+  return samplers;
+}
+
+/**
+ * \returns the shared pcapng files, by name
+ */
+static std::map<std::string, Ptr<PcapNgFileWrapper> > &
+GetSharedFiles (void)
+{
+  static std::map<std::string, Ptr<PcapNgFileWrapper> > sharedFiles;
+  return sharedFiles;
+}
+
 PcapHelper::PcapHelper ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -55,6 +154,17 @@ PcapHelper::CreateFile (
 {
   NS_LOG_FUNCTION (filename << filemode << dataLinkType << snapLen << tzCorrection);
 
+  StringValue sharedFile;
+  g_pcapSharedFile.GetValue (sharedFile);
+  if (!sharedFile.Get ().empty () && (filemode & std::ios::out))
+    {
+      Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
+      file->SetSharedFile (CreateSharedFile (sharedFile.Get ()), filename);
+      file->Init (dataLinkType, snapLen, tzCorrection);
+      NS_ABORT_MSG_IF (file->Fail (), "Unable to add " << filename << " to " << sharedFile.Get ());
+      return file;
+    }
+
   Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
   file->Open (filename, filemode);
   NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename << " for mode " << filemode);
@@ -76,6 +186,42 @@ PcapHelper::CreateFile (
   return file;
 }
 
+Ptr<PcapNgFileWrapper>
+PcapHelper::CreateSharedFile (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  std::map<std::string, Ptr<PcapNgFileWrapper> > &sharedFiles = GetSharedFiles ();
+  std::map<std::string, Ptr<PcapNgFileWrapper> >::iterator it = sharedFiles.find (filename);
+  if (it != sharedFiles.end ())
+    {
+      return it->second;
+    }
+
+  Ptr<PcapNgFileWrapper> file = CreateObject<PcapNgFileWrapper> ();
+  file->Open (filename);
+  NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename);
+
+  //
+  // The helper keeps the file for the devices to come, until the simulator
+  // is destroyed.  The file is then closed once the trace sinks of the
+  // devices are destroyed too.
+  //
+  if (sharedFiles.empty ())
+    {
+      Simulator::ScheduleDestroy (&PcapHelper::ReleaseSharedFiles);
+    }
+  sharedFiles[filename] = file;
+  return file;
+}
+
+void
+PcapHelper::ReleaseSharedFiles (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetSharedFiles ().clear ();
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -193,6 +339,11 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   NS_LOG_FUNCTION (filename << filemode);
 
   Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper> (filename, filemode);
+  AsciiTraceSampling sampling = GetDefaultSampling ();
+  if (sampling.IsEnabled ())
+    {
+      SetSampling (StreamWrapper, sampling);
+    }
 
   //
   // Note that the ascii trace helper promptly forgets all about the trace file.
@@ -208,6 +359,154 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
   return StreamWrapper;
 }
 
+AsciiTraceSampling::AsciiTraceSampling ()
+  : m_compact (false),
+    m_interval (1),
+    m_firstPerFlow (0),
+    m_start (Seconds (0)),
+    m_stop (Seconds (0))
+{
+}
+
+bool
+AsciiTraceSampling::IsEnabled (void) const
+{
+  return m_compact || m_interval > 1 || m_firstPerFlow > 0 || m_start.IsStrictlyPositive () || !m_stop.IsZero ();
+}
+
+void
+AsciiTraceHelper::SetSampling (Ptr<OutputStreamWrapper> stream, AsciiTraceSampling const &sampling)
+{
+  NS_LOG_FUNCTION (stream);
+  std::unordered_map<OutputStreamWrapper *, AsciiTraceSampler> &samplers = GetSamplers ();
+  if (!sampling.IsEnabled ())
+    {
+      samplers.erase (PeekPointer (stream));
+      return;
+    }
+  if (samplers.empty ())
+    {
+      Simulator::ScheduleDestroy (&AsciiTraceHelper::ReleaseSampling);
+    }
+  AsciiTraceSampler &sampler = samplers[PeekPointer (stream)];
+  sampler.m_stream = stream;
+  sampler.m_sampling = sampling;
+  sampler.m_selected = 0;
+  sampler.m_flowEvents.clear ();
+}
+
+AsciiTraceSampling
+AsciiTraceHelper::GetDefaultSampling (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  AsciiTraceSampling sampling;
+  BooleanValue compact;
+  g_asciiTraceCompact.GetValue (compact);
+  sampling.m_compact = compact.Get ();
+  UintegerValue value;
+  g_asciiTraceSampleInterval.GetValue (value);
+  sampling.m_interval = value.Get ();
+  g_asciiTraceFirstPerFlow.GetValue (value);
+  sampling.m_firstPerFlow = value.Get ();
+  TimeValue time;
+  g_asciiTraceStart.GetValue (time);
+  sampling.m_start = time.Get ();
+  g_asciiTraceStop.GetValue (time);
+  sampling.m_stop = time.Get ();
+  return sampling;
+}
+
+void
+AsciiTraceHelper::ReleaseSampling (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetSamplers ().clear ();
+}
+
+/**
+ * \brief Check if the sampling of a stream selects an event.
+ * \param sampler the sampling of the stream
+ * \param now the time of the event
+ * \param context the context of the event, or null
+ * \param p the packet of the event
+ * \returns true if the event must be written
+ */
+static bool
+SelectEvent (AsciiTraceSampler &sampler, Time now, std::string const *context, Ptr<const Packet> p)
+{
+  AsciiTraceSampling const &sampling = sampler.m_sampling;
+  if (now < sampling.m_start || (!sampling.m_stop.IsZero () && now >= sampling.m_stop))
+    {
+      return false;
+    }
+  if (sampling.m_firstPerFlow > 0)
+    {
+      uint64_t flow = 0;
+      if (!sampling.m_flowClassifier.IsNull ())
+        {
+          flow = sampling.m_flowClassifier (p);
+        }
+      else if (context)
+        {
+          flow = std::hash<std::string> () (*context);
+        }
+      uint32_t &events = sampler.m_flowEvents[flow];
+      if (events >= sampling.m_firstPerFlow)
+        {
+          return false;
+        }
+      ++events;
+    }
+  if (++sampler.m_selected < sampling.m_interval)
+    {
+      return false;
+    }
+  sampler.m_selected = 0;
+  return true;
+}
+
+void
+AsciiTraceHelper::WriteLine (char operation, Ptr<OutputStreamWrapper> stream, std::string const *context, Ptr<const Packet> p)
+{
+  Time now = Simulator::Now ();
+  bool compact = false;
+
+  //
+  // The streams without sampling cost one test, when no stream has one.
+  //
+  std::unordered_map<OutputStreamWrapper *, AsciiTraceSampler> &samplers = GetSamplers ();
+  if (!samplers.empty ())
+    {
+      std::unordered_map<OutputStreamWrapper *, AsciiTraceSampler>::iterator it = samplers.find (PeekPointer (stream));
+      if (it != samplers.end ())
+        {
+          if (!SelectEvent (it->second, now, context, p))
+            {
+              return;
+            }
+          compact = it->second.m_sampling.m_compact;
+        }
+    }
+
+  std::ostream *os = stream->GetStream ();
+  *os << operation << " " << now.GetSeconds () << " ";
+  if (context)
+    {
+      *os << *context << " ";
+    }
+  if (compact)
+    {
+      //
+      // Neither the packet metadata nor a flush per line.
+      //
+      *os << p->GetUid () << " " << p->GetSize () << "\n";
+    }
+  else
+    {
+      *os << *p << std::endl;
+    }
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -310,14 +609,14 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
+  WriteLine ('+', stream, 0, p);
 }
 
 void
 AsciiTraceHelper::DefaultEnqueueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
+  WriteLine ('+', stream, &context, p);
 }
 
 //
@@ -336,14 +635,14 @@ void
 AsciiTraceHelper::DefaultDropSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
+  WriteLine ('d', stream, 0, p);
 }
 
 void
 AsciiTraceHelper::DefaultDropSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
+  WriteLine ('d', stream, &context, p);
 }
 
 //
@@ -363,14 +662,14 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
+  WriteLine ('-', stream, 0, p);
 }
 
 void
 AsciiTraceHelper::DefaultDequeueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
+  WriteLine ('-', stream, &context, p);
 }
 
 //
@@ -387,14 +686,14 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
+  WriteLine ('r', stream, 0, p);
 }
 
 void
 AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
-  *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
+  WriteLine ('r', stream, &context, p);
 }
 
 void 
@@ -24,7 +24,10 @@
 #include "ns3/node-container.h"
 #include "ns3/simulator.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file-wrapper.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
 
 namespace ns3 {
 
@@ -109,6 +112,26 @@ public:
                                    DataLinkType dataLinkType,
                                    uint32_t snapLen = std::numeric_limits<uint32_t>::max (),
                                    int32_t tzCorrection = 0);
+
+  /**
+   * @brief Get the shared pcapng file of the given name, created and
+   * opened on the first call.
+   *
+   * The packets of several devices can then be written to this single file,
+   * each device being an interface of the file (see
+   * PcapFileWrapper::SetSharedFile).  The helper releases the file when the
+   * simulator is destroyed.
+   *
+   * When the "PcapSharedFile" global value is not empty, CreateFile () does
+   * this for all the files opened for writing: each one becomes an
+   * interface of the shared file, named after the file, so that the
+   * EnablePcap methods of all the device helpers write to a single file.
+   *
+   * @param filename file name
+   * @returns a smart pointer to the pcapng file
+   */
+  Ptr<PcapNgFileWrapper> CreateSharedFile (std::string filename);
+
   /**
    * @brief Hook a trace source to the default trace sink
    * 
@@ -141,6 +164,11 @@ private:
    * @see DefaultSink
    */
   static void SinkWithHeader (Ptr<PcapFileWrapper> file, const Header& header, Ptr<const Packet> p);
+
+  /**
+   * Release the shared files, when the simulator is destroyed.
+   */
+  static void ReleaseSharedFiles (void);
 };
 
 template <typename T> void
@@ -151,6 +179,39 @@ PcapHelper::HookDefaultSink (Ptr<T> object, std::string tracename, Ptr<PcapFileW
   NS_ASSERT_MSG (result == true, "PcapHelper::HookDefaultSink():  Unable to hook \"" << tracename << "\"");
 }
 
+/**
+ * \ingroup tracing
+ *
+ * \brief Selection of the events written by the default ascii trace sinks,
+ * and format of their lines.
+ *
+ * By default, all the events are written, with the packets printed in full
+ * by Packet::Print.  An event is written if it is in the time window, if it
+ * is among the first events of its flow, and then one event out of
+ * m_interval.  The compact format only writes the uid and the size of the
+ * packets, which does not need the packet metadata.
+ */
+struct AsciiTraceSampling
+{
+  AsciiTraceSampling ();
+
+  /**
+   * \returns true if some events are not written, or the lines are compact
+   */
+  bool IsEnabled (void) const;
+
+  bool m_compact;          //!< Write the uid and size of the packets instead of printing them
+  uint32_t m_interval;     //!< Write one event out of m_interval
+  uint32_t m_firstPerFlow; //!< Write only the first events of each flow, if not zero
+  Time m_start;            //!< Write the events from this time
+  Time m_stop;             //!< Write the events before this time, if not zero
+  /**
+   * Flow of a packet, for m_firstPerFlow.  If null, each traced object
+   * (each context) is one flow.
+   */
+  Callback<uint64_t, Ptr<const Packet> > m_flowClassifier;
+};
+
 /**
  * \brief Manage ASCII trace files for device models
  *
@@ -222,6 +283,27 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Select the events written to a stream by the default sinks, and
+   * the format of their lines.
+   *
+   * The streams created by CreateFileStream () get the sampling given by the
+   * "AsciiTraceCompact", "AsciiTraceSampleInterval", "AsciiTraceFirstPerFlow",
+   * "AsciiTraceStart" and "AsciiTraceStop" global values.  This method sets
+   * the sampling of any stream, for instance one created by the user.  The
+   * sampling of the streams is dropped when the simulator is destroyed.
+   *
+   * @param stream the stream
+   * @param sampling the sampling, or a default AsciiTraceSampling to write
+   *        all the events in full
+   */
+  static void SetSampling (Ptr<OutputStreamWrapper> stream, AsciiTraceSampling const &sampling);
+
+  /**
+   * @returns the sampling given by the global values
+   */
+  static AsciiTraceSampling GetDefaultSampling (void);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
@@ -455,6 +537,23 @@ public:
    * @param p the packet
    */
   static void DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> file, std::string context, Ptr<const Packet> p);
+
+private:
+  /**
+   * @brief Write the line of an event of a default sink, if the sampling of
+   * the stream selects it.
+   *
+   * @param operation the character of the operation
+   * @param file the output file
+   * @param context the context, or null for the sinks without context
+   * @param p the packet
+   */
+  static void WriteLine (char operation, Ptr<OutputStreamWrapper> file, std::string const *context, Ptr<const Packet> p);
+
+  /**
+   * Drop the sampling of the streams, when the simulator is destroyed.
+   */
+  static void ReleaseSampling (void);
 };
 
 template <typename T> void
@@ -25,6 +25,7 @@
 #include "application.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/config.h"
 #include "ns3/object-vector.h"
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
@@ -132,6 +133,7 @@ Node::AddDevice (Ptr<NetDevice> device)
   NS_LOG_FUNCTION (this << device);
   uint32_t index = m_devices.size ();
   m_devices.push_back (device);
+  Config::InvalidateLookupCache ();
   device->SetNode (this);
   device->SetIfIndex (index);
   device->SetReceiveCallback (MakeCallback (&Node::NonPromiscReceiveFromDevice, this));
@@ -161,6 +163,7 @@ Node::AddApplication (Ptr<Application> application)
   NS_LOG_FUNCTION (this << application);
   uint32_t index = m_applications.size ();
   m_applications.push_back (application);
+  Config::InvalidateLookupCache ();
   application->SetNode (this);
   Simulator::ScheduleWithContext (GetId (), Seconds (0.0), 
                                   &Application::Initialize, application);
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test the sampling and the compact format of the default ascii
+ * trace sinks.
+ */
+class AsciiTraceSamplingTestCase : public TestCase
+{
+public:
+  AsciiTraceSamplingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Trace the enqueue of a packet on both streams.
+   * \param context the context of the event
+   * \param size the size of the packet
+   */
+  void Enqueue (std::string context, uint32_t size);
+
+  std::ostringstream m_full;            //!< Output of the stream without sampling
+  std::ostringstream m_sampled;         //!< Output of the sampled stream
+  Ptr<OutputStreamWrapper> m_fullStream;    //!< Stream without sampling
+  Ptr<OutputStreamWrapper> m_sampledStream; //!< Sampled stream
+  std::ostringstream m_expectedFull;    //!< Expected output of the stream without sampling
+};
+
+AsciiTraceSamplingTestCase::AsciiTraceSamplingTestCase ()
+  : TestCase ("Check the sampling and the compact format of the ascii traces")
+{
+}
+
+void
+AsciiTraceSamplingTestCase::Enqueue (std::string context, uint32_t size)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  m_expectedFull << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
+  AsciiTraceHelper::DefaultEnqueueSinkWithContext (m_fullStream, context, p);
+  AsciiTraceHelper::DefaultEnqueueSinkWithContext (m_sampledStream, context, p);
+}
+
+void
+AsciiTraceSamplingTestCase::DoRun (void)
+{
+  m_fullStream = Create<OutputStreamWrapper> (&m_full);
+  m_sampledStream = Create<OutputStreamWrapper> (&m_sampled);
+
+  //
+  // Events in [1s, 4s), at most 3 per context, then one out of 2.
+  //
+  AsciiTraceSampling sampling;
+  sampling.m_compact = true;
+  sampling.m_interval = 2;
+  sampling.m_firstPerFlow = 3;
+  sampling.m_start = Seconds (1);
+  sampling.m_stop = Seconds (4);
+  AsciiTraceHelper::SetSampling (m_sampledStream, sampling);
+
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (500 * i), &AsciiTraceSamplingTestCase::Enqueue, this,
+                           i % 3 ? "a" : "b", 100 + i);
+    }
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_full.str (), m_expectedFull.str (), "The stream without sampling must be unchanged");
+
+  //
+  // In the window: 1s a, 1.5s b, 2s a, 2.5s a, 3s b, 3.5s a.  The fourth
+  // event of "a", at 3.5s, is not a first event.  One out of two of the
+  // others are written: 1.5s b, 2.5s a.
+  //
+  std::string sampled = m_sampled.str ();
+  std::istringstream lines (sampled);
+  std::string line;
+  std::vector<std::string> written;
+  while (std::getline (lines, line))
+    {
+      written.push_back (line);
+    }
+  NS_TEST_ASSERT_MSG_EQ (written.size (), 2, "Incorrect number of sampled events: " << sampled);
+
+  std::istringstream first (written[0]);
+  std::string op, context;
+  double time;
+  uint64_t uid;
+  uint32_t size;
+  first >> op >> time >> context >> uid >> size;
+  NS_TEST_EXPECT_MSG_EQ (op, "+", "Incorrect operation");
+  NS_TEST_EXPECT_MSG_EQ (time, 1.5, "Incorrect time of the first sampled event");
+  NS_TEST_EXPECT_MSG_EQ (context, "b", "Incorrect context of the first sampled event");
+  NS_TEST_EXPECT_MSG_EQ (size, 103, "Incorrect size of the first sampled event");
+
+  std::istringstream second (written[1]);
+  second >> op >> time >> context >> uid >> size;
+  NS_TEST_EXPECT_MSG_EQ (time, 2.5, "Incorrect time of the second sampled event");
+  NS_TEST_EXPECT_MSG_EQ (context, "a", "Incorrect context of the second sampled event");
+  NS_TEST_EXPECT_MSG_EQ (size, 105, "Incorrect size of the second sampled event");
+
+  Simulator::Destroy ();
+  m_fullStream = 0;
+  m_sampledStream = 0;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Ascii trace sampling TestSuite
+ */
+class AsciiTraceSamplingTestSuite : public TestSuite
+{
+public:
+  AsciiTraceSamplingTestSuite ();
+};
+
+AsciiTraceSamplingTestSuite::AsciiTraceSamplingTestSuite ()
+  : TestSuite ("ascii-trace-sampling", UNIT)
+{
+  AddTestCase (new AsciiTraceSamplingTestCase, TestCase::QUICK);
+}
+
+static AsciiTraceSamplingTestSuite g_asciiTraceSamplingTestSuite; //!< Static variable for test initialization
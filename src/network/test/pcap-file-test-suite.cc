@@ -21,10 +21,13 @@
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <thread>  // sleep_for
 
 #include "ns3/log.h"
 #include "ns3/test.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
+#include "ns3/core-config.h"
 
 using namespace ns3;
 
@@ -1144,6 +1147,226 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the buffered and asynchronous writes
+ * give the same file as writing each record as soon as it is given.
+ */
+class BufferedWriteTestCase : public TestCase
+{
+public:
+  BufferedWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write a file with a mix of packets of various sizes.
+   * \param filename the file name
+   * \param bufferSize the size of the blocks written
+   * \param async write the blocks in the background
+   * \returns the contents of the file
+   */
+  std::string WriteFile (std::string filename, uint32_t bufferSize, bool async);
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase ()
+  : TestCase ("Check that buffered and asynchronous writes give the same pcap file")
+{
+}
+
+std::string
+BufferedWriteTestCase::WriteFile (std::string filename, uint32_t bufferSize, bool async)
+{
+  uint8_t data[1500];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i;
+    }
+
+  PcapFile f;
+  f.SetBufferSize (bufferSize);
+  f.SetAsyncWrite (async);
+  f.Open (filename, std::ios::out);
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  f.Init (1, 1000);
+
+  for (uint32_t i = 0; i < 2000; ++i)
+    {
+      uint32_t size = (i * 337) % sizeof (data);
+      if (i % 2)
+        {
+          f.Write (i / 1000, i % 1000, data, size);
+        }
+      else
+        {
+          f.Write (i / 1000, i % 1000, Create<Packet> (data, size));
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Writes must not fail");
+  f.Close ();
+
+  std::ifstream in (filename.c_str (), std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf ();
+  remove (filename.c_str ());
+  return contents.str ();
+}
+
+void
+BufferedWriteTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("buffered.pcap");
+
+  std::string unbuffered = WriteFile (filename, 0, false);
+  NS_TEST_ASSERT_MSG_GT (unbuffered.size (), 24, "No records written");
+
+  NS_TEST_EXPECT_MSG_EQ ((WriteFile (filename, 100, false) == unbuffered), true,
+                         "Blocks smaller than the records give a different file");
+  NS_TEST_EXPECT_MSG_EQ ((WriteFile (filename, 16384, false) == unbuffered), true,
+                         "Buffered writes give a different file");
+  NS_TEST_EXPECT_MSG_EQ ((WriteFile (filename, 4096, true) == unbuffered), true,
+                         "Asynchronous writes give a different file");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the background writer thread sleeps
+ * while it has no block to write.
+ */
+class IdleWriterTestCase : public TestCase
+{
+public:
+  IdleWriterTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+IdleWriterTestCase::IdleWriterTestCase ()
+  : TestCase ("Check that the pcap writer thread blocks while idle")
+{
+}
+
+void
+IdleWriterTestCase::DoRun (void)
+{
+#ifdef HAVE_PTHREAD_H
+  std::string filename = CreateTempDirFilename ("idle.pcap");
+  uint8_t data[1000] = { 0 };
+
+  PcapFile f;
+  f.SetBufferSize (4096);
+  f.SetAsyncWrite (true);
+  f.Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  f.Init (1, 1000);
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      f.Write (0, i, data, sizeof (data));
+    }
+  f.Flush ();
+
+  // all the blocks are written, so the thread must not wake up by itself
+  uint64_t wakeups = PcapFile::GetWriterWakeups ();
+  std::this_thread::sleep_for (std::chrono::milliseconds (100));
+  NS_TEST_EXPECT_MSG_LT (PcapFile::GetWriterWakeups (), wakeups + 2,
+                         "The idle writer thread keeps waking up");
+
+  // and it still writes the blocks queued afterwards
+  for (uint32_t i = 0; i < 100; ++i)
+    {
+      f.Write (1, i, data, sizeof (data));
+    }
+  f.Flush ();
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Writes must not fail");
+  f.Close ();
+  remove (filename.c_str ());
+#endif /* HAVE_PTHREAD_H */
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the pcapng blocks are written
+ * correctly.
+ */
+class PcapNgTestCase : public TestCase
+{
+public:
+  PcapNgTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapNgTestCase::PcapNgTestCase ()
+  : TestCase ("Check that the pcapng blocks are written correctly")
+{
+}
+
+void
+PcapNgTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("interfaces.pcapng");
+
+  uint8_t data[64];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i;
+    }
+
+  PcapFile f;
+  f.Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  f.InitPcapNg ();
+  uint32_t eth = f.AddInterface (1, 40, "eth");
+  uint32_t ppp = f.AddInterface (9, 65535, "", true);
+  NS_TEST_ASSERT_MSG_EQ (eth, 0, "First interface must have identifier 0");
+  NS_TEST_ASSERT_MSG_EQ (ppp, 1, "Second interface must have identifier 1");
+  f.WriteEnhancedPacket (ppp, 5000000001ULL, data, 10);
+  f.WriteEnhancedPacket (eth, 1234, Create<Packet> (data, sizeof (data)));
+  f.Close ();
+
+  std::ifstream in (filename.c_str (), std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf ();
+  std::string file = contents.str ();
+  remove (filename.c_str ());
+
+  //
+  // The section header is 28 bytes, the interface descriptions 20 bytes
+  // plus their options, and the packets 32 bytes plus their padded data.
+  //
+  uint32_t expected[] = {
+    0x0a0d0d0a, 28, 0x1a2b3c4d, 0x00000001, 0xffffffff, 0xffffffff, 28,
+    1, 32, 1, 40, 0x00030002, 0x00687465, 0, 32,
+    1, 32, 9, 65535, 0x00010009, 9, 0, 32,
+    6, 44, 1, 1, 705032705, 10, 10, 0x03020100, 0x07060504, 0x00000908, 44,
+    6, 72, 0, 0, 1234, 40, 64
+  };
+  uint32_t nExpected = sizeof (expected) / sizeof (expected[0]);
+  NS_TEST_ASSERT_MSG_EQ (file.size (), 4 * nExpected + 40 + 4, "pcapng file has an incorrect size");
+  for (uint32_t i = 0; i < nExpected; ++i)
+    {
+      uint32_t val32;
+      std::memcpy (&val32, file.data () + 4 * i, 4);
+      NS_TEST_EXPECT_MSG_EQ (val32, expected[i], "Incorrect word " << i << " of the pcapng file");
+    }
+  for (uint32_t i = 0; i < 40; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((uint8_t)file[4 * nExpected + i], data[i], "Incorrect packet data written");
+    }
+  uint32_t trailer;
+  std::memcpy (&trailer, file.data () + 4 * nExpected + 40, 4);
+  NS_TEST_EXPECT_MSG_EQ (trailer, 72, "Incorrect length at the end of the last block");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1390,9 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new BufferedWriteTestCase, TestCase::QUICK);
+  AddTestCase (new IdleWriterTestCase, TestCase::QUICK);
+  AddTestCase (new PcapNgTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -22,6 +22,7 @@
 #include "ns3/buffer.h"
 #include "ns3/header.h"
 #include "pcap-file-wrapper.h"
+#include "pcapng-file-wrapper.h"
 
 namespace ns3 {
 
@@ -46,12 +47,24 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("BufferSize",
+                   "Size of the blocks of records written to the file, in bytes. "
+                   "Zero writes each record as soon as it is traced, and is the default in debug builds.",
+                   UintegerValue (PcapFile::BUFFER_SIZE_DEFAULT),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("AsyncWrite",
+                   "Whether the blocks of records are written to the file by a background thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_asyncWrite),
+                   MakeBooleanChecker())
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_interfaceId (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,6 +79,10 @@ bool
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_sharedFile)
+    {
+      return m_sharedFile->Fail ();
+    }
   return m_file.Fail ();
 }
 
@@ -93,9 +110,19 @@ void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
+  m_file.SetBufferSize (m_bufferSize);
+  m_file.SetAsyncWrite (m_asyncWrite);
   m_file.Open (filename, mode);
 }
 
+void
+PcapFileWrapper::SetSharedFile (Ptr<PcapNgFileWrapper> file, std::string const &interfaceName)
+{
+  NS_LOG_FUNCTION (this << file << interfaceName);
+  m_sharedFile = file;
+  m_interfaceName = interfaceName;
+}
+
 void
 PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrection)
 {
@@ -105,6 +132,15 @@ PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrec
   // a snaplen, we use the one provided.
   //
   NS_LOG_FUNCTION (this << dataLinkType << snapLen << tzCorrection);
+  if (m_sharedFile)
+    {
+      if (snapLen == std::numeric_limits<uint32_t>::max ())
+        {
+          snapLen = m_snapLen;
+        }
+      m_interfaceId = m_sharedFile->AddInterface (dataLinkType, snapLen, m_interfaceName);
+      return;
+    }
   if (snapLen != std::numeric_limits<uint32_t>::max ())
     {
       m_file.Init (dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
@@ -119,6 +155,11 @@ void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
+  if (m_sharedFile)
+    {
+      m_sharedFile->Write (m_interfaceId, t, p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -139,6 +180,11 @@ void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
+  if (m_sharedFile)
+    {
+      m_sharedFile->Write (m_interfaceId, t, header, p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -159,6 +205,11 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
+  if (m_sharedFile)
+    {
+      m_sharedFile->Write (m_interfaceId, t, buffer, length);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -30,6 +30,8 @@
 
 namespace ns3 {
 
+class PcapNgFileWrapper;
+
 /**
  * A class that wraps a PcapFile as an ns3::Object and provides a higher-layer
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
@@ -77,6 +79,19 @@ public:
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * \brief Write the packets to an interface of a shared pcapng file,
+   * instead of opening a file.
+   *
+   * The interface is added to the shared file by Init (), with the data
+   * link type and snap length given to it.  Only the Write methods may then
+   * be used.
+   *
+   * \param file the shared file
+   * \param interfaceName the name of the interface in the shared file
+   */
+  void SetSharedFile (Ptr<PcapNgFileWrapper> file, std::string const &interfaceName);
+
   /**
    * Close the underlying pcap file.
    */
@@ -224,6 +239,11 @@ private:
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+  uint32_t m_bufferSize; //!< size of the blocks written to the file
+  bool     m_asyncWrite; //!< blocks written by a background thread
+  Ptr<PcapNgFileWrapper> m_sharedFile; //!< shared file written to instead of m_file, if any
+  std::string m_interfaceName; //!< name of the interface in the shared file
+  uint32_t m_interfaceId; //!< identifier of the interface in the shared file
 };
 
 } // namespace ns3
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <deque>
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/fatal-error.h"
@@ -29,6 +30,11 @@
 #include "pcap-file.h"
 #include "ns3/log.h"
 #include "ns3/build-profile.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#include "ns3/system-thread.h"
+#endif /* HAVE_PTHREAD_H */
 //
 // This file is used as part of the ns-3 test framework, so please refrain from 
 // adding any ns-3 specific constructs such as Packet to this file.
@@ -47,10 +53,260 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2;             /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pcap file format */
 
+const uint32_t NG_SECTION_HEADER = 0x0a0d0d0a;    /**< pcapng section header block type */
+const uint32_t NG_INTERFACE_DESCRIPTION = 1;      /**< pcapng interface description block type */
+const uint32_t NG_ENHANCED_PACKET = 6;            /**< pcapng enhanced packet block type */
+const uint32_t NG_BYTE_ORDER_MAGIC = 0x1a2b3c4d;  /**< pcapng byte order magic */
+const uint16_t NG_VERSION_MAJOR = 1;              /**< Major version of the pcapng format */
+const uint16_t NG_VERSION_MINOR = 0;              /**< Minor version of the pcapng format */
+const uint16_t NG_OPT_ENDOFOPT = 0;               /**< pcapng end of options */
+const uint16_t NG_OPT_IF_NAME = 2;                /**< pcapng interface name option */
+const uint16_t NG_OPT_IF_TSRESOL = 9;             /**< pcapng timestamp resolution option */
+
+/**
+ * \param len a length
+ * \returns the length padded to 32 bits, as the pcapng blocks and options are
+ */
+static uint32_t
+NgPad (uint32_t len)
+{
+  return (len + 3) & ~3U;
+}
+
+#ifdef HAVE_PTHREAD_H
+
+/** Maximum number of blocks waiting for the writer thread */
+const uint32_t WRITER_MAX_BLOCKS = 64;
+
+/**
+ * \brief Thread writing the blocks of the pcap files in the background.
+ *
+ * A single thread serves all the files with asynchronous writes, so that
+ * capturing on many devices does not start as many threads.  The number of
+ * blocks waiting to be written is bounded: when the thread cannot keep up,
+ * the simulation waits, instead of using more memory.
+ *
+ * The queue and the counts of blocks are protected by a single mutex, and
+ * the threads wait on condition variables tied to it, checking their
+ * predicate under the mutex, so that an idle writer thread sleeps until a
+ * block is queued.
+ */
+class PcapFileWriter
+{
+public:
+  /**
+   * \brief Get the writer thread, started on the first use.
+   * \returns the writer
+   */
+  static PcapFileWriter *Acquire (void);
+
+  /**
+   * \brief Stop using the writer thread, which is stopped after the last use.
+   */
+  static void Release (void);
+
+  /**
+   * \brief Queue a block to write.
+   * \param file the file to write to
+   * \param pending the count of blocks of the file, incremented until the block is written
+   * \param block the block to write, exchanged for an empty one
+   */
+  void Push (std::fstream *file, uint32_t *pending, std::vector<uint8_t> &block);
+
+  /**
+   * \brief Wait until all the blocks of a file are written.
+   * \param pending the count of blocks of the file
+   */
+  void Wait (uint32_t const *pending);
+
+  /**
+   * \brief Get the number of times the writer thread woke up.
+   * \returns the number of returns from the wait for a block
+   */
+  uint64_t GetWakeups (void);
+
+private:
+  PcapFileWriter ();
+  ~PcapFileWriter ();
+
+  /**
+   * \brief Write the queued blocks until stopped.
+   */
+  void Run (void);
+
+  /// A block to write
+  struct Block
+  {
+    Block () : file (0), pending (0) {}
+    std::fstream *file;         //!< file to write to
+    uint32_t *pending;          //!< count of blocks of the file
+    std::vector<uint8_t> data;  //!< bytes to write
+  };
+
+  Ptr<SystemThread> m_thread;              //!< The writer thread
+  pthread_mutex_t m_mutex;                 //!< Protects the members below
+  pthread_cond_t m_blockQueued;            //!< Signaled when a block is queued or on stop
+  pthread_cond_t m_blockWritten;           //!< Broadcast when a block is written
+  std::deque<Block> m_blocks;              //!< Blocks to write
+  std::vector<std::vector<uint8_t> > m_free; //!< Written blocks, to reuse their memory
+  bool m_stop;                             //!< Stop when the queue is empty
+  uint64_t m_wakeups;                      //!< Returns from the wait for a block
+};
+
+/** The writer thread, if in use */
+static PcapFileWriter *g_pcapFileWriter = 0;
+/** Number of files using the writer thread */
+static uint32_t g_pcapFileWriterUsers = 0;
+
+PcapFileWriter::PcapFileWriter ()
+  : m_stop (false),
+    m_wakeups (0)
+{
+  pthread_mutex_init (&m_mutex, NULL);
+  pthread_cond_init (&m_blockQueued, NULL);
+  pthread_cond_init (&m_blockWritten, NULL);
+  m_thread = Create<SystemThread> (MakeCallback (&PcapFileWriter::Run, this));
+  m_thread->Start ();
+}
+
+PcapFileWriter::~PcapFileWriter ()
+{
+  pthread_cond_destroy (&m_blockWritten);
+  pthread_cond_destroy (&m_blockQueued);
+  pthread_mutex_destroy (&m_mutex);
+}
+
+PcapFileWriter *
+PcapFileWriter::Acquire (void)
+{
+  if (g_pcapFileWriter == 0)
+    {
+      g_pcapFileWriter = new PcapFileWriter ();
+    }
+  ++g_pcapFileWriterUsers;
+  return g_pcapFileWriter;
+}
+
+void
+PcapFileWriter::Release (void)
+{
+  NS_ASSERT (g_pcapFileWriterUsers > 0);
+  if (--g_pcapFileWriterUsers > 0)
+    {
+      return;
+    }
+  PcapFileWriter *writer = g_pcapFileWriter;
+  g_pcapFileWriter = 0;
+  pthread_mutex_lock (&writer->m_mutex);
+  writer->m_stop = true;
+  pthread_cond_signal (&writer->m_blockQueued);
+  pthread_mutex_unlock (&writer->m_mutex);
+  writer->m_thread->Join ();
+  delete writer;
+}
+
+void
+PcapFileWriter::Push (std::fstream *file, uint32_t *pending, std::vector<uint8_t> &block)
+{
+  pthread_mutex_lock (&m_mutex);
+  while (m_blocks.size () >= WRITER_MAX_BLOCKS)
+    {
+      pthread_cond_wait (&m_blockWritten, &m_mutex);
+    }
+  m_blocks.push_back (Block ());
+  m_blocks.back ().file = file;
+  m_blocks.back ().pending = pending;
+  m_blocks.back ().data.swap (block);
+  ++*pending;
+  if (!m_free.empty ())
+    {
+      block.swap (m_free.back ());
+      m_free.pop_back ();
+    }
+  pthread_cond_signal (&m_blockQueued);
+  pthread_mutex_unlock (&m_mutex);
+}
+
+void
+PcapFileWriter::Wait (uint32_t const *pending)
+{
+  pthread_mutex_lock (&m_mutex);
+  while (*pending > 0)
+    {
+      pthread_cond_wait (&m_blockWritten, &m_mutex);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+uint64_t
+PcapFileWriter::GetWakeups (void)
+{
+  pthread_mutex_lock (&m_mutex);
+  uint64_t wakeups = m_wakeups;
+  pthread_mutex_unlock (&m_mutex);
+  return wakeups;
+}
+
+void
+PcapFileWriter::Run (void)
+{
+  pthread_mutex_lock (&m_mutex);
+  while (true)
+    {
+      while (m_blocks.empty () && !m_stop)
+        {
+          pthread_cond_wait (&m_blockQueued, &m_mutex);
+          ++m_wakeups;
+        }
+      if (m_blocks.empty ())
+        {
+          break;
+        }
+      Block block;
+      block.file = m_blocks.front ().file;
+      block.pending = m_blocks.front ().pending;
+      block.data.swap (m_blocks.front ().data);
+      m_blocks.pop_front ();
+      pthread_mutex_unlock (&m_mutex);
+
+      block.file->write ((const char *)&block.data[0], block.data.size ());
+      block.data.clear ();
+
+      pthread_mutex_lock (&m_mutex);
+      --*block.pending;
+      if (m_free.size () < WRITER_MAX_BLOCKS)
+        {
+          m_free.push_back (std::vector<uint8_t> ());
+          m_free.back ().swap (block.data);
+        }
+      //
+      // Both the files waiting for their blocks and the simulation waiting
+      // for room in the queue wait for this condition.
+      //
+      pthread_cond_broadcast (&m_blockWritten);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+#endif /* HAVE_PTHREAD_H */
+
+#ifdef NS3_BUILD_PROFILE_DEBUG
+// Debug builds keep the file complete when an assert or a fatal error aborts the program
+const uint32_t PcapFile::BUFFER_SIZE_DEFAULT = 0;
+#else
+const uint32_t PcapFile::BUFFER_SIZE_DEFAULT = 16384;
+#endif
+
 PcapFile::PcapFile ()
   : m_file (),
     m_swapMode (false),
-    m_nanosecMode (false)
+    m_nanosecMode (false),
+    m_pcapNg (false),
+    m_readOnly (false),
+    m_bufferSize (BUFFER_SIZE_DEFAULT),
+    m_asyncWrite (false),
+    m_writerAcquired (false),
+    m_pendingBlocks (0)
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::RegisterStream (&m_file); 
@@ -68,6 +324,16 @@ bool
 PcapFile::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  //
+  // The state of the stream is only read once the writer thread is done
+  // with the blocks given to it.
+  //
+  if (m_writerAcquired)
+    {
+      g_pcapFileWriter->Wait (&m_pendingBlocks);
+    }
+#endif /* HAVE_PTHREAD_H */
   return m_file.fail ();
 }
 bool 
@@ -88,9 +354,136 @@ void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  Sync ();
+#ifdef HAVE_PTHREAD_H
+  if (m_writerAcquired)
+    {
+      PcapFileWriter::Release ();
+      m_writerAcquired = false;
+    }
+#endif /* HAVE_PTHREAD_H */
   m_file.close ();
 }
 
+void
+PcapFile::SetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  Sync ();
+  m_bufferSize = size;
+}
+
+void
+PcapFile::SetAsyncWrite (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  Sync ();
+  m_asyncWrite = async;
+}
+
+void
+PcapFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  Sync ();
+  m_file.flush ();
+}
+
+uint64_t
+PcapFile::GetWriterWakeups (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+#ifdef HAVE_PTHREAD_H
+  if (g_pcapFileWriter != 0)
+    {
+      return g_pcapFileWriter->GetWakeups ();
+    }
+#endif /* HAVE_PTHREAD_H */
+  return 0;
+}
+
+uint8_t *
+PcapFile::Reserve (uint32_t size)
+{
+  std::size_t used = m_buffer.size ();
+  if (used > 0 && used + size > m_bufferSize)
+    {
+      WriteBuffer ();
+      used = 0;
+    }
+  if (m_buffer.capacity () < m_bufferSize)
+    {
+      m_buffer.reserve (m_bufferSize);
+    }
+  m_buffer.resize (used + size);
+  return m_buffer.data () + used;
+}
+
+template <typename T>
+void
+PcapFile::Append (T value)
+{
+  //
+  // Watch out for memory alignment differences between machines, so copy
+  // the values one by one, as bytes.
+  //
+  std::memcpy (Reserve (sizeof (value)), &value, sizeof (value));
+}
+
+void
+PcapFile::Commit (void)
+{
+  //
+  // The writes to a read-only file are not buffered, so that the stream
+  // reports the failure right away.
+  //
+  if (m_bufferSize == 0 || m_readOnly)
+    {
+      WriteBuffer ();
+      NS_BUILD_DEBUG (m_file.flush ());
+    }
+  else if (m_buffer.size () >= m_bufferSize)
+    {
+      WriteBuffer ();
+    }
+}
+
+void
+PcapFile::WriteBuffer (void)
+{
+  if (m_buffer.empty ())
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_asyncWrite && m_bufferSize > 0)
+    {
+      if (!m_writerAcquired)
+        {
+          PcapFileWriter::Acquire ();
+          m_writerAcquired = true;
+        }
+      g_pcapFileWriter->Push (&m_file, &m_pendingBlocks, m_buffer);
+      m_buffer.clear ();
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  m_file.write ((const char *)&m_buffer[0], m_buffer.size ());
+  m_buffer.clear ();
+}
+
+void
+PcapFile::Sync (void)
+{
+  WriteBuffer ();
+#ifdef HAVE_PTHREAD_H
+  if (m_writerAcquired)
+    {
+      g_pcapFileWriter->Wait (&m_pendingBlocks);
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
 uint32_t
 PcapFile::GetMagic (void)
 {
@@ -333,6 +726,10 @@ PcapFile::Open (std::string const &filename, std::ios::openmode mode)
   mode |= std::ios::binary;
 
   m_filename=filename;
+  m_pcapNg = false;
+  m_interfaceSnapLen.clear ();
+  m_buffer.clear ();
+  m_readOnly = (mode & std::ios::out) == 0;
   m_file.open (filename.c_str (), mode);
   if (mode & std::ios::in)
     {
@@ -396,14 +793,90 @@ PcapFile::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t timeZoneCorrect
   //
   m_swapMode = swapMode | bigEndian;
 
+  Sync ();
+  m_pcapNg = false;
   WriteFileHeader ();
 }
 
+void
+PcapFile::InitPcapNg (void)
+{
+  NS_LOG_FUNCTION (this);
+  Sync ();
+  m_pcapNg = true;
+  m_swapMode = false;
+  m_interfaceSnapLen.clear ();
+  m_file.seekp (0, std::ios::beg);
+
+  //
+  // Section header block, of unspecified length and without options.
+  //
+  uint32_t blockLen = 28;
+  Append (NG_SECTION_HEADER);
+  Append (blockLen);
+  Append (NG_BYTE_ORDER_MAGIC);
+  Append (NG_VERSION_MAJOR);
+  Append (NG_VERSION_MINOR);
+  Append (int64_t (-1));
+  Append (blockLen);
+  Commit ();
+}
+
+uint32_t
+PcapFile::AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name, bool nanosecMode)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << snapLen << name << nanosecMode);
+  NS_ASSERT_MSG (m_pcapNg, "PcapFile::AddInterface(): not a pcapng file");
+
+  uint32_t optionsLen = 4;
+  if (!name.empty ())
+    {
+      optionsLen += 4 + NgPad (name.size ());
+    }
+  if (nanosecMode)
+    {
+      optionsLen += 8;
+    }
+  uint32_t blockLen = 20 + optionsLen;
+
+  Append (NG_INTERFACE_DESCRIPTION);
+  Append (blockLen);
+  Append (uint16_t (dataLinkType));
+  Append (uint16_t (0));
+  Append (snapLen);
+  if (!name.empty ())
+    {
+      Append (NG_OPT_IF_NAME);
+      Append (uint16_t (name.size ()));
+      uint8_t *value = Reserve (NgPad (name.size ()));
+      std::memset (value, 0, NgPad (name.size ()));
+      std::memcpy (value, name.data (), name.size ());
+    }
+  if (nanosecMode)
+    {
+      //
+      // The resolution is 10^-9 s, the default of the format being 10^-6 s.
+      //
+      Append (NG_OPT_IF_TSRESOL);
+      Append (uint16_t (1));
+      Append (uint8_t (9));
+      std::memset (Reserve (3), 0, 3);
+    }
+  Append (NG_OPT_ENDOFOPT);
+  Append (uint16_t (0));
+  Append (blockLen);
+  Commit ();
+
+  m_interfaceSnapLen.push_back (snapLen);
+  return m_interfaceSnapLen.size () - 1;
+}
+
 uint32_t
 PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen);
-  NS_ASSERT (m_file.good ());
+  NS_ASSERT (m_writerAcquired || m_file.good ());
+  NS_ASSERT_MSG (!m_pcapNg, "PcapFile::Write(): use WriteEnhancedPacket() in a pcapng file");
 
   uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -418,25 +891,75 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
       Swap (&header, &header);
     }
 
-  //
-  // Watch out for memory alignment differences between machines, so write
-  // them all individually.
-  //
-  m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
-  m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
-  m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
-  m_file.write ((const char *)&header.m_origLen, sizeof(header.m_origLen));
-  NS_BUILD_DEBUG(m_file.flush());
+  Append (header.m_tsSec);
+  Append (header.m_tsUsec);
+  Append (header.m_inclLen);
+  Append (header.m_origLen);
   return inclLen;
 }
 
+uint32_t
+PcapFile::WriteEnhancedPacketHeader (uint32_t interfaceId, uint64_t timestamp, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << interfaceId << timestamp << totalLen);
+  NS_ASSERT (m_writerAcquired || m_file.good ());
+  NS_ASSERT_MSG (m_pcapNg, "PcapFile::WriteEnhancedPacket(): not a pcapng file");
+  NS_ASSERT_MSG (interfaceId < m_interfaceSnapLen.size (), "PcapFile::WriteEnhancedPacket(): unknown interface " << interfaceId);
+
+  uint32_t snapLen = m_interfaceSnapLen[interfaceId];
+  uint32_t inclLen = totalLen > snapLen ? snapLen : totalLen;
+
+  Append (NG_ENHANCED_PACKET);
+  Append (uint32_t (32 + NgPad (inclLen)));
+  Append (interfaceId);
+  Append (uint32_t (timestamp >> 32));
+  Append (uint32_t (timestamp & 0xffffffff));
+  Append (inclLen);
+  Append (totalLen);
+  return inclLen;
+}
+
+void
+PcapFile::WriteEnhancedPacketTrailer (uint32_t inclLen)
+{
+  uint32_t padding = NgPad (inclLen) - inclLen;
+  if (padding > 0)
+    {
+      std::memset (Reserve (padding), 0, padding);
+    }
+  Append (uint32_t (32 + NgPad (inclLen)));
+}
+
+void
+PcapFile::WritePacketData (uint8_t const *data, const Header *header, Ptr<const Packet> p, uint32_t inclLen)
+{
+  uint8_t *out = Reserve (inclLen);
+  if (data)
+    {
+      std::memcpy (out, data, inclLen);
+      return;
+    }
+  if (header)
+    {
+      uint32_t headerSize = header->GetSerializedSize ();
+      Buffer headerBuffer;
+      headerBuffer.AddAtStart (headerSize);
+      header->Serialize (headerBuffer.Begin ());
+      uint32_t toCopy = std::min (headerSize, inclLen);
+      headerBuffer.CopyData (out, toCopy);
+      out += toCopy;
+      inclLen -= toCopy;
+    }
+  p->CopyData (out, inclLen);
+}
+
 void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
-  m_file.write ((const char *)data, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
+  WritePacketData (data, 0, 0, inclLen);
+  Commit ();
 }
 
 void 
@@ -444,25 +967,49 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
-  p->CopyData (&m_file, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
+  WritePacketData (0, 0, p, inclLen);
+  Commit ();
 }
 
 void 
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &header << p);
-  uint32_t headerSize = header.GetSerializedSize ();
-  uint32_t totalSize = headerSize + p->GetSize ();
+  uint32_t totalSize = header.GetSerializedSize () + p->GetSize ();
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalSize);
+  WritePacketData (0, &header, p, inclLen);
+  Commit ();
+}
+
+void
+PcapFile::WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << interfaceId << timestamp << &data << totalLen);
+  uint32_t inclLen = WriteEnhancedPacketHeader (interfaceId, timestamp, totalLen);
+  WritePacketData (data, 0, 0, inclLen);
+  WriteEnhancedPacketTrailer (inclLen);
+  Commit ();
+}
 
-  Buffer headerBuffer;
-  headerBuffer.AddAtStart (headerSize);
-  header.Serialize (headerBuffer.Begin ());
-  uint32_t toCopy = std::min (headerSize, inclLen);
-  headerBuffer.CopyData (&m_file, toCopy);
-  inclLen -= toCopy;
-  p->CopyData (&m_file, inclLen);
+void
+PcapFile::WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interfaceId << timestamp << p);
+  uint32_t inclLen = WriteEnhancedPacketHeader (interfaceId, timestamp, p->GetSize ());
+  WritePacketData (0, 0, p, inclLen);
+  WriteEnhancedPacketTrailer (inclLen);
+  Commit ();
+}
+
+void
+PcapFile::WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, const Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interfaceId << timestamp << &header << p);
+  uint32_t totalSize = header.GetSerializedSize () + p->GetSize ();
+  uint32_t inclLen = WriteEnhancedPacketHeader (interfaceId, timestamp, totalSize);
+  WritePacketData (0, &header, p, inclLen);
+  WriteEnhancedPacketTrailer (inclLen);
+  Commit ();
 }
 
 void
@@ -477,6 +1024,8 @@ PcapFile::Read (
 {
   NS_LOG_FUNCTION (this << &data <<maxBytes << tsSec << tsUsec << inclLen << origLen << readLen);
   NS_ASSERT (m_file.good ());
+  NS_ASSERT_MSG (!m_pcapNg, "PcapFile::Read(): reading a pcapng file is not supported");
+  Sync ();
 
   PcapRecordHeader header;
 
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ptr.h"
 
@@ -38,12 +39,23 @@ class Header;
  * A class representing a pcap file.  This allows easy creation, writing and 
  * reading of files composed of stored packets; which may be viewed using
  * standard tools.
+ *
+ * The records written are gathered in a memory block, which is written to
+ * the file when it is full, on Flush () and on Close (), so that a record
+ * does not cost several stream operations.  The blocks can also be written
+ * by a background thread, shared by all the files (see SetAsyncWrite ()).
+ * The bytes in the file are the same in all cases.
+ *
+ * Besides the classic pcap format, the file can be written in the pcapng
+ * format (see InitPcapNg ()), which lets several interfaces, each with its
+ * own data link type, share a single file.
  */
 class PcapFile
 {
 public:
   static const int32_t  ZONE_DEFAULT    = 0;           /**< Time zone offset for current location */
   static const uint32_t SNAPLEN_DEFAULT = 65535;       /**< Default value for maximum octets to save per packet */
+  static const uint32_t BUFFER_SIZE_DEFAULT;           /**< Default size of the blocks written to the file, zero in debug builds */
 
 public:
   PcapFile ();
@@ -81,10 +93,46 @@ public:
   void Open (std::string const &filename, std::ios::openmode mode);
 
   /**
-   * Close the underlying file.
+   * Close the underlying file, after writing the pending records.
    */
   void Close (void);
 
+  /**
+   * \brief Set the size of the blocks written to the file.
+   *
+   * The records are gathered in memory until they fill a block.  A size of
+   * zero writes each record as soon as it is given, and in debug builds
+   * flushes the stream after each one, so that the file is complete if the
+   * program crashes.  This is the default in debug builds.
+   *
+   * \param size the size of the blocks, in bytes
+   */
+  void SetBufferSize (uint32_t size);
+
+  /**
+   * \brief Write the blocks from a background thread.
+   *
+   * The simulation then only copies the records to memory.  This has no
+   * effect on systems without threads, or if the buffer size is zero.
+   *
+   * \param async true to write the blocks in the background
+   */
+  void SetAsyncWrite (bool async);
+
+  /**
+   * \brief Write the pending records to the file and flush the stream.
+   */
+  void Flush (void);
+
+  /**
+   * \brief Get the number of times the background writer thread woke up to
+   * write blocks, mainly for testing.
+   *
+   * \returns the number of wakeups since the thread started, or zero if no
+   * file uses the writer thread
+   */
+  static uint64_t GetWriterWakeups (void);
+
   /**
    * Initialize the pcap file associated with this object.  This file must have
    * been previously opened with write permissions.
@@ -153,6 +201,62 @@ public:
    */
   void Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<const Packet> p);
 
+  /**
+   * \brief Initialize the file in the pcapng format.
+   *
+   * Writes the section header block.  The interfaces must then be added
+   * with AddInterface () before their packets are written with
+   * WriteEnhancedPacket ().  The blocks are written in the byte order of
+   * the host, as allowed by the format.  Reading a pcapng file with Read ()
+   * is not supported.
+   *
+   * This file must have been previously opened with write permissions.
+   */
+  void InitPcapNg (void);
+
+  /**
+   * \brief Add an interface to a pcapng file.
+   *
+   * Writes an interface description block.
+   *
+   * \param dataLinkType data link type of the packets of the interface
+   * \param snapLen maximum size of the packets written for the interface
+   * \param name name of the interface, not written if empty
+   * \param nanosecMode true for timestamps in nanoseconds, false for
+   *        microseconds
+   * \returns the identifier of the interface, to give to WriteEnhancedPacket ()
+   */
+  uint32_t AddInterface (uint32_t dataLinkType, uint32_t snapLen = SNAPLEN_DEFAULT,
+                         std::string const &name = "", bool nanosecMode = false);
+
+  /**
+   * \brief Write a packet to a pcapng file
+   *
+   * \param interfaceId Interface the packet was seen on
+   * \param timestamp   Packet timestamp, in the resolution of the interface
+   * \param data        Data buffer
+   * \param totalLen    Total packet length
+   */
+  void WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen);
+
+  /**
+   * \brief Write a packet to a pcapng file
+   *
+   * \param interfaceId Interface the packet was seen on
+   * \param timestamp   Packet timestamp, in the resolution of the interface
+   * \param p           Packet to write
+   */
+  void WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, Ptr<const Packet> p);
+
+  /**
+   * \brief Write a packet to a pcapng file
+   *
+   * \param interfaceId Interface the packet was seen on
+   * \param timestamp   Packet timestamp, in the resolution of the interface
+   * \param header      Header to write, in front of packet
+   * \param p           Packet to write
+   */
+  void WriteEnhancedPacket (uint32_t interfaceId, uint64_t timestamp, const Header &header, Ptr<const Packet> p);
 
   /**
    * \brief Read next packet from file
@@ -361,6 +465,68 @@ private:
    */
   uint32_t WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
 
+  /**
+   * \brief Write a pcapng enhanced packet block header
+   *
+   * \param interfaceId Interface the packet was seen on
+   * \param timestamp Packet timestamp
+   * \param totalLen total packet length
+   * \returns the length of the packet to write in the block
+   */
+  uint32_t WriteEnhancedPacketHeader (uint32_t interfaceId, uint64_t timestamp, uint32_t totalLen);
+
+  /**
+   * \brief Write the end of a pcapng enhanced packet block
+   *
+   * \param inclLen length of the packet written in the block
+   */
+  void WriteEnhancedPacketTrailer (uint32_t inclLen);
+
+  /**
+   * \brief Write packet data to the write buffer
+   *
+   * The data is either the buffer, or the header followed by the packet.
+   *
+   * \param data Data buffer, or null
+   * \param header Header to write in front of the packet, or null
+   * \param p Packet to write, if data is null
+   * \param inclLen number of bytes to write
+   */
+  void WritePacketData (uint8_t const *data, const Header *header, Ptr<const Packet> p, uint32_t inclLen);
+
+  /**
+   * \brief Get space at the end of the write buffer
+   *
+   * Writes the buffer first if the space does not fit in it.
+   *
+   * \param size the number of bytes
+   * \returns the start of the space
+   */
+  uint8_t *Reserve (uint32_t size);
+
+  /**
+   * \brief Append a value to the write buffer
+   * \param value the value
+   */
+  template <typename T>
+  void Append (T value);
+
+  /**
+   * \brief End a record, and write the buffer if it is full
+   */
+  void Commit (void);
+
+  /**
+   * \brief Write the buffer to the file, or give it to the writer thread
+   */
+  void WriteBuffer (void);
+
+  /**
+   * \brief Write the buffer and wait until the writer thread wrote all the
+   * blocks of the file
+   */
+  void Sync (void);
+
   /**
    * \brief Read and verify a Pcap file header
    */
@@ -371,6 +537,14 @@ private:
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
   bool m_nanosecMode;           //!< nanosecond timestamp mode
+  bool m_pcapNg;                //!< file written in the pcapng format
+  bool m_readOnly;              //!< file opened without write permission
+  std::vector<uint32_t> m_interfaceSnapLen; //!< snap length of each pcapng interface
+  std::vector<uint8_t> m_buffer; //!< records not written to the file yet
+  uint32_t m_bufferSize;        //!< size of the blocks written to the file
+  bool m_asyncWrite;            //!< blocks written by the writer thread
+  bool m_writerAcquired;        //!< the writer thread is in use by this file
+  uint32_t m_pendingBlocks;     //!< blocks given to the writer thread and not written yet
 };
 
 } // namespace ns3
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/header.h"
+#include "pcapng-file-wrapper.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapNgFileWrapper");
+
+NS_OBJECT_ENSURE_REGISTERED (PcapNgFileWrapper);
+
+TypeId
+PcapNgFileWrapper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PcapNgFileWrapper")
+    .SetParent<Object> ()
+    .SetGroupName("Network")
+    .AddConstructor<PcapNgFileWrapper> ()
+    .AddAttribute ("NanosecMode",
+                   "Whether packet timestamps in the pcapng file are nanoseconds or microseconds(default).",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapNgFileWrapper::m_nanosecMode),
+                   MakeBooleanChecker())
+    .AddAttribute ("BufferSize",
+                   "Size of the blocks of records written to the file, in bytes. "
+                   "Zero writes each record as soon as it is traced.",
+                   UintegerValue (PcapFile::BUFFER_SIZE_DEFAULT),
+                   MakeUintegerAccessor (&PcapNgFileWrapper::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("AsyncWrite",
+                   "Whether the blocks of records are written to the file by a background thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapNgFileWrapper::m_asyncWrite),
+                   MakeBooleanChecker())
+  ;
+  return tid;
+}
+
+PcapNgFileWrapper::PcapNgFileWrapper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapNgFileWrapper::~PcapNgFileWrapper ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+PcapNgFileWrapper::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.Fail ();
+}
+
+void
+PcapNgFileWrapper::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_file.SetBufferSize (m_bufferSize);
+  m_file.SetAsyncWrite (m_asyncWrite);
+  m_file.Open (filename, std::ios::out);
+  if (!m_file.Fail ())
+    {
+      m_file.InitPcapNg ();
+    }
+}
+
+void
+PcapNgFileWrapper::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Close ();
+}
+
+uint32_t
+PcapNgFileWrapper::AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << snapLen << name);
+  return m_file.AddInterface (dataLinkType, snapLen, name, m_nanosecMode);
+}
+
+uint64_t
+PcapNgFileWrapper::GetTimestamp (Time t) const
+{
+  if (m_nanosecMode)
+    {
+      return t.GetNanoSeconds ();
+    }
+  return t.GetMicroSeconds ();
+}
+
+void
+PcapNgFileWrapper::Write (uint32_t interfaceId, Time t, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interfaceId << t << p);
+  m_file.WriteEnhancedPacket (interfaceId, GetTimestamp (t), p);
+}
+
+void
+PcapNgFileWrapper::Write (uint32_t interfaceId, Time t, const Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interfaceId << t << &header << p);
+  m_file.WriteEnhancedPacket (interfaceId, GetTimestamp (t), header, p);
+}
+
+void
+PcapNgFileWrapper::Write (uint32_t interfaceId, Time t, uint8_t const *buffer, uint32_t length)
+{
+  NS_LOG_FUNCTION (this << interfaceId << t << &buffer << length);
+  m_file.WriteEnhancedPacket (interfaceId, GetTimestamp (t), buffer, length);
+}
+
+} // namespace ns3
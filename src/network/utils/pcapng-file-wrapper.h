@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_WRAPPER_H
+#define PCAPNG_FILE_WRAPPER_H
+
+#include <string>
+
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "pcap-file.h"
+
+namespace ns3 {
+
+/**
+ * A class that wraps a PcapFile written in the pcapng format, so that the
+ * packets of several interfaces, possibly of different data link types,
+ * are captured in a single file.  Each interface is added with
+ * AddInterface (), and its packets are written with the identifier it
+ * returns.
+ *
+ * A single file avoids the cost of opening and writing one file per
+ * device in large simulations.  See also the "PcapSharedFile" global
+ * value of PcapHelper.
+ */
+class PcapNgFileWrapper : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  PcapNgFileWrapper ();
+  ~PcapNgFileWrapper ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Fail (void) const;
+
+  /**
+   * Create a new pcapng file, and write its section header.
+   *
+   * \param filename String containing the name of the file.
+   */
+  void Open (std::string const &filename);
+
+  /**
+   * Close the underlying pcapng file.
+   */
+  void Close (void);
+
+  /**
+   * \brief Add an interface to the file.
+   *
+   * \param dataLinkType A data link type as defined in the pcap library,
+   * see PcapFileWrapper::Init ().
+   * \param snapLen Maximum size of the packets written for the interface.
+   * \param name Name of the interface, for instance the name of the pcap
+   * file the interface would have been written to.
+   * \returns the identifier of the interface
+   */
+  uint32_t AddInterface (uint32_t dataLinkType,
+                         uint32_t snapLen = PcapFile::SNAPLEN_DEFAULT,
+                         std::string const &name = "");
+
+  /**
+   * \brief Write the next packet to file
+   *
+   * \param interfaceId Interface the packet was seen on.
+   * \param t Packet timestamp as ns3::Time.
+   * \param p Packet to write to the pcapng file.
+   */
+  void Write (uint32_t interfaceId, Time t, Ptr<const Packet> p);
+
+  /**
+   * \brief Write the provided header along with the packet to the pcapng file.
+   *
+   * \param interfaceId Interface the packet was seen on.
+   * \param t Packet timestamp as ns3::Time.
+   * \param header The Header to prepend to the packet.
+   * \param p Packet to write to the pcapng file.
+   */
+  void Write (uint32_t interfaceId, Time t, const Header &header, Ptr<const Packet> p);
+
+  /**
+   * \brief Write the provided data buffer to the pcapng file.
+   *
+   * \param interfaceId Interface the packet was seen on.
+   * \param t Packet timestamp as ns3::Time.
+   * \param buffer The buffer to write.
+   * \param length The size of the buffer.
+   */
+  void Write (uint32_t interfaceId, Time t, uint8_t const *buffer, uint32_t length);
+
+private:
+  /**
+   * \param t a time
+   * \returns the timestamp of the time, in the resolution of the interfaces
+   */
+  uint64_t GetTimestamp (Time t) const;
+
+  PcapFile m_file;        //!< Pcapng file
+  bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+  uint32_t m_bufferSize;  //!< size of the blocks written to the file
+  bool     m_asyncWrite;  //!< blocks written by a background thread
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_WRAPPER_H */
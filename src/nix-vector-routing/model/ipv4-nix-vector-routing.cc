@@ -18,7 +18,6 @@
  * Authors: Josh Pelkey <jpelkey@gatech.edu>
  */
 
-#include <queue>
 #include <iomanip>
 
 #include "ns3/log.h"
@@ -35,6 +34,8 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4NixVectorRouting");
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
 bool Ipv4NixVectorRouting::g_isCacheDirty = false;
+NixVectorTopology Ipv4NixVectorRouting::g_topology (false);
+std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> Ipv4NixVectorRouting::g_addressIndex;
 
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
@@ -76,6 +77,10 @@ Ipv4NixVectorRouting::DoDispose ()
   m_node = 0;
   m_ipv4 = 0;
 
+  // the nodes are being destroyed, the next ones may reuse their indices
+  g_topology.Clear ();
+  g_addressIndex.clear ();
+
   Ipv4RoutingProtocol::DoDispose ();
 }
 
@@ -105,6 +110,7 @@ Ipv4NixVectorRouting::FlushGlobalNixRoutingCache (void) const
       rp->FlushNixCache ();
       rp->FlushIpv4RouteCache ();
     }
+  g_addressIndex.clear ();
 }
 
 void
@@ -150,11 +156,7 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
     {
       // otherwise proceed as normal 
       // and build the nix vector
-      std::vector< Ptr<Node> > parentVector;
-
-      BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
-
-      if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector))
+      if (g_topology.BuildNixVector (source, destNode, oif, nixVector))
         {
           return nixVector;
         }
@@ -176,8 +178,12 @@ Ipv4NixVectorRouting::GetNixVectorInCache (Ipv4Address address)
   NixMap_t::iterator iter = m_nixCache.find (address);
   if (iter != m_nixCache.end ())
     {
-      NS_LOG_LOGIC ("Found Nix-vector in cache.");
-      return iter->second;
+      if (iter->second.version == g_topology.GetVersion ())
+        {
+          NS_LOG_LOGIC ("Found Nix-vector in cache.");
+          return iter->second.nixVector;
+        }
+      NS_LOG_LOGIC ("Nix-vector in cache built before a topology change.");
     }
 
   // not in cache
@@ -185,17 +191,17 @@ Ipv4NixVectorRouting::GetNixVectorInCache (Ipv4Address address)
 }
 
 Ptr<Ipv4Route>
-Ipv4NixVectorRouting::GetIpv4RouteInCache (Ipv4Address address)
+Ipv4NixVectorRouting::GetIpv4RouteInCache (Ipv4Address address, uint32_t nixIndex)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
   CheckCacheStateAndFlush ();
 
   Ipv4RouteMap_t::iterator iter = m_ipv4RouteCache.find (address);
-  if (iter != m_ipv4RouteCache.end ())
+  if (iter != m_ipv4RouteCache.end () && iter->second.nixIndex == nixIndex)
     {
       NS_LOG_LOGIC ("Found Ipv4Route in cache.");
-      return iter->second;
+      return iter->second.route;
     }
 
   // not in cache
@@ -229,145 +235,42 @@ Ipv4NixVectorRouting::BuildNixVectorLocal (Ptr<NixVector> nixVector)
   return false;
 }
 
-bool
-Ipv4NixVectorRouting::BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector)
-{
+Ptr<Node>
+Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
+{ 
   NS_LOG_FUNCTION_NOARGS ();
 
-  if (source == dest)
-    {
-      return true;
-    }
-
-  if (parentVector.at (dest) == 0)
-    {
-      return false;
-    }
-
-  Ptr<Node> parentNode = parentVector.at (dest);
-
-  uint32_t numberOfDevices = parentNode->GetNDevices ();
-  uint32_t destId = 0;
-  uint32_t totalNeighbors = 0;
-
-  // scan through the net devices on the parent node
-  // and then look at the nodes adjacent to them
-  for (uint32_t i = 0; i < numberOfDevices; i++)
+  if (g_addressIndex.empty ())
     {
-      // Get a net device from the node
-      // as well as the channel, and figure
-      // out the adjacent net devices
-      Ptr<NetDevice> localNetDevice = parentNode->GetDevice (i);
-      if (localNetDevice->IsBridge ())
-        {
-          continue;
-        }
-      Ptr<Channel> channel = localNetDevice->GetChannel ();
-      if (channel == 0)
+      // the first node with an address wins, as when the
+      // nodes were searched in order
+      NodeContainer allNodes = NodeContainer::GetGlobal ();
+      for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
         {
-          continue;
-        }
-
-      // this function takes in the local net dev, and channel, and
-      // writes to the netDeviceContainer the adjacent net devs
-      NetDeviceContainer netDeviceContainer;
-      GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
-
-      // Finally we can get the adjacent nodes
-      // and scan through them.  If we find the 
-      // node that matches "dest" then we can add 
-      // the index  to the nix vector.
-      // the index corresponds to the neighbor index
-      uint32_t offset = 0;
-      for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
-        {
-          Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-          if (remoteNode->GetId () == dest)
+          Ptr<Node> node = *i;
+          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+          if (!ipv4)
             {
-              destId = totalNeighbors + offset;
+              continue;
             }
-          offset += 1;
-        }
-
-      totalNeighbors += netDeviceContainer.GetN ();
-    }
-  NS_LOG_LOGIC ("Adding Nix: " << destId << " with " 
-                               << nixVector->BitCount (totalNeighbors) << " bits, for node " << parentNode->GetId ());
-  nixVector->AddNeighborIndex (destId, nixVector->BitCount (totalNeighbors));
-
-  // recurse through parent vector, grabbing the path 
-  // and building the nix vector
-  BuildNixVector (parentVector, source, (parentVector.at (dest))->GetId (), nixVector);
-  return true;
-}
-
-void
-Ipv4NixVectorRouting::GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-
-  for (std::size_t i = 0; i < channel->GetNDevices (); i++)
-    {
-      Ptr<NetDevice> remoteDevice = channel->GetDevice (i);
-      if (remoteDevice != netDevice)
-        {
-          Ptr<BridgeNetDevice> bd = NetDeviceIsBridged (remoteDevice);
-          // we have a bridged device, we need to add all 
-          // bridged devices
-          if (bd)
+          for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
             {
-              NS_LOG_LOGIC ("Looking through bridge ports of bridge net device " << bd);
-              for (uint32_t j = 0; j < bd->GetNBridgePorts (); ++j)
+              for (uint32_t k = 0; k < ipv4->GetNAddresses (j); k++)
                 {
-                  Ptr<NetDevice> ndBridged = bd->GetBridgePort (j);
-                  if (ndBridged == remoteDevice)
-                    {
-                      NS_LOG_LOGIC ("That bridge port is me, don't walk backward");
-                      continue;
-                    }
-                  Ptr<Channel> chBridged = ndBridged->GetChannel ();
-                  if (chBridged == 0)
-                    {
-                      continue;
-                    }
-                  GetAdjacentNetDevices (ndBridged, chBridged, netDeviceContainer);
+                  g_addressIndex.insert (std::make_pair (ipv4->GetAddress (j, k).GetLocal (), node->GetId ()));
                 }
             }
-          else
-            {
-              netDeviceContainer.Add (channel->GetDevice (i));
-            }
         }
     }
-}
 
-Ptr<Node>
-Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
-{ 
-  NS_LOG_FUNCTION_NOARGS ();
-
-  NodeContainer allNodes = NodeContainer::GetGlobal ();
-  Ptr<Node> destNode;
-
-  for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
-    {
-      Ptr<Node> node = *i;
-      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-      if (ipv4->GetInterfaceForAddress (dest) != -1)
-        {
-          destNode = node;
-          break;
-        }
-    }
-
-  if (!destNode)
+  std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash>::const_iterator iter = g_addressIndex.find (dest);
+  if (iter == g_addressIndex.end ())
     {
       NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
       return 0;
     }
 
-  return destNode;
+  return NodeList::GetNode (iter->second);
 }
 
 uint32_t
@@ -393,7 +296,7 @@ Ipv4NixVectorRouting::FindTotalNeighbors (void)
       // this function takes in the local net dev, and channel, and
       // writes to the netDeviceContainer the adjacent net devs
       NetDeviceContainer netDeviceContainer;
-      GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+      NixVectorTopology::GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
 
       totalNeighbors += netDeviceContainer.GetN ();
     }
@@ -401,46 +304,6 @@ Ipv4NixVectorRouting::FindTotalNeighbors (void)
   return totalNeighbors;
 }
 
-Ptr<BridgeNetDevice>
-Ipv4NixVectorRouting::NetDeviceIsBridged (Ptr<NetDevice> nd) const
-{
-  NS_LOG_FUNCTION (nd);
-
-  Ptr<Node> node = nd->GetNode ();
-  uint32_t nDevices = node->GetNDevices ();
-
-  //
-  // There is no bit on a net device that says it is being bridged, so we have
-  // to look for bridges on the node to which the device is attached.  If we
-  // find a bridge, we need to look through its bridge ports (the devices it
-  // bridges) to see if we find the device in question.
-  //
-  for (uint32_t i = 0; i < nDevices; ++i)
-    {
-      Ptr<NetDevice> ndTest = node->GetDevice (i);
-      NS_LOG_LOGIC ("Examine device " << i << " " << ndTest);
-
-      if (ndTest->IsBridge ())
-        {
-          NS_LOG_LOGIC ("device " << i << " is a bridge net device");
-          Ptr<BridgeNetDevice> bnd = ndTest->GetObject<BridgeNetDevice> ();
-          NS_ABORT_MSG_UNLESS (bnd, "Ipv4NixVectorRouting::NetDeviceIsBridged (): GetObject for <BridgeNetDevice> failed");
-
-          for (uint32_t j = 0; j < bnd->GetNBridgePorts (); ++j)
-            {
-              NS_LOG_LOGIC ("Examine bridge port " << j << " " << bnd->GetBridgePort (j));
-              if (bnd->GetBridgePort (j) == nd)
-                {
-                  NS_LOG_LOGIC ("Net device " << nd << " is bridged by " << bnd);
-                  return bnd;
-                }
-            }
-        }
-    }
-  NS_LOG_LOGIC ("Net device " << nd << " is not bridged");
-  return 0;
-}
-
 uint32_t
 Ipv4NixVectorRouting::FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address & gatewayIp)
 {
@@ -465,7 +328,7 @@ Ipv4NixVectorRouting::FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address
       // this function takes in the local net dev, and channel, and
       // writes to the netDeviceContainer the adjacent net devs
       NetDeviceContainer netDeviceContainer;
-      GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+      NixVectorTopology::GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
 
       // check how many neighbors we have
       if (nodeIndex < (totalNeighbors + netDeviceContainer.GetN ()))
@@ -510,7 +373,9 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
       nixVectorInCache = GetNixVector (m_node, header.GetDestination (), oif);
 
       // cache it
-      m_nixCache.insert (NixMap_t::value_type (header.GetDestination (), nixVectorInCache));
+      NixCacheEntry &entry = m_nixCache[header.GetDestination ()];
+      entry.nixVector = nixVectorInCache;
+      entry.version = g_topology.GetVersion ();
     }
 
   // path exists
@@ -537,20 +402,12 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
 
       // Search here in a cache for this node index 
       // and look for a Ipv4Route
-      rtentry = GetIpv4RouteInCache (header.GetDestination ());
+      rtentry = GetIpv4RouteInCache (header.GetDestination (), nodeIndex);
 
-      if (!rtentry || !(rtentry->GetOutputDevice () == oif))
+      if (!rtentry || (oif && rtentry->GetOutputDevice () != oif))
         {
           // not in cache or a different specified output
           // device is to be used
-
-          // first, make sure we erase existing (incorrect)
-          // rtentry from the map
-          if (rtentry)
-            {
-              m_ipv4RouteCache.erase (header.GetDestination ());
-            }
-
           NS_LOG_LOGIC ("Ipv4Route not in cache, build: ");
           Ipv4Address gatewayIp;
           uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
@@ -587,8 +444,10 @@ Ipv4NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<
 
           sockerr = Socket::ERROR_NOTERROR;
 
-          // add rtentry to cache
-          m_ipv4RouteCache.insert (Ipv4RouteMap_t::value_type (header.GetDestination (), rtentry));
+          // add rtentry to cache, replacing any existing (incorrect) one
+          RouteCacheEntry &entry = m_ipv4RouteCache[header.GetDestination ()];
+          entry.route = rtentry;
+          entry.nixIndex = nodeIndex;
         }
 
       NS_LOG_LOGIC ("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: " << nixVectorForPacket->GetRemainingBits ());
@@ -661,8 +520,8 @@ Ipv4NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
   uint32_t numberOfBits = nixVector->BitCount (m_totalNeighbors);
   uint32_t nodeIndex = nixVector->ExtractNeighborIndex (numberOfBits);
 
-  rtentry = GetIpv4RouteInCache (header.GetDestination ());
-  // not in cache
+  rtentry = GetIpv4RouteInCache (header.GetDestination (), nodeIndex);
+  // not in cache, or built for another neighbor
   if (!rtentry)
     {
       NS_LOG_LOGIC ("Ipv4Route not in cache, build: ");
@@ -680,7 +539,9 @@ Ipv4NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv4Header &header,
       rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIndex));
 
       // add rtentry to cache
-      m_ipv4RouteCache.insert (Ipv4RouteMap_t::value_type (header.GetDestination (), rtentry));
+      RouteCacheEntry &entry = m_ipv4RouteCache[header.GetDestination ()];
+      entry.route = rtentry;
+      entry.nixIndex = nodeIndex;
     }
 
   NS_LOG_LOGIC ("At Node " << m_node->GetId () << ", Extracting " << numberOfBits <<
@@ -714,10 +575,15 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
       *os << "Destination     NixVector" << std::endl;
       for (NixMap_t::const_iterator it = m_nixCache.begin (); it != m_nixCache.end (); it++)
         {
+          if (!it->second.nixVector || it->second.version != g_topology.GetVersion ())
+            {
+              // no path, or to be rebuilt on next use
+              continue;
+            }
           std::ostringstream dest;
           dest << it->first;
           *os << std::setiosflags (std::ios::left) << std::setw (16) << dest.str ();
-          *os << *(it->second) << std::endl;
+          *os << *(it->second.nixVector) << std::endl;
         }
     }
   *os << "Ipv4RouteCache:" << std::endl;
@@ -726,21 +592,22 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
       *os << "Destination     Gateway         Source            OutputDevice" << std::endl;
       for (Ipv4RouteMap_t::const_iterator it = m_ipv4RouteCache.begin (); it != m_ipv4RouteCache.end (); it++)
         {
+          Ptr<Ipv4Route> route = it->second.route;
           std::ostringstream dest, gw, src;
-          dest << it->second->GetDestination ();
+          dest << route->GetDestination ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << dest.str ();
-          gw << it->second->GetGateway ();
+          gw << route->GetGateway ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << gw.str ();
-          src << it->second->GetSource ();
+          src << route->GetSource ();
           *os << std::setiosflags (std::ios::left) << std::setw (16) << src.str ();
           *os << "  ";
-          if (Names::FindName (it->second->GetOutputDevice ()) != "")
+          if (Names::FindName (route->GetOutputDevice ()) != "")
             {
-              *os << Names::FindName (it->second->GetOutputDevice ());
+              *os << Names::FindName (route->GetOutputDevice ());
             }
           else
             {
-              *os << it->second->GetOutputDevice ()->GetIfIndex ();
+              *os << route->GetOutputDevice ()->GetIfIndex ();
             }
           *os << std::endl;
         }
@@ -752,12 +619,12 @@ Ipv4NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::
 void
 Ipv4NixVectorRouting::NotifyInterfaceUp (uint32_t i)
 {
-  g_isCacheDirty = true;
+  g_topology.NotifyInterfaceUp ();
 }
 void
 Ipv4NixVectorRouting::NotifyInterfaceDown (uint32_t i)
 {
-  g_isCacheDirty = true;
+  g_topology.NotifyInterfaceDown (m_ipv4->GetNetDevice (i));
 }
 void
 Ipv4NixVectorRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
@@ -770,152 +637,6 @@ Ipv4NixVectorRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddr
   g_isCacheDirty = true;
 }
 
-bool
-Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source, 
-                           Ptr<Node> dest, std::vector< Ptr<Node> > & parentVector,
-                           Ptr<NetDevice> oif)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-
-  NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << dest->GetId ());
-  std::queue< Ptr<Node> > greyNodeList;  // discovered nodes with unexplored children
-
-  // reset the parent vector
-  parentVector.assign (numberOfNodes, 0); // initialize to 0
-
-  // Add the source node to the queue, set its parent to itself 
-  greyNodeList.push (source);
-  parentVector.at (source->GetId ()) = source;
-
-  // BFS loop
-  while (greyNodeList.size () != 0)
-    {
-      Ptr<Node> currNode = greyNodeList.front ();
-      Ptr<Ipv4> ipv4 = currNode->GetObject<Ipv4> ();
- 
-      if (currNode == dest) 
-        {
-          NS_LOG_LOGIC ("Made it to Node " << currNode->GetId ());
-          return true;
-        }
-
-      // if this is the first iteration of the loop and a 
-      // specific output interface was given, make sure 
-      // we go this way
-      if (currNode == source && oif)
-        {
-          // make sure that we can go this way
-          if (ipv4)
-            {
-              uint32_t interfaceIndex = (ipv4)->GetInterfaceForDevice (oif);
-              if (!(ipv4->IsUp (interfaceIndex)))
-                {
-                  NS_LOG_LOGIC ("Ipv4Interface is down");
-                  return false;
-                }
-            }
-          if (!(oif->IsLinkUp ()))
-            {
-              NS_LOG_LOGIC ("Link is down.");
-              return false;
-            }
-          Ptr<Channel> channel = oif->GetChannel ();
-          if (channel == 0)
-            { 
-              return false;
-            }
-
-          // this function takes in the local net dev, and channel, and
-          // writes to the netDeviceContainer the adjacent net devs
-          NetDeviceContainer netDeviceContainer;
-          GetAdjacentNetDevices (oif, channel, netDeviceContainer);
-
-          // Finally we can get the adjacent nodes
-          // and scan through them.  We push them
-          // to the greyNode queue, if they aren't 
-          // already there.
-          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
-            {
-              Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-              // check to see if this node has been pushed before
-              // by checking to see if it has a parent
-              // if it doesn't (null or 0), then set its parent and 
-              // push to the queue
-              if (parentVector.at (remoteNode->GetId ()) == 0)
-                {
-                  parentVector.at (remoteNode->GetId ()) = currNode;
-                  greyNodeList.push (remoteNode);
-                }
-            }
-        }
-      else
-        {
-          // Iterate over the current node's adjacent vertices
-          // and push them into the queue
-          for (uint32_t i = 0; i < (currNode->GetNDevices ()); i++)
-            {
-              // Get a net device from the node
-              // as well as the channel, and figure
-              // out the adjacent net device
-              Ptr<NetDevice> localNetDevice = currNode->GetDevice (i);
-
-              // make sure that we can go this way
-              if (ipv4)
-                {
-                  uint32_t interfaceIndex = (ipv4)->GetInterfaceForDevice (currNode->GetDevice (i));
-                  if (!(ipv4->IsUp (interfaceIndex)))
-                    {
-                      NS_LOG_LOGIC ("Ipv4Interface is down");
-                      continue;
-                    }
-                }
-              if (!(localNetDevice->IsLinkUp ()))
-                {
-                  NS_LOG_LOGIC ("Link is down.");
-                  continue;
-                }
-              Ptr<Channel> channel = localNetDevice->GetChannel ();
-              if (channel == 0)
-                { 
-                  continue;
-                }
-
-              // this function takes in the local net dev, and channel, and
-              // writes to the netDeviceContainer the adjacent net devs
-              NetDeviceContainer netDeviceContainer;
-              GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
-
-              // Finally we can get the adjacent nodes
-              // and scan through them.  We push them
-              // to the greyNode queue, if they aren't 
-              // already there.
-              for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
-                {
-                  Ptr<Node> remoteNode = (*iter)->GetNode ();
-
-                  // check to see if this node has been pushed before
-                  // by checking to see if it has a parent
-                  // if it doesn't (null or 0), then set its parent and 
-                  // push to the queue
-                  if (parentVector.at (remoteNode->GetId ()) == 0)
-                    {
-                      parentVector.at (remoteNode->GetId ()) = currNode;
-                      greyNodeList.push (remoteNode);
-                    }
-                }
-            }
-        }
-
-      // Pop off the head grey node.  We have all its children.
-      // It is now black.
-      greyNodeList.pop ();
-    }
-
-  // Didn't find the dest...
-  return false;
-}
-
 void 
 Ipv4NixVectorRouting::CheckCacheStateAndFlush (void) const
 {
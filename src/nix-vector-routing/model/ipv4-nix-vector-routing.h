@@ -22,6 +22,7 @@
 #define IPV4_NIX_VECTOR_ROUTING_H
 
 #include <map>
+#include <unordered_map>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
@@ -32,6 +33,7 @@
 #include "ns3/nix-vector.h"
 #include "ns3/bridge-net-device.h"
 #include "ns3/nstime.h"
+#include "ns3/nix-vector-topology.h"
 
 namespace ns3 {
 
@@ -42,17 +44,6 @@ namespace ns3 {
  * intended for large network topologies.
  */
 
-/**
- * \ingroup nix-vector-routing
- * Map of Ipv4Address to NixVector
- */
-typedef std::map<Ipv4Address, Ptr<NixVector> > NixMap_t;
-/**
- * \ingroup nix-vector-routing
- * Map of Ipv4Address to Ipv4Route
- */
-typedef std::map<Ipv4Address, Ptr<Ipv4Route> > Ipv4RouteMap_t;
-
 /**
  * \ingroup nix-vector-routing
  * Nix-vector routing protocol
@@ -77,7 +68,7 @@ public:
   void SetNode (Ptr<Node> node);
 
   /**
-   * @brief Called when run-time link topology change occurs
+   * @brief Called when run-time address changes occur
    * which iterates through the node list and flushes any
    * nix vector caches
    *
@@ -89,6 +80,24 @@ public:
   void FlushGlobalNixRoutingCache (void) const;
 
 private:
+  /// Nix-vector cached for a destination
+  struct NixCacheEntry
+  {
+    Ptr<NixVector> nixVector; //!< Nix-vector to the destination, null if there is no path
+    uint32_t version;         //!< Version of the topology the nix-vector was built with
+  };
+
+  /// Ipv4Route cached for a destination
+  struct RouteCacheEntry
+  {
+    Ptr<Ipv4Route> route;     //!< Route to the destination
+    uint32_t nixIndex;        //!< Neighbor index the route was built for
+  };
+
+  /// Map of Ipv4Address to cached NixVector
+  typedef std::map<Ipv4Address, NixCacheEntry> NixMap_t;
+  /// Map of Ipv4Address to cached Ipv4Route
+  typedef std::map<Ipv4Address, RouteCacheEntry> Ipv4RouteMap_t;
 
   /**
    * Flushes the cache which stores nix-vector based on
@@ -111,8 +120,8 @@ private:
 
   /**
    * Takes in the source node and dest IP and calls GetNodeByIp,
-   * BFS, accounting for any output interface specified, and finally
-   * BuildNixVector to return the built nix-vector
+   * and builds the nix-vector from the shortest path tree of the
+   * source, accounting for any output interface specified
    *
    * \param source Source node
    * \param dest Destination node address
@@ -122,7 +131,8 @@ private:
   Ptr<NixVector> GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetDevice> oif);
 
   /**
-   * Checks the cache based on dest IP for the nix-vector
+   * Checks the cache based on dest IP for the nix-vector.  A nix-vector
+   * built before a topology change is not returned, so that it is rebuilt.
    * \param address Address to check
    * \returns The NixVector to be used in routing.
    */
@@ -131,37 +141,19 @@ private:
   /**
    * Checks the cache based on dest IP for the Ipv4Route
    * \param address Address to check
-   * \returns The cached route.
+   * \param nixIndex Neighbor index extracted from the nix-vector
+   * \returns The cached route, or null if it was built for another neighbor.
    */
-  Ptr<Ipv4Route> GetIpv4RouteInCache (Ipv4Address address);
+  Ptr<Ipv4Route> GetIpv4RouteInCache (Ipv4Address address, uint32_t nixIndex);
 
   /**
-   * Given a net-device returns all the adjacent net-devices,
-   * essentially getting the neighbors on that channel
-   * \param [in] netDevice the NetDevice attached to the channel.
-   * \param [in] channel the channel to check
-   * \param [out] netDeviceContainer the NetDeviceContainer of the NetDevices in the channel.
-   */
-  void GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer);
-
-  /**
-   * Iterates through the node list and finds the one
-   * corresponding to the given Ipv4Address
+   * Finds the node corresponding to the given Ipv4Address,
+   * with the index of the addresses of all the nodes
    * \param dest destination node IP
    * \return The node with the specified IP.
    */
   Ptr<Node> GetNodeByIp (Ipv4Address dest);
 
-  /**
-   * Recurses the parent vector, created by BFS and actually builds the nixvector
-   * \param [in] parentVector Parent vector for retracing routes
-   * \param [in] source Source Node index
-   * \param [in] dest Destination Node index
-   * \param [out] nixVector the NixVector to be used for routing
-   * \returns true on success, false otherwise.
-   */
-  bool BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector);
-
   /**
    * Special variation of BuildNixVector for when a node is sending to itself
    * \param [out] nixVector the NixVector to be used for routing
@@ -176,14 +168,6 @@ private:
    */
   uint32_t FindTotalNeighbors (void);
 
-  /**
-   * Determine if the NetDevice is bridged
-   * \param nd the NetDevice to check
-   * \returns the bridging NetDevice (or null if the NetDevice is not bridged)
-   */
-  Ptr<BridgeNetDevice> NetDeviceIsBridged (Ptr<NetDevice> nd) const;
-
-
   /**
    * Nix index is with respect to the neighbors.  The net-device index must be
    * derived from this
@@ -193,21 +177,6 @@ private:
    */
   uint32_t FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv4Address & gatewayIp);
 
-  /**
-   * \brief Breadth first search algorithm.
-   * \param [in] numberOfNodes total number of nodes
-   * \param [in] source Source Node
-   * \param [in] dest Destination Node
-   * \param [out] parentVector Parent vector for retracing routes
-   * \param [in] oif specific output interface to use from source node, if not null
-   * \returns false if dest not found, true o.w.
-   */
-  bool BFS (uint32_t numberOfNodes,
-            Ptr<Node> source,
-            Ptr<Node> dest,
-            std::vector< Ptr<Node> > & parentVector,
-            Ptr<NetDevice> oif);
-
   void DoDispose (void);
 
   /* From Ipv4RoutingProtocol */
@@ -229,10 +198,19 @@ private:
 
   /**
    * Flag to mark when caches are dirty and need to be flushed.  
-   * Used for lazy cleanup of caches when there are many topology changes.
+   * Used for lazy cleanup of caches when there are many address changes.
    */
   static bool g_isCacheDirty;
 
+  /**
+   * Graph and shortest path trees of the IPv4 topology, shared by
+   * all the nodes.
+   */
+  static NixVectorTopology g_topology;
+
+  /** Index of the node of each address, rebuilt after address changes */
+  static std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> g_addressIndex;
+
   /** Cache stores nix-vectors based on destination ip */
   mutable NixMap_t m_nixCache;
 
@@ -0,0 +1,657 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <iomanip>
+
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+
+#include "ipv6-nix-vector-routing.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Ipv6NixVectorRouting");
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6NixVectorRouting);
+
+bool Ipv6NixVectorRouting::g_isCacheDirty = false;
+NixVectorTopology Ipv6NixVectorRouting::g_topology (true);
+std::unordered_map<Ipv6Address, uint32_t, Ipv6AddressHash> Ipv6NixVectorRouting::g_addressIndex;
+
+TypeId
+Ipv6NixVectorRouting::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::Ipv6NixVectorRouting")
+    .SetParent<Ipv6RoutingProtocol> ()
+    .SetGroupName ("NixVectorRouting")
+    .AddConstructor<Ipv6NixVectorRouting> ()
+  ;
+  return tid;
+}
+
+Ipv6NixVectorRouting::Ipv6NixVectorRouting ()
+  : m_totalNeighbors (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Ipv6NixVectorRouting::~Ipv6NixVectorRouting ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+Ipv6NixVectorRouting::SetIpv6 (Ptr<Ipv6> ipv6)
+{
+  NS_ASSERT (ipv6 != 0);
+  NS_ASSERT (m_ipv6 == 0);
+  NS_LOG_DEBUG ("Created Ipv6NixVectorProtocol");
+
+  m_ipv6 = ipv6;
+}
+
+void
+Ipv6NixVectorRouting::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_node = 0;
+  m_ipv6 = 0;
+
+  // the nodes are being destroyed, the next ones may reuse their indices
+  g_topology.Clear ();
+  g_addressIndex.clear ();
+
+  Ipv6RoutingProtocol::DoDispose ();
+}
+
+void
+Ipv6NixVectorRouting::SetNode (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_node = node;
+}
+
+void
+Ipv6NixVectorRouting::FlushGlobalNixRoutingCache (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<Ipv6NixVectorRouting> rp = node->GetObject<Ipv6NixVectorRouting> ();
+      if (!rp)
+        {
+          continue;
+        }
+      NS_LOG_LOGIC ("Flushing Nix caches.");
+      rp->FlushNixCache ();
+      rp->FlushIpv6RouteCache ();
+    }
+  g_addressIndex.clear ();
+}
+
+void
+Ipv6NixVectorRouting::FlushNixCache (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_nixCache.clear ();
+}
+
+void
+Ipv6NixVectorRouting::FlushIpv6RouteCache (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_ipv6RouteCache.clear ();
+}
+
+Ptr<NixVector>
+Ipv6NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv6Address dest, Ptr<NetDevice> oif)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  Ptr<NixVector> nixVector = Create<NixVector> ();
+
+  // not in cache, must build the nix vector
+  // First, we have to figure out the nodes
+  // associated with these IPs
+  Ptr<Node> destNode = GetNodeByIp (dest);
+  if (destNode == 0)
+    {
+      NS_LOG_ERROR ("No routing path exists");
+      return 0;
+    }
+
+  // if source == dest, then we have a special case
+  if (source == destNode)
+    {
+      NS_LOG_DEBUG ("Do not process packets to self");
+      return 0;
+    }
+  else
+    {
+      // otherwise proceed as normal
+      // and build the nix vector
+      if (g_topology.BuildNixVector (source, destNode, oif, nixVector))
+        {
+          return nixVector;
+        }
+      else
+        {
+          NS_LOG_ERROR ("No routing path exists");
+          return 0;
+        }
+    }
+}
+
+Ptr<NixVector>
+Ipv6NixVectorRouting::GetNixVectorInCache (Ipv6Address address)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  CheckCacheStateAndFlush ();
+
+  NixMap_t::iterator iter = m_nixCache.find (address);
+  if (iter != m_nixCache.end ())
+    {
+      if (iter->second.version == g_topology.GetVersion ())
+        {
+          NS_LOG_LOGIC ("Found Nix-vector in cache.");
+          return iter->second.nixVector;
+        }
+      NS_LOG_LOGIC ("Nix-vector in cache built before a topology change.");
+    }
+
+  // not in cache
+  return 0;
+}
+
+Ptr<Ipv6Route>
+Ipv6NixVectorRouting::GetIpv6RouteInCache (Ipv6Address address, uint32_t nixIndex)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  CheckCacheStateAndFlush ();
+
+  Ipv6RouteMap_t::iterator iter = m_ipv6RouteCache.find (address);
+  if (iter != m_ipv6RouteCache.end () && iter->second.nixIndex == nixIndex)
+    {
+      NS_LOG_LOGIC ("Found Ipv6Route in cache.");
+      return iter->second.route;
+    }
+
+  // not in cache
+  return 0;
+}
+
+Ptr<Node>
+Ipv6NixVectorRouting::GetNodeByIp (Ipv6Address dest)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  if (g_addressIndex.empty ())
+    {
+      NodeContainer allNodes = NodeContainer::GetGlobal ();
+      for (NodeContainer::Iterator i = allNodes.Begin (); i != allNodes.End (); ++i)
+        {
+          Ptr<Node> node = *i;
+          Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+          if (!ipv6)
+            {
+              continue;
+            }
+          for (uint32_t j = 0; j < ipv6->GetNInterfaces (); j++)
+            {
+              for (uint32_t k = 0; k < ipv6->GetNAddresses (j); k++)
+                {
+                  Ipv6Address address = ipv6->GetAddress (j, k).GetAddress ();
+                  if (address.IsLocalhost () || address.IsLinkLocal ())
+                    {
+                      continue;
+                    }
+                  g_addressIndex.insert (std::make_pair (address, node->GetId ()));
+                }
+            }
+        }
+    }
+
+  std::unordered_map<Ipv6Address, uint32_t, Ipv6AddressHash>::const_iterator iter = g_addressIndex.find (dest);
+  if (iter == g_addressIndex.end ())
+    {
+      NS_LOG_ERROR ("Couldn't find dest node given the IP" << dest);
+      return 0;
+    }
+
+  return NodeList::GetNode (iter->second);
+}
+
+uint32_t
+Ipv6NixVectorRouting::FindTotalNeighbors (void)
+{
+  uint32_t numberOfDevices = m_node->GetNDevices ();
+  uint32_t totalNeighbors = 0;
+
+  // scan through the net devices on the parent node
+  // and then look at the nodes adjacent to them
+  for (uint32_t i = 0; i < numberOfDevices; i++)
+    {
+      // Get a net device from the node
+      // as well as the channel, and figure
+      // out the adjacent net devices
+      Ptr<NetDevice> localNetDevice = m_node->GetDevice (i);
+      Ptr<Channel> channel = localNetDevice->GetChannel ();
+      if (channel == 0)
+        {
+          continue;
+        }
+
+      // this function takes in the local net dev, and channel, and
+      // writes to the netDeviceContainer the adjacent net devs
+      NetDeviceContainer netDeviceContainer;
+      NixVectorTopology::GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+
+      totalNeighbors += netDeviceContainer.GetN ();
+    }
+
+  return totalNeighbors;
+}
+
+uint32_t
+Ipv6NixVectorRouting::FindNetDeviceForNixIndex (uint32_t nodeIndex, Ipv6Address & gatewayIp)
+{
+  uint32_t numberOfDevices = m_node->GetNDevices ();
+  uint32_t index = 0;
+  uint32_t totalNeighbors = 0;
+
+  // scan through the net devices on the parent node
+  // and then look at the nodes adjacent to them
+  for (uint32_t i = 0; i < numberOfDevices; i++)
+    {
+      // Get a net device from the node
+      // as well as the channel, and figure
+      // out the adjacent net devices
+      Ptr<NetDevice> localNetDevice = m_node->GetDevice (i);
+      Ptr<Channel> channel = localNetDevice->GetChannel ();
+      if (channel == 0)
+        {
+          continue;
+        }
+
+      // this function takes in the local net dev, and channel, and
+      // writes to the netDeviceContainer the adjacent net devs
+      NetDeviceContainer netDeviceContainer;
+      NixVectorTopology::GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+
+      // check how many neighbors we have
+      if (nodeIndex < (totalNeighbors + netDeviceContainer.GetN ()))
+        {
+          // found the proper net device
+          index = i;
+          Ptr<NetDevice> gatewayDevice = netDeviceContainer.Get (nodeIndex-totalNeighbors);
+          Ptr<Node> gatewayNode = gatewayDevice->GetNode ();
+          Ptr<Ipv6> ipv6 = gatewayNode->GetObject<Ipv6> ();
+
+          // the next hop is reached on the link, with its link-local address
+          uint32_t interfaceIndex = (ipv6)->GetInterfaceForDevice (gatewayDevice);
+          gatewayIp = ipv6->GetAddress (interfaceIndex, 0).GetAddress ();
+          for (uint32_t j = 0; j < ipv6->GetNAddresses (interfaceIndex); j++)
+            {
+              Ipv6Address address = ipv6->GetAddress (interfaceIndex, j).GetAddress ();
+              if (address.IsLinkLocal ())
+                {
+                  gatewayIp = address;
+                  break;
+                }
+            }
+          break;
+        }
+      totalNeighbors += netDeviceContainer.GetN ();
+    }
+
+  return index;
+}
+
+Ptr<Ipv6Route>
+Ipv6NixVectorRouting::RouteOutput (Ptr<Packet> p, const Ipv6Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Ptr<Ipv6Route> rtentry;
+  Ptr<NixVector> nixVectorInCache;
+  Ptr<NixVector> nixVectorForPacket;
+  Ipv6Address destAddress = header.GetDestinationAddress ();
+
+  CheckCacheStateAndFlush ();
+
+  NS_LOG_DEBUG ("Dest IP from header: " << destAddress);
+
+  // the link-local and multicast destinations, e.g., of the neighbor
+  // discovery, are on the link of the output interface
+  if (destAddress.IsMulticast () || destAddress.IsLinkLocal ())
+    {
+      if (!oif)
+        {
+          NS_LOG_ERROR ("No output interface for the link-local destination " << destAddress);
+          sockerr = Socket::ERROR_NOROUTETOHOST;
+          return 0;
+        }
+      rtentry = Create<Ipv6Route> ();
+      rtentry->SetSource (m_ipv6->SourceAddressSelection (m_ipv6->GetInterfaceForDevice (oif), destAddress));
+      rtentry->SetDestination (destAddress);
+      rtentry->SetGateway (Ipv6Address::GetZero ());
+      rtentry->SetOutputDevice (oif);
+      sockerr = Socket::ERROR_NOTERROR;
+      return rtentry;
+    }
+
+  // check if cache
+  nixVectorInCache = GetNixVectorInCache (destAddress);
+
+  // not in cache
+  if (!nixVectorInCache)
+    {
+      NS_LOG_LOGIC ("Nix-vector not in cache, build: ");
+      // Build the nix-vector, given this node and the
+      // dest IP address
+      nixVectorInCache = GetNixVector (m_node, destAddress, oif);
+
+      // cache it
+      NixCacheEntry &entry = m_nixCache[destAddress];
+      entry.nixVector = nixVectorInCache;
+      entry.version = g_topology.GetVersion ();
+    }
+
+  // path exists
+  if (nixVectorInCache)
+    {
+      NS_LOG_LOGIC ("Nix-vector contents: " << *nixVectorInCache);
+
+      // create a new nix vector to be used,
+      // we want to keep the cached version clean
+      nixVectorForPacket = nixVectorInCache->Copy ();
+
+      // Get the interface number that we go out of, by extracting
+      // from the nix-vector
+      if (m_totalNeighbors == 0)
+        {
+          m_totalNeighbors = FindTotalNeighbors ();
+        }
+
+      // Get the interface number that we go out of, by extracting
+      // from the nix-vector
+      uint32_t numberOfBits = nixVectorForPacket->BitCount (m_totalNeighbors);
+      uint32_t nodeIndex = nixVectorForPacket->ExtractNeighborIndex (numberOfBits);
+
+      // Search here in a cache for this node index
+      // and look for a Ipv6Route
+      rtentry = GetIpv6RouteInCache (destAddress, nodeIndex);
+
+      if (!rtentry || (oif && rtentry->GetOutputDevice () != oif))
+        {
+          // not in cache or a different specified output
+          // device is to be used
+          NS_LOG_LOGIC ("Ipv6Route not in cache, build: ");
+          Ipv6Address gatewayIp;
+          uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
+          int32_t interfaceIndex = 0;
+
+          if (!oif)
+            {
+              interfaceIndex = (m_ipv6)->GetInterfaceForDevice (m_node->GetDevice (index));
+            }
+          else
+            {
+              interfaceIndex = (m_ipv6)->GetInterfaceForDevice (oif);
+            }
+
+          NS_ASSERT_MSG (interfaceIndex != -1, "Interface index not found for device");
+
+          // start filling in the Ipv6Route info
+          rtentry = Create<Ipv6Route> ();
+          rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIndex, destAddress));
+
+          rtentry->SetGateway (gatewayIp);
+          rtentry->SetDestination (destAddress);
+
+          if (!oif)
+            {
+              rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIndex));
+            }
+          else
+            {
+              rtentry->SetOutputDevice (oif);
+            }
+
+          // add rtentry to cache, replacing any existing (incorrect) one
+          RouteCacheEntry &entry = m_ipv6RouteCache[destAddress];
+          entry.route = rtentry;
+          entry.nixIndex = nodeIndex;
+        }
+
+      sockerr = Socket::ERROR_NOTERROR;
+
+      NS_LOG_LOGIC ("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: " << nixVectorForPacket->GetRemainingBits ());
+
+      // Add  nix-vector in the packet class
+      // make sure the packet exists first
+      if (p)
+        {
+          NS_LOG_LOGIC ("Adding Nix-vector to packet: " << *nixVectorForPacket);
+          p->SetNixVector (nixVectorForPacket);
+        }
+    }
+  else // path doesn't exist
+    {
+      NS_LOG_ERROR ("No path to the dest: " << destAddress);
+      sockerr = Socket::ERROR_NOROUTETOHOST;
+    }
+
+  return rtentry;
+}
+
+bool
+Ipv6NixVectorRouting::RouteInput (Ptr<const Packet> p, const Ipv6Header &header, Ptr<const NetDevice> idev,
+                                  UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                                  LocalDeliverCallback lcb, ErrorCallback ecb)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  CheckCacheStateAndFlush ();
+
+  NS_ASSERT (m_ipv6 != 0);
+  // Check if input device supports IP
+  NS_ASSERT (m_ipv6->GetInterfaceForDevice (idev) >= 0);
+  uint32_t iif = m_ipv6->GetInterfaceForDevice (idev);
+  Ipv6Address destAddress = header.GetDestinationAddress ();
+
+  // the local delivery is done by Ipv6L3Protocol, the multicast
+  // packets are not routed
+  if (destAddress.IsMulticast ())
+    {
+      NS_LOG_LOGIC ("Multicast destination");
+      return false;
+    }
+
+  // Check if input device supports IP forwarding
+  if (m_ipv6->IsForwarding (iif) == false)
+    {
+      NS_LOG_LOGIC ("Forwarding disabled for this interface");
+      if (!ecb.IsNull ())
+        {
+          ecb (p, header, Socket::ERROR_NOROUTETOHOST);
+        }
+      return true;
+    }
+
+  Ptr<Ipv6Route> rtentry;
+
+  // Get the nix-vector from the packet
+  Ptr<NixVector> nixVector = p->GetNixVector ();
+
+  // If nixVector isn't in packet, the packet was not routed by nix
+  if (!nixVector)
+    {
+      NS_LOG_LOGIC ("No Nix-vector in the packet");
+      return false;
+    }
+
+  // Get the interface number that we go out of, by extracting
+  // from the nix-vector
+  if (m_totalNeighbors == 0)
+    {
+      m_totalNeighbors = FindTotalNeighbors ();
+    }
+  uint32_t numberOfBits = nixVector->BitCount (m_totalNeighbors);
+  uint32_t nodeIndex = nixVector->ExtractNeighborIndex (numberOfBits);
+
+  rtentry = GetIpv6RouteInCache (destAddress, nodeIndex);
+  // not in cache, or built for another neighbor
+  if (!rtentry)
+    {
+      NS_LOG_LOGIC ("Ipv6Route not in cache, build: ");
+      Ipv6Address gatewayIp;
+      uint32_t index = FindNetDeviceForNixIndex (nodeIndex, gatewayIp);
+      uint32_t interfaceIndex = (m_ipv6)->GetInterfaceForDevice (m_node->GetDevice (index));
+
+      // start filling in the Ipv6Route info
+      rtentry = Create<Ipv6Route> ();
+      rtentry->SetSource (m_ipv6->SourceAddressSelection (interfaceIndex, destAddress));
+
+      rtentry->SetGateway (gatewayIp);
+      rtentry->SetDestination (destAddress);
+      rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIndex));
+
+      // add rtentry to cache
+      RouteCacheEntry &entry = m_ipv6RouteCache[destAddress];
+      entry.route = rtentry;
+      entry.nixIndex = nodeIndex;
+    }
+
+  NS_LOG_LOGIC ("At Node " << m_node->GetId () << ", Extracting " << numberOfBits <<
+                " bits from Nix-vector: " << nixVector << " : " << *nixVector);
+
+  // call the unicast callback
+  ucb (idev, rtentry, p, header);
+
+  return true;
+}
+
+void
+Ipv6NixVectorRouting::PrintRoutingTable (Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
+{
+
+  CheckCacheStateAndFlush ();
+
+  std::ostream* os = stream->GetStream ();
+
+  *os << "Node: " << m_ipv6->GetObject<Node> ()->GetId ()
+      << ", Time: " << Now().As (unit)
+      << ", Local time: " << GetObject<Node> ()->GetLocalTime ().As (unit)
+      << ", Nix Routing" << std::endl;
+
+  *os << "NixCache:" << std::endl;
+  if (m_nixCache.size () > 0)
+    {
+      *os << "Destination                   NixVector" << std::endl;
+      for (NixMap_t::const_iterator it = m_nixCache.begin (); it != m_nixCache.end (); it++)
+        {
+          if (!it->second.nixVector || it->second.version != g_topology.GetVersion ())
+            {
+              // no path, or to be rebuilt on next use
+              continue;
+            }
+          std::ostringstream dest;
+          dest << it->first;
+          *os << std::setiosflags (std::ios::left) << std::setw (30) << dest.str ();
+          *os << *(it->second.nixVector) << std::endl;
+        }
+    }
+  *os << "Ipv6RouteCache:" << std::endl;
+  if (m_ipv6RouteCache.size () > 0)
+    {
+      *os << "Destination                   Gateway                       Source                          OutputDevice" << std::endl;
+      for (Ipv6RouteMap_t::const_iterator it = m_ipv6RouteCache.begin (); it != m_ipv6RouteCache.end (); it++)
+        {
+          Ptr<Ipv6Route> route = it->second.route;
+          std::ostringstream dest, gw, src;
+          dest << route->GetDestination ();
+          *os << std::setiosflags (std::ios::left) << std::setw (30) << dest.str ();
+          gw << route->GetGateway ();
+          *os << std::setiosflags (std::ios::left) << std::setw (30) << gw.str ();
+          src << route->GetSource ();
+          *os << std::setiosflags (std::ios::left) << std::setw (30) << src.str ();
+          *os << "  ";
+          if (Names::FindName (route->GetOutputDevice ()) != "")
+            {
+              *os << Names::FindName (route->GetOutputDevice ());
+            }
+          else
+            {
+              *os << route->GetOutputDevice ()->GetIfIndex ();
+            }
+          *os << std::endl;
+        }
+    }
+  *os << std::endl;
+}
+
+// virtual functions from Ipv6RoutingProtocol
+void
+Ipv6NixVectorRouting::NotifyInterfaceUp (uint32_t i)
+{
+  g_topology.NotifyInterfaceUp ();
+}
+void
+Ipv6NixVectorRouting::NotifyInterfaceDown (uint32_t i)
+{
+  g_topology.NotifyInterfaceDown (m_ipv6->GetNetDevice (i));
+}
+void
+Ipv6NixVectorRouting::NotifyAddAddress (uint32_t interface, Ipv6InterfaceAddress address)
+{
+  g_isCacheDirty = true;
+}
+void
+Ipv6NixVectorRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAddress address)
+{
+  g_isCacheDirty = true;
+}
+void
+Ipv6NixVectorRouting::NotifyAddRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse)
+{
+  // the routes are not used
+}
+void
+Ipv6NixVectorRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse)
+{
+  // the routes are not used
+}
+
+void
+Ipv6NixVectorRouting::CheckCacheStateAndFlush (void) const
+{
+  if (g_isCacheDirty)
+    {
+      FlushGlobalNixRoutingCache ();
+      g_isCacheDirty = false;
+    }
+}
+
+} // namespace ns3
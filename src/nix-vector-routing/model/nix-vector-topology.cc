@@ -0,0 +1,527 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/node-list.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv6.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <unistd.h>
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#endif /* HAVE_PTHREAD_H */
+
+#include "nix-vector-topology.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NixVectorTopology");
+
+/**
+ * \ingroup nix-vector-routing
+ * \brief Compute the trees of all the nodes at once.
+ */
+static GlobalValue g_nixPrecompute ("NixVectorPrecompute",
+                                    "Compute the shortest path trees of all the nodes at once, "
+                                    "before the first packet and after each topology change, "
+                                    "instead of when each node first needs its tree.",
+                                    BooleanValue (false),
+                                    MakeBooleanChecker ());
+
+/**
+ * \ingroup nix-vector-routing
+ * \brief Number of threads computing the trees when they are precomputed.
+ *
+ * The trees do not depend on the number of threads.
+ */
+static GlobalValue g_nixPrecomputeThreads ("NixVectorPrecomputeThreads",
+                                           "The number of threads computing the shortest path "
+                                           "trees when they are precomputed, 0 for one thread "
+                                           "per processor.",
+                                           UintegerValue (0),
+                                           MakeUintegerChecker<uint32_t> ());
+
+/// Parent of the nodes out of a tree
+static const uint32_t NO_PARENT = 0xffffffff;
+
+NixVectorTopology::NixVectorTopology (bool ipv6)
+  : m_ipv6 (ipv6),
+    m_version (0),
+    m_graphDirty (true),
+    m_nNodes (0),
+    m_treeMutex (0),
+    m_treeNext (0)
+{
+  // no logging: the topologies are static objects
+}
+
+NixVectorTopology::~NixVectorTopology ()
+{
+}
+
+uint32_t
+NixVectorTopology::GetVersion (void) const
+{
+  return m_version;
+}
+
+void
+NixVectorTopology::NotifyInterfaceUp (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_version++;
+  m_graphDirty = true;
+  for (std::vector<std::vector<uint32_t> >::iterator i = m_trees.begin (); i != m_trees.end (); i++)
+    {
+      i->clear ();
+    }
+}
+
+void
+NixVectorTopology::NotifyInterfaceDown (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  m_version++;
+  m_graphDirty = true;
+
+  Ptr<Channel> channel = device->GetChannel ();
+  if (channel == 0)
+    {
+      return;
+    }
+  uint32_t nodeId = device->GetNode ()->GetId ();
+  NetDeviceContainer netDeviceContainer;
+  GetAdjacentNetDevices (device, channel, netDeviceContainer);
+
+  // a tree which does not go from the node to one of these neighbors does
+  // not use the links of the device, and is still valid
+  uint32_t dropped = 0;
+  for (std::vector<std::vector<uint32_t> >::iterator i = m_trees.begin (); i != m_trees.end (); i++)
+    {
+      std::vector<uint32_t> &tree = *i;
+      for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+        {
+          uint32_t remoteId = (*iter)->GetNode ()->GetId ();
+          if (remoteId < tree.size () && tree[remoteId] == nodeId)
+            {
+              tree.clear ();
+              dropped++;
+              break;
+            }
+        }
+    }
+  NS_LOG_LOGIC ("Dropped " << dropped << " trees using the links of node " << nodeId);
+}
+
+void
+NixVectorTopology::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_version++;
+  m_graphDirty = true;
+  m_nNodes = 0;
+  m_bfsOffsets.clear ();
+  m_bfsNeighbors.clear ();
+  m_nixOffsets.clear ();
+  m_nixNeighbors.clear ();
+  m_trees.clear ();
+}
+
+bool
+NixVectorTopology::BuildNixVector (Ptr<Node> source, Ptr<Node> dest, Ptr<NetDevice> oif, Ptr<NixVector> nixVector)
+{
+  NS_LOG_FUNCTION (this << source->GetId () << dest->GetId () << oif);
+
+  Update ();
+
+  uint32_t sourceId = source->GetId ();
+  uint32_t destId = dest->GetId ();
+  NS_ASSERT (sourceId < m_nNodes && destId < m_nNodes);
+
+  if (!oif)
+    {
+      std::vector<uint32_t> &tree = m_trees[sourceId];
+      if (tree.empty ())
+        {
+          NS_LOG_LOGIC ("Computing the tree of Node " << sourceId);
+          ComputeTree (sourceId,
+                       m_bfsNeighbors.data () + m_bfsOffsets[sourceId],
+                       m_bfsNeighbors.data () + m_bfsOffsets[sourceId + 1],
+                       tree);
+        }
+      return BuildNixVector (tree, sourceId, destId, nixVector);
+    }
+
+  // a specific output interface was given, so the source may only reach
+  // the neighbors of this interface: this tree is not shared
+  if (!IsUp (source, oif))
+    {
+      NS_LOG_LOGIC ("Output interface is down");
+      return false;
+    }
+  Ptr<Channel> channel = oif->GetChannel ();
+  if (channel == 0)
+    {
+      return false;
+    }
+  NetDeviceContainer netDeviceContainer;
+  GetAdjacentNetDevices (oif, channel, netDeviceContainer);
+  std::vector<uint32_t> neighbors;
+  for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+    {
+      neighbors.push_back ((*iter)->GetNode ()->GetId ());
+    }
+  std::vector<uint32_t> tree;
+  ComputeTree (sourceId, neighbors.data (), neighbors.data () + neighbors.size (), tree);
+  return BuildNixVector (tree, sourceId, destId, nixVector);
+}
+
+bool
+NixVectorTopology::IsUp (Ptr<Node> node, Ptr<NetDevice> device) const
+{
+  if (m_ipv6)
+    {
+      Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+      if (ipv6)
+        {
+          int32_t interfaceIndex = ipv6->GetInterfaceForDevice (device);
+          if (interfaceIndex < 0 || !ipv6->IsUp (interfaceIndex))
+            {
+              return false;
+            }
+        }
+    }
+  else
+    {
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      if (ipv4)
+        {
+          int32_t interfaceIndex = ipv4->GetInterfaceForDevice (device);
+          if (interfaceIndex < 0 || !ipv4->IsUp (interfaceIndex))
+            {
+              return false;
+            }
+        }
+    }
+  return device->IsLinkUp ();
+}
+
+void
+NixVectorTopology::Update (void)
+{
+  if (m_graphDirty || NodeList::GetNNodes () != m_nNodes)
+    {
+      BuildGraph ();
+    }
+
+  BooleanValue precompute;
+  g_nixPrecompute.GetValue (precompute);
+  if (precompute.Get ())
+    {
+      std::vector<uint32_t> sources;
+      for (uint32_t i = 0; i < m_nNodes; i++)
+        {
+          if (m_trees[i].empty ())
+            {
+              sources.push_back (i);
+            }
+        }
+      if (!sources.empty ())
+        {
+          ComputeTrees (sources);
+        }
+    }
+}
+
+void
+NixVectorTopology::BuildGraph (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t nNodes = NodeList::GetNNodes ();
+  if (nNodes != m_nNodes)
+    {
+      // the trees do not cover the new nodes
+      m_trees.clear ();
+      m_trees.resize (nNodes);
+      m_nNodes = nNodes;
+    }
+  m_bfsOffsets.assign (1, 0);
+  m_bfsNeighbors.clear ();
+  m_nixOffsets.assign (1, 0);
+  m_nixNeighbors.clear ();
+
+  for (uint32_t n = 0; n < nNodes; n++)
+    {
+      Ptr<Node> node = NodeList::GetNode (n);
+      for (uint32_t i = 0; i < node->GetNDevices (); i++)
+        {
+          Ptr<NetDevice> localNetDevice = node->GetDevice (i);
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          bool bfs = IsUp (node, localNetDevice);
+          bool nix = !localNetDevice->IsBridge ();
+          if (!bfs && !nix)
+            {
+              continue;
+            }
+
+          NetDeviceContainer netDeviceContainer;
+          GetAdjacentNetDevices (localNetDevice, channel, netDeviceContainer);
+          for (NetDeviceContainer::Iterator iter = netDeviceContainer.Begin (); iter != netDeviceContainer.End (); iter++)
+            {
+              uint32_t remoteId = (*iter)->GetNode ()->GetId ();
+              if (bfs)
+                {
+                  m_bfsNeighbors.push_back (remoteId);
+                }
+              if (nix)
+                {
+                  m_nixNeighbors.push_back (remoteId);
+                }
+            }
+        }
+      m_bfsOffsets.push_back (m_bfsNeighbors.size ());
+      m_nixOffsets.push_back (m_nixNeighbors.size ());
+    }
+  m_graphDirty = false;
+  NS_LOG_LOGIC ("Graph of " << nNodes << " nodes and " << m_bfsNeighbors.size () << " links up");
+}
+
+void
+NixVectorTopology::ComputeTree (uint32_t source, const uint32_t *first, const uint32_t *last,
+                                std::vector<uint32_t> &tree) const
+{
+  tree.assign (m_nNodes, NO_PARENT);
+  std::vector<uint32_t> greyNodeList;  // discovered nodes, unexplored from the head
+  greyNodeList.reserve (m_nNodes);
+
+  tree[source] = source;
+  greyNodeList.push_back (source);
+  for (std::size_t head = 0; head < greyNodeList.size (); head++)
+    {
+      uint32_t currNode = greyNodeList[head];
+      const uint32_t *begin = first;
+      const uint32_t *end = last;
+      if (currNode != source)
+        {
+          begin = m_bfsNeighbors.data () + m_bfsOffsets[currNode];
+          end = m_bfsNeighbors.data () + m_bfsOffsets[currNode + 1];
+        }
+      for (const uint32_t *remoteNode = begin; remoteNode != end; remoteNode++)
+        {
+          if (tree[*remoteNode] == NO_PARENT)
+            {
+              tree[*remoteNode] = currNode;
+              greyNodeList.push_back (*remoteNode);
+            }
+        }
+    }
+}
+
+void
+NixVectorTopology::ComputeTrees (const std::vector<uint32_t> &sources)
+{
+  NS_LOG_FUNCTION (this << sources.size ());
+#ifdef HAVE_PTHREAD_H
+  UintegerValue threads;
+  g_nixPrecomputeThreads.GetValue (threads);
+  uint32_t nThreads = threads.Get ();
+  if (nThreads == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = nProcessors > 0 ? nProcessors : 1;
+    }
+  nThreads = std::min<uint32_t> (nThreads, sources.size ());
+  if (nThreads > 1)
+    {
+      NS_LOG_LOGIC ("Computing " << sources.size () << " trees on " << nThreads << " threads");
+      SystemMutex mutex;
+      m_treeMutex = &mutex;
+      m_treeQueue = sources;
+      m_treeNext = 0;
+      std::vector<Ptr<SystemThread> > workers;
+      for (uint32_t i = 0; i < nThreads; i++)
+        {
+          workers.push_back (Create<SystemThread> (MakeCallback (&NixVectorTopology::TreeWorker, this)));
+          workers.back ()->Start ();
+        }
+      for (uint32_t i = 0; i < nThreads; i++)
+        {
+          workers[i]->Join ();
+        }
+      m_treeQueue.clear ();
+      m_treeMutex = 0;
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  for (std::vector<uint32_t>::const_iterator i = sources.begin (); i != sources.end (); i++)
+    {
+      ComputeTree (*i,
+                   m_bfsNeighbors.data () + m_bfsOffsets[*i],
+                   m_bfsNeighbors.data () + m_bfsOffsets[*i + 1],
+                   m_trees[*i]);
+    }
+}
+
+void
+NixVectorTopology::TreeWorker (void)
+{
+#ifdef HAVE_PTHREAD_H
+  for (;;)
+    {
+      uint32_t source;
+      {
+        CriticalSection cs (*m_treeMutex);
+        if (m_treeNext == m_treeQueue.size ())
+          {
+            return;
+          }
+        source = m_treeQueue[m_treeNext++];
+      }
+      ComputeTree (source,
+                   m_bfsNeighbors.data () + m_bfsOffsets[source],
+                   m_bfsNeighbors.data () + m_bfsOffsets[source + 1],
+                   m_trees[source]);
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+bool
+NixVectorTopology::BuildNixVector (const std::vector<uint32_t> &tree, uint32_t source, uint32_t dest,
+                                   Ptr<NixVector> nixVector) const
+{
+  NS_LOG_FUNCTION (this << source << dest);
+
+  if (tree[dest] == NO_PARENT)
+    {
+      return false;
+    }
+
+  // walk the path back from the destination, the index of the last hop
+  // is added first
+  for (uint32_t currNode = dest; currNode != source; currNode = tree[currNode])
+    {
+      uint32_t parentNode = tree[currNode];
+      uint32_t begin = m_nixOffsets[parentNode];
+      uint32_t totalNeighbors = m_nixOffsets[parentNode + 1] - begin;
+      uint32_t destId = 0;
+      for (uint32_t i = 0; i < totalNeighbors; i++)
+        {
+          if (m_nixNeighbors[begin + i] == currNode)
+            {
+              destId = i;
+            }
+        }
+      NS_LOG_LOGIC ("Adding Nix: " << destId << " with "
+                                   << nixVector->BitCount (totalNeighbors) << " bits, for node " << parentNode);
+      nixVector->AddNeighborIndex (destId, nixVector->BitCount (totalNeighbors));
+    }
+  return true;
+}
+
+void
+NixVectorTopology::GetAdjacentNetDevices (Ptr<NetDevice> netDevice, Ptr<Channel> channel, NetDeviceContainer & netDeviceContainer)
+{
+  NS_LOG_FUNCTION (netDevice << channel);
+
+  for (std::size_t i = 0; i < channel->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> remoteDevice = channel->GetDevice (i);
+      if (remoteDevice != netDevice)
+        {
+          Ptr<BridgeNetDevice> bd = NetDeviceIsBridged (remoteDevice);
+          // we have a bridged device, we need to add all
+          // bridged devices
+          if (bd)
+            {
+              NS_LOG_LOGIC ("Looking through bridge ports of bridge net device " << bd);
+              for (uint32_t j = 0; j < bd->GetNBridgePorts (); ++j)
+                {
+                  Ptr<NetDevice> ndBridged = bd->GetBridgePort (j);
+                  if (ndBridged == remoteDevice)
+                    {
+                      NS_LOG_LOGIC ("That bridge port is me, don't walk backward");
+                      continue;
+                    }
+                  Ptr<Channel> chBridged = ndBridged->GetChannel ();
+                  if (chBridged == 0)
+                    {
+                      continue;
+                    }
+                  GetAdjacentNetDevices (ndBridged, chBridged, netDeviceContainer);
+                }
+            }
+          else
+            {
+              netDeviceContainer.Add (channel->GetDevice (i));
+            }
+        }
+    }
+}
+
+Ptr<BridgeNetDevice>
+NixVectorTopology::NetDeviceIsBridged (Ptr<NetDevice> nd)
+{
+  NS_LOG_FUNCTION (nd);
+
+  Ptr<Node> node = nd->GetNode ();
+  uint32_t nDevices = node->GetNDevices ();
+
+  //
+  // There is no bit on a net device that says it is being bridged, so we have
+  // to look for bridges on the node to which the device is attached.  If we
+  // find a bridge, we need to look through its bridge ports (the devices it
+  // bridges) to see if we find the device in question.
+  //
+  for (uint32_t i = 0; i < nDevices; ++i)
+    {
+      Ptr<NetDevice> ndTest = node->GetDevice (i);
+      NS_LOG_LOGIC ("Examine device " << i << " " << ndTest);
+
+      if (ndTest->IsBridge ())
+        {
+          NS_LOG_LOGIC ("device " << i << " is a bridge net device");
+          Ptr<BridgeNetDevice> bnd = ndTest->GetObject<BridgeNetDevice> ();
+          NS_ABORT_MSG_UNLESS (bnd, "NixVectorTopology::NetDeviceIsBridged (): GetObject for <BridgeNetDevice> failed");
+
+          for (uint32_t j = 0; j < bnd->GetNBridgePorts (); ++j)
+            {
+              NS_LOG_LOGIC ("Examine bridge port " << j << " " << bnd->GetBridgePort (j));
+              if (bnd->GetBridgePort (j) == nd)
+                {
+                  NS_LOG_LOGIC ("Net device " << nd << " is bridged by " << bnd);
+                  return bnd;
+                }
+            }
+        }
+    }
+  NS_LOG_LOGIC ("Net device " << nd << " is not bridged");
+  return 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,383 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/socket.h"
+#include "ns3/socket-factory.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv6-nix-vector-helper.h"
+#include <sstream>
+
+using namespace ns3;
+
+// A ring of five routers with a host on r0 and a LAN shared by r2 and two
+// hosts.  The ring has an odd length, so that the shortest paths are
+// unique:
+//
+//         h0
+//         |
+//    +--- r0 ---+
+//    |          |
+//    r1         r4
+//    |          |
+//    r2 ------- r3
+//    |
+//  ==+===+===+== LAN
+//        |   |
+//        h1  h2
+//
+
+/**
+ * \ingroup nix-vector-routing
+ * \ingroup tests
+ *
+ * \brief Build the devices of the test topology.
+ * \param routers the five routers
+ * \param hosts the three hosts
+ * \param [out] r1r2 the devices of the r1 - r2 link
+ * \returns the device pairs of the point-to-point links, then the LAN devices
+ */
+static std::vector<NetDeviceContainer>
+BuildTestTopology (NodeContainer routers, NodeContainer hosts, NetDeviceContainer &r1r2)
+{
+  std::vector<NetDeviceContainer> links;
+  SimpleNetDeviceHelper devHelper;
+  devHelper.SetNetDevicePointToPointMode (true);
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      links.push_back (devHelper.Install (NodeContainer (routers.Get (i), routers.Get ((i + 1) % 5))));
+    }
+  r1r2 = links[1];
+  links.push_back (devHelper.Install (NodeContainer (hosts.Get (0), routers.Get (0))));
+  devHelper.SetNetDevicePointToPointMode (false);
+  links.push_back (devHelper.Install (NodeContainer (routers.Get (2), hosts.Get (1), hosts.Get (2))));
+  return links;
+}
+
+/**
+ * \ingroup nix-vector-routing
+ * \ingroup tests
+ *
+ * \brief IPv4 nix-vector routing test
+ *
+ * Checks that the precomputed trees give the same nix-vectors as the trees
+ * computed on demand, and that the packets follow the new shortest path
+ * after a link goes down, and the former one after it goes up again.
+ */
+class Ipv4NixVectorRoutingTestCase : public TestCase
+{
+public:
+  Ipv4NixVectorRoutingTestCase ();
+
+private:
+  /**
+   * \brief Build the topology.
+   * \param [out] nodes the routers then the hosts
+   * \param [out] r1r2 the devices of the r1 - r2 link
+   */
+  void Build (NodeContainer &nodes, NetDeviceContainer &r1r2);
+  /**
+   * \brief Route from every node to every address, and print the caches.
+   * \param nodes the nodes
+   * \returns the routing tables
+   */
+  std::string RouteAll (NodeContainer nodes);
+  /**
+   * \brief Send a packet.
+   * \param socket the sending socket
+   * \param to the destination address
+   */
+  void Send (Ptr<Socket> socket, Ipv4Address to);
+  /**
+   * \brief Receive the packets and record their TTL.
+   * \param socket the receiving socket
+   */
+  void Receive (Ptr<Socket> socket);
+  virtual void DoRun (void);
+
+  std::vector<uint32_t> m_ttls; //!< TTL of the received packets
+};
+
+Ipv4NixVectorRoutingTestCase::Ipv4NixVectorRoutingTestCase ()
+  : TestCase ("IPv4 nix-vector routing")
+{
+}
+
+void
+Ipv4NixVectorRoutingTestCase::Build (NodeContainer &nodes, NetDeviceContainer &r1r2)
+{
+  NodeContainer routers;
+  routers.Create (5);
+  NodeContainer hosts;
+  hosts.Create (3);
+  nodes = NodeContainer (routers, hosts);
+
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (Ipv4NixVectorHelper ());
+  internet.SetIpv6StackInstall (false);
+  internet.Install (nodes);
+
+  std::vector<NetDeviceContainer> links = BuildTestTopology (routers, hosts, r1r2);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.0.0", "255.255.255.252");
+  for (uint32_t i = 0; i + 1 < links.size (); i++)
+    {
+      ipv4.Assign (links[i]);
+      ipv4.NewNetwork ();
+    }
+  ipv4.SetBase ("10.3.0.0", "255.255.255.0");
+  ipv4.Assign (links.back ());
+}
+
+std::string
+Ipv4NixVectorRoutingTestCase::RouteAll (NodeContainer nodes)
+{
+  std::ostringstream oss;
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&oss);
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); i++)
+    {
+      Ptr<Ipv4> ipv4 = (*i)->GetObject<Ipv4> ();
+      for (NodeContainer::Iterator j = nodes.Begin (); j != nodes.End (); j++)
+        {
+          Ptr<Ipv4> destIpv4 = (*j)->GetObject<Ipv4> ();
+          for (uint32_t k = 1; k < destIpv4->GetNInterfaces (); k++)
+            {
+              Ipv4Header header;
+              header.SetDestination (destIpv4->GetAddress (k, 0).GetLocal ());
+              Socket::SocketErrno sockerr;
+              ipv4->GetRoutingProtocol ()->RouteOutput (Create<Packet> (), header, 0, sockerr);
+            }
+        }
+      ipv4->GetRoutingProtocol ()->PrintRoutingTable (stream);
+    }
+  return oss.str ();
+}
+
+void
+Ipv4NixVectorRoutingTestCase::Send (Ptr<Socket> socket, Ipv4Address to)
+{
+  socket->SendTo (Create<Packet> (100), 0, InetSocketAddress (to, 1234));
+}
+
+void
+Ipv4NixVectorRoutingTestCase::Receive (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      SocketIpTtlTag tag;
+      NS_TEST_EXPECT_MSG_EQ (packet->RemovePacketTag (tag), true, "No TTL tag");
+      m_ttls.push_back (tag.GetTtl ());
+    }
+}
+
+void
+Ipv4NixVectorRoutingTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  NetDeviceContainer r1r2;
+
+  // the trees computed on demand and precomputed give the same nix-vectors
+  Build (nodes, r1r2);
+  std::string onDemand = RouteAll (nodes);
+  Simulator::Destroy ();
+
+  Config::SetGlobal ("NixVectorPrecompute", BooleanValue (true));
+  Config::SetGlobal ("NixVectorPrecomputeThreads", UintegerValue (4));
+  Build (nodes, r1r2);
+  std::string precomputed = RouteAll (nodes);
+  NS_TEST_ASSERT_MSG_EQ (onDemand, precomputed, "Precomputed trees gave different nix-vectors");
+  NS_TEST_ASSERT_MSG_NE (onDemand.find ("10.3.0.1"), std::string::npos, "No route to the LAN");
+  Config::SetGlobal ("NixVectorPrecompute", BooleanValue (false));
+  Config::SetGlobal ("NixVectorPrecomputeThreads", UintegerValue (0));
+  Simulator::Destroy ();
+
+  // h0 sends to r2 before, while, and after the r1 - r2 link is down: the
+  // path goes through r1 (2 hops forwarded), then r4 and r3 (3 hops)
+  Build (nodes, r1r2);
+  Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (2), UdpSocketFactory::GetTypeId ());
+  sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 1234));
+  sink->SetIpRecvTtl (true);
+  sink->SetRecvCallback (MakeCallback (&Ipv4NixVectorRoutingTestCase::Receive, this));
+  Ptr<Socket> source = Socket::CreateSocket (nodes.Get (5), UdpSocketFactory::GetTypeId ());
+
+  Ipv4Address r2 ("10.3.0.1");
+  Ptr<Ipv4> ipv4r1 = nodes.Get (1)->GetObject<Ipv4> ();
+  uint32_t r1r2Interface = ipv4r1->GetInterfaceForDevice (r1r2.Get (0));
+  Simulator::Schedule (Seconds (1), &Ipv4NixVectorRoutingTestCase::Send, this, source, r2);
+  Simulator::Schedule (Seconds (2), &Ipv4::SetDown, ipv4r1, r1r2Interface);
+  Simulator::Schedule (Seconds (3), &Ipv4NixVectorRoutingTestCase::Send, this, source, r2);
+  Simulator::Schedule (Seconds (4), &Ipv4::SetUp, ipv4r1, r1r2Interface);
+  Simulator::Schedule (Seconds (5), &Ipv4NixVectorRoutingTestCase::Send, this, source, r2);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_ttls.size (), 3, "Packets lost");
+  NS_TEST_EXPECT_MSG_EQ (m_ttls[0], 62, "Wrong path before the link went down");
+  NS_TEST_EXPECT_MSG_EQ (m_ttls[1], 61, "Wrong path while the link was down");
+  NS_TEST_EXPECT_MSG_EQ (m_ttls[2], 62, "Wrong path after the link went up");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing
+ * \ingroup tests
+ *
+ * \brief IPv6 nix-vector routing test
+ *
+ * Checks that the packets follow the shortest path, with precomputed
+ * trees, before, while and after a link is down.
+ */
+class Ipv6NixVectorRoutingTestCase : public TestCase
+{
+public:
+  Ipv6NixVectorRoutingTestCase ();
+
+private:
+  /**
+   * \brief Send a packet.
+   * \param socket the sending socket
+   * \param to the destination address
+   */
+  void Send (Ptr<Socket> socket, Ipv6Address to);
+  /**
+   * \brief Receive the packets and record their hop limit.
+   * \param socket the receiving socket
+   */
+  void Receive (Ptr<Socket> socket);
+  virtual void DoRun (void);
+
+  std::vector<uint32_t> m_hopLimits; //!< Hop limit of the received packets
+};
+
+Ipv6NixVectorRoutingTestCase::Ipv6NixVectorRoutingTestCase ()
+  : TestCase ("IPv6 nix-vector routing")
+{
+}
+
+void
+Ipv6NixVectorRoutingTestCase::Send (Ptr<Socket> socket, Ipv6Address to)
+{
+  socket->SendTo (Create<Packet> (100), 0, Inet6SocketAddress (to, 1234));
+}
+
+void
+Ipv6NixVectorRoutingTestCase::Receive (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      SocketIpv6HopLimitTag tag;
+      NS_TEST_EXPECT_MSG_EQ (packet->RemovePacketTag (tag), true, "No hop limit tag");
+      m_hopLimits.push_back (tag.GetHopLimit ());
+    }
+}
+
+void
+Ipv6NixVectorRoutingTestCase::DoRun (void)
+{
+  Config::SetGlobal ("NixVectorPrecompute", BooleanValue (true));
+  Config::SetGlobal ("NixVectorPrecomputeThreads", UintegerValue (2));
+
+  NodeContainer routers;
+  routers.Create (5);
+  NodeContainer hosts;
+  hosts.Create (3);
+
+  InternetStackHelper internet;
+  internet.SetRoutingHelper (Ipv6NixVectorHelper ());
+  internet.SetIpv4StackInstall (false);
+  internet.Install (routers);
+  internet.Install (hosts);
+
+  NetDeviceContainer r1r2;
+  std::vector<NetDeviceContainer> links = BuildTestTopology (routers, hosts, r1r2);
+  Ipv6AddressHelper ipv6;
+  ipv6.SetBase (Ipv6Address ("2001:1::"), Ipv6Prefix (64));
+  for (uint32_t i = 0; i < links.size (); i++)
+    {
+      ipv6.Assign (links[i]);
+      ipv6.NewNetwork ();
+    }
+  for (uint32_t i = 0; i < routers.GetN (); i++)
+    {
+      Ptr<Ipv6> ipv6Router = routers.Get (i)->GetObject<Ipv6> ();
+      for (uint32_t j = 0; j < ipv6Router->GetNInterfaces (); j++)
+        {
+          ipv6Router->SetForwarding (j, true);
+        }
+    }
+
+  // h0 sends to h1 before, while, and after the r1 - r2 link is down: the
+  // path goes through r0, r1, r2 (3 hops forwarded), then r0, r4, r3, r2
+  Ptr<Socket> sink = Socket::CreateSocket (hosts.Get (1), UdpSocketFactory::GetTypeId ());
+  sink->Bind (Inet6SocketAddress (Ipv6Address::GetAny (), 1234));
+  sink->SetIpv6RecvHopLimit (true);
+  sink->SetRecvCallback (MakeCallback (&Ipv6NixVectorRoutingTestCase::Receive, this));
+  Ptr<Socket> source = Socket::CreateSocket (hosts.Get (0), UdpSocketFactory::GetTypeId ());
+
+  Ptr<Ipv6> ipv6h1 = hosts.Get (1)->GetObject<Ipv6> ();
+  Ipv6Address h1 = ipv6h1->GetAddress (1, 1).GetAddress ();
+  NS_TEST_ASSERT_MSG_EQ (h1.IsLinkLocal (), false, "Wrong address of h1");
+  Ptr<Ipv6> ipv6r1 = routers.Get (1)->GetObject<Ipv6> ();
+  uint32_t r1r2Interface = ipv6r1->GetInterfaceForDevice (r1r2.Get (0));
+  Simulator::Schedule (Seconds (2), &Ipv6NixVectorRoutingTestCase::Send, this, source, h1);
+  Simulator::Schedule (Seconds (3), &Ipv6::SetDown, ipv6r1, r1r2Interface);
+  Simulator::Schedule (Seconds (4), &Ipv6NixVectorRoutingTestCase::Send, this, source, h1);
+  Simulator::Schedule (Seconds (5), &Ipv6::SetUp, ipv6r1, r1r2Interface);
+  Simulator::Schedule (Seconds (7), &Ipv6NixVectorRoutingTestCase::Send, this, source, h1);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_hopLimits.size (), 3, "Packets lost");
+  NS_TEST_EXPECT_MSG_EQ (m_hopLimits[0], 61, "Wrong path before the link went down");
+  NS_TEST_EXPECT_MSG_EQ (m_hopLimits[1], 60, "Wrong path while the link was down");
+  NS_TEST_EXPECT_MSG_EQ (m_hopLimits[2], 61, "Wrong path after the link went up");
+
+  Config::SetGlobal ("NixVectorPrecompute", BooleanValue (false));
+  Config::SetGlobal ("NixVectorPrecomputeThreads", UintegerValue (0));
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing
+ * \ingroup tests
+ *
+ * \brief Nix-vector routing TestSuite
+ */
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ();
+};
+
+NixVectorRoutingTestSuite::NixVectorRoutingTestSuite ()
+  : TestSuite ("nix-vector-routing", UNIT)
+{
+  AddTestCase (new Ipv4NixVectorRoutingTestCase, TestCase::QUICK);
+  AddTestCase (new Ipv6NixVectorRoutingTestCase, TestCase::QUICK);
+}
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite; //!< Static variable for test initialization
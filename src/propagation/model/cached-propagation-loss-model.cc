@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cached-propagation-loss-model.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The chain of propagation loss models whose results are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationLossModel::SetModel,
+                                        &CachedPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("MaxSize",
+                   "The number of (source, destination) pairs beyond which the cache is cleared.",
+                   UintegerValue (1000000),
+                   MakeUintegerAccessor (&CachedPropagationLossModel::m_maxSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+  : PropagationLossModel ()
+{
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  m_model = 0;
+  m_cache.clear ();
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  m_model = model;
+  m_cache.clear ();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+void
+CachedPropagationLossModel::Clear (void)
+{
+  m_cache.clear ();
+}
+
+std::size_t
+CachedPropagationLossModel::GetN (void) const
+{
+  return m_cache.size ();
+}
+
+double
+CachedPropagationLossModel::Lookup (double txPowerDbm, Ptr<MobilityModel> a, const Vector &aPosition,
+                                    Ptr<MobilityModel> b) const
+{
+  Vector bPosition = b->GetPosition ();
+  Key key (PeekPointer (a), PeekPointer (b));
+  Cache::iterator it = m_cache.find (key);
+  if (it != m_cache.end ())
+    {
+      const Entry &entry = it->second;
+      if (entry.txPowerDbm == txPowerDbm
+          && entry.aPosition == aPosition
+          && entry.bPosition == bPosition)
+        {
+          return entry.rxPowerDbm;
+        }
+    }
+  double rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  if (it == m_cache.end ())
+    {
+      if (m_cache.size () >= m_maxSize)
+        {
+          NS_LOG_LOGIC ("cache full, cleared");
+          m_cache.clear ();
+        }
+      it = m_cache.insert (std::make_pair (key, Entry ())).first;
+    }
+  Entry &entry = it->second;
+  entry.aPosition = aPosition;
+  entry.bPosition = bPosition;
+  entry.txPowerDbm = txPowerDbm;
+  entry.rxPowerDbm = rxPowerDbm;
+  return rxPowerDbm;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "CachedPropagationLossModel: no model to cache");
+  if (!m_model->IsDeterministic ())
+    {
+      return m_model->CalcRxPower (txPowerDbm, a, b);
+    }
+  return Lookup (txPowerDbm, a, a->GetPosition (), b);
+}
+
+void
+CachedPropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                            const std::vector<Ptr<MobilityModel> > &b,
+                                            std::vector<double> &powerDbm) const
+{
+  NS_ASSERT_MSG (m_model != 0, "CachedPropagationLossModel: no model to cache");
+  if (!m_model->IsDeterministic ())
+    {
+      // not cached: the wrapped chain is evaluated for each destination
+      for (std::size_t i = 0; i < b.size (); ++i)
+        {
+          powerDbm[i] = m_model->CalcRxPower (powerDbm[i], a, b[i]);
+        }
+      return;
+    }
+  Vector aPosition = a->GetPosition ();
+  for (std::size_t i = 0; i < b.size (); ++i)
+    {
+      powerDbm[i] = Lookup (powerDbm[i], a, aPosition, b[i]);
+    }
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+bool
+CachedPropagationLossModel::DoIsDeterministic (void) const
+{
+  return m_model == 0 || m_model->IsDeterministic ();
+}
+
+} // namespace ns3
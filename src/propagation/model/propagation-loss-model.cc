@@ -82,6 +82,49 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPower (double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &rxPowerDbm) const
+{
+  rxPowerDbm.assign (b.size (), txPowerDbm);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowers (a, b, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                      const std::vector<Ptr<MobilityModel> > &b,
+                                      std::vector<double> &powerDbm) const
+{
+  for (std::size_t i = 0; i < b.size (); ++i)
+    {
+      powerDbm[i] = DoCalcRxPower (powerDbm[i], a, b[i]);
+    }
+}
+
+bool
+PropagationLossModel::IsDeterministic (void) const
+{
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      if (!model->DoIsDeterministic ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+PropagationLossModel::DoIsDeterministic (void) const
+{
+  return false;
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -271,12 +314,44 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm - std::max (lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                           const std::vector<Ptr<MobilityModel> > &b,
+                                           std::vector<double> &powerDbm) const
+{
+  // same computation as DoCalcRxPower, with the loop inside
+  Vector position = a->GetPosition ();
+  double numerator = m_lambda * m_lambda;
+  for (std::size_t i = 0; i < b.size (); ++i)
+    {
+      double distance = CalculateDistance (position, b[i]->GetPosition ());
+      if (distance < 3*m_lambda)
+        {
+          NS_LOG_WARN ("distance not within the far field region => inaccurate propagation loss value");
+        }
+      if (distance <= 0)
+        {
+          powerDbm[i] -= m_minLoss;
+          continue;
+        }
+      double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+      double lossDb = -10 * log10 (numerator / denominator);
+      powerDbm[i] -= std::max (lossDb, m_minLoss);
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+FriisPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -451,6 +526,12 @@ TwoRayGroundPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+TwoRayGroundPropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (LogDistancePropagationLossModel);
@@ -534,12 +615,39 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                                 const std::vector<Ptr<MobilityModel> > &b,
+                                                 std::vector<double> &powerDbm) const
+{
+  // same computation as DoCalcRxPower, with the loop inside
+  Vector position = a->GetPosition ();
+  for (std::size_t i = 0; i < b.size (); ++i)
+    {
+      double distance = CalculateDistance (position, b[i]->GetPosition ());
+      if (distance <= m_referenceDistance)
+        {
+          powerDbm[i] -= m_referenceLoss;
+          continue;
+        }
+      double pathLossDb = 10 * m_exponent * std::log10 (distance / m_referenceDistance);
+      double rxc = -m_referenceLoss - pathLossDb;
+      powerDbm[i] += rxc;
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
 {
   return 0;
 }
 
+bool
+LogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeLogDistancePropagationLossModel);
@@ -642,6 +750,12 @@ ThreeLogDistancePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (NakagamiPropagationLossModel);
@@ -804,6 +918,12 @@ FixedRssLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+FixedRssLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (MatrixPropagationLossModel);
@@ -930,6 +1050,12 @@ RangePropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+RangePropagationLossModel::DoIsDeterministic (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
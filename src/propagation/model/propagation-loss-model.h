@@ -28,6 +28,7 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -93,6 +94,33 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Powers of several destinations of a transmission, taking
+   * into account all the PropagationLossModel(s) chained to the current one.
+   *
+   * The powers are the same as those returned by CalcRxPower () for each
+   * destination in turn, but each model of the chain computes all the
+   * destinations in one loop, with the position of the source looked up
+   * once.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param rxPowerDbm the reception powers (in dBm), in the order of the
+   *        destinations
+   */
+  void CalcRxPower (double txPowerDbm,
+                    Ptr<MobilityModel> a,
+                    const std::vector<Ptr<MobilityModel> > &b,
+                    std::vector<double> &rxPowerDbm) const;
+
+  /**
+   * \returns true if this model and the models chained to it always
+   * return the same reception power for the same transmission power and
+   * positions, so that their results can be cached
+   */
+  bool IsDeterministic (void) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -134,12 +162,33 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Applies only the particular PropagationLossModel to the powers
+   * received by several destinations.  By default, DoCalcRxPower () is
+   * called for each destination.
+   *
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param powerDbm the powers (in dBm) before the loss of this model, and
+   *        after it on return
+   */
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               std::vector<double> &powerDbm) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
    */
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
 
+  /**
+   * \returns true if the particular PropagationLossModel always returns the
+   * same reception power for the same transmission power and positions.
+   * The default is false.
+   */
+  virtual bool DoIsDeterministic (void) const;
+
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -321,7 +370,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -442,6 +495,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    * Transforms a Dbm value to Watt
@@ -529,7 +583,11 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &b,
+                               std::vector<double> &powerDbm) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   /**
    *  Creates a default reference loss model
@@ -613,6 +671,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 
   double m_distance0; //!< Beginning of the first (near) distance field
   double m_distance1; //!< Beginning of the second (middle) distance field.
@@ -747,6 +806,7 @@ private:
                                 Ptr<MobilityModel> b) const;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
   double m_rss; //!< the received signal strength
 };
 
@@ -852,6 +912,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsDeterministic (void) const;
 private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
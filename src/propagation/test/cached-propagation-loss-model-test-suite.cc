@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/cached-propagation-loss-model.h"
+#include "ns3/okumura-hata-propagation-loss-model.h"
+#include "ns3/constant-position-mobility-model.h"
+
+using namespace ns3;
+
+/**
+ * \brief Deterministic loss model counting its computations.
+ */
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  CountingPropagationLossModel ()
+    : m_count (0)
+  {
+  }
+
+  mutable uint32_t m_count; //!< Number of computations
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const
+  {
+    ++m_count;
+    return txPowerDbm - a->GetDistanceFrom (b);
+  }
+  virtual int64_t DoAssignStreams (int64_t stream)
+  {
+    return 0;
+  }
+  virtual bool DoIsDeterministic (void) const
+  {
+    return true;
+  }
+};
+
+/**
+ * \brief Check that the batch CalcRxPower gives the same powers as
+ * CalcRxPower for each destination, for deterministic and random chains.
+ */
+class BatchCalcRxPowerTestCase : public TestCase
+{
+public:
+  BatchCalcRxPowerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param random whether to add a random model to the chain
+   * \returns a chain of loss models
+   */
+  Ptr<PropagationLossModel> CreateChain (bool random);
+};
+
+BatchCalcRxPowerTestCase::BatchCalcRxPowerTestCase ()
+  : TestCase ("Check the computation of the reception powers of several destinations at once")
+{
+}
+
+Ptr<PropagationLossModel>
+BatchCalcRxPowerTestCase::CreateChain (bool random)
+{
+  Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<PropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  Ptr<PropagationLossModel> okumura = CreateObject<OkumuraHataPropagationLossModel> ();
+  logDistance->SetNext (friis);
+  friis->SetNext (okumura);
+  if (random)
+    {
+      okumura->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+      Ptr<RandomPropagationLossModel> uniform = CreateObject<RandomPropagationLossModel> ();
+      uniform->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0|Max=10]"));
+      okumura->GetNext ()->SetNext (uniform);
+    }
+  logDistance->AssignStreams (5);
+  return logDistance;
+}
+
+void
+BatchCalcRxPowerTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 30));
+  std::vector<Ptr<MobilityModel> > b;
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      // the first destination is at the same position as the source
+      mobility->SetPosition (Vector (i * i * 7.5, i * 3.0, i ? 1.5 : 30));
+      b.push_back (mobility);
+    }
+
+  for (uint32_t random = 0; random < 2; ++random)
+    {
+      Ptr<PropagationLossModel> scalar = CreateChain (random);
+      Ptr<PropagationLossModel> batch = CreateChain (random);
+      NS_TEST_ASSERT_MSG_EQ (batch->IsDeterministic (), !random, "Wrong deterministic chain");
+      std::vector<double> rxPowerDbm;
+      batch->CalcRxPower (16, a, b, rxPowerDbm);
+      NS_TEST_ASSERT_MSG_EQ (rxPowerDbm.size (), b.size (), "Wrong number of powers");
+      for (uint32_t i = 0; i < b.size (); ++i)
+        {
+          NS_TEST_EXPECT_MSG_EQ (rxPowerDbm[i], scalar->CalcRxPower (16, a, b[i]),
+                                 "Different power for destination " << i << " of the " << (random ? "random" : "deterministic") << " chain");
+        }
+    }
+}
+
+/**
+ * \brief Check that the CachedPropagationLossModel computes the loss of a
+ * pair again only when the pair or the transmission power change, and that
+ * it does not cache random models.
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Check the cache of the reception powers")
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (10, 0, 0));
+  Ptr<MobilityModel> c = CreateObject<ConstantPositionMobilityModel> ();
+  c->SetPosition (Vector (0, 20, 0));
+
+  Ptr<CountingPropagationLossModel> counting = CreateObject<CountingPropagationLossModel> ();
+  Ptr<CachedPropagationLossModel> cache = CreateObject<CachedPropagationLossModel> ();
+  cache->SetModel (counting);
+  NS_TEST_ASSERT_MSG_EQ (cache->IsDeterministic (), true, "The cache of a deterministic model is deterministic");
+
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (10, a, b), 0, "Wrong power");
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (10, a, b), 0, "Wrong cached power");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 1, "The power of a pair must be cached");
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (10, b, a), 0, "Wrong power");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 2, "The pairs are directed");
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (20, a, b), 10, "Wrong power");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 3, "The power depends on the transmission power");
+
+  std::vector<Ptr<MobilityModel> > destinations;
+  destinations.push_back (b);
+  destinations.push_back (c);
+  std::vector<double> rxPowerDbm;
+  cache->CalcRxPower (20, a, destinations, rxPowerDbm);
+  NS_TEST_EXPECT_MSG_EQ (rxPowerDbm[0], 10, "Wrong cached power");
+  NS_TEST_EXPECT_MSG_EQ (rxPowerDbm[1], 0, "Wrong power");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 4, "Only the new pair must be computed");
+  NS_TEST_EXPECT_MSG_EQ (cache->GetN (), 3, "Wrong number of pairs");
+
+  b->SetPosition (Vector (5, 0, 0));
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (20, a, b), 15, "The power must follow the position");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 5, "The power must be computed again after a move");
+  NS_TEST_EXPECT_MSG_EQ (cache->CalcRxPower (20, a, b), 15, "Wrong cached power");
+  NS_TEST_EXPECT_MSG_EQ (counting->m_count, 5, "The power at the new position must be cached");
+
+  cache->SetAttribute ("MaxSize", UintegerValue (2));
+  cache->CalcRxPower (20, c, b);
+  NS_TEST_EXPECT_MSG_EQ (cache->GetN (), 1, "The full cache must be cleared");
+
+  // random models chained after the cache still draw a value every time
+  Ptr<RandomPropagationLossModel> random = CreateObject<RandomPropagationLossModel> ();
+  random->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0|Max=10]"));
+  cache->SetNext (random);
+  NS_TEST_ASSERT_MSG_EQ (cache->IsDeterministic (), false, "The chain is random");
+  NS_TEST_EXPECT_MSG_NE (cache->CalcRxPower (20, a, b), cache->CalcRxPower (20, a, b), "The random model must not be cached");
+
+  // random models wrapped by the cache are not cached
+  Ptr<CachedPropagationLossModel> randomCache = CreateObject<CachedPropagationLossModel> ();
+  Ptr<RandomPropagationLossModel> wrapped = CreateObject<RandomPropagationLossModel> ();
+  wrapped->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0|Max=10]"));
+  randomCache->SetModel (wrapped);
+  NS_TEST_EXPECT_MSG_NE (randomCache->CalcRxPower (20, a, b), randomCache->CalcRxPower (20, a, b), "The random model must not be cached");
+  NS_TEST_EXPECT_MSG_EQ (randomCache->GetN (), 0, "The random model must not be cached");
+}
+
+/**
+ * \brief CachedPropagationLossModel TestSuite
+ */
+class CachedPropagationLossModelTestSuite : public TestSuite
+{
+public:
+  CachedPropagationLossModelTestSuite ();
+};
+
+CachedPropagationLossModelTestSuite::CachedPropagationLossModelTestSuite ()
+  : TestSuite ("cached-propagation-loss-model", UNIT)
+{
+  AddTestCase (new BatchCalcRxPowerTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
+}
+
+static CachedPropagationLossModelTestSuite g_cachedPropagationLossModelTestSuite; //!< Static variable for test initialization
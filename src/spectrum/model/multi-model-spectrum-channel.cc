@@ -37,6 +37,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/antenna-model.h>
 #include <ns3/angles.h>
+#include <ns3/spatial-grid.h>
 #include "multi-model-spectrum-channel.h"
 
 namespace ns3 {
@@ -79,7 +80,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_maxRange (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +92,9 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_grid = 0;
+  m_gridPhys.clear ();
+  m_unlocatedPhys.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +105,15 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("MaxRange",
+                   "The distance in meters beyond which the receivers are neither "
+                   "given the transmissions nor their interference, without computing "
+                   "their propagation loss; 0 gives the transmissions to all the "
+                   "receivers.  It must be larger than the range of the loss models "
+                   "down to the power which the receivers can detect.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
@@ -109,6 +122,7 @@ void
 MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
+  m_grid = 0;
 
   Ptr<const SpectrumModel> rxSpectrumModel = phy->GetRxSpectrumModel ();
 
@@ -235,6 +249,12 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  if (m_maxRange > 0 && txMobility)
+    {
+      StartTxInRange (txParams, txMobility, txInfoIteratorerator);
+      return;
+    }
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -269,83 +289,175 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC ("copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
+              StartTxTo (txParams, txMobility, convertedTxPowerSpectrum, *rxPhyIterator);
+            }
+        }
 
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+    }
 
-              if (txMobility && receiverMobility)
-                {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
-                  // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
-                  // Pathloss trace
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if (pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
-                }
+}
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
-                {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
-                }
-              else
-                {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
-                }
+void
+MultiModelSpectrumChannel::StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                                      Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> rxPhy)
+{
+  NS_LOG_LOGIC ("copying signal parameters " << txParams);
+  Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+  Time delay = MicroSeconds (0);
+
+  Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility ();
+
+  if (txMobility && receiverMobility)
+    {
+      double txAntennaGain = 0;
+      double rxAntennaGain = 0;
+      double propagationGainDb = 0;
+      double pathLossDb = 0;
+      if (rxParams->txAntenna != 0)
+        {
+          Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+          txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = rxPhy->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+          rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      // Gain trace
+      m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+      // Pathloss trace
+      m_pathLossTrace (txParams->txPhy, rxPhy, pathLossDb);
+      if (pathLossDb > m_maxLossDb)
+        {
+          // beyond range
+          return;
+        }
+      double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+      *(rxParams->psd) *= pathGainLinear;
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+        }
+
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+        }
+    }
+
+  Ptr<NetDevice> netDev = rxPhy->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                      rxParams, rxPhy);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                           rxParams, rxPhy);
+    }
+}
+
+void
+MultiModelSpectrumChannel::BuildGrid (void)
+{
+  NS_LOG_FUNCTION (this << m_maxRange);
+  m_grid = Create<SpatialGrid> (m_maxRange);
+  m_gridPhys.clear ();
+  m_unlocatedPhys.clear ();
+  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+       ++rxInfoIterator)
+    {
+      for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin ();
+           rxPhyIterator != rxInfoIterator->second.m_rxPhys.end ();
+           ++rxPhyIterator)
+        {
+          uint32_t id = m_gridPhys.size ();
+          m_gridPhys.push_back (std::make_pair (*rxPhyIterator, rxInfoIterator->first));
+          Ptr<MobilityModel> mobility = (*rxPhyIterator)->GetMobility ();
+          if (mobility)
+            {
+              m_grid->Add (id, mobility);
+            }
+          else
+            {
+              m_unlocatedPhys.push_back (id);
             }
         }
+    }
+}
 
+void
+MultiModelSpectrumChannel::StartTxInRange (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                                           TxSpectrumModelInfoMap_t::const_iterator txInfoIterator)
+{
+  NS_LOG_FUNCTION (this << txParams);
+  if (m_grid == 0 || m_grid->GetCellSize () != m_maxRange)
+    {
+      BuildGrid ();
+    }
+  m_grid->GetNeighbors (txMobility->GetPosition (), m_maxRange, m_neighbors);
+  if (!m_unlocatedPhys.empty ())
+    {
+      m_neighbors.insert (m_neighbors.end (), m_unlocatedPhys.begin (), m_unlocatedPhys.end ());
+      std::sort (m_neighbors.begin (), m_neighbors.end ());
     }
 
+  // the ids follow the RX spectrum models, as the receivers of StartTx
+  SpectrumModelUid_t txSpectrumModelUid = txInfoIterator->first;
+  SpectrumModelUid_t convertedUid = txSpectrumModelUid;
+  Ptr<SpectrumValue> convertedTxPowerSpectrum = txParams->psd;
+  bool orthogonal = false;
+  for (std::vector<uint32_t>::const_iterator i = m_neighbors.begin (); i != m_neighbors.end (); ++i)
+    {
+      Ptr<SpectrumPhy> rxPhy = m_gridPhys[*i].first;
+      SpectrumModelUid_t rxSpectrumModelUid = m_gridPhys[*i].second;
+      if (rxPhy == txParams->txPhy)
+        {
+          continue;
+        }
+      if (rxSpectrumModelUid != convertedUid)
+        {
+          convertedUid = rxSpectrumModelUid;
+          orthogonal = false;
+          if (rxSpectrumModelUid == txSpectrumModelUid)
+            {
+              convertedTxPowerSpectrum = txParams->psd;
+            }
+          else
+            {
+              SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+              orthogonal = rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end ();
+              if (!orthogonal)
+                {
+                  convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+                }
+            }
+        }
+      if (!orthogonal)
+        {
+          StartTxTo (txParams, txMobility, convertedTxPowerSpectrum, rxPhy);
+        }
+    }
 }
 
 void
@@ -32,6 +32,7 @@
 
 namespace ns3 {
 
+class SpatialGrid;
 
 /**
  * \ingroup spectrum
@@ -102,6 +103,12 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * When the MaxRange attribute is set, the receivers farther from the
+ * transmitter are not looked at, and the Gain and PathLoss traces are not
+ * fired for them: the receivers are kept in a SpatialGrid of their
+ * positions, so that the cost of a transmission depends on the number of
+ * receivers in range rather than on the number of receivers on the channel.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -149,6 +156,34 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Compute the signal received by a receiver, and schedule its reception
+   * if the receiver is in range.
+   *
+   * \param txParams The parameters of the signal being transmitted.
+   * \param txMobility The mobility model of the transmitter.
+   * \param convertedTxPowerSpectrum The transmitted power spectral density,
+   *        converted to the SpectrumModel of the receiver.
+   * \param rxPhy The receiver.
+   */
+  void StartTxTo (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                  Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> rxPhy);
+
+  /**
+   * Schedule the receptions of the receivers in range of the transmitter.
+   *
+   * \param txParams The parameters of the signal being transmitted.
+   * \param txMobility The mobility model of the transmitter.
+   * \param txInfoIterator The converters of the TX SpectrumModel.
+   */
+  void StartTxInRange (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                       TxSpectrumModelInfoMap_t::const_iterator txInfoIterator);
+
+  /**
+   * Build the grid of the positions of the receivers.
+   */
+  void BuildGrid (void);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +204,34 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * Distance beyond which the receivers are not looked at, or 0.
+   */
+  double m_maxRange;
+
+  /**
+   * Positions of the receivers, if the range is limited.  It is built again
+   * after a receiver is added.
+   */
+  Ptr<SpatialGrid> m_grid;
+
+  /**
+   * The receivers, in the order of the RX spectrum models, and the uid of
+   * their models, indexed by their ids in the grid.
+   */
+  std::vector<std::pair<Ptr<SpectrumPhy>, SpectrumModelUid_t> > m_gridPhys;
+
+  /**
+   * Ids of the receivers without a mobility model, which are given all the
+   * transmissions.
+   */
+  std::vector<uint32_t> m_unlocatedPhys;
+
+  /**
+   * Ids of the receivers in range of a transmission.
+   */
+  std::vector<uint32_t> m_neighbors;
+
 };
 
 
@@ -38,6 +38,7 @@
 #include "ns3/vht-configuration.h"
 #include "ns3/he-configuration.h"
 #include "ns3/obss-pd-algorithm.h"
+#include "ns3/multi-user-scheduler.h"
 #include "ns3/wifi-ack-policy-selector.h"
 #include "wifi-helper.h"
 
@@ -708,6 +709,29 @@ WifiHelper::SetObssPdAlgorithm (std::string type,
   m_obssPdAlgorithm.Set (n7, v7);
 }
 
+void
+WifiHelper::SetMultiUserScheduler (std::string type,
+                                   std::string n0, const AttributeValue &v0,
+                                   std::string n1, const AttributeValue &v1,
+                                   std::string n2, const AttributeValue &v2,
+                                   std::string n3, const AttributeValue &v3,
+                                   std::string n4, const AttributeValue &v4,
+                                   std::string n5, const AttributeValue &v5,
+                                   std::string n6, const AttributeValue &v6,
+                                   std::string n7, const AttributeValue &v7)
+{
+  m_muScheduler = ObjectFactory ();
+  m_muScheduler.SetTypeId (type);
+  m_muScheduler.Set (n0, v0);
+  m_muScheduler.Set (n1, v1);
+  m_muScheduler.Set (n2, v2);
+  m_muScheduler.Set (n3, v3);
+  m_muScheduler.Set (n4, v4);
+  m_muScheduler.Set (n5, v5);
+  m_muScheduler.Set (n6, v6);
+  m_muScheduler.Set (n7, v7);
+}
+
 void
 WifiHelper::SetAckPolicySelectorForAc (AcIndex ac, std::string type,
                                        std::string n0, const AttributeValue &v0,
@@ -785,6 +809,13 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
           device->AggregateObject (obssPdAlgorithm);
           obssPdAlgorithm->ConnectWifiNetDevice (device);
         }
+      if ((m_standard >= WIFI_PHY_STANDARD_80211ax_2_4GHZ) && (m_muScheduler.IsTypeIdSet ())
+          && (DynamicCast<ApWifiMac> (mac) != 0))
+        {
+          Ptr<MultiUserScheduler> muScheduler = m_muScheduler.Create<MultiUserScheduler> ();
+          device->AggregateObject (muScheduler);
+          muScheduler->ConnectWifiNetDevice (device);
+        }
       devices.Add (device);
       NS_LOG_DEBUG ("node=" << node << ", mob=" << node->GetObject<MobilityModel> ());
       // Aggregate a NetDeviceQueueInterface object if a RegularWifiMac is installed
@@ -901,12 +932,14 @@ WifiHelper::EnableLogComponents (void)
   LogComponentEnable ("MinstrelWifiManager", LOG_LEVEL_ALL);
   LogComponentEnable ("MpduAggregator", LOG_LEVEL_ALL);
   LogComponentEnable ("MsduAggregator", LOG_LEVEL_ALL);
+  LogComponentEnable ("MultiUserScheduler", LOG_LEVEL_ALL);
   LogComponentEnable ("NistErrorRateModel", LOG_LEVEL_ALL);
   LogComponentEnable ("ObssPdAlgorithm", LOG_LEVEL_ALL);
   LogComponentEnable ("OnoeWifiManager", LOG_LEVEL_ALL);
   LogComponentEnable ("ParfWifiManager", LOG_LEVEL_ALL);
   LogComponentEnable ("RegularWifiMac", LOG_LEVEL_ALL);
   LogComponentEnable ("RraaWifiManager", LOG_LEVEL_ALL);
+  LogComponentEnable ("RrMultiUserScheduler", LOG_LEVEL_ALL);
   LogComponentEnable ("RrpaaWifiManager", LOG_LEVEL_ALL);
   LogComponentEnable ("SimpleFrameCaptureModel", LOG_LEVEL_ALL);
   LogComponentEnable ("SpectrumWifiPhy", LOG_LEVEL_ALL);
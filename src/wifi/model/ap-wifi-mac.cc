@@ -1615,6 +1615,12 @@ ApWifiMac::GetRifsMode (void) const
   return rifsMode;
 }
 
+const std::map<uint16_t, Mac48Address> &
+ApWifiMac::GetStaList (void) const
+{
+  return m_staList;
+}
+
 uint16_t
 ApWifiMac::GetNextAssociationId (void)
 {
@@ -110,6 +110,12 @@ public:
    */
   uint16_t GetVhtOperationalChannelWidth (void) const;
 
+  /**
+   * \return the map of the stations currently associated to the AP, indexed
+   *         by their association ID
+   */
+  const std::map<uint16_t, Mac48Address> & GetStaList (void) const;
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -21,13 +21,14 @@
 #ifndef BLOCK_ACK_MANAGER_H
 #define BLOCK_ACK_MANAGER_H
 
-#include <map>
+#include <unordered_map>
 #include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
 #include "wifi-mac-header.h"
 #include "originator-block-ack-agreement.h"
 #include "block-ack-type.h"
 #include "wifi-mac-queue-item.h"
+#include "qos-utils.h"
 
 namespace ns3 {
 
@@ -444,20 +445,23 @@ private:
    */
   typedef std::list<Ptr<WifiMacQueueItem>>::const_iterator PacketQueueCI;
   /**
-   * typedef for a map between MAC address and block ack agreement.
+   * typedef for a hash table between (MAC address, TID) and block ack agreement.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> > Agreements;
+  typedef std::unordered_map<WifiAddressTidPair,
+                             std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                             WifiAddressTidHash> Agreements;
   /**
    * typedef for an iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::iterator AgreementsI;
+  typedef std::unordered_map<WifiAddressTidPair,
+                             std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                             WifiAddressTidHash>::iterator AgreementsI;
   /**
    * typedef for a const iterator for Agreements.
    */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::const_iterator AgreementsCI;
+  typedef std::unordered_map<WifiAddressTidPair,
+                             std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                             WifiAddressTidHash>::const_iterator AgreementsCI;
 
   /**
    * \param mpdu the packet to insert in the retransmission queue
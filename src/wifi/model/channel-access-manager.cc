@@ -344,12 +344,18 @@ void
 ChannelAccessManager::DoGrantDcfAccess (void)
 {
   NS_LOG_FUNCTION (this);
+  Time accessGrantStart = GetAccessGrantStart ();
+  if (accessGrantStart > Simulator::Now ())
+    {
+      // no backoff can have expired while the medium is busy
+      return;
+    }
   uint32_t k = 0;
   for (Txops::iterator i = m_txops.begin (); i != m_txops.end (); k++)
     {
       Ptr<Txop> txop = *i;
       if (txop->IsAccessRequested ()
-          && GetBackoffEndFor (txop) <= Simulator::Now () )
+          && GetBackoffEndFor (txop, accessGrantStart) <= Simulator::Now () )
         {
           /**
            * This is the first Txop we find with an expired backoff and which
@@ -363,7 +369,7 @@ ChannelAccessManager::DoGrantDcfAccess (void)
             {
               Ptr<Txop> otherTxop = *j;
               if (otherTxop->IsAccessRequested ()
-                  && GetBackoffEndFor (otherTxop) <= Simulator::Now ())
+                  && GetBackoffEndFor (otherTxop, accessGrantStart) <= Simulator::Now ())
                 {
                   NS_LOG_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
                                 otherTxop->GetBackoffSlots ());
@@ -450,21 +456,21 @@ ChannelAccessManager::GetAccessGrantStart (bool ignoreNav) const
 }
 
 Time
-ChannelAccessManager::GetBackoffStartFor (Ptr<Txop> txop)
+ChannelAccessManager::GetBackoffStartFor (Ptr<Txop> txop, Time accessGrantStart) const
 {
-  NS_LOG_FUNCTION (this << txop);
+  NS_LOG_FUNCTION (this << txop << accessGrantStart);
   Time mostRecentEvent = MostRecent ({txop->GetBackoffStart (),
-                                     GetAccessGrantStart () + (txop->GetAifsn () * m_slot)});
+                                     accessGrantStart + (txop->GetAifsn () * m_slot)});
   NS_LOG_DEBUG ("Backoff start: " << mostRecentEvent.As (Time::US));
 
   return mostRecentEvent;
 }
 
 Time
-ChannelAccessManager::GetBackoffEndFor (Ptr<Txop> txop)
+ChannelAccessManager::GetBackoffEndFor (Ptr<Txop> txop, Time accessGrantStart) const
 {
-  NS_LOG_FUNCTION (this << txop);
-  Time backoffEnd = GetBackoffStartFor (txop) + (txop->GetBackoffSlots () * m_slot);
+  NS_LOG_FUNCTION (this << txop << accessGrantStart);
+  Time backoffEnd = GetBackoffStartFor (txop, accessGrantStart) + (txop->GetBackoffSlots () * m_slot);
   NS_LOG_DEBUG ("Backoff end: " << backoffEnd.As (Time::US));
 
   return backoffEnd;
@@ -474,10 +480,17 @@ void
 ChannelAccessManager::UpdateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
+  Time accessGrantStart = GetAccessGrantStart ();
+  if (accessGrantStart > Simulator::Now ())
+    {
+      // The medium is busy or within a SIFS/EIFS of its last busy period:
+      // the backoff slots were already accounted for when it became busy.
+      return;
+    }
   uint32_t k = 0;
   for (auto txop : m_txops)
     {
-      Time backoffStart = GetBackoffStartFor (txop);
+      Time backoffStart = GetBackoffStartFor (txop, accessGrantStart);
       if (backoffStart <= Simulator::Now ())
         {
           uint32_t nIntSlots = ((Simulator::Now () - backoffStart) / m_slot).GetHigh ();
@@ -515,11 +528,12 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
    */
   bool accessTimeoutNeeded = false;
   Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
+  Time accessGrantStart = GetAccessGrantStart ();
   for (auto txop : m_txops)
     {
       if (txop->IsAccessRequested ())
         {
-          Time tmp = GetBackoffEndFor (txop);
+          Time tmp = GetBackoffEndFor (txop, accessGrantStart);
           if (tmp > Simulator::Now ())
             {
               accessTimeoutNeeded = true;
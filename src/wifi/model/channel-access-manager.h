@@ -262,19 +262,22 @@ private:
    * started for the given Txop.
    *
    * \param txop the Txop
+   * \param accessGrantStart the time returned by GetAccessGrantStart (),
+   *        which callers iterating over the Txops compute only once
    *
    * \return the time when the backoff procedure started
    */
-  Time GetBackoffStartFor (Ptr<Txop> txop);
+  Time GetBackoffStartFor (Ptr<Txop> txop, Time accessGrantStart) const;
   /**
    * Return the time when the backoff procedure
    * ended (or will ended) for the given Txop.
    *
    * \param txop the Txop
+   * \param accessGrantStart the time returned by GetAccessGrantStart ()
    *
    * \return the time when the backoff procedure ended (or will ended)
    */
-  Time GetBackoffEndFor (Ptr<Txop> txop);
+  Time GetBackoffEndFor (Ptr<Txop> txop, Time accessGrantStart) const;
 
   void DoRestartAccessTimeoutIfNeeded (void);
 
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "he-ru.h"
+
+namespace ns3 {
+
+/// Number of RUs of each type (up to RU_996_TONE) in a 20, 40 and 80 MHz channel
+static const std::size_t N_RUS[3][6] =
+{
+  { 9, 4, 2, 1, 0, 0 },      // 20 MHz
+  { 18, 8, 4, 2, 1, 0 },     // 40 MHz
+  { 37, 16, 8, 4, 2, 1 }     // 80 MHz
+};
+
+std::size_t
+HeRu::GetNRus (uint16_t bw, RuType ruType)
+{
+  switch (bw)
+    {
+    case 20:
+    case 40:
+    case 80:
+      return (ruType == RU_2x996_TONE) ? 0 : N_RUS[bw / 40][ruType];
+    case 160:
+      return (ruType == RU_2x996_TONE) ? 1 : 2 * N_RUS[2][ruType];
+    default:
+      NS_ABORT_MSG ("Unsupported HE PPDU bandwidth: " << bw << " MHz");
+      return 0;
+    }
+}
+
+uint16_t
+HeRu::GetBandwidth (RuType ruType)
+{
+  switch (ruType)
+    {
+    case RU_26_TONE:
+      return 2;
+    case RU_52_TONE:
+      return 4;
+    case RU_106_TONE:
+      return 8;
+    case RU_242_TONE:
+      return 20;
+    case RU_484_TONE:
+      return 40;
+    case RU_996_TONE:
+      return 80;
+    case RU_2x996_TONE:
+      return 160;
+    default:
+      NS_ABORT_MSG ("RU type " << ruType << " not found");
+      return 0;
+    }
+}
+
+uint16_t
+HeRu::GetNDataSubcarriers (RuType ruType)
+{
+  switch (ruType)
+    {
+    case RU_26_TONE:
+      return 24;
+    case RU_52_TONE:
+      return 48;
+    case RU_106_TONE:
+      return 102;
+    case RU_242_TONE:
+      return 234;
+    case RU_484_TONE:
+      return 468;
+    case RU_996_TONE:
+      return 980;
+    case RU_2x996_TONE:
+      return 1960;
+    default:
+      NS_ABORT_MSG ("RU type " << ruType << " not found");
+      return 0;
+    }
+}
+
+HeRu::RuType
+HeRu::GetEqualSizedRusForStations (uint16_t bandwidth, std::size_t &nStations)
+{
+  NS_ASSERT (nStations > 0);
+  for (int type = RU_26_TONE; type <= RU_2x996_TONE; type++)
+    {
+      RuType ruType = static_cast<RuType> (type);
+      std::size_t nRus = GetNRus (bandwidth, ruType);
+      if (nRus > 0 && nRus <= nStations)
+        {
+          nStations = nRus;
+          return ruType;
+        }
+    }
+  NS_ABORT_MSG ("No RU found for " << nStations << " stations in " << bandwidth << " MHz");
+  return RU_26_TONE;
+}
+
+HeRu::RuSpec
+HeRu::GetRu (uint16_t bw, RuType ruType, std::size_t n)
+{
+  std::size_t nRus = GetNRus (bw, ruType);
+  NS_ASSERT (n < nRus);
+  RuSpec ru;
+  ru.ruType = ruType;
+  if (bw == 160 && ruType != RU_2x996_TONE && n >= nRus / 2)
+    {
+      ru.primary80MHz = false;
+      ru.index = n - nRus / 2 + 1;
+    }
+  else
+    {
+      ru.primary80MHz = true;
+      ru.index = n + 1;
+    }
+  return ru;
+}
+
+std::ostream& operator<< (std::ostream& os, HeRu::RuType ruType)
+{
+  switch (ruType)
+    {
+    case HeRu::RU_26_TONE:
+      return (os << "26-tones");
+    case HeRu::RU_52_TONE:
+      return (os << "52-tones");
+    case HeRu::RU_106_TONE:
+      return (os << "106-tones");
+    case HeRu::RU_242_TONE:
+      return (os << "242-tones");
+    case HeRu::RU_484_TONE:
+      return (os << "484-tones");
+    case HeRu::RU_996_TONE:
+      return (os << "996-tones");
+    case HeRu::RU_2x996_TONE:
+      return (os << "2x996-tones");
+    default:
+      NS_FATAL_ERROR ("Unknown RU type");
+    }
+  return os;
+}
+
+std::ostream& operator<< (std::ostream& os, const HeRu::RuSpec &ru)
+{
+  os << "RU{" << ru.ruType << "/" << ru.index << "/" << (ru.primary80MHz ? "primary80MHz" : "secondary80MHz") << "}";
+  return os;
+}
+
+} //namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HE_RU_H
+#define HE_RU_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * This class stores the HE resource units (RUs) of 802.11ax, i.e., the
+ * groups of subcarriers that an HE MU PPDU or an HE TB PPDU assigns to a
+ * station.
+ */
+class HeRu
+{
+public:
+  /**
+   * The different HE Resource Unit (RU) types.
+   */
+  enum RuType
+  {
+    RU_26_TONE = 0,
+    RU_52_TONE,
+    RU_106_TONE,
+    RU_242_TONE,
+    RU_484_TONE,
+    RU_996_TONE,
+    RU_2x996_TONE
+  };
+
+  /**
+   * RU Specification. Stores the information carried by the RU Allocation
+   * subfield of the User Info field of Trigger frames. Note that primary80MHz
+   * must be true if ruType is RU_2x996_TONE.
+   */
+  struct RuSpec
+  {
+    bool primary80MHz; //!< true if the RU is allocated in the primary 80 MHz channel
+    RuType ruType;     //!< the RU type
+    std::size_t index; //!< the RU index (starting at 1) within the 80 MHz channel
+  };
+
+  /**
+   * Get the number of distinct RUs of the given type (number of tones)
+   * available in a HE PPDU of the given bandwidth.
+   *
+   * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+   * \param ruType the RU type (number of tones)
+   * \return the number of distinct RUs available
+   */
+  static std::size_t GetNRus (uint16_t bw, RuType ruType);
+
+  /**
+   * Get the approximate bandwidth occupied by a RU.
+   *
+   * \param ruType the RU type
+   * \return the approximate bandwidth (in MHz) occupied by the RU
+   */
+  static uint16_t GetBandwidth (RuType ruType);
+
+  /**
+   * Get the number of data subcarriers of a RU.
+   *
+   * \param ruType the RU type
+   * \return the number of data subcarriers of the RU
+   */
+  static uint16_t GetNDataSubcarriers (RuType ruType);
+
+  /**
+   * Get the RU of the largest type such that a HE PPDU of the given bandwidth
+   * contains at most the given number of RUs of that type, so that every
+   * station gets a RU of the same size and no RU is left unused.  The number
+   * of stations is set to the number of RUs of the returned type, which may
+   * be less than requested.
+   *
+   * \param bandwidth the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+   * \param nStations the number of stations to serve (updated)
+   * \return the RU type
+   */
+  static RuType GetEqualSizedRusForStations (uint16_t bandwidth, std::size_t &nStations);
+
+  /**
+   * Get the given RU of a HE PPDU of the given bandwidth.  The RUs of a
+   * 160 MHz PPDU are numbered from the first RU of the primary 80 MHz
+   * channel to the last RU of the secondary 80 MHz channel.
+   *
+   * \param bw the bandwidth (MHz) of the HE PPDU
+   * \param ruType the RU type
+   * \param n the number (starting at 0) of the RU among the GetNRus (bw, ruType) RUs
+   * \return the RU specification
+   */
+  static RuSpec GetRu (uint16_t bw, RuType ruType, std::size_t n);
+};
+
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param os the stream
+ * \param ruType the RU type
+ * \returns a reference to the stream
+ */
+std::ostream& operator<< (std::ostream& os, HeRu::RuType ruType);
+
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param os the stream
+ * \param ru the RU
+ * \returns a reference to the stream
+ */
+std::ostream& operator<< (std::ostream& os, const HeRu::RuSpec &ru);
+
+} //namespace ns3
+
+#endif /* HE_RU_H */
@@ -19,6 +19,8 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <algorithm>
+#include <cmath>
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
@@ -130,6 +132,125 @@ InterferenceHelper::NiChange::GetEvent (void) const
   return m_event;
 }
 
+/****************************************************************
+ *       The NiChanges of a band, sorted by time
+ ****************************************************************/
+
+/// Compare the time of a NiChange with a moment
+struct NiChangeTimeLess
+{
+  /**
+   * \param change the NiChange
+   * \param moment the moment
+   * \return true if the change is before moment
+   */
+  template <typename Change>
+  bool operator() (const Change &change, Time moment) const
+  {
+    return change.first < moment;
+  }
+  /**
+   * \param moment the moment
+   * \param change the NiChange
+   * \return true if moment is before the change
+   */
+  template <typename Change>
+  bool operator() (Time moment, const Change &change) const
+  {
+    return moment < change.first;
+  }
+};
+
+InterferenceHelper::NiChangeList::NiChangeList ()
+  : m_first (0)
+{
+  m_changes.emplace_back (Time (0), NiChange (0.0, 0));
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChangeList::Begin (void)
+{
+  return m_changes.begin () + m_first;
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChangeList::Begin (void) const
+{
+  return m_changes.begin () + m_first;
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChangeList::End (void)
+{
+  return m_changes.end ();
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChangeList::End (void) const
+{
+  return m_changes.end ();
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChangeList::LowerBound (Time moment) const
+{
+  return std::lower_bound (Begin (), End (), moment, NiChangeTimeLess ());
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChangeList::UpperBound (Time moment) const
+{
+  return std::upper_bound (Begin (), End (), moment, NiChangeTimeLess ());
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::NiChangeList::GetPrevious (Time moment) const
+{
+  auto it = UpperBound (moment);
+  // This is safe since there is always an NiChange at time 0,
+  // before moment.
+  --it;
+  return it;
+}
+
+InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChangeList::Insert (Time moment, NiChange change)
+{
+  auto it = std::upper_bound (Begin (), End (), moment, NiChangeTimeLess ());
+  return m_changes.insert (it, std::make_pair (moment, change));
+}
+
+void
+InterferenceHelper::NiChangeList::EraseUntil (Time moment)
+{
+  std::size_t last = UpperBound (moment) - m_changes.begin ();
+  if (last <= m_first + 1)
+    {
+      return;
+    }
+  // The last change erased becomes the zero power change, and the
+  // events of the others are released
+  for (std::size_t i = m_first; i + 1 < last; i++)
+    {
+      m_changes[i].second = NiChange (0.0, 0);
+    }
+  m_first = last - 1;
+  m_changes[m_first] = std::make_pair (Time (0), NiChange (0.0, 0));
+  if (m_first >= m_changes.size () / 2)
+    {
+      m_changes.erase (m_changes.begin (), m_changes.begin () + m_first);
+      m_first = 0;
+    }
+}
+
+void
+InterferenceHelper::NiChangeList::Clear (void)
+{
+  m_changes.clear ();
+  m_first = 0;
+  m_changes.emplace_back (Time (0), NiChange (0.0, 0));
+}
+
 
 /****************************************************************
  *       The actual InterferenceHelper
@@ -139,10 +260,11 @@ InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
     m_firstPower (0),
-    m_rxing (false)
+    m_rxing (false),
+    m_niChangesVersion (0),
+    m_cachedVersion (0),
+    m_cachedEffectiveSnr (-1)
 {
-  // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
 }
 
 InterferenceHelper::~InterferenceHelper ()
@@ -195,13 +317,62 @@ InterferenceHelper::SetNumberOfReceiveAntennas (uint8_t rx)
   m_numRxAntennas = rx;
 }
 
+void
+InterferenceHelper::SetNumberOfSubBands (uint8_t nSubBands)
+{
+  m_subBandNiChanges.assign (nSubBands, NiChangeList ());
+}
+
+uint8_t
+InterferenceHelper::GetNumberOfSubBands (void) const
+{
+  return static_cast<uint8_t> (m_subBandNiChanges.size ());
+}
+
+void
+InterferenceHelper::AddSubBandPowers (Time duration, const std::vector<double> &rxPowersW)
+{
+  NS_LOG_FUNCTION (this << duration);
+  NS_ASSERT (rxPowersW.size () == m_subBandNiChanges.size ());
+  Time start = Simulator::Now ();
+  Time end = start + duration;
+  for (std::size_t band = 0; band < rxPowersW.size (); band++)
+    {
+      NiChangeList &niChanges = m_subBandNiChanges[band];
+      double previousPowerStart = niChanges.GetPrevious (start)->second.GetPower ();
+      double previousPowerEnd = niChanges.GetPrevious (end)->second.GetPower ();
+      // No reception is evaluated on the sub-bands: only the present matters
+      niChanges.EraseUntil (start);
+      auto it = niChanges.Insert (start, NiChange (previousPowerStart, 0));
+      std::size_t first = it - niChanges.Begin ();
+      auto last = niChanges.Insert (end, NiChange (previousPowerEnd, 0));
+      for (auto i = niChanges.Begin () + first; i != last; ++i)
+        {
+          i->second.AddPower (rxPowersW[band]);
+        }
+    }
+}
+
 Time
 InterferenceHelper::GetEnergyDuration (double energyW) const
+{
+  return GetEnergyDuration (m_niChanges, energyW);
+}
+
+Time
+InterferenceHelper::GetEnergyDuration (double energyW, uint8_t subBand) const
+{
+  NS_ASSERT (subBand < m_subBandNiChanges.size ());
+  return GetEnergyDuration (m_subBandNiChanges[subBand], energyW);
+}
+
+Time
+InterferenceHelper::GetEnergyDuration (const NiChangeList &niChanges, double energyW)
 {
   Time now = Simulator::Now ();
-  auto i = GetPreviousPosition (now);
+  auto i = niChanges.GetPrevious (now);
   Time end = i->first;
-  for (; i != m_niChanges.end (); ++i)
+  for (; i != niChanges.End (); ++i)
     {
       double noiseInterferenceW = i->second.GetPower ();
       end = i->first;
@@ -219,22 +390,24 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
   NS_LOG_FUNCTION (this);
   double previousPowerStart = 0;
   double previousPowerEnd = 0;
-  previousPowerStart = GetPreviousPosition (event->GetStartTime ())->second.GetPower ();
-  previousPowerEnd = GetPreviousPosition (event->GetEndTime ())->second.GetPower ();
+  previousPowerStart = m_niChanges.GetPrevious (event->GetStartTime ())->second.GetPower ();
+  previousPowerEnd = m_niChanges.GetPrevious (event->GetEndTime ())->second.GetPower ();
 
   if (!m_rxing)
     {
       m_firstPower = previousPowerStart;
       // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
-                         GetNextPosition (event->GetStartTime ()));
+      m_niChanges.EraseUntil (event->GetStartTime ());
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  // The insertions invalidate the iterators: keep an index
+  auto it = m_niChanges.Insert (event->GetStartTime (), NiChange (previousPowerStart, event));
+  std::size_t first = it - m_niChanges.Begin ();
+  auto last = m_niChanges.Insert (event->GetEndTime (), NiChange (previousPowerEnd, event));
+  for (auto i = m_niChanges.Begin () + first; i != last; ++i)
     {
       i->second.AddPower (event->GetRxPowerW ());
     }
+  m_niChangesVersion++;
 }
 
 double
@@ -253,26 +426,51 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event) const
 {
   double noiseInterferenceW = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->first < Simulator::Now (); ++it)
+  // The power before now is the one of the last change before now, if
+  // the changes of the event are still there
+  auto it = m_niChanges.LowerBound (event->GetStartTime ());
+  if (it != m_niChanges.End () && it->first == event->GetStartTime ())
     {
-      noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
-    }
-  it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it);
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
-  while (++it != m_niChanges.end () && it->second.GetEvent () != event)
-    {
-      ni->insert (*it);
+      auto next = m_niChanges.LowerBound (Simulator::Now ());
+      if (next != it)
+        {
+          noiseInterferenceW = (next - 1)->second.GetPower () - event->GetRxPowerW ();
+        }
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
   NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
   return noiseInterferenceW;
 }
 
+const InterferenceHelper::NiChanges &
+InterferenceHelper::GetEventNiChanges (Ptr<Event> event) const
+{
+  if (event == m_cachedEvent && m_cachedVersion == m_niChangesVersion)
+    {
+      return m_cachedNiChanges;
+    }
+  m_cachedEvent = event;
+  m_cachedVersion = m_niChangesVersion;
+  m_cachedNiChanges.clear ();
+  m_cachedEffectiveSnr = -1;
+  auto it = m_niChanges.LowerBound (event->GetStartTime ());
+  if (it != m_niChanges.End () && it->first != event->GetStartTime ())
+    {
+      // the changes of the event were erased
+      it = m_niChanges.End ();
+    }
+  for (; it != m_niChanges.End () && it->second.GetEvent () != event; ++it);
+  m_cachedNiChanges.emplace_back (event->GetStartTime (), NiChange (0, event));
+  while (it != m_niChanges.End () && ++it != m_niChanges.End () && it->second.GetEvent () != event)
+    {
+      m_cachedNiChanges.push_back (*it);
+    }
+  m_cachedNiChanges.emplace_back (event->GetEndTime (), NiChange (0, event));
+  return m_cachedNiChanges;
+}
+
 double
 InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const
 {
@@ -310,7 +508,66 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate (double snir, Time duration
 }
 
 double
-InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const
+InterferenceHelper::GetEesmBeta (WifiMode mode)
+{
+  uint16_t constellationSize = mode.GetConstellationSize ();
+  if (constellationSize <= 2)
+    {
+      return 1.0;
+    }
+  return 2.0 * (constellationSize - 1) / 3.0;
+}
+
+double
+InterferenceHelper::CalculateEffectiveSnr (Ptr<const Event> event, const NiChanges *ni) const
+{
+  NS_LOG_FUNCTION (this);
+  const WifiTxVector txVector = event->GetTxVector ();
+  double beta = GetEesmBeta (txVector.GetMode ());
+  double powerW = event->GetRxPowerW ();
+  Time payloadStart = event->GetStartTime () + WifiPhy::CalculatePhyPreambleAndHeaderDuration (txVector);
+  // The SNIRs and durations of the chunks of the payload
+  std::vector<std::pair<double, double> > chunks;
+  double minSnr = 0;
+  double noiseInterferenceW = m_firstPower;
+  auto j = ni->begin ();
+  Time previous = j->first;
+  while (++j != ni->end ())
+    {
+      Time current = j->first;
+      if (current > Max (previous, payloadStart))
+        {
+          double snr = CalculateSnr (powerW, noiseInterferenceW, txVector.GetChannelWidth ());
+          double duration = (current - Max (previous, payloadStart)).GetSeconds ();
+          if (chunks.empty () || snr < minSnr)
+            {
+              minSnr = snr;
+            }
+          chunks.emplace_back (snr, duration);
+        }
+      noiseInterferenceW = j->second.GetPower () - powerW;
+      previous = current;
+    }
+  if (chunks.size () <= 1)
+    {
+      return chunks.empty () ? CalculateSnr (powerW, noiseInterferenceW, txVector.GetChannelWidth ()) : minSnr;
+    }
+  // The exponentials are taken relative to the lowest SNIR, which dominates
+  // the sum, to avoid underflows
+  double sum = 0;
+  double totalDuration = 0;
+  for (const auto &chunk : chunks)
+    {
+      sum += chunk.second * std::exp (-(chunk.first - minSnr) / beta);
+      totalDuration += chunk.second;
+    }
+  double effectiveSnr = minSnr - beta * std::log (sum / totalDuration);
+  NS_LOG_DEBUG ("effective SNIR=" << RatioToDb (effectiveSnr) << "dB over " << chunks.size () << " chunks");
+  return effectiveSnr;
+}
+
+double
+InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, const NiChanges *ni, std::pair<Time, Time> window) const
 {
   NS_LOG_FUNCTION (this << window.first << window.second);
   const WifiTxVector txVector = event->GetTxVector ();
@@ -358,7 +615,7 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni,
 }
 
 double
-InterferenceHelper::CalculateNonHtPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNonHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
@@ -471,7 +728,7 @@ InterferenceHelper::CalculateNonHtPhyHeaderPer (Ptr<const Event> event, NiChange
 }
 
 double
-InterferenceHelper::CalculateHtPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
@@ -739,8 +996,7 @@ InterferenceHelper::CalculateHtPhyHeaderPer (Ptr<const Event> event, NiChanges *
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Time> relativeMpduStartStop) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -748,7 +1004,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
   /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
    * all SNIR changes in the SNIR vector.
    */
-  double per = CalculatePayloadPer (event, &ni, relativeMpduStartStop);
+  double per = CalculatePayloadPer (event, &GetEventNiChanges (event), relativeMpduStartStop);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -759,8 +1015,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
 double
 InterferenceHelper::CalculateSnr (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -770,8 +1025,7 @@ InterferenceHelper::CalculateSnr (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -779,7 +1033,7 @@ InterferenceHelper::CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the PHY header and accumulate
    * all SNIR changes in the SNIR vector.
    */
-  double per = CalculateNonHtPhyHeaderPer (event, &ni);
+  double per = CalculateNonHtPhyHeaderPer (event, &GetEventNiChanges (event));
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -790,8 +1044,7 @@ InterferenceHelper::CalculateNonHtPhyHeaderSnrPer (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculateHtPhyHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -799,7 +1052,7 @@ InterferenceHelper::CalculateHtPhyHeaderSnrPer (Ptr<Event> event) const
   /* calculate the SNIR at the start of the PHY header and accumulate
    * all SNIR changes in the SNIR vector.
    */
-  double per = CalculateHtPhyHeaderPer (event, &ni);
+  double per = CalculateHtPhyHeaderPer (event, &GetEventNiChanges (event));
   
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -807,36 +1060,34 @@ InterferenceHelper::CalculateHtPhyHeaderSnrPer (Ptr<Event> event) const
   return snrPer;
 }
 
+struct InterferenceHelper::SnrPer
+InterferenceHelper::CalculateEffectivePayloadSnrPer (Ptr<Event> event, Time duration) const
+{
+  const NiChanges &ni = GetEventNiChanges (event);
+  if (m_cachedEffectiveSnr < 0)
+    {
+      m_cachedEffectiveSnr = CalculateEffectiveSnr (event, &ni);
+    }
+  struct SnrPer snrPer;
+  snrPer.snr = m_cachedEffectiveSnr;
+  snrPer.per = 1 - CalculatePayloadChunkSuccessRate (m_cachedEffectiveSnr, duration, event->GetTxVector ());
+  return snrPer;
+}
+
 void
 InterferenceHelper::EraseEvents (void)
 {
-  m_niChanges.clear ();
-  // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
+  m_niChanges.Clear ();
+  for (auto &niChanges : m_subBandNiChanges)
+    {
+      niChanges.Clear ();
+    }
   m_rxing = false;
   m_firstPower = 0;
-}
-
-InterferenceHelper::NiChanges::const_iterator
-InterferenceHelper::GetNextPosition (Time moment) const
-{
-  return m_niChanges.upper_bound (moment);
-}
-
-InterferenceHelper::NiChanges::const_iterator
-InterferenceHelper::GetPreviousPosition (Time moment) const
-{
-  auto it = GetNextPosition (moment);
-  // This is safe since there is always an NiChange at time 0,
-  // before moment.
-  --it;
-  return it;
-}
-
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
-{
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
+  m_niChangesVersion++;
+  m_cachedEvent = 0;
+  m_cachedNiChanges.clear ();
+  m_cachedEffectiveSnr = -1;
 }
 
 void
@@ -852,7 +1103,7 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = GetPreviousPosition (Simulator::Now ());
+  auto it = m_niChanges.GetPrevious (Simulator::Now ());
   it--;
   m_firstPower = it->second.GetPower ();
 }
@@ -23,7 +23,7 @@
 
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
-#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -188,6 +188,34 @@ public:
    * \param rxPower received power (W)
    */
   void AddForeignSignal (Time duration, double rxPower);
+  /**
+   * Set the number of 20 MHz sub-bands whose energy is tracked, in
+   * addition to the energy over the whole channel.  The sub-bands are
+   * forgotten.
+   *
+   * \param nSubBands the number of 20 MHz sub-bands (0 to disable the tracking)
+   */
+  void SetNumberOfSubBands (uint8_t nSubBands);
+  /**
+   * \return the number of 20 MHz sub-bands whose energy is tracked
+   */
+  uint8_t GetNumberOfSubBands (void) const;
+  /**
+   * Add the powers received on each 20 MHz sub-band by a signal.
+   *
+   * \param duration the duration of the signal
+   * \param rxPowersW the power (W) received on each sub-band, from the lowest frequency
+   */
+  void AddSubBandPowers (Time duration, const std::vector<double> &rxPowersW);
+  /**
+   * \param energyW the minimum energy (W) requested
+   * \param subBand the index of the 20 MHz sub-band
+   *
+   * \returns the expected amount of time the observed
+   *          energy on the sub-band will be higher than
+   *          the requested threshold.
+   */
+  Time GetEnergyDuration (double energyW, uint8_t subBand) const;
   /**
    * Calculate the SNIR at the start of the payload and accumulate
    * all SNIR changes in the SNIR vector for each MPDU of an A-MPDU.
@@ -227,6 +255,19 @@ public:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculateHtPhyHeaderSnrPer (Ptr<Event> event) const;
+  /**
+   * Calculate the PER of a part of the payload from the effective SNIR of
+   * the whole payload, instead of accumulating the success rates of the
+   * SNIR changes within that part.  The effective SNIR maps the SNIR changes
+   * over the payload with the exponential effective SNIR mapping (EESM)
+   * and is computed once per event.
+   *
+   * \param event the event corresponding to the first time the corresponding PPDU arrives
+   * \param duration the duration of the part of the payload
+   *
+   * \return struct of effective SNR and PER
+   */
+  struct InterferenceHelper::SnrPer CalculateEffectivePayloadSnrPer (Ptr<Event> event, Time duration) const;
 
   /**
    * Notify that RX has started.
@@ -282,10 +323,75 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a vector of NiChanges sorted by time
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
+
+  /**
+   * The NiChanges of a band, sorted by time in a vector, which is appended
+   * to most of the time since the changes are added at or after the
+   * current time.  The first change is always a zero power change at time
+   * 0; the changes erased after it are only skipped, and are removed from
+   * the vector once they make up half of it.
+   */
+  class NiChangeList
+  {
+public:
+    NiChangeList ();
+    /**
+     * \return an iterator to the first change
+     */
+    NiChanges::iterator Begin (void);
+    /**
+     * \return an iterator to the first change
+     */
+    NiChanges::const_iterator Begin (void) const;
+    /**
+     * \return an iterator past the last change
+     */
+    NiChanges::iterator End (void);
+    /**
+     * \return an iterator past the last change
+     */
+    NiChanges::const_iterator End (void) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the first change not before moment
+     */
+    NiChanges::const_iterator LowerBound (Time moment) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the first change after moment
+     */
+    NiChanges::const_iterator UpperBound (Time moment) const;
+    /**
+     * \param moment time to check from
+     * \return an iterator to the last change not after moment
+     */
+    NiChanges::const_iterator GetPrevious (Time moment) const;
+    /**
+     * Add a change after the changes at the same time.
+     *
+     * \param moment the time of the change
+     * \param change the change
+     * \return the iterator of the new change
+     */
+    NiChanges::iterator Insert (Time moment, NiChange change);
+    /**
+     * Erase the changes until moment, but the first zero power change.
+     *
+     * \param moment the time of the last change to erase
+     */
+    void EraseUntil (Time moment);
+    /**
+     * Erase all the changes, but the first zero power change.
+     */
+    void Clear (void);
 
+private:
+    NiChanges m_changes; //!< the changes, the skipped ones included
+    std::size_t m_first; //!< index of the zero power change
+  };
   /**
    * Append the given Event.
    *
@@ -296,11 +402,28 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event the event
-   * \param ni the NiChanges
    *
    * \return noise and interference power
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event) const;
+  /**
+   * Return the NiChanges over the duration of an event, from its start to
+   * its end.  They are kept until the NiChanges are modified, for the
+   * next MPDUs of an A-MPDU.
+   *
+   * \param event the event
+   *
+   * \return the NiChanges of the event
+   */
+  const NiChanges & GetEventNiChanges (Ptr<Event> event) const;
+  /**
+   * \param niChanges the NiChanges of a band
+   * \param energyW the minimum energy (W) requested
+   *
+   * \returns the expected amount of time the energy of the band will be
+   *          higher than the requested threshold.
+   */
+  static Time GetEnergyDuration (const NiChangeList &niChanges, double energyW);
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    *
@@ -334,6 +457,27 @@ private:
    * \return the success rate
    */
   double CalculatePayloadChunkSuccessRate (double snir, Time duration, WifiTxVector txVector) const;
+  /**
+   * Map the SNIR changes over the payload of the event to a single SNIR,
+   * with the exponential effective SNIR mapping (EESM):
+   * -beta ln (sum_i d_i / D exp (-snir_i / beta)).
+   *
+   * \param event the event
+   * \param ni the NiChanges of the event
+   *
+   * \return the effective SNIR of the payload in linear scale
+   */
+  double CalculateEffectiveSnr (Ptr<const Event> event, const NiChanges *ni) const;
+  /**
+   * Return the EESM parameter of a mode, from the Chernoff bound of the
+   * symbol error rate of its constellation: 1 for BPSK, 2 (M - 1) / 3 for
+   * a square M-QAM.
+   *
+   * \param mode the Wi-Fi mode
+   *
+   * \return the EESM parameter
+   */
+  static double GetEesmBeta (WifiMode mode);
   /**
    * Calculate the error rate of the given PHY payload only in the provided time
    * window (thus enabling per MPDU PER information). The PHY payload can be divided into
@@ -345,7 +489,7 @@ private:
    *
    * \return the error rate of the payload
    */
-  double CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const;
+  double CalculatePayloadPer (Ptr<const Event> event, const NiChanges *ni, std::pair<Time, Time> window) const;
   /**
    * Calculate the error rate of the non-HT PHY header. The non-HT PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
@@ -355,7 +499,7 @@ private:
    *
    * \return the error rate of the non-HT PHY header
    */
-  double CalculateNonHtPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculateNonHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const;
   /**
    * Calculate the error rate of the HT PHY header. TheHT PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
@@ -365,47 +509,21 @@ private:
    *
    * \return the error rate of the HT PHY header
    */
-  double CalculateHtPhyHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculateHtPhyHeaderPer (Ptr<const Event> event, const NiChanges *ni) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
   uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
   /// Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
+  NiChangeList m_niChanges;
+  std::vector<NiChangeList> m_subBandNiChanges; ///< NiChanges of the 20 MHz sub-bands
   double m_firstPower; ///< first power in watts
   bool m_rxing; ///< flag whether it is in receiving state
-
-  /**
-   * Returns an iterator to the first NiChange that is later than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
-   */
-  NiChanges::const_iterator GetNextPosition (Time moment) const;
-  /**
-   * Returns an iterator to the first NiChange that is later than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
-   */
-  //NiChanges::iterator GetNextPosition (Time moment);
-  /**
-   * Returns an iterator to the last NiChange that is before than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
-   */
-  NiChanges::const_iterator GetPreviousPosition (Time moment) const;
-
-  /**
-   * Add NiChange to the list at the appropriate position and
-   * return the iterator of the new event.
-   *
-   * \param moment time to check from
-   * \param change the NiChange to add
-   * \returns the iterator of the new event
-   */
-  NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change);
+  uint64_t m_niChangesVersion; ///< incremented when the NiChanges are modified
+  mutable Ptr<Event> m_cachedEvent; ///< event whose NiChanges are cached
+  mutable uint64_t m_cachedVersion; ///< version of the NiChanges cached
+  mutable NiChanges m_cachedNiChanges; ///< NiChanges of the cached event
+  mutable double m_cachedEffectiveSnr; ///< effective SNIR of the cached event payload, negative if not computed
 };
 
 } //namespace ns3
@@ -127,8 +127,8 @@ MsduAggregator::GetNextAmsdu (Mac48Address recipient, uint8_t tid,
   while (peekedIt != queue->end ())
     {
       // check if aggregating the peeked MSDU violates the A-MSDU size limit
-      uint16_t newAmsduSize = GetSizeIfAggregated ((*peekedIt)->GetPacket ()->GetSize (),
-                                                   amsdu->GetPacket ()->GetSize ());
+      uint16_t newAmsduSize = GetSizeIfAggregated ((*peekedIt)->GetPacketSize (),
+                                                   amsdu->GetPacketSize ());
 
       if (newAmsduSize > maxAmsduSize)
         {
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "multi-user-scheduler.h"
+#include "ap-wifi-mac.h"
+#include "qos-txop.h"
+#include "wifi-net-device.h"
+#include "he-configuration.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultiUserScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (MultiUserScheduler);
+
+/// Number of bits of the SERVICE field and of the tail of a PSDU
+static const uint32_t SERVICE_AND_TAIL_BITS = 16 + 6;
+
+TypeId
+MultiUserScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultiUserScheduler")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+    .AddAttribute ("MaxPpduDuration",
+                   "The maximum duration of a frame exchange when the TXOP limit of the "
+                   "EDCA function that gained channel access is null.",
+                   TimeValue (MicroSeconds (5484)),
+                   MakeTimeAccessor (&MultiUserScheduler::m_maxPpduDuration),
+                   MakeTimeChecker ())
+    .AddTraceSource ("DlMuSchedule",
+                     "A DL MU PPDU has been scheduled.",
+                     MakeTraceSourceAccessor (&MultiUserScheduler::m_dlMuTrace),
+                     "ns3::MultiUserScheduler::MuInfoTracedCallback")
+    .AddTraceSource ("UlMuSchedule",
+                     "HE TB PPDUs have been solicited.",
+                     MakeTraceSourceAccessor (&MultiUserScheduler::m_ulMuTrace),
+                     "ns3::MultiUserScheduler::MuInfoTracedCallback")
+  ;
+  return tid;
+}
+
+MultiUserScheduler::MultiUserScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MultiUserScheduler::~MultiUserScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultiUserScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_apMac = 0;
+  m_edca = 0;
+  m_dlInfo.users.clear ();
+  m_ulInfo.users.clear ();
+  Object::DoDispose ();
+}
+
+void
+MultiUserScheduler::ConnectWifiNetDevice (const Ptr<WifiNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  m_apMac = DynamicCast<ApWifiMac> (device->GetMac ());
+  NS_ABORT_MSG_IF (m_apMac == 0, "A multi-user scheduler can only be installed on an AP");
+  NS_ABORT_MSG_IF (device->GetHeConfiguration () == 0, "A multi-user scheduler requires an HE AP");
+  for (AcIndex ac : {AC_BE, AC_BK, AC_VI, AC_VO})
+    {
+      m_apMac->GetQosTxop (ac)->SetMultiUserScheduler (this);
+    }
+}
+
+MultiUserScheduler::TxFormat
+MultiUserScheduler::NotifyAccessGranted (Ptr<QosTxop> edca)
+{
+  NS_LOG_FUNCTION (this << edca);
+  m_edca = edca;
+  m_availableTime = edca->GetTxopLimit ();
+  if (m_availableTime.IsZero ())
+    {
+      m_availableTime = m_maxPpduDuration;
+    }
+
+  TxFormat txFormat = SelectTxFormat ();
+  if (txFormat == DL_MU_TX)
+    {
+      m_dlInfo = ComputeDlMuInfo ();
+      m_dlMuTrace (m_dlInfo);
+    }
+  else if (txFormat == UL_MU_TX)
+    {
+      m_ulInfo = ComputeUlMuInfo ();
+      m_ulMuTrace (m_ulInfo);
+    }
+  NS_LOG_DEBUG ("Selected transmission format " << txFormat);
+  return txFormat;
+}
+
+const MultiUserScheduler::MuInfo &
+MultiUserScheduler::GetDlMuInfo (void) const
+{
+  return m_dlInfo;
+}
+
+const MultiUserScheduler::MuInfo &
+MultiUserScheduler::GetUlMuInfo (void) const
+{
+  return m_ulInfo;
+}
+
+/**
+ * \param txVector the TXVECTOR used in a RU
+ * \return the duration of an HE data symbol, including the guard interval, in nanoseconds
+ */
+static uint64_t
+GetSymbolDuration (const WifiTxVector &txVector)
+{
+  return 12800 + txVector.GetGuardInterval ();
+}
+
+/**
+ * \param txVector the TXVECTOR used in a RU
+ * \param ruType the type of the RU
+ * \return the number of data bits carried by an HE data symbol in the RU
+ */
+static double
+GetBitsPerSymbol (const WifiTxVector &txVector, HeRu::RuType ruType)
+{
+  // the data rate in 20 MHz is obtained with the 234 data subcarriers of a 242-tone RU
+  double rate = txVector.GetMode ().GetDataRate (20, txVector.GetGuardInterval (), txVector.GetNss ());
+  return rate * GetSymbolDuration (txVector) * 1e-9 * HeRu::GetNDataSubcarriers (ruType)
+         / HeRu::GetNDataSubcarriers (HeRu::RU_242_TONE);
+}
+
+Time
+MultiUserScheduler::GetPayloadDuration (uint32_t psduSize, const WifiTxVector &txVector, HeRu::RuType ruType)
+{
+  double nSymbols = std::ceil ((8.0 * psduSize + SERVICE_AND_TAIL_BITS) / GetBitsPerSymbol (txVector, ruType));
+  return NanoSeconds (static_cast<uint64_t> (nSymbols) * GetSymbolDuration (txVector));
+}
+
+uint32_t
+MultiUserScheduler::GetMaxPsduSize (Time duration, const WifiTxVector &txVector, HeRu::RuType ruType)
+{
+  if (!duration.IsStrictlyPositive ())
+    {
+      return 0;
+    }
+  uint64_t nSymbols = duration.GetNanoSeconds () / GetSymbolDuration (txVector);
+  double nBits = std::floor (nSymbols * GetBitsPerSymbol (txVector, ruType)) - SERVICE_AND_TAIL_BITS;
+  return (nBits > 0) ? static_cast<uint32_t> (nBits / 8) : 0;
+}
+
+} //namespace ns3
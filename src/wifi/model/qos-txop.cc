@@ -39,6 +39,7 @@
 #include "ctrl-headers.h"
 #include "wifi-phy.h"
 #include "wifi-ack-policy-selector.h"
+#include "multi-user-scheduler.h"
 #include "wifi-psdu.h"
 
 #undef NS_LOG_APPEND_CONTEXT
@@ -119,6 +120,7 @@ QosTxop::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_ackPolicySelector = 0;
+  m_muScheduler = 0;
   m_baManager = 0;
   m_qosBlockedDestinations = 0;
   Txop::DoDispose ();
@@ -190,6 +192,19 @@ QosTxop::GetAckPolicySelector (void) const
   return m_ackPolicySelector;
 }
 
+void
+QosTxop::SetMultiUserScheduler (Ptr<MultiUserScheduler> muScheduler)
+{
+  NS_LOG_FUNCTION (this << muScheduler);
+  m_muScheduler = muScheduler;
+}
+
+Ptr<MultiUserScheduler>
+QosTxop::GetMultiUserScheduler (void) const
+{
+  return m_muScheduler;
+}
+
 void
 QosTxop::SetTypeOfStation (TypeOfStation type)
 {
@@ -545,6 +560,13 @@ QosTxop::NotifyAccessGranted (void)
             {
               return;
             }
+          if (m_muScheduler != 0)
+            {
+              // HE MU and HE TB PPDUs are not modelled by MacLow and the PHY:
+              // the decisions of the scheduler are only reported through its
+              // trace sources and the frame is sent in an SU PPDU
+              m_muScheduler->NotifyAccessGranted (this);
+            }
 
           m_stationManager->UpdateFragmentationThreshold ();
           Ptr<WifiMacQueueItem> item;
@@ -1404,6 +1426,12 @@ QosTxop::SetAccessCategory (AcIndex ac)
   m_ac = ac;
 }
 
+AcIndex
+QosTxop::GetAccessCategory (void) const
+{
+  return m_ac;
+}
+
 Mac48Address
 QosTxop::MapSrcAddressForAggregation (const WifiMacHeader &hdr)
 {
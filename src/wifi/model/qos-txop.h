@@ -23,6 +23,7 @@
 #ifndef QOS_TXOP_H
 #define QOS_TXOP_H
 
+#include <unordered_map>
 #include "ns3/traced-value.h"
 #include "block-ack-manager.h"
 #include "txop.h"
@@ -40,6 +41,7 @@ class MgtDelBaHeader;
 class AggregationCapableTransmissionListener;
 class WifiTxVector;
 class WifiAckPolicySelector;
+class MultiUserScheduler;
 
 /**
  * Enumeration for type of station
@@ -99,7 +101,7 @@ public:
   /// allow HeAggregationTest class access
   friend class ::HeAggregationTest;
 
-  std::map<Mac48Address, bool> m_aMpduEnabled; //!< list containing flags whether A-MPDU is enabled for a given destination address
+  std::unordered_map<Mac48Address, bool, WifiAddressHash> m_aMpduEnabled; //!< list containing flags whether A-MPDU is enabled for a given destination address
 
   /**
    * \brief Get the type ID.
@@ -140,6 +142,19 @@ public:
    * \return the ack policy selector.
    */
   Ptr<WifiAckPolicySelector> GetAckPolicySelector (void) const;
+  /**
+   * Set the multi-user scheduler notified when this EDCAF of an AP gains
+   * channel access.
+   *
+   * \param muScheduler the multi-user scheduler.
+   */
+  void SetMultiUserScheduler (Ptr<MultiUserScheduler> muScheduler);
+  /**
+   * Return the multi-user scheduler.
+   *
+   * \return the multi-user scheduler.
+   */
+  Ptr<MultiUserScheduler> GetMultiUserScheduler (void) const;
   /**
    * Set type of station with the given type.
    *
@@ -240,6 +255,12 @@ public:
    * \param ac access category.
    */
   void SetAccessCategory (AcIndex ac);
+  /**
+   * Get the access category of this EDCAF.
+   *
+   * \return the access category.
+   */
+  AcIndex GetAccessCategory (void) const;
 
   /**
    * \param packet packet to send.
@@ -530,6 +551,7 @@ private:
   AcIndex m_ac;                                         //!< the access category
   TypeOfStation m_typeOfStation;                        //!< the type of station
   Ptr<WifiAckPolicySelector> m_ackPolicySelector;       //!< the ack policy selector
+  Ptr<MultiUserScheduler> m_muScheduler;                //!< the multi-user scheduler
   Ptr<QosBlockedDestinations> m_qosBlockedDestinations; //!< the QoS blocked destinations
   Ptr<BlockAckManager> m_baManager;                     //!< the block ack manager
   uint8_t m_blockAckThreshold;                          /**< the block ack threshold (use BA mechanism if number of packets in queue reaches
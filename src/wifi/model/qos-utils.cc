@@ -19,6 +19,7 @@
  *          Cecchi Niccolò <insa@igeek.it>
  */
 
+#include <functional>
 #include "ns3/socket.h"
 #include "ns3/queue-item.h"
 #include "qos-utils.h"
@@ -28,6 +29,26 @@
 
 namespace ns3 {
 
+std::size_t
+WifiAddressHash::operator() (const Mac48Address &address) const
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  // the low-order bytes, which differ between the stations, are the last ones
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      value = (value << 8) | buffer[i];
+    }
+  return std::hash<uint64_t> () (value);
+}
+
+std::size_t
+WifiAddressTidHash::operator() (const WifiAddressTidPair &addressTidPair) const
+{
+  return WifiAddressHash () (addressTidPair.first) * 8 + addressTidPair.second;
+}
+
 AcIndex
 QosUtilsMapTidToAc (uint8_t tid)
 {
@@ -21,7 +21,9 @@
 #ifndef QOS_UTILS_H
 #define QOS_UTILS_H
 
+#include <utility>
 #include "ns3/ptr.h"
+#include "ns3/mac48-address.h"
 
 namespace ns3 {
 
@@ -29,6 +31,40 @@ class Packet;
 class WifiMacHeader;
 class QueueItem;
 
+/**
+ * \ingroup wifi
+ * (MAC address, TID) pair, identifying the per-recipient state of a TID,
+ * such as a Block Ack agreement.
+ */
+typedef std::pair<Mac48Address, uint8_t> WifiAddressTidPair;
+
+/**
+ * \ingroup wifi
+ * Function object computing the hash of a MAC address, to index the state
+ * kept for each remote station in hash tables.
+ */
+struct WifiAddressHash
+{
+  /**
+   * \param address the MAC address
+   * \return the hash of the MAC address
+   */
+  std::size_t operator() (const Mac48Address &address) const;
+};
+
+/**
+ * \ingroup wifi
+ * Function object computing the hash of a (MAC address, TID) pair.
+ */
+struct WifiAddressTidHash
+{
+  /**
+   * \param addressTidPair the (MAC address, TID) pair
+   * \return the hash of the pair
+   */
+  std::size_t operator() (const WifiAddressTidPair &addressTidPair) const;
+};
+
 /**
  * \ingroup wifi
  * This enumeration defines the Access Categories as an enumeration
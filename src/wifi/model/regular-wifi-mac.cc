@@ -455,6 +455,14 @@ RegularWifiMac::GetTxop () const
   return m_txop;
 }
 
+Ptr<QosTxop>
+RegularWifiMac::GetQosTxop (AcIndex ac) const
+{
+  EdcaQueues::const_iterator it = m_edca.find (ac);
+  NS_ASSERT (it != m_edca.end ());
+  return it->second;
+}
+
 Ptr<QosTxop>
 RegularWifiMac::GetVOQueue () const
 {
@@ -138,6 +138,14 @@ public:
    * \return the station manager attached to this MAC.
    */
   Ptr<WifiRemoteStationManager> GetWifiRemoteStationManager (void) const;
+
+  /**
+   * Accessor for a given AC. The MAC must support QoS.
+   *
+   * \param ac the access category
+   * \return a smart pointer to the QosTxop of the given AC
+   */
+  Ptr<QosTxop> GetQosTxop (AcIndex ac) const;
   /**
    * Return the extended capabilities of the device.
    *
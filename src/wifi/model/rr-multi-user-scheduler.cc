@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "rr-multi-user-scheduler.h"
+#include "ap-wifi-mac.h"
+#include "qos-txop.h"
+#include "wifi-mac-queue.h"
+#include "wifi-phy.h"
+#include "wifi-remote-station-manager.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RrMultiUserScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RrMultiUserScheduler);
+
+TypeId
+RrMultiUserScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RrMultiUserScheduler")
+    .SetParent<MultiUserScheduler> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<RrMultiUserScheduler> ()
+    .AddAttribute ("NStations",
+                   "The maximum number of stations that can be granted an RU in a "
+                   "DL MU PPDU or in a Trigger frame.",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&RrMultiUserScheduler::m_nStations),
+                   MakeUintegerChecker<uint8_t> (1, 74))
+    .AddAttribute ("ForceDlOfdma",
+                   "If enabled, return DL_MU_TX even if a single station has data to receive.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RrMultiUserScheduler::m_forceDlOfdma),
+                   MakeBooleanChecker ())
+    .AddAttribute ("EnableUlOfdma",
+                   "If enabled, return UL_MU_TX every other channel access.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&RrMultiUserScheduler::m_enableUlOfdma),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UlPsduSize",
+                   "The size in bytes of the PSDU solicited from each station by a Trigger frame.",
+                   UintegerValue (500),
+                   MakeUintegerAccessor (&RrMultiUserScheduler::m_ulPsduSize),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+RrMultiUserScheduler::RrMultiUserScheduler ()
+  : m_lastTxFormat (NO_TX),
+    m_lastDlAid (0),
+    m_lastUlAid (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RrMultiUserScheduler::~RrMultiUserScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+RrMultiUserScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_dlCandidates.clear ();
+  m_ulCandidates.clear ();
+  MultiUserScheduler::DoDispose ();
+}
+
+MultiUserScheduler::TxFormat
+RrMultiUserScheduler::SelectTxFormat (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_enableUlOfdma && m_lastTxFormat == DL_MU_TX)
+    {
+      FindUlCandidates ();
+      if (!m_ulCandidates.empty ())
+        {
+          m_lastTxFormat = UL_MU_TX;
+          return m_lastTxFormat;
+        }
+    }
+
+  FindDlCandidates ();
+  if (m_dlCandidates.size () > 1 || (m_forceDlOfdma && !m_dlCandidates.empty ()))
+    {
+      m_lastTxFormat = DL_MU_TX;
+    }
+  else
+    {
+      m_lastTxFormat = SU_TX;
+    }
+  return m_lastTxFormat;
+}
+
+void
+RrMultiUserScheduler::FindDlCandidates (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_dlCandidates.clear ();
+  Ptr<WifiRemoteStationManager> stationManager = m_apMac->GetWifiRemoteStationManager ();
+  Ptr<WifiMacQueue> queue = m_edca->GetWifiMacQueue ();
+  AcIndex ac = m_edca->GetAccessCategory ();
+  if (queue->IsEmpty ())
+    {
+      return;
+    }
+
+  // the TIDs of the access category, the highest user priority first
+  std::vector<uint8_t> tids;
+  for (uint8_t tid = 8; tid-- > 0; )
+    {
+      if (QosUtilsMapTidToAc (tid) == ac)
+        {
+          tids.push_back (tid);
+        }
+    }
+
+  // visit each associated station at most once, starting after the last
+  // station served
+  const std::map<uint16_t, Mac48Address> &staList = m_apMac->GetStaList ();
+  std::map<uint16_t, Mac48Address>::const_iterator it = staList.upper_bound (m_lastDlAid);
+  for (std::size_t n = 0; n < staList.size () && m_dlCandidates.size () < m_nStations; n++, it++)
+    {
+      if (it == staList.end ())
+        {
+          it = staList.begin ();
+        }
+      if (!stationManager->GetHeSupported (it->second))
+        {
+          continue;
+        }
+      for (uint8_t tid : tids)
+        {
+          if (!m_edca->GetBaAgreementEstablished (it->second, tid))
+            {
+              continue;
+            }
+          WifiMacQueue::ConstIterator mpduIt = queue->PeekByTidAndAddress (tid, it->second);
+          if (mpduIt == queue->end ())
+            {
+              continue;
+            }
+          Candidate candidate;
+          candidate.aid = it->first;
+          candidate.address = it->second;
+          candidate.tid = tid;
+          candidate.mpdu = *mpduIt;
+          // the rate control algorithm is not consulted, so that the scan
+          // does not change the rates of the SU transmissions
+          candidate.txVector = stationManager->GetLastDataTxVector (it->second);
+          if (candidate.txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_HE)
+            {
+              m_dlCandidates.push_back (candidate);
+            }
+          break;
+        }
+    }
+  NS_LOG_DEBUG (m_dlCandidates.size () << " stations with data among " << staList.size ());
+}
+
+void
+RrMultiUserScheduler::FindUlCandidates (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ulCandidates.clear ();
+  Ptr<WifiRemoteStationManager> stationManager = m_apMac->GetWifiRemoteStationManager ();
+
+  const std::map<uint16_t, Mac48Address> &staList = m_apMac->GetStaList ();
+  std::map<uint16_t, Mac48Address>::const_iterator it = staList.upper_bound (m_lastUlAid);
+  for (std::size_t n = 0; n < staList.size () && m_ulCandidates.size () < m_nStations; n++, it++)
+    {
+      if (it == staList.end ())
+        {
+          it = staList.begin ();
+        }
+      if (!stationManager->IsAssociated (it->second) || !stationManager->GetHeSupported (it->second))
+        {
+          continue;
+        }
+      // the AP uses the TXVECTOR it last used to send data to the station
+      Candidate candidate;
+      candidate.aid = it->first;
+      candidate.address = it->second;
+      candidate.tid = 0;
+      candidate.txVector = stationManager->GetLastDataTxVector (it->second);
+      if (candidate.txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_HE)
+        {
+          m_ulCandidates.push_back (candidate);
+        }
+    }
+  NS_LOG_DEBUG (m_ulCandidates.size () << " stations to solicit among " << staList.size ());
+}
+
+HeRu::RuType
+RrMultiUserScheduler::AssignRus (const std::vector<Candidate> &candidates, MuInfo &info) const
+{
+  NS_LOG_FUNCTION (this << candidates.size ());
+  info.channelWidth = m_apMac->GetWifiPhy ()->GetChannelWidth ();
+  std::size_t nStations = candidates.size ();
+  HeRu::RuType ruType = HeRu::GetEqualSizedRusForStations (info.channelWidth, nStations);
+  info.users.clear ();
+  for (std::size_t i = 0; i < nStations; i++)
+    {
+      UserInfo user;
+      user.aid = candidates[i].aid;
+      user.address = candidates[i].address;
+      user.ru = HeRu::GetRu (info.channelWidth, ruType, i);
+      user.txVector = candidates[i].txVector;
+      user.txVector.SetChannelWidth (info.channelWidth);
+      user.tid = candidates[i].tid;
+      user.nMpdus = 0;
+      user.psduSize = 0;
+      info.users.push_back (user);
+    }
+  return ruType;
+}
+
+MultiUserScheduler::MuInfo
+RrMultiUserScheduler::ComputeDlMuInfo (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_dlCandidates.empty ());
+  MuInfo info;
+  HeRu::RuType ruType = AssignRus (m_dlCandidates, info);
+  Ptr<WifiMacQueue> queue = m_edca->GetWifiMacQueue ();
+
+  WifiTxVector muTxVector = info.users.front ().txVector;
+  muTxVector.SetPreambleType (WIFI_PREAMBLE_HE_MU);
+  Time preamble = WifiPhy::CalculatePhyPreambleAndHeaderDuration (muTxVector);
+  Time payload = Seconds (0);
+  for (std::size_t i = 0; i < info.users.size (); i++)
+    {
+      UserInfo &user = info.users[i];
+      user.txVector.SetPreambleType (WIFI_PREAMBLE_HE_MU);
+      // size of the first MPDU in an A-MPDU, with its delimiter and padding
+      uint32_t subframeSize = (m_dlCandidates[i].mpdu->GetSize () + 4 + 3) & ~3u;
+      uint32_t maxSize = GetMaxPsduSize (m_availableTime - preamble, user.txVector, ruType);
+      uint32_t nMpdus = std::min<uint32_t> (queue->GetNPacketsByTidAndAddress (user.tid, user.address),
+                                            m_edca->GetBaBufferSize (user.address, user.tid));
+      user.nMpdus = std::max<uint32_t> (1, std::min (nMpdus, maxSize / subframeSize));
+      user.psduSize = user.nMpdus * subframeSize;
+      payload = Max (payload, GetPayloadDuration (user.psduSize, user.txVector, ruType));
+    }
+  info.ppduDuration = preamble + payload;
+  m_lastDlAid = info.users.back ().aid;
+  NS_LOG_DEBUG ("DL MU PPDU to " << info.users.size () << " stations in " << ruType
+                << " RUs lasting " << info.ppduDuration.As (Time::US));
+  return info;
+}
+
+MultiUserScheduler::MuInfo
+RrMultiUserScheduler::ComputeUlMuInfo (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_ulCandidates.empty ());
+  MuInfo info;
+  HeRu::RuType ruType = AssignRus (m_ulCandidates, info);
+
+  // HE TB PPDUs have the preamble of HE SU PPDUs plus a longer HE-STF
+  WifiTxVector tbTxVector = info.users.front ().txVector;
+  tbTxVector.SetPreambleType (WIFI_PREAMBLE_HE_SU);
+  Time preamble = WifiPhy::CalculatePhyPreambleAndHeaderDuration (tbTxVector) + MicroSeconds (4);
+  Time payload = Seconds (0);
+  for (UserInfo &user : info.users)
+    {
+      user.txVector.SetPreambleType (WIFI_PREAMBLE_HE_TB);
+      user.psduSize = m_ulPsduSize;
+      payload = Max (payload, GetPayloadDuration (user.psduSize, user.txVector, ruType));
+    }
+  info.ppduDuration = preamble + payload;
+  m_lastUlAid = info.users.back ().aid;
+  NS_LOG_DEBUG ("Trigger frame soliciting " << info.users.size () << " stations in " << ruType
+                << " RUs for " << info.ppduDuration.As (Time::US));
+  return info;
+}
+
+} //namespace ns3
@@ -52,6 +52,11 @@ SpectrumWifiPhy::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&SpectrumWifiPhy::m_disableWifiReception),
                    MakeBooleanChecker ())
+    .AddAttribute ("TrackSubBands",
+                   "Track the energy received on each 20 MHz sub-band of a channel wider than 20 MHz.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SpectrumWifiPhy::m_trackSubBands),
+                   MakeBooleanChecker ())
     .AddTraceSource ("SignalArrival",
                      "Signal arrival",
                      MakeTraceSourceAccessor (&SpectrumWifiPhy::m_signalCb),
@@ -61,6 +66,7 @@ SpectrumWifiPhy::GetTypeId (void)
 }
 
 SpectrumWifiPhy::SpectrumWifiPhy ()
+  : m_trackSubBands (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -145,6 +151,52 @@ SpectrumWifiPhy::ResetSpectrumModel (void)
   m_channel->AddRx (m_wifiSpectrumPhyInterface);
 }
 
+void
+SpectrumWifiPhy::ResetSubBands (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint16_t channelWidth = GetChannelWidth ();
+  uint8_t nSubBands = (m_trackSubBands && channelWidth > 20) ? channelWidth / 20 : 0;
+  if (nSubBands != m_interference.GetNumberOfSubBands ())
+    {
+      m_interference.SetNumberOfSubBands (nSubBands);
+    }
+}
+
+std::vector<double>
+SpectrumWifiPhy::GetSubBandPowers (const SpectrumValue &filteredSignal) const
+{
+  uint8_t nSubBands = m_interference.GetNumberOfSubBands ();
+  std::vector<double> rxPowersW (nSubBands, 0.0);
+  // The RF filter passes the center-most bands; each sub-band gets the
+  // bands of its 20 MHz, the last one also gets the odd band of the filter
+  uint32_t bandBandwidth = GetBandBandwidth ();
+  std::size_t numBands = filteredSignal.GetSpectrumModel ()->GetNumBands ();
+  std::size_t numBandsInFilter = static_cast<std::size_t> (GetChannelWidth () * 1e6 / bandBandwidth) + 1;
+  std::size_t bandsPerSubBand = static_cast<std::size_t> (20e6 / bandBandwidth);
+  std::size_t startIndex = (numBands - numBandsInFilter) / 2;
+  Bands::const_iterator bit = filteredSignal.ConstBandsBegin () + startIndex;
+  Values::const_iterator vit = filteredSignal.ConstValuesBegin () + startIndex;
+  for (std::size_t i = 0; i < numBandsInFilter; i++, bit++, vit++)
+    {
+      std::size_t subBand = std::min<std::size_t> (i / bandsPerSubBand, nSubBands - 1);
+      rxPowersW[subBand] += (*vit) * (bit->fh - bit->fl);
+    }
+  double rxGain = DbToRatio (GetRxGain ());
+  for (double &rxPowerW : rxPowersW)
+    {
+      rxPowerW *= rxGain;
+    }
+  return rxPowersW;
+}
+
+Time
+SpectrumWifiPhy::GetSubBandEnergyDuration (uint8_t subBand) const
+{
+  NS_ABORT_MSG_IF (subBand >= m_interference.GetNumberOfSubBands (), "Sub-band " << +subBand << " is not tracked");
+  return m_interference.GetEnergyDuration (DbmToW (GetCcaEdThreshold ()), subBand);
+}
+
 void
 SpectrumWifiPhy::SetChannelNumber (uint8_t nch)
 {
@@ -225,6 +277,11 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
       NS_LOG_INFO ("Received signal too weak to process: " << WToDbm (rxPowerW) << " dBm");
       return;
     }
+  ResetSubBands ();
+  if (m_interference.GetNumberOfSubBands () > 0)
+    {
+      m_interference.AddSubBandPowers (rxDuration, GetSubBandPowers (filteredSignal));
+    }
   if (wifiRxParams == 0)
     {
       NS_LOG_INFO ("Received non Wi-Fi signal");
@@ -157,6 +157,17 @@ public:
   virtual void SetChannelWidth (uint16_t channelwidth);
   virtual void ConfigureStandard (WifiPhyStandard standard);
 
+  /**
+   * Return the amount of time the energy received on the given 20 MHz
+   * sub-band of the channel will stay above the CCA-ED threshold.  The
+   * energy of the sub-bands is only tracked if the TrackSubBands attribute
+   * is set and the channel is wider than 20 MHz.
+   *
+   * \param subBand the index of the 20 MHz sub-band, from the lowest frequency
+   * \return the time the sub-band will stay busy
+   */
+  Time GetSubBandEnergyDuration (uint8_t subBand) const;
+
 protected:
   // Inherited
   void DoDispose (void);
@@ -180,6 +191,17 @@ private:
    * Perform run-time spectrum model change
    */
   void ResetSpectrumModel (void);
+  /**
+   * Set the number of 20 MHz sub-bands tracked by the interference helper
+   * according to the TrackSubBands attribute and the channel width, if it
+   * changed since the last signal
+   */
+  void ResetSubBands (void);
+  /**
+   * \param filteredSignal the received PSD, filtered by the RF filter
+   * \return the power (W) received on each 20 MHz sub-band, from the lowest frequency
+   */
+  std::vector<double> GetSubBandPowers (const SpectrumValue &filteredSignal) const;
 
   Ptr<SpectrumChannel> m_channel;        //!< SpectrumChannel that this SpectrumWifiPhy is connected to
 
@@ -187,6 +209,7 @@ private:
   Ptr<AntennaModel> m_antenna;                              //!< antenna model
   mutable Ptr<const SpectrumModel> m_rxSpectrumModel;       //!< receive spectrum model
   bool m_disableWifiReception;                              //!< forces this PHY to fail to sync on any signal
+  bool m_trackSubBands;                                     //!< track the energy of each 20 MHz sub-band
   TracedCallback<bool, uint32_t, double, Time> m_signalCb;  //!< Signal callback
 
 };
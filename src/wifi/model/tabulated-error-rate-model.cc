@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "tabulated-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TabulatedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TabulatedErrorRateModel);
+
+/// Logarithm stored for a null success rate, whose exponential is zero
+static const double MIN_LOG_SUCCESS = -750.0;
+
+const uint32_t TabulatedErrorRateModel::N_LENGTHS;
+
+TypeId
+TabulatedErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TabulatedErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TabulatedErrorRateModel> ()
+    .AddAttribute ("ErrorRateModel",
+                   "The error rate model whose chunk success rates are tabulated. "
+                   "If not set, a NistErrorRateModel is used.",
+                   PointerValue (),
+                   MakePointerAccessor (&TabulatedErrorRateModel::SetErrorRateModel,
+                                        &TabulatedErrorRateModel::GetErrorRateModel),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr",
+                   "The first SNR (dB) of the grid. The grid must be set before the first table is used.",
+                   DoubleValue (-5.0),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_minSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The last SNR (dB) of the grid. The grid must be set before the first table is used.",
+                   DoubleValue (45.0),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_maxSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("SnrStep",
+                   "The step (dB) of the SNR grid. The grid must be set before the first table is used.",
+                   DoubleValue (0.02),
+                   MakeDoubleAccessor (&TabulatedErrorRateModel::m_snrStep),
+                   MakeDoubleChecker<double> (1e-6))
+  ;
+  return tid;
+}
+
+TabulatedErrorRateModel::TabulatedErrorRateModel ()
+  : m_nSnrs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TabulatedErrorRateModel::~TabulatedErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TabulatedErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_model = 0;
+  m_tables.reset ();
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TabulatedErrorRateModel::SetErrorRateModel (Ptr<ErrorRateModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_model = model;
+  m_tables.reset ();
+}
+
+Ptr<ErrorRateModel>
+TabulatedErrorRateModel::GetErrorRateModel (void) const
+{
+  if (m_model == 0)
+    {
+      const_cast<TabulatedErrorRateModel *> (this)->m_model = CreateObject<NistErrorRateModel> ();
+    }
+  return m_model;
+}
+
+uint32_t
+TabulatedErrorRateModel::GetNSnrs (void) const
+{
+  NS_ABORT_MSG_IF (m_maxSnr <= m_minSnr, "The SNR grid must not be empty");
+  return static_cast<uint32_t> (std::lround ((m_maxSnr - m_minSnr) / m_snrStep)) + 1;
+}
+
+std::shared_ptr<TabulatedErrorRateModel::Tables>
+TabulatedErrorRateModel::GetTables (void) const
+{
+  if (m_tables)
+    {
+      return m_tables;
+    }
+  // The models of the same type, with the same attribute values, have the
+  // same success rates: their tables are shared.
+  Ptr<ErrorRateModel> model = GetErrorRateModel ();
+  std::ostringstream key;
+  key.precision (17);
+  key << model->GetInstanceTypeId ().GetName () << " " << m_minSnr << " "
+      << m_maxSnr << " " << m_snrStep;
+  for (TypeId tid = model->GetInstanceTypeId (); ; tid = tid.GetParent ())
+    {
+      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          if (info.flags & TypeId::ATTR_GET)
+            {
+              Ptr<AttributeValue> value = info.checker->Create ();
+              model->GetAttribute (info.name, *value);
+              key << " " << info.name << "=" << value->SerializeToString (info.checker);
+            }
+        }
+      if (tid == tid.GetParent ())
+        {
+          break;
+        }
+    }
+  static std::map<std::string, std::shared_ptr<Tables> > shared;
+  std::shared_ptr<Tables> &tables = shared[key.str ()];
+  if (!tables)
+    {
+      tables = std::make_shared<Tables> ();
+    }
+  m_nSnrs = GetNSnrs ();
+  m_tables = tables;
+  return m_tables;
+}
+
+const TabulatedErrorRateModel::Table &
+TabulatedErrorRateModel::GetTable (WifiMode mode) const
+{
+  std::shared_ptr<Tables> tables = GetTables ();
+  Tables::const_iterator it = tables->find (mode.GetUid ());
+  if (it != tables->end ())
+    {
+      return it->second;
+    }
+  NS_LOG_DEBUG ("Generating the table of " << mode);
+  Ptr<ErrorRateModel> model = GetErrorRateModel ();
+  WifiTxVector txVector;
+  txVector.SetMode (mode);
+  Table &table = (*tables)[mode.GetUid ()];
+  table.mode = mode;
+  table.logSuccess.resize (m_nSnrs * N_LENGTHS);
+  for (uint32_t i = 0; i < m_nSnrs; i++)
+    {
+      double snr = std::pow (10.0, (m_minSnr + i * m_snrStep) / 10.0);
+      for (uint32_t k = 0; k < N_LENGTHS; k++)
+        {
+          double success = model->GetChunkSuccessRate (mode, txVector, snr, static_cast<uint64_t> (1) << k);
+          table.logSuccess[i * N_LENGTHS + k] = (success > 0) ? std::min (std::log (success), 0.0) : MIN_LOG_SUCCESS;
+        }
+    }
+  return table;
+}
+
+void
+TabulatedErrorRateModel::Generate (WifiMode mode)
+{
+  NS_LOG_FUNCTION (this << mode);
+  GetTable (mode);
+}
+
+void
+TabulatedErrorRateModel::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::shared_ptr<Tables> tables = GetTables ();
+  std::ofstream os (filename.c_str ());
+  NS_ABORT_MSG_IF (!os.is_open (), "Could not open " << filename);
+  os.precision (17);
+  os << m_minSnr << " " << m_snrStep << " " << m_nSnrs << " " << N_LENGTHS << std::endl;
+  for (Tables::const_iterator it = tables->begin (); it != tables->end (); it++)
+    {
+      os << it->second.mode.GetUniqueName ();
+      for (double value : it->second.logSuccess)
+        {
+          os << " " << value;
+        }
+      os << std::endl;
+    }
+}
+
+void
+TabulatedErrorRateModel::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::shared_ptr<Tables> tables = GetTables ();
+  std::ifstream is (filename.c_str ());
+  NS_ABORT_MSG_IF (!is.is_open (), "Could not open " << filename);
+  double minSnr;
+  double snrStep;
+  uint32_t nSnrs;
+  uint32_t nLengths;
+  is >> minSnr >> snrStep >> nSnrs >> nLengths;
+  NS_ABORT_MSG_IF (!is || std::abs (minSnr - m_minSnr) > 1e-9 || std::abs (snrStep - m_snrStep) > 1e-9
+                   || nSnrs != m_nSnrs || nLengths != N_LENGTHS,
+                   "The grid of " << filename << " is not the grid of the model");
+  std::string name;
+  while (is >> name)
+    {
+      Table table;
+      table.mode = WifiMode (name);
+      table.logSuccess.resize (m_nSnrs * N_LENGTHS);
+      for (double &value : table.logSuccess)
+        {
+          is >> value;
+        }
+      NS_ABORT_MSG_IF (!is, "Truncated table of " << name << " in " << filename);
+      (*tables)[table.mode.GetUid ()] = table;
+    }
+}
+
+double
+TabulatedErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << snr << nbits);
+  if (nbits == 0)
+    {
+      return 1.0;
+    }
+  const Table &table = GetTable (mode);
+  double x = (10.0 * std::log10 (snr) - m_minSnr) / m_snrStep;
+  // also catches the NaN of a negative SNR
+  if (!(x >= 0 && x <= m_nSnrs - 1))
+    {
+      return GetErrorRateModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  uint32_t i = std::min (static_cast<uint32_t> (x), m_nSnrs - 2);
+  double f = x - i;
+  // nbits is in [2^(exponent - 1), 2^exponent); the line through the last
+  // two lengths is extended beyond them
+  int exponent;
+  std::frexp (static_cast<double> (nbits), &exponent);
+  uint32_t k = std::min (static_cast<uint32_t> (exponent - 1), N_LENGTHS - 2);
+  double length = std::ldexp (1.0, k);
+  double g = (nbits - length) / length;
+  const double *low = &table.logSuccess[i * N_LENGTHS + k];
+  const double *high = low + N_LENGTHS;
+  double lowValue = low[0] + g * (low[1] - low[0]);
+  double highValue = high[0] + g * (high[1] - high[0]);
+  if (lowValue <= MIN_LOG_SUCCESS || highValue <= MIN_LOG_SUCCESS)
+    {
+      // the logarithm is singular where a success rate becomes null, as
+      // when the coded BER bound of the NIST model reaches 1
+      return (1 - f) * std::exp (lowValue) + f * std::exp (highValue);
+    }
+  return std::exp (std::min (lowValue + f * (highValue - lowValue), 0.0));
+}
+
+} //namespace ns3
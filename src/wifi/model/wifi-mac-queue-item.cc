@@ -39,6 +39,7 @@ WifiMacQueueItem::WifiMacQueueItem (Ptr<const Packet> p, const WifiMacHeader & h
 
 WifiMacQueueItem::WifiMacQueueItem (Ptr<const Packet> p, const WifiMacHeader & header, Time tstamp)
   : m_packet (p),
+    m_packetSize (p->GetSize ()),
     m_header (header),
     m_tstamp (tstamp)
 {
@@ -55,9 +56,34 @@ WifiMacQueueItem::~WifiMacQueueItem ()
 Ptr<const Packet>
 WifiMacQueueItem::GetPacket (void) const
 {
+  if (m_packet == 0)
+    {
+      // build the A-MSDU from its subframes
+      Ptr<Packet> amsdu = Create<Packet> ();
+      for (const auto& msdu : m_msduList)
+        {
+          // pad the previous A-MSDU subframe
+          uint8_t padding = MsduAggregator::CalculatePadding (amsdu->GetSize ());
+          if (amsdu->GetSize () > 0 && padding)
+            {
+              amsdu->AddAtEnd (Create<Packet> (padding));
+            }
+          Ptr<Packet> amsduSubframe = msdu.first->Copy ();
+          amsduSubframe->AddHeader (msdu.second);
+          amsdu->AddAtEnd (amsduSubframe);
+        }
+      NS_ASSERT (amsdu->GetSize () == m_packetSize);
+      m_packet = amsdu;
+    }
   return m_packet;
 }
 
+uint32_t
+WifiMacQueueItem::GetPacketSize (void) const
+{
+  return m_packetSize;
+}
+
 const WifiMacHeader&
 WifiMacQueueItem::GetHeader (void) const
 {
@@ -85,13 +111,13 @@ WifiMacQueueItem::GetTimeStamp (void) const
 uint32_t
 WifiMacQueueItem::GetSize (void) const
 {
-  return m_packet->GetSize () + m_header.GetSerializedSize () + WIFI_MAC_FCS_LENGTH;
+  return m_packetSize + m_header.GetSerializedSize () + WIFI_MAC_FCS_LENGTH;
 }
 
 Ptr<Packet>
 WifiMacQueueItem::GetProtocolDataUnit (void) const
 {
-  Ptr<Packet> mpdu = m_packet->Copy ();
+  Ptr<Packet> mpdu = GetPacket ()->Copy ();
   mpdu->AddHeader (m_header);
   AddWifiMacTrailer (mpdu);
   return mpdu;
@@ -109,7 +135,8 @@ WifiMacQueueItem::Aggregate (Ptr<const WifiMacQueueItem> msdu)
     {
       // An MSDU is going to be aggregated to this MPDU, hence this has to be an A-MSDU now
       Ptr<const WifiMacQueueItem> firstMsdu = Create<const WifiMacQueueItem> (*this);
-      m_packet = Create<Packet> ();
+      m_packet = 0;
+      m_packetSize = 0;
       DoAggregate (firstMsdu);
 
       m_header.SetQosAmsdu ();
@@ -157,26 +184,15 @@ WifiMacQueueItem::DoAggregate (Ptr<const WifiMacQueueItem> msdu)
 
   m_msduList.push_back ({msdu->GetPacket (), hdr});
 
-  // build the A-MSDU
-  NS_ASSERT (m_packet);
-  Ptr<Packet> amsdu = m_packet->Copy ();
-
-  // pad the previous A-MSDU subframe if the A-MSDU is not empty
-  if (m_packet->GetSize () > 0)
+  // the bytes of the A-MSDU are built by GetPacket, only when needed, to avoid
+  // copying the A-MSDU every time an MSDU is aggregated.  The previous A-MSDU
+  // subframe, if any, is padded
+  if (m_packetSize > 0)
     {
-      uint8_t padding = MsduAggregator::CalculatePadding (m_packet->GetSize ());
-
-      if (padding)
-        {
-          amsdu->AddAtEnd (Create<Packet> (padding));
-        }
+      m_packetSize += MsduAggregator::CalculatePadding (m_packetSize);
     }
-
-  // add A-MSDU subframe header and MSDU
-  Ptr<Packet> amsduSubframe = msdu->GetPacket ()->Copy ();
-  amsduSubframe->AddHeader (hdr);
-  amsdu->AddAtEnd (amsduSubframe);
-  m_packet = amsdu;
+  m_packetSize += hdr.GetSerializedSize () + msdu->GetPacketSize ();
+  m_packet = 0;
 
   /* "The expiration of the A-MSDU lifetime timer occurs only when the lifetime
     * timer of all of the constituent MSDUs of the A-MSDU have expired" (Section
@@ -202,7 +218,7 @@ WifiMacQueueItem::end (void)
 void
 WifiMacQueueItem::Print (std::ostream& os) const
 {
-  os << "size=" << m_packet->GetSize ()
+  os << "size=" << m_packetSize
      << ", to=" << m_header.GetAddr1 ()
      << ", seqN=" << m_header.GetSequenceNumber ()
      << ", lifetime=" << (Simulator::Now () - m_tstamp).GetMicroSeconds () << "us";
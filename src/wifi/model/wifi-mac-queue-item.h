@@ -61,11 +61,19 @@ public:
   virtual ~WifiMacQueueItem ();
 
   /**
-   * \brief Get the packet stored in this item
+   * \brief Get the packet stored in this item. The bytes of an A-MSDU are
+   *        only built from its MSDUs when this method is first called.
    * \return the packet stored in this item.
    */
   Ptr<const Packet> GetPacket (void) const;
 
+  /**
+   * \brief Get the size of the packet stored in this item, without building
+   *        the bytes of an A-MSDU
+   * \return the size of the packet stored in this item in bytes.
+   */
+  uint32_t GetPacketSize (void) const;
+
   /**
    * \brief Get the header stored in this item
    * \return the header stored in this item.
@@ -142,7 +150,8 @@ private:
    */
   void DoAggregate (Ptr<const WifiMacQueueItem> msdu);
 
-  Ptr<const Packet> m_packet;                   //!< The packet (MSDU or A-MSDU) contained in this queue item
+  mutable Ptr<const Packet> m_packet;           //!< The packet (MSDU or A-MSDU) contained in this queue item, null until an A-MSDU is built
+  uint32_t m_packetSize;                        //!< The size of the packet (MSDU or A-MSDU)
   WifiMacHeader m_header;                       //!< Wifi MAC header associated with the packet
   Time m_tstamp;                                //!< timestamp when the packet arrived at the queue
   MsduAggregator::DeaggregatedMsdus m_msduList; //!< The list of aggregated MSDUs included in this MPDU
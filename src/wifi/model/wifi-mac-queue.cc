@@ -62,7 +62,8 @@ WifiMacQueue::GetTypeId (void)
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_expiredPacketsPresent (false),
+  : m_oldest (Time::Max ()),
+    m_expiredPacketsPresent (false),
     NS_LOG_TEMPLATE_DEFINE ("WifiMacQueue")
 {
 }
@@ -104,6 +105,143 @@ WifiMacQueue::TtlExceeded (ConstIterator &it)
   return false;
 }
 
+void
+WifiMacQueue::RemoveExpired (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (Simulator::Now () - m_maxDelay <= m_oldest)
+    {
+      // no item may have expired
+      return;
+    }
+  Time oldest = Time::Max ();
+  for (ConstIterator it = begin (); it != end (); )
+    {
+      if (!TtlExceeded (it))
+        {
+          oldest = Min (oldest, (*it)->GetTimeStamp ());
+          it++;
+        }
+    }
+  m_oldest = oldest;
+}
+
+void
+WifiMacQueue::RemoveExpired (TidAddressQueue &queue)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (Simulator::Now () - m_maxDelay <= queue.oldest)
+    {
+      // no frame of the pair may have expired
+      return;
+    }
+  Time oldest = Time::Max ();
+  for (auto indexIt = queue.mpdus.begin (); indexIt != queue.mpdus.end (); )
+    {
+      // TtlExceeded removes the index entry of an expired frame
+      ConstIterator it = *indexIt++;
+      if (!TtlExceeded (it))
+        {
+          oldest = Min (oldest, (*it)->GetTimeStamp ());
+        }
+    }
+  queue.oldest = oldest;
+}
+
+bool
+WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  NS_LOG_FUNCTION (this << *item);
+
+  if (!Queue<WifiMacQueueItem>::DoEnqueue (pos, item))
+    {
+      return false;
+    }
+  m_oldest = Min (m_oldest, item->GetTimeStamp ());
+  if (item->GetHeader ().IsQosData ())
+    {
+      // the item has been inserted before the given position
+      AddToIndex (std::prev (pos));
+    }
+  return true;
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoDequeue (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromIndex (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoDequeue (pos);
+  if (QueueBase::GetNPackets () == 0)
+    {
+      m_oldest = Time::Max ();
+    }
+  return item;
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoRemove (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  RemoveFromIndex (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoRemove (pos);
+  if (QueueBase::GetNPackets () == 0)
+    {
+      m_oldest = Time::Max ();
+    }
+  return item;
+}
+
+void
+WifiMacQueue::AddToIndex (ConstIterator it)
+{
+  NS_LOG_FUNCTION (this);
+  const WifiMacHeader &hdr = (*it)->GetHeader ();
+  TidAddressQueue &queue = m_tidAddressQueues[{hdr.GetAddr1 (), hdr.GetQosTid ()}];
+  if (queue.mpdus.empty ())
+    {
+      queue.oldest = Time::Max ();
+    }
+  queue.oldest = Min (queue.oldest, (*it)->GetTimeStamp ());
+
+  std::list<ConstIterator>::iterator pos = queue.mpdus.end ();
+  if (!queue.mpdus.empty () && it == begin ())
+    {
+      pos = queue.mpdus.begin ();
+    }
+  else if (!queue.mpdus.empty () && std::next (it) != end ())
+    {
+      // the item has been inserted in the middle of the queue: it precedes
+      // the first following frame of the same pair, if any
+      for (ConstIterator next = std::next (it); next != end (); next++)
+        {
+          auto entryIt = m_indexEntries.find (GetPointer (*next));
+          if (entryIt != m_indexEntries.end () && entryIt->second.queue == &queue)
+            {
+              pos = entryIt->second.pos;
+              break;
+            }
+        }
+    }
+  NS_ASSERT_MSG (m_indexEntries.find (GetPointer (*it)) == m_indexEntries.end (), "Item queued twice");
+  m_indexEntries[GetPointer (*it)] = {&queue, queue.mpdus.insert (pos, it)};
+}
+
+void
+WifiMacQueue::RemoveFromIndex (ConstIterator it)
+{
+  NS_LOG_FUNCTION (this);
+  auto entryIt = m_indexEntries.find (GetPointer (*it));
+  if (entryIt == m_indexEntries.end ())
+    {
+      return;
+    }
+  entryIt->second.queue->mpdus.erase (entryIt->second.pos);
+  m_indexEntries.erase (entryIt);
+}
+
 bool
 WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
 {
@@ -342,25 +480,53 @@ WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << +tid << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
-  while (it != end ())
+  auto queueIt = m_tidAddressQueues.find ({dest, tid});
+  if (queueIt == m_tidAddressQueues.end () || queueIt->second.mpdus.empty ())
     {
-      // skip packets that stayed in the queue for too long. They will be
-      // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      NS_LOG_DEBUG ("The queue is empty");
+      return end ();
+    }
+  const TidAddressQueue &queue = queueIt->second;
+
+  std::list<ConstIterator>::const_iterator indexIt = queue.mpdus.begin ();
+  if (pos != EMPTY)
+    {
+      // look for the first frame of the pair starting from the given position.
+      // Callers usually pass the position of, or following, a frame of the pair
+      auto entryIt = (pos != end () ? m_indexEntries.find (GetPointer (*pos)) : m_indexEntries.end ());
+      auto prevIt = (pos != begin () ? m_indexEntries.find (GetPointer (*std::prev (pos))) : m_indexEntries.end ());
+      if (entryIt != m_indexEntries.end () && entryIt->second.queue == &queue)
+        {
+          indexIt = entryIt->second.pos;
+        }
+      else if (prevIt != m_indexEntries.end () && prevIt->second.queue == &queue)
+        {
+          indexIt = std::next (prevIt->second.pos);
+        }
+      else
         {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
+          while (pos != end () && (entryIt == m_indexEntries.end () || entryIt->second.queue != &queue))
             {
-              return it;
+              if (++pos != end ())
+                {
+                  entryIt = m_indexEntries.find (GetPointer (*pos));
+                }
             }
+          indexIt = (pos != end () ? entryIt->second.pos : queue.mpdus.end ());
         }
-      else
+    }
+
+  bool noneExpired = (Simulator::Now () - m_maxDelay <= queue.oldest);
+  for (; indexIt != queue.mpdus.end (); indexIt++)
+    {
+      // skip packets that stayed in the queue for too long. They will be
+      // actually removed from the queue by the next call to a non-const method
+      if (noneExpired || Simulator::Now () <= (**indexIt)->GetTimeStamp () + m_maxDelay)
         {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
+          return *indexIt;
         }
-      it++;
+      // signal the presence of expired packets
+      m_expiredPacketsPresent = true;
     }
   NS_LOG_DEBUG ("The queue is empty");
   return end ();
@@ -492,20 +658,15 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  for (ConstIterator it = begin (); it != end (); )
+  auto queueIt = m_tidAddressQueues.find ({dest, tid});
+  if (queueIt == m_tidAddressQueues.end ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
+      NS_LOG_DEBUG ("returns 0");
+      return 0;
     }
+  // remove the frames of the pair that stayed in the queue for too long
+  RemoveExpired (queueIt->second);
+  uint32_t nPackets = queueIt->second.mpdus.size ();
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
@@ -531,13 +692,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNPackets ();
 }
 
@@ -546,13 +701,7 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNBytes ();
 }
 
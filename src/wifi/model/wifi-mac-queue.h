@@ -24,7 +24,9 @@
 #ifndef WIFI_MAC_QUEUE_H
 #define WIFI_MAC_QUEUE_H
 
+#include <unordered_map>
 #include "wifi-mac-queue-item.h"
+#include "qos-utils.h"
 #include "ns3/queue.h"
 
 namespace ns3 {
@@ -53,6 +55,12 @@ extern template class Queue<WifiMacQueueItem>;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * The QoS data frames are also indexed by (receiver address, TID), so that
+ * the frames queued for a given recipient and TID can be peeked and counted
+ * without scanning the whole queue.  Each index, as well as the whole queue,
+ * keeps a lower bound of the timestamps of its frames, so that expired frames
+ * are only looked for when some of them may have expired.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -312,7 +320,74 @@ private:
    * \return true if the item is removed, false otherwise
    */
   bool TtlExceeded (ConstIterator &it);
+  /**
+   * Remove all the items whose lifetime expired, if any may have expired.
+   */
+  void RemoveExpired (void);
+
+  /// The QoS data frames queued for a (receiver address, TID) pair
+  struct TidAddressQueue
+  {
+    std::list<ConstIterator> mpdus;  //!< positions of the frames in the queue, in queue order
+    Time oldest;                     //!< lower bound of the timestamps of the frames
+  };
+  /// Position of a QoS data frame in the index of its (receiver address, TID) pair
+  struct IndexEntry
+  {
+    TidAddressQueue *queue;                 //!< the index of the pair
+    std::list<ConstIterator>::iterator pos; //!< the position in the index
+  };
+
+  /**
+   * Enqueue the given item before the given position and add it to the
+   * index of its (receiver address, TID) pair, if it is a QoS data frame.
+   *
+   * \param pos the position before which the item is to be inserted
+   * \param item the item to enqueue
+   * \return true if success, false if the packet has been dropped
+   */
+  bool DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item);
+  /**
+   * Dequeue the item at the given position and remove it from the index.
+   *
+   * \param pos the position of the item to dequeue
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> DoDequeue (ConstIterator pos);
+  /**
+   * Drop the item at the given position and remove it from the index.
+   *
+   * \param pos the position of the item to remove
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> DoRemove (ConstIterator pos);
+  /**
+   * Add the item at the given position, which must be a QoS data frame, to
+   * the index of its (receiver address, TID) pair.
+   *
+   * \param it the position of the item
+   */
+  void AddToIndex (ConstIterator it);
+  /**
+   * Remove the item at the given position from the index, if present.
+   *
+   * \param it the position of the item
+   */
+  void RemoveFromIndex (ConstIterator it);
+  /**
+   * Remove the frames of the given (receiver address, TID) pair whose lifetime
+   * expired, if any may have expired.
+   *
+   * \param queue the index of the pair
+   */
+  void RemoveExpired (TidAddressQueue &queue);
+
+  /// Index of the QoS data frames by (receiver address, TID)
+  typedef std::unordered_map<WifiAddressTidPair, TidAddressQueue, WifiAddressTidHash> TidAddressQueues;
 
+  TidAddressQueues m_tidAddressQueues;      //!< QoS data frames by (receiver address, TID)
+  std::unordered_map<const WifiMacQueueItem *, IndexEntry> m_indexEntries; //!< index entries of the queued QoS data frames
+  Time m_oldest;                            //!< lower bound of the timestamps of the queued items
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
   mutable bool m_expiredPacketsPresent;     //!< True if expired packets are in the queue
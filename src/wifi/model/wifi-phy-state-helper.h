@@ -165,11 +165,11 @@ public:
    * Switch state to TX for the given duration.
    *
    * \param txDuration the duration of the TX
-   * \param packet the packet
+   * \param psdu the PSDU being transmitted
    * \param txPowerDbm the nominal TX power in dBm
-   * \param txVector the TX vector of the packet
+   * \param txVector the TX vector of the PSDU
    */
-  void SwitchToTx (Time txDuration, Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector);
+  void SwitchToTx (Time txDuration, Ptr<const WifiPsdu> psdu, double txPowerDbm, WifiTxVector txVector);
   /**
    * Switch state to RX for the given duration.
    *
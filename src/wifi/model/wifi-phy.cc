@@ -324,6 +324,15 @@ WifiPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiPhy::m_postReceptionErrorModel),
                    MakePointerChecker<ErrorModel> ())
+    .AddAttribute ("AbstractReception",
+                   "If true, the preamble and PHY headers of a PPDU the PHY synchronizes "
+                   "on are decided at once, from the interference at the start of the PPDU, "
+                   "the PHY is in RX during the whole PPDU, whose end is the only scheduled "
+                   "event, and the MPDUs are decided from the effective SNR of the payload. "
+                   "Frame capture is not modelled.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WifiPhy::m_abstractReception),
+                   MakeBooleanChecker ())
     .AddTraceSource ("PhyTxBegin",
                      "Trace source indicating a packet "
                      "has begun transmitting over the channel medium",
@@ -405,7 +414,8 @@ WifiPhy::WifiPhy ()
     m_initialChannelNumber (0),
     m_currentEvent (0),
     m_wifiRadioEnergyModel (0),
-    m_timeLastPreambleDetected (Seconds (0))
+    m_timeLastPreambleDetected (Seconds (0)),
+    m_abstractReception (false)
 {
   NS_LOG_FUNCTION (this);
   m_random = CreateObject<UniformRandomVariable> ();
@@ -2424,6 +2434,10 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t fre
 void
 WifiPhy::NotifyTxBegin (Ptr<const WifiPsdu> psdu, double txPowerW)
 {
+  if (m_phyTxBeginTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyTxBeginTrace (mpdu->GetProtocolDataUnit (), txPowerW);
@@ -2433,6 +2447,10 @@ WifiPhy::NotifyTxBegin (Ptr<const WifiPsdu> psdu, double txPowerW)
 void
 WifiPhy::NotifyTxEnd (Ptr<const WifiPsdu> psdu)
 {
+  if (m_phyTxEndTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyTxEndTrace (mpdu->GetProtocolDataUnit ());
@@ -2442,6 +2460,10 @@ WifiPhy::NotifyTxEnd (Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyTxDrop (Ptr<const WifiPsdu> psdu)
 {
+  if (m_phyTxDropTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyTxDropTrace (mpdu->GetProtocolDataUnit ());
@@ -2451,6 +2473,10 @@ WifiPhy::NotifyTxDrop (Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu)
 {
+  if (m_phyRxBeginTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyRxBeginTrace (mpdu->GetProtocolDataUnit ());
@@ -2460,6 +2486,10 @@ WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxEnd (Ptr<const WifiPsdu> psdu)
 {
+  if (m_phyRxEndTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyRxEndTrace (mpdu->GetProtocolDataUnit ());
@@ -2469,6 +2499,10 @@ WifiPhy::NotifyRxEnd (Ptr<const WifiPsdu> psdu)
 void
 WifiPhy::NotifyRxDrop (Ptr<const WifiPsdu> psdu, WifiPhyRxfailureReason reason)
 {
+  if (m_phyRxDropTrace.IsEmpty ())
+    {
+      return;
+    }
   for (auto& mpdu : *PeekPointer (psdu))
     {
       m_phyRxDropTrace (mpdu->GetProtocolDataUnit (), reason);
@@ -2479,6 +2513,15 @@ void
 WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector,
                                SignalNoiseDbm signalNoise, std::vector<bool> statusPerMpdu)
 {
+  if (m_phyMonitorSniffRxTrace.IsEmpty ())
+    {
+      // the A-MPDU reference numbers are shared by both sniffer traces
+      if (psdu->IsAggregate ())
+        {
+          ++m_rxMpduReferenceNumber;
+        }
+      return;
+    }
   MpduInfo aMpdu;
   if (psdu->IsAggregate ())
     {
@@ -2509,6 +2552,15 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
 void
 WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector)
 {
+  if (m_phyMonitorSniffTxTrace.IsEmpty ())
+    {
+      // the A-MPDU reference numbers are shared by both sniffer traces
+      if (psdu->IsAggregate ())
+        {
+          ++m_rxMpduReferenceNumber;
+        }
+      return;
+    }
   MpduInfo aMpdu;
   if (psdu->IsAggregate ())
     {
@@ -2595,7 +2647,7 @@ WifiPhy::Send (Ptr<const WifiPsdu> psdu, WifiTxVector txVector)
   NotifyTxBegin (psdu, txPowerW);
   m_phyTxPsduBeginTrace (psdu, txVector, txPowerW);
   NotifyMonitorSniffTx (psdu, GetFrequency (), txVector);
-  m_state->SwitchToTx (txDuration, psdu->GetPacket (), GetPowerDbm (txVector.GetTxPowerLevel ()), txVector);
+  m_state->SwitchToTx (txDuration, psdu, GetPowerDbm (txVector.GetTxPowerLevel ()), txVector);
 
   Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration, GetFrequency ());
 
@@ -2756,7 +2808,7 @@ WifiPhy::StartReceivePreamble (Ptr<WifiPpdu> ppdu, double rxPowerW)
       break;
     case WifiPhyState::RX:
       NS_ASSERT (m_currentEvent != 0);
-      if (m_frameCaptureModel != 0
+      if (m_frameCaptureModel != 0 && !m_abstractReception
           && m_frameCaptureModel->IsInCaptureWindow (m_timeLastPreambleDetected)
           && m_frameCaptureModel->CaptureNewFrame (m_currentEvent, event))
         {
@@ -2913,7 +2965,8 @@ WifiPhy::StartReceivePayload (Ptr<Event> event)
 void
 WifiPhy::EndReceive (Ptr<Event> event)
 {
-  Time psduDuration = event->GetEndTime () - event->GetStartTime ();
+  WifiTxVector txVector = event->GetTxVector ();
+  Time psduDuration = event->GetEndTime () - event->GetStartTime () - CalculatePhyPreambleAndHeaderDuration (txVector);
   NS_LOG_FUNCTION (this << *event << psduDuration);
   NS_ASSERT (GetLastRxEndTime () == Simulator::Now ());
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
@@ -2926,7 +2979,6 @@ WifiPhy::EndReceive (Ptr<Event> event)
   Time relativeStart = NanoSeconds (0);
   bool receptionOkAtLeastForOneMpdu = false;
   std::pair<bool, SignalNoiseDbm> rxInfo;
-  WifiTxVector txVector = event->GetTxVector ();
   size_t nMpdus = psdu->GetNMpdus ();
   if (nMpdus > 1)
     {
@@ -2990,7 +3042,14 @@ WifiPhy::GetReceptionStatus (Ptr<const WifiPsdu> psdu, Ptr<Event> event, Time re
 {
   NS_LOG_FUNCTION (this << *psdu << *event << relativeMpduStart << mpduDuration);
   InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePayloadSnrPer (event, std::make_pair (relativeMpduStart, relativeMpduStart + mpduDuration));
+  if (m_abstractReception)
+    {
+      snrPer = m_interference.CalculateEffectivePayloadSnrPer (event, mpduDuration);
+    }
+  else
+    {
+      snrPer = m_interference.CalculatePayloadSnrPer (event, std::make_pair (relativeMpduStart, relativeMpduStart + mpduDuration));
+    }
 
   NS_LOG_DEBUG ("mode=" << (event->GetTxVector ().GetMode ().GetDataRate (event->GetTxVector ())) <<
                 ", snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per << ", size=" << psdu->GetSize () <<
@@ -3016,6 +3075,75 @@ WifiPhy::GetReceptionStatus (Ptr<const WifiPsdu> psdu, Ptr<Event> event, Time re
     }
 }
 
+void
+WifiPhy::StartReceiveAbstract (Ptr<Event> event)
+{
+  NS_LOG_FUNCTION (this << *event);
+  m_currentEvent = event;
+  WifiTxVector txVector = event->GetTxVector ();
+  WifiMode txMode = txVector.GetMode ();
+  Time rxDuration = event->GetDuration ();
+
+  //The preamble and the PHY headers are decided now, with the interference
+  //known at the start of the PPDU
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculateNonHtPhyHeaderSnrPer (event);
+  if (m_preambleDetectionModel && !m_preambleDetectionModel->IsPreambleDetected (event->GetRxPowerW (), snrPer.snr, m_channelWidth))
+    {
+      NS_LOG_DEBUG ("Drop packet because PHY preamble detection failed");
+      NotifyRxDrop (event->GetPsdu (), PREAMBLE_DETECT_FAILURE);
+      m_interference.NotifyRxEnd ();
+      m_currentEvent = 0;
+      MaybeCcaBusyDuration ();
+      return;
+    }
+  NotifyRxBegin (event->GetPsdu ());
+  m_timeLastPreambleDetected = Simulator::Now ();
+
+  if (!((txMode.GetModulationClass () == WIFI_MOD_CLASS_HT) && (txVector.GetPreambleType () == WIFI_PREAMBLE_HT_GF))
+      && m_random->GetValue () <= snrPer.per)
+    {
+      NS_LOG_DEBUG ("Abort reception because non-HT PHY header reception failed");
+      AbortCurrentReception (L_SIG_FAILURE);
+      MaybeCcaBusyDuration ();
+      return;
+    }
+
+  WifiPhyRxfailureReason reason = UNKNOWN;
+  if ((txMode.GetModulationClass () >= WIFI_MOD_CLASS_HT)
+      && m_random->GetValue () <= m_interference.CalculateHtPhyHeaderSnrPer (event).per)
+    {
+      NS_LOG_DEBUG ("Drop packet because HT PHY header reception failed");
+      reason = SIG_A_FAILURE;
+    }
+  else if ((txVector.GetNss () > GetMaxSupportedRxSpatialStreams ())
+           || ((txVector.GetChannelWidth () >= 40) && (txVector.GetChannelWidth () > GetChannelWidth ()))
+           || (!IsModeSupported (txMode) && !IsMcsSupported (txMode)))
+    {
+      NS_LOG_DEBUG ("Packet reception could not be started because of unsupported settings");
+      reason = UNSUPPORTED_SETTINGS;
+    }
+  if (reason != UNKNOWN)
+    {
+      NotifyRxDrop (event->GetPsdu (), reason);
+      m_state->SwitchMaybeToCcaBusy (rxDuration);
+      m_endRxEvent = Simulator::Schedule (rxDuration, &WifiPhy::ResetReceive, this, event);
+      return;
+    }
+
+  m_state->SwitchToRx (rxDuration);
+  m_endRxEvent = Simulator::Schedule (rxDuration, &WifiPhy::EndReceive, this, event);
+  NS_LOG_DEBUG ("Receiving PPDU");
+  //The MAC expects the PSDU to end after the given duration
+  m_phyRxPayloadBeginTrace (txVector, rxDuration);
+  if (txMode.GetModulationClass () == WIFI_MOD_CLASS_HE)
+    {
+      HePreambleParameters params;
+      params.rssiW = event->GetRxPowerW ();
+      params.bssColor = txVector.GetBssColor ();
+      NotifyEndOfHePreamble (params);
+    }
+}
+
 void
 WifiPhy::EndReceiveInterBss (void)
 {
@@ -4169,6 +4297,11 @@ WifiPhy::StartRx (Ptr<Event> event, double rxPowerW)
   NS_LOG_DEBUG ("sync to signal (power=" << rxPowerW << "W)");
   m_interference.NotifyRxStart (); //We need to notify it now so that it starts recording events
 
+  if (m_abstractReception)
+    {
+      StartReceiveAbstract (event);
+      return;
+    }
   if (!m_endPreambleDetectionEvent.IsRunning ())
     {
       Time startOfPreambleDuration = GetPreambleDetectionDuration ();
@@ -22,6 +22,7 @@
 #ifndef WIFI_PHY_H
 #define WIFI_PHY_H
 
+#include <map>
 #include "ns3/event-id.h"
 #include "ns3/deprecated.h"
 #include "ns3/error-model.h"
@@ -225,6 +226,16 @@ public:
    */
   void EndReceive (Ptr<Event> event);
 
+  /**
+   * Start the abstract reception of a PPDU the PHY has synchronized on: the
+   * preamble detection and the PHY headers are decided at once, from the
+   * interference known at the start of the PPDU, and the PHY stays in RX
+   * until EndReceive () at the end of the PPDU.
+   *
+   * \param event the event holding incoming PPDU's information
+   */
+  void StartReceiveAbstract (Ptr<Event> event);
+
   /**
    * Reset PHY at the end of the packet under reception after it has failed the PHY header.
    *
@@ -2079,6 +2090,7 @@ private:
   Ptr<WifiRadioEnergyModel> m_wifiRadioEnergyModel;     //!< Wifi radio energy model
   Ptr<ErrorModel> m_postReceptionErrorModel;            //!< Error model for receive packet events
   Time m_timeLastPreambleDetected;                      //!< Record the time the last preamble was detected
+  bool m_abstractReception;                             //!< Whether PPDUs are received with a single event
 
   Callback<void> m_capabilitiesChangedCallback;         //!< Callback when PHY capabilities changed
 };
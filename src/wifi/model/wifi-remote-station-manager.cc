@@ -565,6 +565,10 @@ WifiRemoteStationManager::GetDataTxVector (Mac48Address address, const WifiMacHe
       HighLatencyDataTxVectorTag datatag;
       bool found = ConstCast<Packet> (packet)->PeekPacketTag (datatag);
       NS_ASSERT (found);
+      if (!header->IsMgt ())
+        {
+          LookupState (address)->m_lastDataTxVector = datatag.GetDataTxVector ();
+        }
       return datatag.GetDataTxVector ();
     }
   WifiTxVector txVector;
@@ -598,9 +602,20 @@ WifiRemoteStationManager::GetDataTxVector (Mac48Address address, const WifiMacHe
       heConfiguration->GetAttribute ("BssColor", bssColor);
       txVector.SetBssColor (bssColor.Get ());
     }
+  if (!header->IsMgt ())
+    {
+      LookupState (address)->m_lastDataTxVector = txVector;
+    }
   return txVector;
 }
 
+WifiTxVector
+WifiRemoteStationManager::GetLastDataTxVector (Mac48Address address) const
+{
+  NS_LOG_FUNCTION (this << address);
+  return LookupState (address)->m_lastDataTxVector;
+}
+
 WifiTxVector
 WifiRemoteStationManager::GetCtsToSelfTxVector (const WifiMacHeader *header,
                                                 Ptr<const Packet> packet)
@@ -1096,13 +1111,11 @@ WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  StationStates::const_iterator i = m_states.find (address);
+  if (i != m_states.end ())
     {
-      if ((*i)->m_address == address)
-        {
-          NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
-          return (*i);
-        }
+      NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
+      return i->second;
     }
   WifiRemoteStationState *state = new WifiRemoteStationState ();
   state->m_state = WifiRemoteStationState::BRAND_NEW;
@@ -1114,10 +1127,13 @@ WifiRemoteStationManager::LookupState (Mac48Address address) const
   state->m_heCapabilities = 0;
   state->m_channelWidth = m_wifiPhy->GetChannelWidth ();
   state->m_guardInterval = GetGuardInterval ();
+  state->m_lastDataTxVector.SetMode (GetDefaultMode ());
+  state->m_lastDataTxVector.SetChannelWidth (state->m_channelWidth);
+  state->m_lastDataTxVector.SetGuardInterval (state->m_guardInterval);
   state->m_ness = 0;
   state->m_aggregation = false;
   state->m_qosSupported = false;
-  const_cast<WifiRemoteStationManager *> (this)->m_states.push_back (state);
+  const_cast<WifiRemoteStationManager *> (this)->m_states[address] = state;
   NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning new state");
   return state;
 }
@@ -1126,18 +1142,16 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  Stations::const_iterator i = m_stations.find (address);
+  if (i != m_stations.end ())
     {
-      if ((*i)->m_state->m_address == address)
-        {
-          return (*i);
-        }
+      return i->second;
     }
   WifiRemoteStationState *state = LookupState (address);
 
   WifiRemoteStation *station = DoCreateStation ();
   station->m_state = state;
-  const_cast<WifiRemoteStationManager *> (this)->m_stations.push_back (station);
+  const_cast<WifiRemoteStationManager *> (this)->m_stations[address] = station;
   return station;
 }
 
@@ -1319,12 +1333,12 @@ WifiRemoteStationManager::Reset (void)
   NS_LOG_FUNCTION (this);
   for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
     {
-      delete (*i);
+      delete i->second;
     }
   m_states.clear ();
   for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
     {
-      delete (*i);
+      delete i->second;
     }
   m_stations.clear ();
   m_bssBasicRateSet.clear ();
@@ -22,11 +22,13 @@
 #define WIFI_REMOTE_STATION_MANAGER_H
 
 #include <array>
+#include <unordered_map>
 #include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/data-rate.h"
 #include "ns3/mac48-address.h"
 #include "wifi-mode.h"
+#include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 #include "qos-utils.h"
 #include "wifi-remote-station-info.h"
@@ -94,6 +96,7 @@ struct WifiRemoteStationState
   Ptr<const VhtCapabilities> m_vhtCapabilities; //!< remote station VHT capabilities
   Ptr<const HeCapabilities> m_heCapabilities;   //!< remote station HE capabilities
 
+  WifiTxVector m_lastDataTxVector; //!< TXVECTOR of the last data frame sent to the remote station
   uint16_t m_channelWidth;    //!< Channel width (in MHz) supported by the remote station
   uint16_t m_guardInterval;   //!< HE Guard interval duration (in nanoseconds) supported by the remote station
   uint8_t m_ness;             //!< Number of extended spatial streams of the remote station
@@ -129,13 +132,13 @@ public:
   };
 
   /**
-   * A vector of WifiRemoteStations
+   * The WifiRemoteStations, indexed by MAC address
    */
-  typedef std::vector <WifiRemoteStation *> Stations;
+  typedef std::unordered_map <Mac48Address, WifiRemoteStation *, WifiAddressHash> Stations;
   /**
-   * A vector of WifiRemoteStationStates
+   * The WifiRemoteStationStates, indexed by MAC address
    */
-  typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef std::unordered_map <Mac48Address, WifiRemoteStationState *, WifiAddressHash> StationStates;
 
   /**
    * Set up PHY associated with this device since it is the object that
@@ -673,6 +676,17 @@ public:
    */
   WifiTxVector GetDataTxVector (Mac48Address address, const WifiMacHeader *header,
                                 Ptr<const Packet> packet);
+  /**
+   * Unlike GetDataTxVector, this method does not consult the rate control
+   * algorithm, so it has no effect on its state (e.g., Minstrel sampling).
+   *
+   * \param address remote address
+   *
+   * \return the TXVECTOR last returned by GetDataTxVector for a unicast data
+   *         frame to the station, or a TXVECTOR using the default mode if
+   *         no such frame was sent
+   */
+  WifiTxVector GetLastDataTxVector (Mac48Address address) const;
   /**
    * \param address remote address
    * \param packet the packet to send
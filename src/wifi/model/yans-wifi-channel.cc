@@ -21,11 +21,13 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
+#include "ns3/spatial-grid.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
@@ -53,11 +55,21 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The distance in meters beyond which the PHYs are neither given "
+                   "the transmissions nor their interference, without computing their "
+                   "propagation loss; 0 gives the transmissions to all the PHYs. "
+                   "It must be larger than the range of the loss model down to the "
+                   "sensitivity of the PHYs.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,6 +78,7 @@ YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION (this);
   m_phyList.clear ();
+  m_grid = 0;
 }
 
 void
@@ -88,51 +101,111 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
   NS_LOG_FUNCTION (this << sender << ppdu << txPowerDbm);
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  m_receivers.clear ();
+  if (m_maxRange <= 0)
     {
-      if (sender != (*i))
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<WifiPpdu> copy = Copy (ppdu);
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
-            {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-            }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm);
+          AddReceiver (sender, *i);
         }
     }
+  else
+    {
+      UpdateGrid ();
+      m_grid->GetNeighbors (senderMobility->GetPosition (), m_maxRange, m_neighbors);
+      for (std::vector<uint32_t>::const_iterator i = m_neighbors.begin (); i != m_neighbors.end (); i++)
+        {
+          AddReceiver (sender, m_phyList[*i]);
+        }
+    }
+  if (m_receivers.empty ())
+    {
+      return;
+    }
+  // the losses to all the receivers are computed at once
+  m_receiverMobilities.clear ();
+  for (PhyList::const_iterator i = m_receivers.begin (); i != m_receivers.end (); i++)
+    {
+      m_receiverMobilities.push_back ((*i)->GetMobility ()->GetObject<MobilityModel> ());
+    }
+  m_loss->CalcRxPower (txPowerDbm, senderMobility, m_receiverMobilities, m_rxPowersDbm);
+  for (std::size_t i = 0; i < m_receivers.size (); i++)
+    {
+      SendTo (senderMobility, m_receivers[i], m_receiverMobilities[i], ppdu, m_rxPowersDbm[i]);
+    }
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
+YansWifiChannel::AddReceiver (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const
 {
-  NS_LOG_FUNCTION (phy << ppdu << rxPowerDbm);
+  if (sender == receiver)
+    {
+      return;
+    }
+  //For now don't account for inter channel interference nor channel bonding
+  if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+  m_receivers.push_back (receiver);
+}
+
+void
+YansWifiChannel::SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                         Ptr<MobilityModel> receiverMobility, Ptr<const WifiPpdu> ppdu,
+                         double rxPowerDbm) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
   // Do no further processing if signal is too weak
   // Current implementation assumes constant RX power over the PPDU duration
-  if ((rxPowerDbm + phy->GetRxGain ()) < phy->GetRxSensitivity ())
+  if ((rxPowerDbm + receiver->GetRxGain ()) < receiver->GetRxSensitivity ())
     {
       NS_LOG_INFO ("Received signal too weak to process: " << rxPowerDbm << " dBm");
       return;
     }
+  Ptr<WifiPpdu> copy = Copy (ppdu);
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, copy, rxPowerDbm);
+}
+
+void
+YansWifiChannel::UpdateGrid (void) const
+{
+  if (m_grid != 0 && m_grid->GetCellSize () == m_maxRange)
+    {
+      // the PHYs are only appended to the list
+      for (uint32_t i = m_grid->GetN (); i < m_phyList.size (); ++i)
+        {
+          m_grid->Add (i, m_phyList[i]->GetMobility ());
+        }
+      return;
+    }
+  NS_LOG_FUNCTION (this << m_maxRange);
+  m_grid = Create<SpatialGrid> (m_maxRange);
+  for (uint32_t i = 0; i < m_phyList.size (); ++i)
+    {
+      m_grid->Add (i, m_phyList[i]->GetMobility ());
+    }
+}
+
+void
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
+{
+  NS_LOG_FUNCTION (phy << ppdu << rxPowerDbm);
   phy->StartReceivePreamble (ppdu, DbmToW (rxPowerDbm + phy->GetRxGain ()));
 }
 
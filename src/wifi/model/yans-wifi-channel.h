@@ -21,6 +21,7 @@
 #ifndef YANS_WIFI_CHANNEL_H
 #define YANS_WIFI_CHANNEL_H
 
+#include <vector>
 #include "ns3/channel.h"
 
 namespace ns3 {
@@ -28,6 +29,8 @@ namespace ns3 {
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
+class SpatialGrid;
+class MobilityModel;
 class YansWifiPhy;
 class Packet;
 class Time;
@@ -41,6 +44,15 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * The signals received below the sensitivity of a PHY are dropped when they
+ * are sent, without scheduling their reception.  When the MaxRange attribute
+ * is set, the PHYs farther from the sender are not even looked at: the PHYs
+ * are kept in a SpatialGrid of their positions, so that the cost of a
+ * transmission depends on the number of PHYs in range rather than on the
+ * number of PHYs on the channel.  The range must be larger than the distance
+ * at which the propagation loss model can bring a signal above the
+ * sensitivity of the PHYs.
  */
 class YansWifiChannel : public Channel
 {
@@ -115,9 +127,44 @@ private:
    */
   static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
 
+  /**
+   * Add a PHY to the receivers of a PPDU, unless it is the sender or is
+   * tuned to another channel.
+   *
+   * \param sender the PHY object from which the packet is originating
+   * \param receiver the PHY which may receive the PPDU
+   */
+  void AddReceiver (Ptr<YansWifiPhy> sender, Ptr<YansWifiPhy> receiver) const;
+
+  /**
+   * Schedule the reception of a PPDU by a PHY if its reception power is
+   * above the sensitivity of the PHY.
+   *
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the PHY receiving the PPDU
+   * \param receiverMobility the mobility model of the receiver
+   * \param ppdu the PPDU to send
+   * \param rxPowerDbm the power of the PPDU at the receiver, in dBm
+   */
+  void SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+               Ptr<MobilityModel> receiverMobility, Ptr<const WifiPpdu> ppdu,
+               double rxPowerDbm) const;
+
+  /**
+   * Add the PHYs connected since the last transmission to the grid, or
+   * build it again if the range has changed.
+   */
+  void UpdateGrid (void) const;
+
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Distance beyond which the PHYs are not looked at, or 0
+  mutable Ptr<SpatialGrid> m_grid;     //!< Positions of the PHYs, if the range is limited
+  mutable std::vector<uint32_t> m_neighbors; //!< Indices of the PHYs in range of a transmission
+  mutable PhyList m_receivers;         //!< PHYs receiving the current transmission
+  mutable std::vector<Ptr<MobilityModel> > m_receiverMobilities; //!< Mobility models of the receivers
+  mutable std::vector<double> m_rxPowersDbm; //!< Reception powers of the receivers, in dBm
 };
 
 } //namespace ns3
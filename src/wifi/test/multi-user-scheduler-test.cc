@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/config.h"
+#include "ns3/ssid.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/he-ru.h"
+#include "ns3/rr-multi-user-scheduler.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MultiUserSchedulerTestSuite");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the HE RU allocation
+ */
+class HeRuTest : public TestCase
+{
+public:
+  HeRuTest ();
+  virtual ~HeRuTest ();
+
+private:
+  void DoRun (void);
+  /**
+   * Check the RU type returned for a number of stations.
+   *
+   * \param bw the bandwidth (MHz)
+   * \param nStations the number of stations
+   * \param expectedRuType the expected RU type
+   * \param expectedNStations the expected number of stations served
+   */
+  void CheckEqualSizedRus (uint16_t bw, std::size_t nStations, HeRu::RuType expectedRuType, std::size_t expectedNStations);
+};
+
+HeRuTest::HeRuTest ()
+  : TestCase ("Check the HE RU allocation")
+{
+}
+
+HeRuTest::~HeRuTest ()
+{
+}
+
+void
+HeRuTest::CheckEqualSizedRus (uint16_t bw, std::size_t nStations, HeRu::RuType expectedRuType, std::size_t expectedNStations)
+{
+  HeRu::RuType ruType = HeRu::GetEqualSizedRusForStations (bw, nStations);
+  NS_TEST_EXPECT_MSG_EQ (ruType, expectedRuType, "Unexpected RU type in " << bw << " MHz");
+  NS_TEST_EXPECT_MSG_EQ (nStations, expectedNStations, "Unexpected number of stations in " << bw << " MHz");
+}
+
+void
+HeRuTest::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (20, HeRu::RU_26_TONE), 9, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (20, HeRu::RU_484_TONE), 0, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (40, HeRu::RU_52_TONE), 8, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (80, HeRu::RU_26_TONE), 37, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (80, HeRu::RU_996_TONE), 1, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (160, HeRu::RU_26_TONE), 74, "Unexpected number of RUs");
+  NS_TEST_EXPECT_MSG_EQ (HeRu::GetNRus (160, HeRu::RU_2x996_TONE), 1, "Unexpected number of RUs");
+
+  CheckEqualSizedRus (20, 1, HeRu::RU_242_TONE, 1);
+  CheckEqualSizedRus (20, 3, HeRu::RU_106_TONE, 2);
+  CheckEqualSizedRus (20, 4, HeRu::RU_52_TONE, 4);
+  CheckEqualSizedRus (20, 20, HeRu::RU_26_TONE, 9);
+  CheckEqualSizedRus (80, 10, HeRu::RU_106_TONE, 8);
+  CheckEqualSizedRus (160, 3, HeRu::RU_996_TONE, 2);
+  CheckEqualSizedRus (160, 1, HeRu::RU_2x996_TONE, 1);
+
+  HeRu::RuSpec ru = HeRu::GetRu (160, HeRu::RU_242_TONE, 5);
+  NS_TEST_EXPECT_MSG_EQ (ru.primary80MHz, false, "Sixth 242-tone RU of 160 MHz should be in the secondary 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (ru.index, 2, "Unexpected index of the sixth 242-tone RU of 160 MHz");
+  ru = HeRu::GetRu (80, HeRu::RU_52_TONE, 15);
+  NS_TEST_EXPECT_MSG_EQ (ru.primary80MHz, true, "RUs of 80 MHz are in the primary 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (ru.index, 16, "Unexpected index of the last 52-tone RU of 80 MHz");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the round robin multi-user scheduler
+ *
+ * An HE AP with an RrMultiUserScheduler serving at most two stations per
+ * multi-user PPDU sends bursts of packets to four HE stations.  Once the
+ * Block Ack agreements are established, the scheduler must alternate
+ * between DL MU PPDUs and Trigger frames, grant 106-tone RUs in 20 MHz,
+ * and serve the stations in round robin.  The packets must all be
+ * delivered through single-user PPDUs.
+ */
+class RrMultiUserSchedulerTest : public TestCase
+{
+public:
+  RrMultiUserSchedulerTest ();
+  virtual ~RrMultiUserSchedulerTest ();
+
+private:
+  void DoRun (void);
+  /**
+   * Callback invoked when a DL MU PPDU is scheduled
+   * \param info the stations served
+   */
+  void NotifyDlMuSchedule (const MultiUserScheduler::MuInfo &info);
+  /**
+   * Callback invoked when HE TB PPDUs are solicited
+   * \param info the stations solicited
+   */
+  void NotifyUlMuSchedule (const MultiUserScheduler::MuInfo &info);
+  /**
+   * Callback invoked when a station receives a packet
+   * \param context the context
+   * \param p the packet
+   */
+  void NotifyRx (std::string context, Ptr<const Packet> p);
+  /**
+   * Send a burst of packets from the AP to every station
+   */
+  void SendBurst (void);
+
+  static const uint32_t N_STAS = 4;     ///< number of stations
+  static const uint32_t N_PACKETS = 20; ///< number of packets of a burst per station
+  static const uint32_t N_BURSTS = 10;  ///< number of bursts
+
+  NetDeviceContainer m_apDevices;             ///< AP device
+  NetDeviceContainer m_staDevices;            ///< station devices
+  std::vector<MultiUserScheduler::MuInfo> m_dlInfos; ///< DL MU PPDUs scheduled
+  std::vector<MultiUserScheduler::MuInfo> m_ulInfos; ///< HE TB PPDUs solicited
+  std::vector<bool> m_dlAfterUl;              ///< whether each schedule (after the first) alternates
+  bool m_lastWasDl;                           ///< whether the last schedule was a DL MU PPDU
+  uint32_t m_received;                        ///< number of packets received by the stations
+};
+
+RrMultiUserSchedulerTest::RrMultiUserSchedulerTest ()
+  : TestCase ("Check the round robin multi-user scheduler"),
+    m_lastWasDl (false),
+    m_received (0)
+{
+}
+
+RrMultiUserSchedulerTest::~RrMultiUserSchedulerTest ()
+{
+}
+
+void
+RrMultiUserSchedulerTest::NotifyDlMuSchedule (const MultiUserScheduler::MuInfo &info)
+{
+  m_dlInfos.push_back (info);
+  m_lastWasDl = true;
+}
+
+void
+RrMultiUserSchedulerTest::NotifyUlMuSchedule (const MultiUserScheduler::MuInfo &info)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_lastWasDl, true, "HE TB PPDUs must be solicited after a DL MU PPDU");
+  m_ulInfos.push_back (info);
+  m_lastWasDl = false;
+}
+
+void
+RrMultiUserSchedulerTest::NotifyRx (std::string context, Ptr<const Packet> p)
+{
+  m_received++;
+}
+
+void
+RrMultiUserSchedulerTest::SendBurst (void)
+{
+  Ptr<WifiNetDevice> ap = DynamicCast<WifiNetDevice> (m_apDevices.Get (0));
+  for (uint32_t n = 0; n < N_PACKETS; n++)
+    {
+      for (uint32_t i = 0; i < N_STAS; i++)
+        {
+          ap->Send (Create<Packet> (1000), m_staDevices.Get (i)->GetAddress (), 1);
+        }
+    }
+}
+
+void
+RrMultiUserSchedulerTest::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 100;
+
+  NodeContainer wifiApNode;
+  wifiApNode.Create (1);
+  NodeContainer wifiStaNodes;
+  wifiStaNodes.Create (N_STAS);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelNumber", UintegerValue (36));
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ax_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("HeMcs5"),
+                                "ControlMode", StringValue ("HeMcs0"));
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid));
+  m_staDevices = wifi.Install (phy, mac, wifiStaNodes);
+
+  wifi.SetMultiUserScheduler ("ns3::RrMultiUserScheduler",
+                              "NStations", UintegerValue (2));
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "EnableBeaconJitter", BooleanValue (false));
+  m_apDevices = wifi.Install (phy, mac, wifiApNode);
+
+  // the scheduler is only installed on the AP
+  for (uint32_t i = 0; i < N_STAS; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_staDevices.Get (i)->GetObject<MultiUserScheduler> (), 0, "No scheduler expected on a station");
+    }
+  Ptr<MultiUserScheduler> scheduler = m_apDevices.Get (0)->GetObject<MultiUserScheduler> ();
+  NS_TEST_ASSERT_MSG_NE (scheduler, 0, "The AP should have a multi-user scheduler");
+
+  wifi.AssignStreams (m_apDevices, streamNumber);
+  wifi.AssignStreams (m_staDevices, streamNumber);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (wifiApNode);
+  mobility.Install (wifiStaNodes);
+
+  scheduler->TraceConnectWithoutContext ("DlMuSchedule", MakeCallback (&RrMultiUserSchedulerTest::NotifyDlMuSchedule, this));
+  scheduler->TraceConnectWithoutContext ("UlMuSchedule", MakeCallback (&RrMultiUserSchedulerTest::NotifyUlMuSchedule, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/MacRx", MakeCallback (&RrMultiUserSchedulerTest::NotifyRx, this));
+
+  // the first burst establishes the Block Ack agreements
+  for (uint32_t i = 0; i < N_BURSTS; i++)
+    {
+      Simulator::Schedule (Seconds (1.0) + i * MilliSeconds (50), &RrMultiUserSchedulerTest::SendBurst, this);
+    }
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  uint16_t channelWidth = DynamicCast<WifiNetDevice> (m_apDevices.Get (0))->GetPhy ()->GetChannelWidth ();
+  NS_TEST_ASSERT_MSG_EQ (channelWidth, 20, "The test expects a 20 MHz channel");
+  NS_TEST_EXPECT_MSG_EQ (m_received, N_BURSTS * N_PACKETS * N_STAS, "All the packets should be delivered in SU PPDUs");
+  NS_TEST_ASSERT_MSG_GT (m_dlInfos.size (), 1, "DL MU PPDUs should have been scheduled");
+  NS_TEST_ASSERT_MSG_GT (m_ulInfos.size (), 0, "HE TB PPDUs should have been solicited");
+
+  // the stations are served in round robin
+  std::vector<uint16_t> served;
+  for (const auto &info : m_dlInfos)
+    {
+      NS_TEST_EXPECT_MSG_EQ (info.channelWidth, 20, "Unexpected bandwidth");
+      NS_TEST_EXPECT_MSG_EQ (info.users.size (), 2, "Two stations should be served");
+      for (const auto &user : info.users)
+        {
+          NS_TEST_EXPECT_MSG_EQ (user.ru.ruType, HeRu::RU_106_TONE, "Unexpected RU type");
+          NS_TEST_EXPECT_MSG_GT (user.nMpdus, 0, "At least an MPDU should be sent to each station");
+          NS_TEST_EXPECT_MSG_EQ (user.txVector.GetPreambleType (), WIFI_PREAMBLE_HE_MU, "Unexpected preamble");
+          served.push_back (user.aid);
+        }
+      NS_TEST_EXPECT_MSG_NE (info.users[0].ru.index, info.users[1].ru.index, "The stations should get distinct RUs");
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (info.ppduDuration, MicroSeconds (5484), "The DL MU PPDU is too long");
+    }
+  // stations without queued data are skipped, hence a station is never
+  // served twice in a row and every station is eventually served
+  for (std::size_t i = 1; i < served.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_NE (served[i], served[i - 1], "The stations should be served in round robin");
+    }
+  for (uint16_t aid = 1; aid <= N_STAS; aid++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((std::find (served.begin (), served.end (), aid) != served.end ()), true,
+                             "Station " << aid << " has never been served");
+    }
+  for (const auto &info : m_ulInfos)
+    {
+      NS_TEST_EXPECT_MSG_EQ (info.users.size (), 2, "Two stations should be solicited");
+      NS_TEST_EXPECT_MSG_EQ (info.users[0].psduSize, 500, "Unexpected solicited PSDU size");
+      NS_TEST_EXPECT_MSG_EQ (info.users[0].txVector.GetPreambleType (), WIFI_PREAMBLE_HE_TB, "Unexpected preamble");
+      NS_TEST_EXPECT_MSG_GT (info.ppduDuration, MicroSeconds (0), "Null HE TB PPDU duration");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Multi-user scheduler Test Suite
+ */
+class MultiUserSchedulerTestSuite : public TestSuite
+{
+public:
+  MultiUserSchedulerTestSuite ();
+};
+
+MultiUserSchedulerTestSuite::MultiUserSchedulerTestSuite ()
+  : TestSuite ("wifi-mu-scheduler", UNIT)
+{
+  AddTestCase (new HeRuTest, TestCase::QUICK);
+  AddTestCase (new RrMultiUserSchedulerTest, TestCase::QUICK);
+}
+
+static MultiUserSchedulerTestSuite g_multiUserSchedulerTestSuite; ///< the test suite
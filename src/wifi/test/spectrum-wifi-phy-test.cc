@@ -28,6 +28,7 @@
 #include "ns3/log.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-ppdu.h"
+#include "ns3/boolean.h"
 
 using namespace ns3;
 
@@ -305,6 +306,106 @@ SpectrumWifiPhyListenerTest::DoRun (void)
   delete m_listener;
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Spectrum Wifi Phy Sub-Band Test
+ *
+ * Inject signals on the 20 MHz sub-bands of a 40 MHz channel and check the
+ * time each sub-band is busy.
+ */
+class SpectrumWifiPhySubBandTest : public TestCase
+{
+public:
+  SpectrumWifiPhySubBandTest ();
+  virtual ~SpectrumWifiPhySubBandTest ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  /**
+   * Send a non Wi-Fi signal of uniform PSD between two frequencies
+   * \param lowFrequency the lowest frequency (MHz)
+   * \param highFrequency the highest frequency (MHz)
+   * \param rxPowerW the received power (W)
+   * \param duration the duration of the signal
+   */
+  void SendSignal (uint16_t lowFrequency, uint16_t highFrequency, double rxPowerW, Time duration);
+  /**
+   * Check the time the sub-bands are busy
+   * \param lowDuration the expected busy time of the lower sub-band
+   * \param highDuration the expected busy time of the upper sub-band
+   */
+  void CheckSubBands (Time lowDuration, Time highDuration);
+  Ptr<SpectrumWifiPhy> m_phy; ///< Phy
+};
+
+SpectrumWifiPhySubBandTest::SpectrumWifiPhySubBandTest ()
+  : TestCase ("SpectrumWifiPhy test of the 20 MHz sub-band energy tracking")
+{
+}
+
+SpectrumWifiPhySubBandTest::~SpectrumWifiPhySubBandTest ()
+{
+}
+
+void
+SpectrumWifiPhySubBandTest::SendSignal (uint16_t lowFrequency, uint16_t highFrequency, double rxPowerW, Time duration)
+{
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (m_phy->GetRxSpectrumModel ());
+  Bands::const_iterator bit = psd->ConstBandsBegin ();
+  for (Values::iterator vit = psd->ValuesBegin (); vit != psd->ValuesEnd (); vit++, bit++)
+    {
+      if (bit->fc >= lowFrequency * 1e6 && bit->fc < highFrequency * 1e6)
+        {
+          *vit = rxPowerW / ((highFrequency - lowFrequency) * 1e6);
+        }
+    }
+  Ptr<SpectrumSignalParameters> rxParams = Create<SpectrumSignalParameters> ();
+  rxParams->psd = psd;
+  rxParams->txPhy = 0;
+  rxParams->duration = duration;
+  m_phy->StartRx (rxParams);
+}
+
+void
+SpectrumWifiPhySubBandTest::CheckSubBands (Time lowDuration, Time highDuration)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_phy->GetSubBandEnergyDuration (0), lowDuration, "Unexpected busy time of the lower sub-band");
+  NS_TEST_EXPECT_MSG_EQ (m_phy->GetSubBandEnergyDuration (1), highDuration, "Unexpected busy time of the upper sub-band");
+}
+
+void
+SpectrumWifiPhySubBandTest::DoSetup (void)
+{
+  m_phy = CreateObject<SpectrumWifiPhy> ();
+  m_phy->SetAttribute ("TrackSubBands", BooleanValue (true));
+  m_phy->ConfigureStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  Ptr<ErrorRateModel> error = CreateObject<NistErrorRateModel> ();
+  m_phy->SetErrorRateModel (error);
+  m_phy->SetChannelNumber (38);
+  m_phy->SetFrequency (5190);
+  m_phy->SetChannelWidth (40);
+}
+
+void
+SpectrumWifiPhySubBandTest::DoRun (void)
+{
+  // -50 dBm on the lower sub-band only
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhySubBandTest::SendSignal, this, 5170, 5190, 1e-8, MicroSeconds (100));
+  Simulator::Schedule (Seconds (1) + MicroSeconds (10), &SpectrumWifiPhySubBandTest::CheckSubBands, this, MicroSeconds (90), Seconds (0));
+  // -70 dBm on the upper sub-band, below the CCA-ED threshold
+  Simulator::Schedule (Seconds (2), &SpectrumWifiPhySubBandTest::SendSignal, this, 5190, 5210, 1e-10, MicroSeconds (100));
+  Simulator::Schedule (Seconds (2) + MicroSeconds (10), &SpectrumWifiPhySubBandTest::CheckSubBands, this, Seconds (0), Seconds (0));
+  // -50 dBm over the whole channel, then -50 dBm on the upper sub-band
+  Simulator::Schedule (Seconds (3), &SpectrumWifiPhySubBandTest::SendSignal, this, 5170, 5210, 1e-8, MicroSeconds (100));
+  Simulator::Schedule (Seconds (3) + MicroSeconds (50), &SpectrumWifiPhySubBandTest::SendSignal, this, 5190, 5210, 1e-8, MicroSeconds (100));
+  Simulator::Schedule (Seconds (3) + MicroSeconds (60), &SpectrumWifiPhySubBandTest::CheckSubBands, this, MicroSeconds (40), MicroSeconds (90));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -322,6 +423,7 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
 {
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhySubBandTest, TestCase::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
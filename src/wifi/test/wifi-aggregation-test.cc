@@ -341,7 +341,8 @@ TwoLevelAggregationTest::DoRun (void)
    * Test MSDU aggregation of two packets using MsduAggregator::GetNextAmsdu.
    * It checks whether aggregation succeeded:
    *      - returned packet should be different from 0;
-   *      - A-MSDU frame size should be 3030 bytes (= 2 packets + headers + padding);
+   *      - A-MSDU frame size should be 3030 bytes (= 2 packets + headers + padding),
+   *        both before and after the bytes of the A-MSDU are built;
    *      - one packet should be removed from the queue (the other packet is removed later in MacLow::AggregateToAmpdu) .
    */
   m_mac->GetBEQueue ()->GetWifiMacQueue ()->Enqueue (Create<WifiMacQueueItem> (pkt, hdr));
@@ -354,6 +355,7 @@ TwoLevelAggregationTest::DoRun (void)
                                                                               currentAggregatedPacket->GetSize ());
   bool result = (item != 0);
   NS_TEST_EXPECT_MSG_EQ (result, true, "aggregation failed");
+  NS_TEST_EXPECT_MSG_EQ (item->GetPacketSize (), 3030, "wrong packet size");
   NS_TEST_EXPECT_MSG_EQ (item->GetPacket ()->GetSize (), 3030, "wrong packet size");
   NS_TEST_EXPECT_MSG_EQ (m_mac->GetBEQueue ()->GetWifiMacQueue ()->GetNPackets (), 0, "aggregated packets not removed from the queue");
 
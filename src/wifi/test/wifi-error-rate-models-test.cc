@@ -22,6 +22,9 @@
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/tabulated-error-rate-model.h"
+#include "ns3/wifi-phy.h"
 #include "ns3/wifi-tx-vector.h"
 
 using namespace ns3;
@@ -291,6 +294,113 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Tabulated
+ *
+ * Checks that the TabulatedErrorRateModel stays within its documented
+ * accuracy bound of the NIST and YANS models, and that its tables are
+ * saved and loaded without loss.
+ */
+class WifiErrorRateModelsTestCaseTabulated : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTabulated ();
+  virtual ~WifiErrorRateModelsTestCaseTabulated ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the tabulated model against the model it wraps.
+   *
+   * \param model the error rate model to tabulate
+   */
+  void CheckAccuracy (Ptr<ErrorRateModel> model);
+};
+
+WifiErrorRateModelsTestCaseTabulated::WifiErrorRateModelsTestCaseTabulated ()
+  : TestCase ("WifiErrorRateModel test case Tabulated")
+{
+}
+
+WifiErrorRateModelsTestCaseTabulated::~WifiErrorRateModelsTestCaseTabulated ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::CheckAccuracy (Ptr<ErrorRateModel> model)
+{
+  Ptr<TabulatedErrorRateModel> tabulated = CreateObject<TabulatedErrorRateModel> ();
+  tabulated->SetErrorRateModel (model);
+  std::vector<WifiMode> modes {WifiPhy::GetDsssRate1Mbps (), WifiPhy::GetDsssRate2Mbps (),
+                               WifiPhy::GetDsssRate5_5Mbps (), WifiPhy::GetDsssRate11Mbps (),
+                               WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate9Mbps (),
+                               WifiPhy::GetOfdmRate12Mbps (), WifiPhy::GetOfdmRate18Mbps (),
+                               WifiPhy::GetOfdmRate24Mbps (), WifiPhy::GetOfdmRate36Mbps (),
+                               WifiPhy::GetOfdmRate48Mbps (), WifiPhy::GetOfdmRate54Mbps (),
+                               WifiPhy::GetHtMcs7 (), WifiPhy::GetVhtMcs8 (),
+                               WifiPhy::GetHeMcs10 (), WifiPhy::GetHeMcs11 ()};
+  std::vector<uint64_t> lengths {1, 2, 100, 14 * 8, 1500 * 8, 1537 * 8, 65535 * 8};
+  for (const auto &mode : modes)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (mode);
+      // mostly off the points of the grid
+      for (double snrDb = -4.99; snrDb < 45; snrDb += 0.0371)
+        {
+          if (mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS && std::abs (snrDb - 10) < 0.02)
+            {
+              // the CCK models without GSL are discontinuous at 10 dB
+              continue;
+            }
+          double snr = std::pow (10.0, snrDb / 10.0);
+          for (uint64_t nbits : lengths)
+            {
+              double exact = model->GetChunkSuccessRate (mode, txVector, snr, nbits);
+              double ps = tabulated->GetChunkSuccessRate (mode, txVector, snr, nbits);
+              NS_TEST_ASSERT_MSG_EQ_TOL (ps, exact, (nbits <= 2 ? 0.02 : 0.001),
+                                         "Tabulated " << mode << " at " << snrDb << " dB for "
+                                         << nbits << " bits not within the accuracy bound");
+            }
+        }
+    }
+
+  // Beyond the grid, the wrapped model is used
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate54Mbps ());
+  double snr = std::pow (10.0, 50 / 10.0);
+  NS_TEST_ASSERT_MSG_EQ (tabulated->GetChunkSuccessRate (WifiPhy::GetOfdmRate54Mbps (), txVector, snr, 12000),
+                         model->GetChunkSuccessRate (WifiPhy::GetOfdmRate54Mbps (), txVector, snr, 12000),
+                         "The wrapped model should be used beyond the grid");
+
+  // The saved tables are loaded back, replacing the shared tables
+  std::string filename = CreateTempDirFilename ("tabulated-error-rate-model.txt");
+  tabulated->Save (filename);
+  Ptr<TabulatedErrorRateModel> loaded = CreateObject<TabulatedErrorRateModel> ();
+  loaded->SetErrorRateModel (model);
+  loaded->Load (filename);
+  for (const auto &mode : modes)
+    {
+      txVector.SetMode (mode);
+      for (double snrDb = 0.01; snrDb < 40; snrDb += 0.789)
+        {
+          snr = std::pow (10.0, snrDb / 10.0);
+          NS_TEST_ASSERT_MSG_EQ (loaded->GetChunkSuccessRate (mode, txVector, snr, 1500 * 8),
+                                 tabulated->GetChunkSuccessRate (mode, txVector, snr, 1500 * 8),
+                                 "The loaded table of " << mode << " differs at " << snrDb << " dB");
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseTabulated::DoRun (void)
+{
+  CheckAccuracy (CreateObject<NistErrorRateModel> ());
+  CheckAccuracy (CreateObject<YansErrorRateModel> ());
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +418,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTabulated, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/wifi-mac-queue.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the lookups of the WifiMacQueue by receiver address and TID
+ *
+ * QoS data frames for several receivers and TIDs, along with management
+ * frames, are enqueued at the end, at the front and in the middle of the
+ * queue, then dequeued and left to expire.  After each operation, the frames
+ * returned by PeekByTidAndAddress and GetNPacketsByTidAndAddress are checked
+ * against a scan of the whole queue.
+ */
+class WifiMacQueueTidAddressTest : public TestCase
+{
+public:
+  WifiMacQueueTidAddressTest ();
+  virtual ~WifiMacQueueTidAddressTest ();
+
+private:
+  void DoRun (void);
+  /**
+   * Create a frame
+   * \param dest the receiver address
+   * \param tid the TID
+   * \param qos whether the frame is a QoS data frame
+   * \return the frame
+   */
+  Ptr<WifiMacQueueItem> CreateItem (Mac48Address dest, uint8_t tid, bool qos = true);
+  /**
+   * Enqueue frames for all the receivers and TIDs
+   */
+  void EnqueueFrames (void);
+  /**
+   * Check the lookups against a scan of the whole queue
+   */
+  void CheckLookups (void);
+
+  Ptr<WifiMacQueue> m_queue;               ///< the queue
+  std::vector<Mac48Address> m_receivers;   ///< the receivers
+  uint16_t m_seqNo;                        ///< the sequence number of the next frame
+};
+
+WifiMacQueueTidAddressTest::WifiMacQueueTidAddressTest ()
+  : TestCase ("Check the lookups of the WifiMacQueue by receiver address and TID"),
+    m_seqNo (0)
+{
+}
+
+WifiMacQueueTidAddressTest::~WifiMacQueueTidAddressTest ()
+{
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueueTidAddressTest::CreateItem (Mac48Address dest, uint8_t tid, bool qos)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (qos ? WIFI_MAC_QOSDATA : WIFI_MAC_MGT_ACTION);
+  hdr.SetAddr1 (dest);
+  if (qos)
+    {
+      hdr.SetQosTid (tid);
+    }
+  hdr.SetSequenceNumber (m_seqNo++);
+  return Create<WifiMacQueueItem> (Create<Packet> (100), hdr);
+}
+
+void
+WifiMacQueueTidAddressTest::EnqueueFrames (void)
+{
+  for (uint8_t n = 0; n < 3; n++)
+    {
+      for (const auto &dest : m_receivers)
+        {
+          for (uint8_t tid : {0, 3})
+            {
+              m_queue->Enqueue (CreateItem (dest, tid));
+            }
+          m_queue->Enqueue (CreateItem (dest, 0, false));
+        }
+    }
+}
+
+void
+WifiMacQueueTidAddressTest::CheckLookups (void)
+{
+  for (const auto &dest : m_receivers)
+    {
+      for (uint8_t tid : {0, 3, 5})
+        {
+          // frames of the pair in queue order, found by scanning the queue
+          std::vector<WifiMacQueue::ConstIterator> expected;
+          for (auto it = m_queue->begin (); it != m_queue->end (); it++)
+            {
+              if ((*it)->GetHeader ().IsQosData () && (*it)->GetHeader ().GetAddr1 () == dest
+                  && (*it)->GetHeader ().GetQosTid () == tid
+                  && Simulator::Now () <= (*it)->GetTimeStamp () + m_queue->GetMaxDelay ())
+                {
+                  expected.push_back (it);
+                }
+            }
+
+          WifiMacQueue::ConstIterator it = m_queue->PeekByTidAndAddress (tid, dest);
+          for (std::size_t i = 0; i < expected.size (); i++)
+            {
+              NS_TEST_ASSERT_MSG_EQ ((it == expected[i]), true, "Unexpected frame " << i << " for "
+                                     << dest << " and TID " << +tid);
+              // start the search from the following position
+              it = m_queue->PeekByTidAndAddress (tid, dest, std::next (it));
+            }
+          NS_TEST_EXPECT_MSG_EQ ((it == m_queue->end ()), true, "Unexpected frame for " << dest
+                                 << " and TID " << +tid);
+          NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (tid, dest), expected.size (),
+                                 "Unexpected number of frames for " << dest << " and TID " << +tid);
+        }
+    }
+}
+
+void
+WifiMacQueueTidAddressTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  m_receivers = {Mac48Address ("00:00:00:00:00:01"),
+                 Mac48Address ("00:00:00:00:00:02"),
+                 Mac48Address ("00:00:00:00:00:03")};
+
+  EnqueueFrames ();
+  CheckLookups ();
+
+  // frames pushed at the front and inserted in the middle of the queue
+  m_queue->PushFront (CreateItem (m_receivers[1], 3));
+  m_queue->PushFront (CreateItem (m_receivers[0], 0, false));
+  WifiMacQueue::ConstIterator it = m_queue->PeekByTidAndAddress (0, m_receivers[2]);
+  m_queue->Insert (std::next (it), CreateItem (m_receivers[2], 0));
+  m_queue->Insert (it, CreateItem (m_receivers[0], 3));
+  CheckLookups ();
+
+  // frames dequeued from the head and by receiver and TID
+  m_queue->Dequeue ();
+  m_queue->Dequeue ();
+  m_queue->DequeueByTidAndAddress (3, m_receivers[1]);
+  m_queue->Remove (m_queue->PeekByTidAndAddress (0, m_receivers[0], std::next (m_queue->PeekByTidAndAddress (0, m_receivers[0]))));
+  CheckLookups ();
+
+  // the first frames expire while new frames are enqueued
+  Simulator::Schedule (MilliSeconds (6), &WifiMacQueueTidAddressTest::EnqueueFrames, this);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueTidAddressTest::CheckLookups, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 9 * m_receivers.size (), "Expired frames should have been removed");
+  CheckLookups ();
+
+  // all the frames expire
+  Simulator::Schedule (MilliSeconds (20), &WifiMacQueueTidAddressTest::CheckLookups, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), true, "All the frames should have expired");
+  CheckLookups ();
+
+  m_queue = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief WifiMacQueue Test Suite
+ */
+class WifiMacQueueTestSuite : public TestSuite
+{
+public:
+  WifiMacQueueTestSuite ();
+};
+
+WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
+  : TestSuite ("wifi-mac-queue", UNIT)
+{
+  AddTestCase (new WifiMacQueueTidAddressTest, TestCase::QUICK);
+}
+
+static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
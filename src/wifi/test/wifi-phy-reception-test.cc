@@ -18,9 +18,11 @@
  * Author: Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/spectrum-wifi-helper.h"
@@ -2274,6 +2276,345 @@ TestAmpduReception::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Abstract reception test
+ */
+class TestAbstractReception : public TestCase
+{
+public:
+  TestAbstractReception ();
+  virtual ~TestAbstractReception ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  /**
+   * Send packet function
+   * \param rxPowerDbm the transmit power in dBm
+   */
+  void SendPacket (double rxPowerDbm);
+  /**
+   * RX success function
+   * \param psdu the PSDU
+   * \param snr the SNR
+   * \param txVector the transmit vector
+   * \param statusPerMpdu reception status per MPDU
+   */
+  void RxSuccess (Ptr<WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  /**
+   * RX failure function
+   * \param psdu the PSDU
+   */
+  void RxFailure (Ptr<WifiPsdu> psdu);
+  /**
+   * Schedule now to check the PHY state
+   * \param expectedState the expected PHY state
+   */
+  void CheckPhyState (WifiPhyState expectedState);
+  /**
+   * Check the PHY state now
+   * \param expectedState the expected PHY state
+   */
+  void DoCheckPhyState (WifiPhyState expectedState);
+  /**
+   * Check the number of received packets
+   * \param expectedSuccessCount the number of successfully received packets
+   * \param expectedFailureCount the number of unsuccessfully received packets
+   */
+  void CheckRxCount (uint32_t expectedSuccessCount, uint32_t expectedFailureCount);
+
+  Ptr<SpectrumWifiPhy> m_phy; ///< Phy
+  uint32_t m_countRxSuccess; ///< count RX success
+  uint32_t m_countRxFailure; ///< count RX failure
+};
+
+TestAbstractReception::TestAbstractReception ()
+  : TestCase ("Abstract reception test"),
+    m_countRxSuccess (0),
+    m_countRxFailure (0)
+{
+}
+
+TestAbstractReception::~TestAbstractReception ()
+{
+  m_phy = 0;
+}
+
+void
+TestAbstractReception::SendPacket (double rxPowerDbm)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetHeMcs7 (), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, 20, false, false);
+
+  Ptr<Packet> pkt = Create<Packet> (1000);
+  WifiMacHeader hdr;
+
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  Time txDuration = m_phy->CalculateTxDuration (psdu->GetSize (), txVector, m_phy->GetFrequency ());
+
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration, FREQUENCY);
+
+  Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (rxPowerDbm), GUARD_WIDTH);
+
+  Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
+  txParams->psd = txPowerSpectrum;
+  txParams->txPhy = 0;
+  txParams->duration = txDuration;
+  txParams->ppdu = ppdu;
+
+  m_phy->StartRx (txParams);
+}
+
+void
+TestAbstractReception::RxSuccess (Ptr<WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+{
+  NS_LOG_FUNCTION (this << *psdu << snr << txVector);
+  m_countRxSuccess++;
+}
+
+void
+TestAbstractReception::RxFailure (Ptr<WifiPsdu> psdu)
+{
+  NS_LOG_FUNCTION (this << *psdu);
+  m_countRxFailure++;
+}
+
+void
+TestAbstractReception::CheckPhyState (WifiPhyState expectedState)
+{
+  //This is needed to make sure PHY state will be checked as the last event if a state change occured at the exact same time as the check
+  Simulator::ScheduleNow (&TestAbstractReception::DoCheckPhyState, this, expectedState);
+}
+
+void
+TestAbstractReception::DoCheckPhyState (WifiPhyState expectedState)
+{
+  WifiPhyState currentState;
+  PointerValue ptr;
+  m_phy->GetAttribute ("State", ptr);
+  Ptr <WifiPhyStateHelper> state = DynamicCast <WifiPhyStateHelper> (ptr.Get<WifiPhyStateHelper> ());
+  currentState = state->GetState ();
+  NS_LOG_FUNCTION (this << currentState);
+  NS_TEST_ASSERT_MSG_EQ (currentState, expectedState, "PHY State " << currentState << " does not match expected state " << expectedState << " at " << Simulator::Now ());
+}
+
+void
+TestAbstractReception::CheckRxCount (uint32_t expectedSuccessCount, uint32_t expectedFailureCount)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_countRxSuccess, expectedSuccessCount, "Didn't receive right number of successful packets");
+  NS_TEST_ASSERT_MSG_EQ (m_countRxFailure, expectedFailureCount, "Didn't receive right number of unsuccessful packets");
+}
+
+void
+TestAbstractReception::DoSetup (void)
+{
+  m_phy = CreateObject<SpectrumWifiPhy> ();
+  m_phy->SetAttribute ("AbstractReception", BooleanValue (true));
+  m_phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ax_5GHZ);
+  Ptr<ErrorRateModel> error = CreateObject<NistErrorRateModel> ();
+  m_phy->SetErrorRateModel (error);
+  m_phy->SetChannelNumber (CHANNEL_NUMBER);
+  m_phy->SetFrequency (FREQUENCY);
+  m_phy->SetReceiveOkCallback (MakeCallback (&TestAbstractReception::RxSuccess, this));
+  m_phy->SetReceiveErrorCallback (MakeCallback (&TestAbstractReception::RxFailure, this));
+  Ptr<ThresholdPreambleDetectionModel> preambleDetectionModel = CreateObject<ThresholdPreambleDetectionModel> ();
+  m_phy->SetPreambleDetectionModel (preambleDetectionModel);
+}
+
+void
+TestAbstractReception::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 0;
+  m_phy->AssignStreams (streamNumber);
+
+  double rxPowerDbm = -50;
+
+  // CASE 1: one packet is received: the PHY is in RX from the start to the end of the PPDU,
+  // which takes 152.8us, without any intermediate CCA_BUSY state.
+  Simulator::Schedule (Seconds (1.0), &TestAbstractReception::SendPacket, this, rxPowerDbm);
+  Simulator::Schedule (Seconds (1.0), &TestAbstractReception::CheckPhyState, this, WifiPhyState::RX);
+  Simulator::Schedule (Seconds (1.0) + NanoSeconds (152799), &TestAbstractReception::CheckPhyState, this, WifiPhyState::RX);
+  Simulator::Schedule (Seconds (1.0) + NanoSeconds (152800), &TestAbstractReception::CheckPhyState, this, WifiPhyState::IDLE);
+  Simulator::Schedule (Seconds (1.1), &TestAbstractReception::CheckRxCount, this, 1, 0);
+
+  // CASE 2: a second packet with the same power arrives 10us after the first one: the PHY headers
+  // were decided at the start of the first packet, which is received until its end, but its payload
+  // fails.  The PHY is then CCA_BUSY until the end of the second packet.
+  Simulator::Schedule (Seconds (2.0), &TestAbstractReception::SendPacket, this, rxPowerDbm);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (10), &TestAbstractReception::SendPacket, this, rxPowerDbm);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (10), &TestAbstractReception::CheckPhyState, this, WifiPhyState::RX);
+  Simulator::Schedule (Seconds (2.0) + NanoSeconds (152799), &TestAbstractReception::CheckPhyState, this, WifiPhyState::RX);
+  Simulator::Schedule (Seconds (2.0) + NanoSeconds (152800), &TestAbstractReception::CheckPhyState, this, WifiPhyState::CCA_BUSY);
+  Simulator::Schedule (Seconds (2.0) + NanoSeconds (162799), &TestAbstractReception::CheckPhyState, this, WifiPhyState::CCA_BUSY);
+  Simulator::Schedule (Seconds (2.0) + NanoSeconds (162800), &TestAbstractReception::CheckPhyState, this, WifiPhyState::IDLE);
+  Simulator::Schedule (Seconds (2.1), &TestAbstractReception::CheckRxCount, this, 1, 1);
+
+  // CASE 3: a second packet 30 dB weaker arrives 10us after the first one: the effective SNR of the
+  // payload is high enough for the first packet to be received.
+  Simulator::Schedule (Seconds (3.0), &TestAbstractReception::SendPacket, this, rxPowerDbm);
+  Simulator::Schedule (Seconds (3.0) + MicroSeconds (10), &TestAbstractReception::SendPacket, this, rxPowerDbm - 30);
+  Simulator::Schedule (Seconds (3.0) + NanoSeconds (152799), &TestAbstractReception::CheckPhyState, this, WifiPhyState::RX);
+  Simulator::Schedule (Seconds (3.0) + NanoSeconds (152800), &TestAbstractReception::CheckPhyState, this, WifiPhyState::IDLE);
+  Simulator::Schedule (Seconds (3.1), &TestAbstractReception::CheckRxCount, this, 2, 1);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Abstract reception PER test
+ *
+ * The same interference-free PSDUs are received at a marginal SNR by a PHY
+ * with abstract reception disabled and by a PHY with abstract reception
+ * enabled, using the same random draws: since the SNIR is constant over the
+ * payload, both PHYs must compute the same PER and therefore receive the
+ * same PSDUs.
+ */
+class TestAbstractReceptionPer : public TestCase
+{
+public:
+  TestAbstractReceptionPer ();
+  virtual ~TestAbstractReceptionPer ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Receive PSDUs with or without abstract reception
+   * \param abstractReception whether abstract reception is enabled
+   * \param rxPowerDbm the received power in dBm
+   * \param nPackets the number of PSDUs to send
+   */
+  void RunReception (bool abstractReception, double rxPowerDbm, uint32_t nPackets);
+  /**
+   * Send packet function
+   * \param rxPowerDbm the received power in dBm
+   */
+  void SendPacket (double rxPowerDbm);
+  /**
+   * RX success function
+   * \param psdu the PSDU
+   * \param snr the SNR
+   * \param txVector the transmit vector
+   * \param statusPerMpdu reception status per MPDU
+   */
+  void RxSuccess (Ptr<WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  /**
+   * RX failure function
+   * \param psdu the PSDU
+   */
+  void RxFailure (Ptr<WifiPsdu> psdu);
+
+  Ptr<SpectrumWifiPhy> m_phy; ///< Phy
+  std::vector<bool> m_rxOutcomes; ///< reception outcome of each PSDU, in order
+};
+
+TestAbstractReceptionPer::TestAbstractReceptionPer ()
+  : TestCase ("Abstract reception PER test")
+{
+}
+
+TestAbstractReceptionPer::~TestAbstractReceptionPer ()
+{
+  m_phy = 0;
+}
+
+void
+TestAbstractReceptionPer::SendPacket (double rxPowerDbm)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetHeMcs7 (), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, 20, false, false);
+
+  Ptr<Packet> pkt = Create<Packet> (100);
+  WifiMacHeader hdr;
+
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  Time txDuration = m_phy->CalculateTxDuration (psdu->GetSize (), txVector, m_phy->GetFrequency ());
+
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration, FREQUENCY);
+
+  Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (rxPowerDbm), GUARD_WIDTH);
+
+  Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
+  txParams->psd = txPowerSpectrum;
+  txParams->txPhy = 0;
+  txParams->duration = txDuration;
+  txParams->ppdu = ppdu;
+
+  m_phy->StartRx (txParams);
+}
+
+void
+TestAbstractReceptionPer::RxSuccess (Ptr<WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+{
+  NS_LOG_FUNCTION (this << *psdu << snr << txVector);
+  m_rxOutcomes.push_back (true);
+}
+
+void
+TestAbstractReceptionPer::RxFailure (Ptr<WifiPsdu> psdu)
+{
+  NS_LOG_FUNCTION (this << *psdu);
+  m_rxOutcomes.push_back (false);
+}
+
+void
+TestAbstractReceptionPer::RunReception (bool abstractReception, double rxPowerDbm, uint32_t nPackets)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  m_phy = CreateObject<SpectrumWifiPhy> ();
+  m_phy->SetAttribute ("AbstractReception", BooleanValue (abstractReception));
+  m_phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ax_5GHZ);
+  Ptr<ErrorRateModel> error = CreateObject<NistErrorRateModel> ();
+  m_phy->SetErrorRateModel (error);
+  m_phy->SetChannelNumber (CHANNEL_NUMBER);
+  m_phy->SetFrequency (FREQUENCY);
+  m_phy->SetReceiveOkCallback (MakeCallback (&TestAbstractReceptionPer::RxSuccess, this));
+  m_phy->SetReceiveErrorCallback (MakeCallback (&TestAbstractReceptionPer::RxFailure, this));
+  m_phy->AssignStreams (0);
+
+  for (uint32_t i = 0; i < nPackets; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (i + 1), &TestAbstractReceptionPer::SendPacket, this, rxPowerDbm);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_phy = 0;
+}
+
+void
+TestAbstractReceptionPer::DoRun (void)
+{
+  double rxPowerDbm = -71.5; // PER of about 0.5
+  uint32_t nPackets = 200;
+
+  RunReception (false, rxPowerDbm, nPackets);
+  std::vector<bool> expectedOutcomes = m_rxOutcomes;
+  m_rxOutcomes.clear ();
+  RunReception (true, rxPowerDbm, nPackets);
+
+  uint32_t nSuccess = std::count (expectedOutcomes.begin (), expectedOutcomes.end (), true);
+  NS_TEST_ASSERT_MSG_EQ (expectedOutcomes.size (), nPackets, "All PSDUs should be received without abstract reception");
+  NS_TEST_ASSERT_MSG_GT (nSuccess, 0, "The SNR should be high enough for some PSDUs to be received");
+  NS_TEST_ASSERT_MSG_LT (nSuccess, nPackets, "The SNR should be low enough for some PSDUs to fail");
+  NS_TEST_ASSERT_MSG_EQ (m_rxOutcomes.size (), nPackets, "All PSDUs should be received with abstract reception");
+  NS_TEST_ASSERT_MSG_EQ ((m_rxOutcomes == expectedOutcomes), true, "Abstract reception should give the same PER as chunk-based reception");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2294,6 +2635,8 @@ WifiPhyReceptionTestSuite::WifiPhyReceptionTestSuite ()
   AddTestCase (new TestSimpleFrameCaptureModel, TestCase::QUICK);
   AddTestCase (new TestPhyHeadersReception, TestCase::QUICK);
   AddTestCase (new TestAmpduReception, TestCase::QUICK);
+  AddTestCase (new TestAbstractReception, TestCase::QUICK);
+  AddTestCase (new TestAbstractReceptionPer, TestCase::QUICK);
 }
 
 static WifiPhyReceptionTestSuite wifiPhyReceptionTestSuite; ///< the test suite
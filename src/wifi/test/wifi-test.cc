@@ -2483,6 +2483,103 @@ Issue169TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the PHYs farther than the MaxRange of a YansWifiChannel
+ * from a sender do not receive its signals, even if the loss model would
+ * let them, and that the PHYs which move into range do.
+ */
+class YansWifiChannelRangeTest : public TestCase
+{
+public:
+  YansWifiChannelRangeTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Callback when a PHY starts receiving a packet
+   * \param context node context
+   * \param p the packet
+   */
+  void RxBeginCallback (std::string context, Ptr<const Packet> p);
+  /**
+   * Send a broadcast packet
+   * \param dev the device
+   */
+  void SendOnePacket (Ptr<NetDevice> dev);
+
+  uint32_t m_rxCount[3]; ///< Number of receptions started by each node
+};
+
+YansWifiChannelRangeTest::YansWifiChannelRangeTest ()
+  : TestCase ("Test case for the range of the YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelRangeTest::RxBeginCallback (std::string context, Ptr<const Packet> p)
+{
+  std::string sub = context.substr (10);
+  uint32_t nodeId = atoi (sub.substr (0, sub.find ("/Device")).c_str ());
+  m_rxCount[nodeId]++;
+}
+
+void
+YansWifiChannelRangeTest::SendOnePacket (Ptr<NetDevice> dev)
+{
+  Ptr<Packet> p = Create<Packet> (1000);
+  dev->Send (p, dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelRangeTest::DoRun (void)
+{
+  m_rxCount[0] = m_rxCount[1] = m_rxCount[2] = 0;
+  NodeContainer nodes;
+  nodes.Create (3);
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper channel;
+  channel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  channel.AddPropagationLoss ("ns3::FixedRssLossModel", "Rss", DoubleValue (-50));
+  Ptr<YansWifiChannel> yansChannel = channel.Create ();
+  yansChannel->SetAttribute ("MaxRange", DoubleValue (100));
+  phy.SetChannel (yansChannel);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (50.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (300.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::WifiPhy/PhyRxBegin",
+                   MakeCallback (&YansWifiChannelRangeTest::RxBeginCallback, this));
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelRangeTest::SendOnePacket, this, devices.Get (0));
+  Simulator::Schedule (Seconds (2.0), &MobilityModel::SetPosition,
+                       nodes.Get (2)->GetObject<MobilityModel> (), Vector (90.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (3.0), &YansWifiChannelRangeTest::SendOnePacket, this, devices.Get (0));
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[0], 0, "The sender must not receive its packets");
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[1], 2, "The node in range must receive both packets");
+  NS_TEST_ASSERT_MSG_EQ (m_rxCount[2], 1, "The node must only receive the packet sent when it is in range");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2512,6 +2609,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2470TestCase, TestCase::QUICK); //Bug 2470
   AddTestCase (new Issue40TestCase, TestCase::QUICK); //Issue #40
   AddTestCase (new Issue169TestCase, TestCase::QUICK); //Issue #169
+  AddTestCase (new YansWifiChannelRangeTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
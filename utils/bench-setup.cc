@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the setup of a large simulation:
+// the construction of 'n' nodes with a Wi-Fi device and the internet
+// stack, their addressing, and the configuration of their attributes and
+// trace sources through the Config paths.  The simulation is not run.
+// Sample usage:  ./waf --run 'bench-setup --n=10000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/internet-module.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// Wall clock time of the current phase
+static SystemWallClockMs g_time;
+
+/**
+ * Start a phase of the setup.
+ * \param name the name of the phase
+ */
+static void
+StartPhase (std::string name)
+{
+  std::cout << name << "... " << std::flush;
+  g_time.Start ();
+}
+
+/**
+ * End a phase of the setup, and print its duration.
+ * \param n the number of nodes
+ */
+static void
+EndPhase (uint32_t n)
+{
+  uint64_t deltaMs = g_time.End ();
+  std::cout << deltaMs << " ms (" << deltaMs * 1000.0 / n << " us/node)" << std::endl;
+}
+
+/**
+ * Trace sink of the transmissions.
+ * \param p the packet
+ * \param txPowerW the transmit power
+ */
+static void
+PhyTxBegin (Ptr<const Packet> p, double txPowerW)
+{
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the setup of nodes with Wi-Fi and internet stacks");
+  cmd.AddValue ("n", "number of nodes", n);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of nodes must be positive" << std::endl;
+      return 1;
+    }
+  std::cout << "Running bench-setup with n=" << n << std::endl;
+  SystemWallClockMs total;
+  total.Start ();
+
+  StartPhase ("Create nodes");
+  NodeContainer nodes;
+  nodes.Create (n);
+  EndPhase (n);
+
+  StartPhase ("Install mobility");
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (10.0),
+                                 "DeltaY", DoubleValue (10.0),
+                                 "GridWidth", UintegerValue (1000));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+  EndPhase (n);
+
+  StartPhase ("Install Wi-Fi");
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"));
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  EndPhase (n);
+
+  StartPhase ("Install internet stack");
+  InternetStackHelper internet;
+  internet.Install (nodes);
+  EndPhase (n);
+
+  StartPhase ("Assign addresses");
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.0.0.0", "255.0.0.0");
+  ipv4.Assign (devices);
+  EndPhase (n);
+
+  StartPhase ("Set attributes by path");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      std::ostringstream oss;
+      oss << "/NodeList/" << nodes.Get (i)->GetId () << "/DeviceList/0/$ns3::WifiNetDevice/Phy/";
+      Config::Set (oss.str () + "TxPowerStart", DoubleValue (15.0));
+      Config::Set (oss.str () + "TxPowerEnd", DoubleValue (15.0));
+    }
+  EndPhase (n);
+
+  StartPhase ("Connect trace sources by path");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      std::ostringstream oss;
+      oss << "/NodeList/" << nodes.Get (i)->GetId () << "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxBegin";
+      Config::ConnectWithoutContext (oss.str (), MakeCallback (&PhyTxBegin));
+    }
+  EndPhase (n);
+
+  StartPhase ("Set attributes by wildcard");
+  Config::Set ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/RxSensitivity", DoubleValue (-95.0));
+  EndPhase (n);
+
+  StartPhase ("Destroy");
+  Simulator::Destroy ();
+  EndPhase (n);
+
+  std::cout << "Total " << total.End () << " ms" << std::endl;
+  return 0;
+}
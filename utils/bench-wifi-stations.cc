@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the per-station lookups made by an
+// access point for every frame, as the number of associated stations grows:
+// the remote station manager (TX vector selection and RX report), the
+// Block Ack agreements and the A-MPDU flags of the QosTxop.  The stations
+// are not simulated: their addresses are registered as if they had
+// associated, and the lookups of 'frames' frames, sent to the stations in
+// turn, are timed.
+// Sample usage:  ./waf --run 'bench-wifi-stations --stations=10,100,2000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/block-ack-manager.h"
+#include "ns3/qos-txop.h"
+#include "ns3/mgt-headers.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print the duration of a phase.
+ * \param name the name of the phase
+ * \param deltaMs the duration of the phase
+ * \param frames the number of frames
+ */
+static void
+PrintPhase (std::string name, int64_t deltaMs, uint32_t frames)
+{
+  std::cout << "  " << name << ": " << deltaMs << " ms ("
+            << deltaMs * 1e6 / frames << " ns/frame)" << std::endl;
+}
+
+/**
+ * Callback invoked when an agreement is created.
+ * \param recipient the recipient of the agreement
+ * \param tid the TID of the agreement
+ */
+static void
+BlockDestination (Mac48Address recipient, uint8_t tid)
+{
+}
+
+/**
+ * Run the benchmark with a given number of stations.
+ * \param nStations the number of associated stations
+ * \param frames the number of frames
+ * \param manager the type of remote station manager
+ */
+static void
+Run (uint32_t nStations, uint32_t frames, std::string manager)
+{
+  std::cout << nStations << " stations" << std::endl;
+
+  NodeContainer ap;
+  ap.Create (1);
+  MobilityHelper mobility;
+  mobility.Install (ap);
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiMacHelper mac;
+  mac.SetType ("ns3::ApWifiMac");
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  wifi.SetRemoteStationManager (manager);
+  NetDeviceContainer devices = wifi.Install (phy, mac, ap);
+  ap.Get (0)->Initialize ();
+  Ptr<WifiRemoteStationManager> stationManager =
+    DynamicCast<WifiNetDevice> (devices.Get (0))->GetRemoteStationManager ();
+
+  Ptr<BlockAckManager> baManager = CreateObject<BlockAckManager> ();
+  baManager->SetWifiRemoteStationManager (stationManager);
+  baManager->SetBlockDestinationCallback (MakeCallback (&BlockDestination));
+  Ptr<QosTxop> txop = CreateObject<QosTxop> ();
+
+  std::vector<Mac48Address> stations;
+  for (uint32_t i = 0; i < nStations; ++i)
+    {
+      Mac48Address address = Mac48Address::Allocate ();
+      stations.push_back (address);
+      stationManager->AddAllSupportedModes (address);
+      stationManager->RecordWaitAssocTxOk (address);
+      stationManager->RecordGotAssocTxOk (address);
+      MgtAddBaRequestHeader reqHdr;
+      reqHdr.SetImmediateBlockAck ();
+      reqHdr.SetTid (0);
+      reqHdr.SetBufferSize (64);
+      reqHdr.SetTimeout (0);
+      reqHdr.SetStartingSequence (0);
+      baManager->CreateAgreement (&reqHdr, address);
+      txop->SetAmpduExist (address, true);
+    }
+
+  Ptr<Packet> packet = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  WifiMode mode = stationManager->GetDefaultMode ();
+  SystemWallClockMs clock;
+
+  clock.Start ();
+  uint32_t associated = 0;
+  for (uint32_t i = 0; i < frames; ++i)
+    {
+      Mac48Address address = stations[i % nStations];
+      hdr.SetAddr1 (address);
+      stationManager->GetDataTxVector (address, &hdr, packet);
+      stationManager->ReportRxOk (address, 20, mode);
+      associated += stationManager->IsAssociated (address);
+    }
+  PrintPhase ("Remote station manager", clock.End (), frames);
+  NS_ABORT_MSG_UNLESS (associated == frames, "All the stations must be associated");
+
+  clock.Start ();
+  uint32_t agreements = 0;
+  for (uint32_t i = 0; i < frames; ++i)
+    {
+      Mac48Address address = stations[i % nStations];
+      agreements += baManager->ExistsAgreementInState (address, 0, OriginatorBlockAckAgreement::PENDING);
+      agreements += txop->GetAmpduExist (address);
+    }
+  PrintPhase ("Block Ack agreements", clock.End (), frames);
+  NS_ABORT_MSG_UNLESS (agreements == 2 * frames, "All the stations must have an agreement");
+
+  txop->Dispose ();
+  baManager->Dispose ();
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string stationList = "10,100,500,1000,2000";
+  uint32_t frames = 1000000;
+  std::string manager = "ns3::IdealWifiManager";
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the per-station lookups of an access point");
+  cmd.AddValue ("stations", "comma-separated numbers of associated stations", stationList);
+  cmd.AddValue ("frames", "number of frames", frames);
+  cmd.AddValue ("manager", "type of remote station manager", manager);
+  cmd.Parse (argc, argv);
+
+  if (frames == 0)
+    {
+      std::cerr << "Error-- number of frames must be positive" << std::endl;
+      return 1;
+    }
+  std::cout << "Running bench-wifi-stations with frames=" << frames
+            << " and " << manager << std::endl;
+  std::istringstream iss (stationList);
+  std::string item;
+  while (std::getline (iss, item, ','))
+    {
+      uint32_t nStations = std::stoul (item);
+      if (nStations == 0)
+        {
+          std::cerr << "Error-- number of stations must be positive" << std::endl;
+          return 1;
+        }
+      Run (nStations, frames, manager);
+    }
+  return 0;
+}